@@ -250,6 +250,14 @@ namespace Plugin {
                     result->Body(Core::proxy_cast<Web::IBody>(response));
                 }
             }
+        } else if (index.Current() == _T("Metrics")) {
+            // Served in the Prometheus text format, so it can be scraped as is.
+            Core::ProxyType<Web::TextBody> response(jsonBodyTextFactory.Element());
+
+            _pluginServer->Services().Prometheus(*response);
+
+            result->ContentType = Web::MIME_TEXT;
+            result->Body(Core::proxy_cast<Web::IBody>(response));
         } else if (index.Current() == _T("Process")) {
             Core::ProxyType<Web::JSONBodyType<PluginHost::MetaData>> response(jsonBodyMetaDataFactory.Element());
 
@@ -529,37 +537,64 @@ namespace Plugin {
 		else {
 			Core::ProxyType<PluginHost::Server::Service> service;
 
-            uint32_t result = _pluginServer->Services().FromIdentifier(callsign, service);
+            result = _pluginServer->Services().FromIdentifier(callsign, service);
 
             if (result == Core::ERROR_NONE) {
                 ASSERT(service.IsValid());
-                PluginHost::IDispatcher* plugin = service->Dispatcher();
 
-                if (plugin == nullptr) {
-                    result = Core::ERROR_BAD_REQUEST;
-                } else if (service->State() != PluginHost::IShell::ACTIVATED) {
-                    result = Core::ERROR_UNAVAILABLE;
-                } else {
+                if ((service->IsLazy() == true) && (service->State() != PluginHost::IShell::ACTIVATED)) {
+                    // Lazy plugins are activated by their first call, registrations for events included. The
+                    // call waits for that, parked with the plugin, and is answered once it is forwarded.
+                    Core::ProxyType<Forwarder> job(Core::ProxyType<Forwarder>::Create(*this, channelId, service, inbound));
+
+                    asyncCall = job->Park();
+                }
+
+                if (asyncCall == false) {
                     Core::JSONRPC::Message forwarder;
 
                     forwarder.Id = inbound.Id;
                     forwarder.Parameters = inbound.Parameters;
                     
                     forwarder.Designator = inbound.VersionedFullMethod();
-                    response = plugin->Invoke(channelId, forwarder);
-                    asyncCall = (response.IsValid() == false);
+
+                    result = Forward(channelId, *service, forwarder, response);
+                    asyncCall = ((result == Core::ERROR_NONE) && (response.IsValid() == false));
                 }
             }
 		}
 
         if ((inbound.Id.Value() != static_cast<uint32_t>(~0)) && (response.IsValid() == false) && (asyncCall == false)) {
-            response = Message();
-            response->JSONRPC = Core::JSONRPC::Message::DefaultVersion;
-            response->Error.SetError(result);
-            response->Error.Text = "Invalid JSONRPC Request";
-            response->Id = inbound.Id.Value();
+            response = Failure(inbound.Id.Value(), result);
+        }
+
+        return (response);
+    }
+
+    uint32_t Controller::Forward(const uint32_t channelId, PluginHost::Server::Service& service, const Core::JSONRPC::Message& forwarder, Core::ProxyType<Core::JSONRPC::Message>& response)
+    {
+        uint32_t result = Core::ERROR_NONE;
+
+        if (service.Dispatcher() == nullptr) {
+            result = Core::ERROR_BAD_REQUEST;
+        } else if (service.State() != PluginHost::IShell::ACTIVATED) {
+            result = Core::ERROR_UNAVAILABLE;
+        } else {
+            response = service.Invoke(channelId, forwarder, 0);
         }
 
+        return (result);
+    }
+
+    Core::ProxyType<Core::JSONRPC::Message> Controller::Failure(const uint32_t id, const uint32_t result) const
+    {
+        Core::ProxyType<Core::JSONRPC::Message> response(Message());
+
+        response->JSONRPC = Core::JSONRPC::Message::DefaultVersion;
+        response->Error.SetError(result);
+        response->Error.Text = "Invalid JSONRPC Request";
+        response->Id = id;
+
         return (response);
     }
 
@@ -105,6 +105,62 @@ namespace Plugin {
             Core::ProxyType<Job> _decoupled;
         };
 
+        // A call for a lazy plugin that is not activated yet. It is parked with the plugin, which gets activated,
+        // and forwarded once that is settled. The answer goes out as an asynchronous one.
+        class Forwarder : public Core::IDispatchType<void> {
+        private:
+            Forwarder() = delete;
+            Forwarder(const Forwarder&) = delete;
+            Forwarder& operator=(const Forwarder&) = delete;
+
+        public:
+            Forwarder(Controller& parent, const uint32_t channelId, const Core::ProxyType<PluginHost::Server::Service>& service, const Core::JSONRPC::Message& inbound)
+                : _parent(parent)
+                , _channelId(channelId)
+                , _service(service)
+                , _message()
+                , _requested(false)
+            {
+                _message.Id = inbound.Id;
+                _message.Parameters = inbound.Parameters;
+                _message.Designator = inbound.VersionedFullMethod();
+            }
+            virtual ~Forwarder()
+            {
+            }
+
+        public:
+            // Returns true if the call waits for the plugin.
+            bool Park()
+            {
+                return (_service->Wakeup(Core::ProxyType<Core::IDispatchType<void>>(*this), _requested));
+            }
+            virtual void Dispatch() override
+            {
+                if (Park() == false) {
+                    Core::ProxyType<Core::JSONRPC::Message> response;
+
+                    const uint32_t result = _parent.Forward(_channelId, *_service, _message, response);
+
+                    if ((result != Core::ERROR_NONE) && (_message.Id.Value() != static_cast<uint32_t>(~0))) {
+                        response = _parent.Failure(_message.Id.Value(), result);
+                    }
+                    if (response.IsValid() == true) {
+                        _parent._service->Submit(_channelId, Core::ProxyType<Core::JSON::IElement>(response));
+                    }
+
+                    _service.Release();
+                }
+            }
+
+        private:
+            Controller& _parent;
+            const uint32_t _channelId;
+            Core::ProxyType<PluginHost::Server::Service> _service;
+            Core::JSONRPC::Message _message;
+            bool _requested;
+        };
+
         // GET -> URL /<MetaDataCallsign>/Plugin/<Callsign>
         // PUT -> URL /<MetaDataCallsign>/Configure
         // PUT -> URL /<MetaDataCallsign>/Activate/<Callsign>
@@ -260,6 +316,8 @@ namespace Plugin {
                 newElement = snapshot.Slot[teller];
                 data.ThreadPoolRuns.Add(newElement);
             }
+
+            _pluginServer->Services().TokenStatistics(data.Tokens);
 		}
         void SubSystems();
         void SubSystems(Core::JSON::ArrayType<Core::JSON::EnumType<PluginHost::ISubSystem::subsystem>>::ConstIterator& index);
@@ -268,6 +326,8 @@ namespace Plugin {
         Core::ProxyType<Web::Response> DeleteMethod(Core::TextSegmentIterator& index, const Web::Request& request);
         void StateChange(PluginHost::IShell* plugin);
         virtual Core::ProxyType<Core::JSONRPC::Message> Invoke(const uint32_t channelId, const Core::JSONRPC::Message& inbound) override;
+        uint32_t Forward(const uint32_t channelId, PluginHost::Server::Service& service, const Core::JSONRPC::Message& forwarder, Core::ProxyType<Core::JSONRPC::Message>& response);
+        Core::ProxyType<Core::JSONRPC::Message> Failure(const uint32_t id, const uint32_t result) const;
         void DeleteDirectory(const string& directory);
 
         void RegisterAll();
@@ -281,6 +341,7 @@ namespace Plugin {
         uint32_t get_status(const string& index, Core::JSON::ArrayType<PluginHost::MetaData::Service>& response) const;
         uint32_t get_links(Core::JSON::ArrayType<PluginHost::MetaData::Channel>& response) const;
         uint32_t get_processinfo(PluginHost::MetaData::Server& response) const;
+        uint32_t get_metrics(const string& index, Core::JSON::ArrayType<PluginHost::MetaData::Metrics>& response) const;
         uint32_t get_subsystems(Core::JSON::ArrayType<JsonData::Controller::SubsystemsParamsData>& response) const;
         uint32_t get_discoveryresults(Core::JSON::ArrayType<PluginHost::MetaData::Bridge>& response) const;
         uint32_t get_environment(const string& index, Core::JSON::String& response) const;
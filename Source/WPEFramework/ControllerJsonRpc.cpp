@@ -42,7 +42,10 @@ namespace Plugin {
         Property<Core::JSON::ArrayType<PluginHost::MetaData::Service>>(_T("status"), &Controller::get_status, nullptr, this);
         Property<Core::JSON::ArrayType<PluginHost::MetaData::Channel>>(_T("links"), &Controller::get_links, nullptr, this);
         Property<PluginHost::MetaData::Server>(_T("processinfo"), &Controller::get_processinfo, nullptr, this);
+        Property<Core::JSON::ArrayType<PluginHost::MetaData::Metrics>>(_T("metrics"), &Controller::get_metrics, nullptr, this);
         Property<Core::JSON::ArrayType<SubsystemsParamsData>>(_T("subsystems"), &Controller::get_subsystems, nullptr, this);
+        // Polled a lot, while every change is announced.
+        Cacheable(_T("subsystems"), 60000, { _T("subsystemchange") });
         Property<Core::JSON::ArrayType<PluginHost::MetaData::Bridge>>(_T("discoveryresults"), &Controller::get_discoveryresults, nullptr, this);
         Property<Core::JSON::String>(_T("environment"), &Controller::get_environment, nullptr, this);
         Property<Core::JSON::String>(_T("configuration"), &Controller::get_configuration, &Controller::set_configuration, this);
@@ -60,6 +63,7 @@ namespace Plugin {
         Unregister(_T("environment"));
         Unregister(_T("discoveryresults"));
         Unregister(_T("subsystems"));
+        Unregister(_T("metrics"));
         Unregister(_T("processinfo"));
         Unregister(_T("links"));
         Unregister(_T("status"));
@@ -261,6 +265,19 @@ namespace Plugin {
         return Core::ERROR_NONE;
     }
 
+    // Property: metrics - Call statistics of plugins, per method
+    // Return codes:
+    //  - ERROR_NONE: Success
+    //  - ERROR_UNKNOWN_KEY: The service does not exist
+    uint32_t Controller::get_metrics(const string& index, Core::JSON::ArrayType<PluginHost::MetaData::Metrics>& response) const
+    {
+        ASSERT(_pluginServer != nullptr);
+
+        _pluginServer->Services().GetMetrics(index, response);
+
+        return ((index.empty() == true) || (response.Length() != 0) ? Core::ERROR_NONE : Core::ERROR_UNKNOWN_KEY);
+    }
+
     // Property: processinfo - Information about the framework process
     // Return codes:
     //  - ERROR_NONE: Success
@@ -21,6 +21,13 @@ string(TOLOWER ${NAMESPACE} NAMESPACE_LIB)
 set(PORT 80 CACHE STRING "The port for the webinterface")
 set(BINDING "0.0.0.0" CACHE STRING "The binding interface")
 set(IDLE_TIME 180 CACHE STRING "Idle time")
+set(MAX_BATCH_SIZE 64 CACHE STRING "Maximum number of requests in a JSON-RPC batch, 0 disables batches")
+set(SEND_QUEUE_LIMIT 256 CACHE STRING "Maximum number of messages queued per websocket link, 0 is unlimited")
+set(SEND_QUEUE_POLICY "coalesce" CACHE STRING "Policy for a full send queue: dropoldest, coalesce or disconnect")
+set(PIPELINE_DEPTH 16 CACHE STRING "Maximum number of pipelined HTTP requests per connection handled at the same time, as many may wait, 0 is unlimited")
+set(WEBSOCKET_COMPRESSION "none" CACHE STRING "permessage-deflate on websocket links if the client offers it: none, deflate or deflatenocontext")
+set(WEBSOCKET_MAX_MESSAGE_SIZE 4194304 CACHE STRING "Largest message taken in on a websocket link in bytes, over all its frames and after inflating, 0 is unlimited")
+set(STARTUP_THREADS 4 CACHE STRING "Number of threads activating the autostart plugins in parallel, 1 activates them one by one")
 set(PERSISTENT_PATH "/root" CACHE STRING "Persistent path")
 set(DATA_PATH "${CMAKE_INSTALL_PREFIX}/share/${NAMESPACE}" CACHE STRING "Data path")
 set(SYSTEM_PATH "${CMAKE_INSTALL_PREFIX}/lib/${NAMESPACE_LIB}/plugins" CACHE STRING "System path")
@@ -46,6 +53,13 @@ map_set(${CONFIG} port ${PORT})
 map_set(${CONFIG} binding ${BINDING})
 map_set(${CONFIG} ipv6 ${IPV6_SUPPORT})
 map_set(${CONFIG} idletime ${IDLE_TIME})
+map_set(${CONFIG} maxbatchsize ${MAX_BATCH_SIZE})
+map_set(${CONFIG} sendqueuelimit ${SEND_QUEUE_LIMIT})
+map_set(${CONFIG} sendqueuepolicy ${SEND_QUEUE_POLICY})
+map_set(${CONFIG} pipelinedepth ${PIPELINE_DEPTH})
+map_set(${CONFIG} compression ${WEBSOCKET_COMPRESSION})
+map_set(${CONFIG} maxmessagesize ${WEBSOCKET_MAX_MESSAGE_SIZE})
+map_set(${CONFIG} startupthreads ${STARTUP_THREADS})
 map_set(${CONFIG} persistentpath ${PERSISTENT_PATH})
 map_set(${CONFIG} volatilepath ${VOLATILE_PATH})
 map_set(${CONFIG} datapath ${DATA_PATH})
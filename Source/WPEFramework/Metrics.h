@@ -0,0 +1,304 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2020 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "Module.h"
+
+#include <atomic>
+
+namespace WPEFramework {
+namespace PluginHost {
+
+    // Call statistics of a plugin, per method. Nothing a request touches takes a lock: a method is found in an
+    // open addressed table of which the slots are claimed with a compare-and-swap and never given back, the
+    // figures of a method are atomics. Methods that no longer fit the table are counted as one.
+    class Metrics {
+    public:
+        // Durations are in microseconds, the last bucket counts everything from ~4s on.
+        typedef Core::HistogramType<24> Histogram;
+
+        class Method {
+        public:
+            Method() = delete;
+            Method(const Method&) = delete;
+            Method& operator=(const Method&) = delete;
+
+            Method(const Core::TextFragment& name)
+                : _name(name.Data(), name.Length())
+                , _errors(0)
+                , _lastError(0)
+                , _bytesIn(0)
+                , _bytesOut(0)
+                , _wait()
+                , _execution()
+            {
+            }
+            ~Method()
+            {
+            }
+
+        public:
+            inline const string& Name() const
+            {
+                return (_name);
+            }
+            // A wait of ~0 means the time spent in a queue is not known.
+            void Record(const uint32_t wait, const uint32_t duration, const int32_t error, const uint32_t bytesIn, const uint32_t bytesOut)
+            {
+                if (wait != static_cast<uint32_t>(~0)) {
+                    _wait.Add(wait);
+                }
+                _execution.Add(duration);
+
+                if (error != 0) {
+                    _errors.fetch_add(1, std::memory_order_relaxed);
+                    _lastError.store(error, std::memory_order_relaxed);
+                }
+
+                _bytesIn.fetch_add(bytesIn, std::memory_order_relaxed);
+                _bytesOut.fetch_add(bytesOut, std::memory_order_relaxed);
+            }
+            void Get(MetaData::Metrics::Method& info) const
+            {
+                info.Name = _name;
+                info.Calls = _execution.Count();
+                info.Errors = _errors.load(std::memory_order_relaxed);
+                info.LastError = _lastError.load(std::memory_order_relaxed);
+                info.BytesIn = _bytesIn.load(std::memory_order_relaxed);
+                info.BytesOut = _bytesOut.load(std::memory_order_relaxed);
+                Get(_wait, info.Wait);
+                Get(_execution, info.Execution);
+            }
+            inline uint32_t Errors() const
+            {
+                return (_errors.load(std::memory_order_relaxed));
+            }
+            inline uint64_t BytesIn() const
+            {
+                return (_bytesIn.load(std::memory_order_relaxed));
+            }
+            inline uint64_t BytesOut() const
+            {
+                return (_bytesOut.load(std::memory_order_relaxed));
+            }
+            inline const Histogram& Wait() const
+            {
+                return (_wait);
+            }
+            inline const Histogram& Execution() const
+            {
+                return (_execution);
+            }
+
+        private:
+            static void Get(const Histogram& histogram, MetaData::Metrics::Histogram& info)
+            {
+                info.Count = histogram.Count();
+                info.Total = histogram.Total();
+                info.Max = histogram.Max();
+
+                for (uint8_t index = 0; index < Histogram::Buckets(); index++) {
+                    info.Buckets.Add(Core::JSON::DecUInt32(histogram[index]));
+                }
+            }
+
+        private:
+            const string _name;
+            std::atomic<uint32_t> _errors;
+            std::atomic<int32_t> _lastError;
+            std::atomic<uint64_t> _bytesIn;
+            std::atomic<uint64_t> _bytesOut;
+            Histogram _wait;
+            Histogram _execution;
+        };
+
+        typedef std::pair<string, const Metrics*> Entry;
+
+    private:
+        static constexpr uint16_t Slots = 128;
+
+    public:
+        Metrics(const Metrics&) = delete;
+        Metrics& operator=(const Metrics&) = delete;
+
+        Metrics()
+            : _overflow(Core::TextFragment(_T("*")))
+        {
+            for (uint16_t index = 0; index < Slots; index++) {
+                _slots[index] = nullptr;
+            }
+        }
+        ~Metrics()
+        {
+            for (uint16_t index = 0; index < Slots; index++) {
+                delete _slots[index].load(std::memory_order_relaxed);
+            }
+        }
+
+    public:
+        // Where everything without a method of its own is counted.
+        Method& Overflow()
+        {
+            return (_overflow);
+        }
+        Method& operator[](const Core::TextFragment& name)
+        {
+            Method* result = nullptr;
+            uint16_t slot = Hash(name);
+            uint16_t probes = 0;
+
+            while ((result == nullptr) && (probes < Slots)) {
+                Method* current = _slots[slot].load(std::memory_order_acquire);
+
+                if (current == nullptr) {
+                    Method* entry = new Method(name);
+
+                    if (_slots[slot].compare_exchange_strong(current, entry, std::memory_order_acq_rel) == true) {
+                        current = entry;
+                    } else {
+                        // Someone else claimed it first, current is now what was claimed.
+                        delete entry;
+                    }
+                }
+
+                if (name == current->Name()) {
+                    result = current;
+                } else {
+                    slot = (slot + 1) % Slots;
+                    probes++;
+                }
+            }
+
+            return (result != nullptr ? *result : _overflow);
+        }
+        void Get(MetaData::Metrics& info) const
+        {
+            for (uint16_t index = 0; index < Slots; index++) {
+                const Method* method = _slots[index].load(std::memory_order_acquire);
+
+                if (method != nullptr) {
+                    MetaData::Metrics::Method entry;
+                    method->Get(entry);
+                    info.Methods.Add(entry);
+                }
+            }
+            if (_overflow.Execution().Count() != 0) {
+                MetaData::Metrics::Method entry;
+                _overflow.Get(entry);
+                info.Methods.Add(entry);
+            }
+        }
+
+        // Prometheus text exposition format, all metrics of one family are kept together.
+        static void Prometheus(const std::list<Entry>& entries, string& text)
+        {
+            Family(entries, text, _T("calls_total"), _T("counter"), [](const Method& method, const string& labels, string& output) {
+                output += _T("wpeframework_calls_total{") + labels + _T("} ") + Core::NumberType<uint32_t>(method.Execution().Count()).Text() + '\n';
+            });
+            Family(entries, text, _T("errors_total"), _T("counter"), [](const Method& method, const string& labels, string& output) {
+                output += _T("wpeframework_errors_total{") + labels + _T("} ") + Core::NumberType<uint32_t>(method.Errors()).Text() + '\n';
+            });
+            Family(entries, text, _T("received_bytes_total"), _T("counter"), [](const Method& method, const string& labels, string& output) {
+                output += _T("wpeframework_received_bytes_total{") + labels + _T("} ") + Core::NumberType<uint64_t>(method.BytesIn()).Text() + '\n';
+            });
+            Family(entries, text, _T("sent_bytes_total"), _T("counter"), [](const Method& method, const string& labels, string& output) {
+                output += _T("wpeframework_sent_bytes_total{") + labels + _T("} ") + Core::NumberType<uint64_t>(method.BytesOut()).Text() + '\n';
+            });
+            Family(entries, text, _T("wait_microseconds"), _T("histogram"), [](const Method& method, const string& labels, string& output) {
+                Distribution(method.Wait(), _T("wpeframework_wait_microseconds"), labels, output);
+            });
+            Family(entries, text, _T("execution_microseconds"), _T("histogram"), [](const Method& method, const string& labels, string& output) {
+                Distribution(method.Execution(), _T("wpeframework_execution_microseconds"), labels, output);
+            });
+        }
+
+    private:
+        static uint16_t Hash(const Core::TextFragment& name)
+        {
+            // FNV-1a
+            uint32_t hash = 2166136261;
+
+            for (uint32_t index = 0; index < name.Length(); index++) {
+                hash = (hash ^ static_cast<uint8_t>(name[index])) * 16777619;
+            }
+
+            return (static_cast<uint16_t>(hash % Slots));
+        }
+        template <typename RENDER>
+        static void Family(const std::list<Entry>& entries, string& text, const TCHAR name[], const TCHAR type[], RENDER render)
+        {
+            text += string(_T("# TYPE wpeframework_")) + name + ' ' + type + '\n';
+
+            for (const Entry& entry : entries) {
+                const Metrics& metrics(*entry.second);
+
+                for (uint16_t index = 0; index < Slots; index++) {
+                    const Method* method = metrics._slots[index].load(std::memory_order_acquire);
+
+                    if (method != nullptr) {
+                        render(*method, Labels(entry.first, method->Name()), text);
+                    }
+                }
+                if (metrics._overflow.Execution().Count() != 0) {
+                    render(metrics._overflow, Labels(entry.first, metrics._overflow.Name()), text);
+                }
+            }
+        }
+        static void Distribution(const Histogram& histogram, const TCHAR name[], const string& labels, string& text)
+        {
+            uint32_t cumulative = 0;
+
+            for (uint8_t index = 0; index < (Histogram::Buckets() - 1); index++) {
+                cumulative += histogram[index];
+                // The limit of a bucket is exclusive, le is inclusive, the durations are whole microseconds.
+                text += name + string(_T("_bucket{")) + labels + _T(",le=\"") + Core::NumberType<uint64_t>(Histogram::Limit(index) - 1).Text() + _T("\"} ") + Core::NumberType<uint32_t>(cumulative).Text() + '\n';
+            }
+            text += name + string(_T("_bucket{")) + labels + _T(",le=\"+Inf\"} ") + Core::NumberType<uint32_t>(histogram.Count()).Text() + '\n';
+            text += name + string(_T("_sum{")) + labels + _T("} ") + Core::NumberType<uint64_t>(histogram.Total()).Text() + '\n';
+            text += name + string(_T("_count{")) + labels + _T("} ") + Core::NumberType<uint32_t>(histogram.Count()).Text() + '\n';
+        }
+        static string Labels(const string& callsign, const string& method)
+        {
+            return (_T("callsign=\"") + Escape(callsign) + _T("\",method=\"") + Escape(method) + '\"');
+        }
+        static string Escape(const string& value)
+        {
+            string result;
+
+            for (const TCHAR character : value) {
+                if ((character == '\\') || (character == '\"')) {
+                    result += '\\';
+                    result += character;
+                } else if (character == '\n') {
+                    result += _T("\\n");
+                } else {
+                    result += character;
+                }
+            }
+
+            return (result);
+        }
+
+    private:
+        std::atomic<Method*> _slots[Slots];
+        Method _overflow;
+    };
+}
+}
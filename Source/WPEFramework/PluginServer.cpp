@@ -51,6 +51,7 @@ ENUM_CONVERSION_BEGIN(Core::ProcessInfo::scheduler)
 {
     /* static */ Core::ProxyType<Web::Response> Server::Channel::_missingCallsign(Core::ProxyType<Web::Response>::Create());
     /* static */ Core::ProxyType<Web::Response> Server::Channel::_incorrectVersion(Core::ProxyType<Web::Response>::Create());
+    /* static */ Core::ProxyType<Web::Response> Server::Channel::_overloaded(Core::ProxyType<Web::Response>::Create());
     /* static */ Core::ProxyType<Web::Response> Server::Channel::WebRequestJob::_missingResponse(Core::ProxyType<Web::Response>::Create());
     /* static */ Core::ProxyType<Web::Response> Server::Channel::_unauthorizedRequest(Core::ProxyType<Web::Response>::Create());
     /* static */ Core::ProxyType<Web::Response> Server::Service::_missingHandler(Core::ProxyType<Web::Response>::Create());
@@ -227,6 +228,21 @@ ENUM_CONVERSION_BEGIN(Core::ProcessInfo::scheduler)
             if (name.empty() == false) {
                 newInfo.Name = name;
             }
+            if (client->IsWebSocket() == true) {
+                newInfo.Dropped = client->Dropped();
+                newInfo.Coalesced = client->Coalesced();
+
+                if (client->IsCompressed() == true) {
+                    const Web::WebSocket::Deflate::Statistics& deflated(client->Deflated());
+                    const Web::WebSocket::Deflate::Statistics& inflated(client->Inflated());
+
+                    newInfo.Sent = deflated.Original;
+                    newInfo.SentCompressed = deflated.Compressed;
+                    newInfo.Received = inflated.Original;
+                    newInfo.ReceivedCompressed = inflated.Compressed;
+                    newInfo.CompressionTime = deflated.Duration + inflated.Duration;
+                }
+            }
 
             metaData.Add(newInfo);
         }
@@ -240,6 +256,9 @@ ENUM_CONVERSION_BEGIN(Core::ProcessInfo::scheduler)
 
         TRACE_L1("Deactivating %d plugins.", static_cast<uint32_t>(_services.size()));
 
+        // The security provider goes down with the plugins, release what it handed out before.
+        _tokens.Clear();
+
         // First, move them all to deactivated except Controller
         Core::ProxyType<Service> controller;
         do {
@@ -271,6 +290,8 @@ ENUM_CONVERSION_BEGIN(Core::ProcessInfo::scheduler)
             service.Release();
         }
 
+        _routes.Publish();
+
         Core::ServiceAdministrator::Instance().FlushLibraries();
 
         _adminLock.Unlock();
@@ -418,6 +439,13 @@ ENUM_CONVERSION_BEGIN(Core::ProcessInfo::scheduler)
                     }
 
                     SYSLOG(Logging::Startup, (_T("Activated plugin [%s]:[%s]"), className.c_str(), callSign.c_str()));
+
+                    if ((IsLazy() == true) && (IdleTimeout() != 0)) {
+                        _lastAccess = Core::Time::Now().Ticks();
+                        _administrator.WorkerPool().Revoke(_idle);
+                        _administrator.WorkerPool().Schedule(Core::Time::Now().Add(IdleTimeout() * 1000), _idle);
+                    }
+
                     Lock();
                     State(ACTIVATED);
                     _administrator.StateChange(this);
@@ -440,6 +468,8 @@ ENUM_CONVERSION_BEGIN(Core::ProcessInfo::scheduler)
 
         Unlock();
 
+        Unpark();
+
         return (result);
     }
 
@@ -512,9 +542,132 @@ ENUM_CONVERSION_BEGIN(Core::ProcessInfo::scheduler)
 
         Unlock();
 
+        Unpark();
+
         return (result);
     }
 
+    bool Server::Service::Wakeup(const Core::ProxyType<Core::IDispatchType<void>>& job, bool& requested)
+    {
+        bool parked = false;
+
+        if (IsLazy() == true) {
+            bool activate = false;
+
+            _lastAccess = Core::Time::Now().Ticks();
+
+            Lock();
+
+            const IShell::state current(State());
+
+            if ((current == IShell::ACTIVATION) || (current == IShell::DEACTIVATION)) {
+                // Someone else is (de)activating it, hold on till that is settled.
+                parked = true;
+            } else if ((current == IShell::DEACTIVATED) && (requested == false)) {
+                requested = true;
+                activate = true;
+                parked = true;
+            }
+
+            if (parked == true) {
+                _parked.push_back(job);
+            }
+
+            Unlock();
+
+            if (activate == true) {
+                RequestWakeup();
+            }
+        }
+
+        return (parked);
+    }
+
+    void Server::Service::Wakeup()
+    {
+        if (IsLazy() == true) {
+            _lastAccess = Core::Time::Now().Ticks();
+
+            if (State() == IShell::DEACTIVATED) {
+                RequestWakeup();
+            }
+        }
+    }
+
+    void Server::Service::Handover(Web::Request& request)
+    {
+        if (request.HasBody() == true) {
+            Core::ProxyType<HeldBody> held(request.Body<HeldBody>());
+
+            if (held.IsValid() == true) {
+                const string& text(*held);
+
+                request.Body(Core::ProxyType<Web::IBody>());
+
+                Inbound(request);
+
+                if (request.HasBody() == true) {
+                    Core::ProxyType<Web::IBody> body(request.Body<Web::IBody>());
+                    const uint8_t* data = reinterpret_cast<const uint8_t*>(text.c_str());
+                    uint32_t offset = 0;
+
+                    body->Deserialize();
+
+                    while (offset < text.length()) {
+                        const uint16_t length = static_cast<uint16_t>(std::min(static_cast<uint32_t>(text.length()) - offset, static_cast<uint32_t>(0xFFFF)));
+
+                        body->Deserialize(&(data[offset]), length);
+                        offset += length;
+                    }
+
+                    body->End();
+                }
+            }
+        }
+    }
+
+    void Server::Service::Unpark()
+    {
+        Lock();
+
+        const IShell::state current(State());
+
+        if ((current != IShell::ACTIVATION) && (current != IShell::DEACTIVATION)) {
+            for (const Core::ProxyType<Core::IDispatchType<void>>& job : _parked) {
+                _administrator.WorkerPool().Submit(job);
+            }
+
+            _parked.clear();
+        }
+
+        Unlock();
+    }
+
+    void Server::Service::Idle()
+    {
+        Lock();
+
+        if (State() == IShell::ACTIVATED) {
+            const uint64_t now(Core::Time::Now().Ticks());
+            const uint64_t expires(_lastAccess.load() + (static_cast<uint64_t>(IdleTimeout()) * 1000 * Core::Time::TicksPerMillisecond));
+
+            if ((now < expires) || (_activity != 0) || (_channels.empty() == false)) {
+                // Still in use, look again once it could have expired.
+                _administrator.WorkerPool().Schedule(Core::Time(now < expires ? expires : now + (static_cast<uint64_t>(IdleTimeout()) * 1000 * Core::Time::TicksPerMillisecond)), _idle);
+
+                Unlock();
+            } else {
+                Unlock();
+
+                SYSLOG(Logging::Shutdown, (_T("Deactivating plugin [%s]:[%s], idle for %d seconds"), ClassName().c_str(), Callsign().c_str(), IdleTimeout()));
+
+                Deactivate(IShell::AUTOMATIC);
+            }
+        } else {
+            Unlock();
+        }
+    }
+
     /* virtual */ uint32_t Server::Service::Submit(const uint32_t id, const Core::ProxyType<Core::JSON::IElement>& response)
     {
         return (_administrator.Submit(id, response));
@@ -539,54 +692,67 @@ ENUM_CONVERSION_BEGIN(Core::ProcessInfo::scheduler)
 
     uint32_t Server::ServiceMap::FromLocator(const string& identifier, Core::ProxyType<PluginHost::Server::Service>& service, bool& serviceCall)
     {
-        uint32_t result = Core::ERROR_BAD_REQUEST;
-        const string& serviceHeader(_webbridgeConfig.WebPrefix());
-        const string& JSONRPCHeader(_webbridgeConfig.JSONRPCPrefix());
+        uint32_t result;
 
-        // Check the header (prefix part)
-        if (identifier.compare(0, serviceHeader.length(), serviceHeader.c_str()) == 0) {
+        {
+            Reader reader(_routes);
 
-            serviceCall = true;
+            result = reader.Current().Locate(Core::TextFragment(identifier), service, serviceCall);
+        }
 
-            if (identifier.length() <= (serviceHeader.length() + 1)) {
-                service = _server._controller;
-                result = Core::ERROR_NONE;
-            } else {
-                size_t length;
-                uint32_t offset = static_cast<uint32_t>(serviceHeader.length()) + 1; /* skip the slash after */
+        // Not a path of a service, it might be one of the prefixes itself, which belongs to the controller.
+        if (result == Core::ERROR_UNAVAILABLE) {
+            const string& serviceHeader(_webbridgeConfig.WebPrefix());
+            const string& JSONRPCHeader(_webbridgeConfig.JSONRPCPrefix());
 
-                const string callSign(identifier.substr(offset, ((length = identifier.find_first_of('/', offset)) == string::npos ? string::npos : length - offset)));
+            result = Core::ERROR_BAD_REQUEST;
 
-                result = FromIdentifier(callSign, service);
-            }
-        } else if (identifier.compare(0, JSONRPCHeader.length(), JSONRPCHeader.c_str()) == 0) {
+            // Check the header (prefix part)
+            if (identifier.compare(0, serviceHeader.length(), serviceHeader.c_str()) == 0) {
 
-            serviceCall = false;
+                serviceCall = true;
+                result = Core::ERROR_UNAVAILABLE;
 
-            if (identifier.length() <= (JSONRPCHeader.length() + 1)) {
-                service = _server._controller;
-                result = Core::ERROR_NONE;
-            } else {
-                size_t length;
-                uint32_t offset = static_cast<uint32_t>(JSONRPCHeader.length()) + 1; /* skip the slash after */
+                if (identifier.length() <= (serviceHeader.length() + 1)) {
+                    service = _server._controller;
+                    result = Core::ERROR_NONE;
+                }
+            } else if (identifier.compare(0, JSONRPCHeader.length(), JSONRPCHeader.c_str()) == 0) {
 
-                const string callSign(identifier.substr(offset, ((length = identifier.find_first_of('/', offset)) == string::npos ? string::npos : length - offset)));
+                serviceCall = false;
+                result = Core::ERROR_UNAVAILABLE;
 
-                result = FromIdentifier(callSign, service);
+                if (identifier.length() <= (JSONRPCHeader.length() + 1)) {
+                    service = _server._controller;
+                    result = Core::ERROR_NONE;
+                }
             }
         }
 
         return (result);
     }
 
+#ifdef __WINDOWS__
+#pragma warning(disable : 4355)
+#endif
     Server::Channel::Channel(const SOCKET& connector, const Core::NodeId& remoteId, Core::SocketServerType<Channel>* parent)
         : PluginHost::Channel(connector, remoteId)
         , _parent(static_cast<ChannelMap&>(*parent).Parent())
         , _security(_parent.Officer())
         , _service()
+        , _pipeline(*this, static_cast<ChannelMap&>(*parent).PipelineDepth())
     {
+        const ChannelMap& channels(static_cast<ChannelMap&>(*parent));
+
+        SendQueue(channels.SendQueueLimit(), channels.SendQueuePolicy());
+        Compression(channels.Compression());
+        MaxMessageSize(channels.MaxMessageSize());
+
         TRACE(Activity, (_T("Construct a link with ID: [%d] to [%s]"), Id(), remoteId.QualifiedName().c_str()));
     }
+#ifdef __WINDOWS__
+#pragma warning(default : 4355)
+#endif
 
     /* virtual */ Server::Channel::~Channel()
     {
@@ -625,7 +791,7 @@ ENUM_CONVERSION_BEGIN(Core::ProcessInfo::scheduler)
     Server::Server(Server::Config & configuration, const bool background)
         : _accessor()
         , _dispatcher(configuration.Process.IsSet() ? configuration.Process.StackSize.Value() : 0)
-        , _connections(*this, DetermineAccessor(configuration, _accessor), configuration.IdleTime)
+        , _connections(*this, DetermineAccessor(configuration, _accessor), configuration.IdleTime, configuration.MaxBatchSize.Value(), configuration.SendQueueLimit.Value(), configuration.SendQueuePolicy.Value(), configuration.PipelineDepth.Value(), configuration.Compression.Value(), configuration.MaxMessageSize.Value())
         , _config(configuration.Version.Value(),
               DetermineProperModel(configuration.Model),
               background,
@@ -642,6 +808,8 @@ ENUM_CONVERSION_BEGIN(Core::ProcessInfo::scheduler)
               configuration.Redirect.Value())
         , _services(*this, _config, configuration.Process.IsSet() ? configuration.Process.StackSize.Value() : 0)
         , _controller()
+        , _startupThreads(configuration.StartupThreads.Value())
+        , _stackSize(configuration.Process.IsSet() ? configuration.Process.StackSize.Value() : 0)
     {
 
         // See if the persitent path for our-selves exist, if not we will create it :-)
@@ -778,17 +946,141 @@ ENUM_CONVERSION_BEGIN(Core::ProcessInfo::scheduler)
 
         // Right we have the shells for all possible services registered, time to activate what is needed :-)
         ServiceMap::Iterator iterator(_services.Services());
+        std::list<Core::ProxyType<Service>> autoStart;
 
         while (iterator.Next() == true) {
 
             Core::ProxyType<Service> service(*iterator);
 
-            if (service->AutoStart() == true) {
-                service->Activate(PluginHost::IShell::STARTUP);
+            if (service->IsLazy() == true) {
+                SYSLOG(Logging::Startup, (_T("Activation of plugin [%s]:[%s] deferred till it is used"), service->ClassName().c_str(), service->Callsign().c_str()));
+            } else if (service->AutoStart() == true) {
+                autoStart.push_back(service);
             } else {
                 SYSLOG(Logging::Startup, (_T("Activation of plugin [%s]:[%s] blocked"), service->ClassName().c_str(), service->Callsign().c_str()));
             }
         }
+
+        if (_startupThreads <= 1) {
+            // Just the old fashioned way, one after the other.
+            std::list<Core::ProxyType<Service>>::iterator index(autoStart.begin());
+
+            while (index != autoStart.end()) {
+                (*index)->Activate(PluginHost::IShell::STARTUP);
+                index++;
+            }
+        } else if (autoStart.empty() == false) {
+            Startup startup(_startupThreads, _stackSize, autoStart);
+
+            startup.Run();
+        }
+    }
+
+    Server::Startup::Startup(const uint8_t threads, const uint32_t stackSize, const std::list<Core::ProxyType<Service>>& services)
+        : _pool(threads, stackSize, static_cast<uint32_t>(services.size()))
+        , _signal(false, false)
+        , _running(0)
+        , _jobs()
+    {
+        std::list<Core::ProxyType<Service>>::const_iterator index(services.begin());
+
+        while (index != services.end()) {
+            _jobs.push_back(Core::ProxyType<Job>::Create(this, *index));
+            index++;
+        }
+    }
+
+    Server::Startup::~Startup()
+    {
+        ASSERT(_running == 0);
+
+        _pool.Stop();
+    }
+
+    void Server::Startup::Run()
+    {
+        const uint64_t begin = Core::Time::Now().Ticks();
+        std::list<Core::ProxyType<Job>> waiting(_jobs);
+
+        _pool.Run();
+
+        while (waiting.empty() == false) {
+            std::list<Core::ProxyType<Job>>::iterator index(waiting.begin());
+
+            while (index != waiting.end()) {
+                if ((*index)->Plugin()->PendingConditions() != 0) {
+                    index++;
+                } else {
+                    (*index)->Queued(Core::Time::Now().Ticks());
+
+                    Core::InterlockedIncrement(_running);
+                    _pool.Submit(Core::proxy_cast<Core::IDispatch>(*index), Core::infinite);
+
+                    index = waiting.erase(index);
+                }
+            }
+
+            if (_running == 0) {
+                // Nothing is activating, so nothing that is waiting will be released by us anymore.
+                break;
+            }
+
+            _signal.Lock(Core::infinite);
+        }
+
+        // Wait for the last activations to complete.
+        while (_running != 0) {
+            _signal.Lock(Core::infinite);
+        }
+
+        const uint64_t end = Core::Time::Now().Ticks();
+
+        // These are waiting for subsystems no plugin signalled (yet), the service picks them up once they are.
+        std::list<Core::ProxyType<Job>>::iterator index(waiting.begin());
+
+        while (index != waiting.end()) {
+            (*index)->Plugin()->Activate(PluginHost::IShell::STARTUP);
+            index++;
+        }
+
+        Timeline(begin, end);
+    }
+
+    void Server::Startup::Timeline(const uint64_t begin, const uint64_t end) const
+    {
+        uint64_t work = 0;
+        uint32_t activated = 0;
+        std::list<Core::ProxyType<Job>>::const_iterator index(_jobs.begin());
+
+        while (index != _jobs.end()) {
+            const Job& job(*(*index));
+
+            if (job.Finished() != 0) {
+                const string& callsign(job.Plugin()->Callsign());
+
+                work += (job.Finished() - job.Started());
+
+                if (job.Result() == Core::ERROR_NONE) {
+                    activated++;
+                }
+
+                SYSLOG(Logging::Startup, (_T("Startup of plugin [%s]: ready at %d ms, started at %d ms, took %d ms [%s]"),
+                    callsign.c_str(),
+                    static_cast<uint32_t>((job.Queued() - begin) / Core::Time::TicksPerMillisecond),
+                    static_cast<uint32_t>((job.Started() - begin) / Core::Time::TicksPerMillisecond),
+                    static_cast<uint32_t>((job.Finished() - job.Started()) / Core::Time::TicksPerMillisecond),
+                    Core::ErrorToString(job.Result())));
+            }
+
+            index++;
+        }
+
+        SYSLOG(Logging::Startup, (_T("Startup activated %d of %d plugins in %d ms, %d ms of activation on %d threads"),
+            activated,
+            static_cast<uint32_t>(_jobs.size()),
+            static_cast<uint32_t>((end - begin) / Core::Time::TicksPerMillisecond),
+            static_cast<uint32_t>(work / Core::Time::TicksPerMillisecond),
+            _pool.Count()));
     }
 
     void Server::Close()
@@ -22,6 +22,7 @@
 
 #include "Environment.h"
 #include "IRemoteInstantiation.h"
+#include "Metrics.h"
 #include "Module.h"
 #include "SystemInfo.h"
 
@@ -260,6 +261,13 @@ namespace PluginHost {
                 , Redirect(_T("http://127.0.0.1/Service/Controller/UI"))
                 , Signature(_T("TestSecretKey"))
                 , IdleTime(0)
+                , MaxBatchSize(64)
+                , SendQueueLimit(256)
+                , SendQueuePolicy(PluginHost::Channel::COALESCE)
+                , PipelineDepth(16)
+                , Compression(Web::WebSocket::NO_COMPRESSION)
+                , MaxMessageSize(4 * 1024 * 1024)
+                , StartupThreads(4)
                 , IPV6(false)
                 , DefaultTraceCategories(false)
                 , Process()
@@ -285,6 +293,13 @@ namespace PluginHost {
                 Add(_T("communicator"), &Communicator);
                 Add(_T("signature"), &Signature);
                 Add(_T("idletime"), &IdleTime);
+                Add(_T("maxbatchsize"), &MaxBatchSize);
+                Add(_T("sendqueuelimit"), &SendQueueLimit);
+                Add(_T("sendqueuepolicy"), &SendQueuePolicy);
+                Add(_T("pipelinedepth"), &PipelineDepth);
+                Add(_T("compression"), &Compression);
+                Add(_T("maxmessagesize"), &MaxMessageSize);
+                Add(_T("startupthreads"), &StartupThreads);
                 Add(_T("ipv6"), &IPV6);
                 Add(_T("tracing"), &DefaultTraceCategories);
                 Add(_T("redirect"), &Redirect);
@@ -318,6 +333,13 @@ namespace PluginHost {
             Core::JSON::String Redirect;
             Core::JSON::String Signature;
             Core::JSON::DecUInt16 IdleTime;
+            Core::JSON::DecUInt16 MaxBatchSize;
+            Core::JSON::DecUInt16 SendQueueLimit;
+            Core::JSON::EnumType<PluginHost::Channel::queuepolicy> SendQueuePolicy;
+            Core::JSON::DecUInt16 PipelineDepth;
+            Core::JSON::EnumType<Web::WebSocket::compression> Compression;
+            Core::JSON::DecUInt32 MaxMessageSize;
+            Core::JSON::DecUInt8 StartupThreads;
             Core::JSON::Boolean IPV6;
             Core::JSON::String DefaultTraceCategories;
             ProcessSet Process;
@@ -592,7 +614,50 @@ namespace PluginHost {
                 uint32_t _value;
             };
 
+            class IdleJob : public Core::IDispatch {
+            public:
+                IdleJob() = delete;
+                IdleJob(const IdleJob&) = delete;
+                IdleJob& operator=(const IdleJob&) = delete;
+
+                IdleJob(Service* parent)
+                    : _parent(*parent)
+                {
+                    ASSERT(parent != nullptr);
+                }
+                ~IdleJob() override
+                {
+                }
+
+            public:
+                void Dispatch() override
+                {
+                    _parent.Idle();
+                }
+
+            private:
+                Service& _parent;
+            };
+
+            // The body of a request for a lazy plugin that is not activated yet, see Inbound().
+            class HeldBody : public Web::TextBody {
+            public:
+                HeldBody(const HeldBody&) = delete;
+                HeldBody& operator=(const HeldBody&) = delete;
+
+                HeldBody()
+                    : Web::TextBody()
+                {
+                }
+                ~HeldBody() override
+                {
+                }
+            };
+
         public:
+#ifdef __WINDOWS__
+#pragma warning(disable : 4355)
+#endif
             Service(const PluginHost::Config* server, const Plugin::Config* plugin, ServiceMap* administrator)
                 : PluginHost::Service(*server, *plugin)
                 , _handler(nullptr)
@@ -606,14 +671,24 @@ namespace PluginHost {
                 , _precondition(plugin->Precondition, true)
                 , _termination(plugin->Termination, false)
                 , _activity(0)
+                , _lastAccess(0)
+                , _parked()
+                , _channels()
+                , _idle(Core::ProxyType<IdleJob>::Create(this))
+                , _metrics()
                 , _administrator(*administrator)
             {
                 ASSERT(server != nullptr);
                 ASSERT(plugin != nullptr);
                 ASSERT(administrator != nullptr);
             }
+#ifdef __WINDOWS__
+#pragma warning(default : 4355)
+#endif
             ~Service()
             {
+                _administrator.WorkerPool().Revoke(_idle);
+
                 Deactivate(PluginHost::IShell::SHUTDOWN);
 
                 ASSERT(_handler == nullptr);
@@ -679,15 +754,20 @@ namespace PluginHost {
                 if ((result == true) && (_extended != nullptr)) {
                     _extended->Attach(channel);
                 }
-
-                return (result);
 #else
                 if (_extended != nullptr) {
                     _extended->Attach(channel);
                 }
 
-                return (_extended != nullptr);
+                bool result = (_extended != nullptr);
 #endif
+                if (result == true) {
+                    Lock();
+                    _channels.push_back(&channel);
+                    Unlock();
+                }
+
+                return (result);
             }
             inline void Unsubscribe(Channel& channel)
             {
@@ -697,6 +777,13 @@ namespace PluginHost {
                 if (_extended != nullptr) {
                     _extended->Detach(channel);
                 }
+
+                Lock();
+                std::list<const PluginHost::Channel*>::iterator index(std::find(_channels.begin(), _channels.end(), &channel));
+                if (index != _channels.end()) {
+                    _channels.erase(index);
+                }
+                Unlock();
             }
             inline void Configuration(const string& config)
             {
@@ -741,6 +828,9 @@ namespace PluginHost {
                 _administrator.StateChange(this);
 
                 Unlock();
+
+                // Parked jobs refer to the service, let them finish.
+                Unpark();
             }
 
             // The service might be still alive and refered to in the request/links but they will
@@ -751,10 +841,16 @@ namespace PluginHost {
 
                 if ((_webRequest != nullptr) && (IsActive() == true)) {
                     _webRequest->Inbound(request);
+                } else if (IsLazy() == true) {
+                    // There is no plugin to take the body yet, it is kept as it comes in, see Handover().
+                    request.Body(Core::ProxyType<HeldBody>::Create());
                 }
 
                 Unlock();
             }
+            // A body kept for a lazy plugin that was not activated yet, is handed over to the body the plugin
+            // takes it in, now that it is.
+            void Handover(Web::Request& request);
             virtual Core::ProxyType<Core::JSON::IElement> Inbound(const string& identifier)
             {
                 Core::ProxyType<Core::JSON::IElement> result;
@@ -774,11 +870,13 @@ namespace PluginHost {
 
                 Lock();
 
-                if (IsActive() == false) {
+                if ((IsActive() == false) && (IsLazy() == true)) {
+                    // The job handling the request activates the plugin and is parked till it is ready.
+                } else if (IsActive() == false) {
                     result = _unavailableHandler;
                 } else if (IsWebServerRequest(request.Path) == true) {
                     result = Factories::Instance().Response();
-                    FileToServe(request.Path, *result);
+                    FileToServe(request, *result);
                 } else if (request.Verb == Web::Request::HTTP_OPTIONS) {
 
                     result = Factories::Instance().Response();
@@ -804,7 +902,7 @@ namespace PluginHost {
 
                 return (result);
             }
-            inline Core::ProxyType<Web::Response> Process(const Web::Request& request)
+            inline Core::ProxyType<Web::Response> Process(const Web::Request& request, const uint64_t queued)
             {
                 Core::ProxyType<Web::Response> result;
 
@@ -818,10 +916,28 @@ namespace PluginHost {
 #ifdef RUNTIME_STATISTICS
                     IncrementProcessedRequests();
 #endif
+                    const uint64_t start = Core::Time::Now().Ticks();
+
                     Core::InterlockedIncrement(_activity);
                     result = service->Process(request);
                     Core::InterlockedDecrement(_activity);
 
+                    // REST calls are accounted per HTTP verb, without a response the caller gets an internal error.
+                    int32_t error = Web::STATUS_INTERNAL_SERVER_ERROR;
+                    uint32_t bytesOut = 0;
+
+                    if (result.IsValid() == true) {
+                        error = (result->ErrorCode >= Web::STATUS_BAD_REQUEST ? result->ErrorCode : 0);
+                        bytesOut = (result->ContentLength.IsSet() == true ? result->ContentLength.Value() : 0);
+                    }
+
+                    _metrics[Core::TextFragment(Web::Request::ToString(request.Verb))].Record(
+                        Wait(queued, start),
+                        static_cast<uint32_t>(Core::Time::Now().Ticks() - start),
+                        error,
+                        (request.ContentLength.IsSet() == true ? request.ContentLength.Value() : 0),
+                        bytesOut);
+
                     service->Release();
                 } else {
                     Unlock();
@@ -829,6 +945,73 @@ namespace PluginHost {
 
                 return (result);
             }
+            // Calls the JSON-RPC handler of this plugin and keeps track of its call statistics. Calls addressed
+            // to another callsign are only passed on by this plugin (the Controller), they are counted by their
+            // target. The queued time is 0 if the time spent waiting for a worker thread is not known.
+            Core::ProxyType<Core::JSONRPC::Message> Invoke(const uint32_t channelId, const Core::JSONRPC::Message& message, const uint64_t queued)
+            {
+                ASSERT(_jsonrpc != nullptr);
+
+                const uint64_t start = Core::Time::Now().Ticks();
+                Core::ProxyType<Core::JSONRPC::Message> result(_jsonrpc->Invoke(channelId, message));
+                const Core::JSONRPC::DesignatorFragments designator(message.Designator.Value());
+
+                if ((designator.Callsign().IsEmpty() == true) || (designator.Callsign() == Callsign())) {
+                    int32_t error = 0;
+                    uint32_t bytesOut = 0;
+                    bool known = true;
+
+                    if (result.IsValid() == true) {
+                        if (result->Error.IsSet() == true) {
+                            error = result->Error.Code.Value();
+
+                            // Methods the handler does not have are counted as one, whatever names callers make up.
+                            if ((error == static_cast<int32_t>(Core::ERROR_UNKNOWN_KEY)) || (error == static_cast<int32_t>(Core::ERROR_INVALID_SIGNATURE)) || (error == static_cast<int32_t>(Core::ERROR_INVALID_DESIGNATOR))) {
+                                PluginHost::JSONRPC* handler = dynamic_cast<PluginHost::JSONRPC*>(_jsonrpc);
+
+                                // A handler out of our process can not be asked, the error is taken for it.
+                                known = ((handler != nullptr) && (handler->Handles(message.Designator.Value()) == true));
+                            }
+                        }
+                        bytesOut = static_cast<uint32_t>(result->Result.Value().length());
+                    }
+
+                    (known == true ? _metrics[designator.Method()] : _metrics.Overflow()).Record(
+                        Wait(queued, start),
+                        static_cast<uint32_t>(Core::Time::Now().Ticks() - start),
+                        error,
+                        static_cast<uint32_t>(message.Parameters.Value().length()),
+                        bytesOut);
+                }
+
+                return (result);
+            }
+            inline void GetMetrics(MetaData::Metrics& info) const
+            {
+                info.Callsign = Callsign();
+                _metrics.Get(info);
+
+                Lock();
+
+                // Only a plugin running in our own process shows its cache, there is no interface to ask for it.
+                const PluginHost::JSONRPC* handler = dynamic_cast<const PluginHost::JSONRPC*>(_jsonrpc);
+
+                if ((handler != nullptr) && (handler->IsCaching() == true)) {
+                    uint32_t hits, misses, entries;
+
+                    handler->CacheStatistics(hits, misses, entries);
+
+                    info.Cached.Hits = hits;
+                    info.Cached.Misses = misses;
+                    info.Cached.Entries = entries;
+                }
+
+                Unlock();
+            }
+            inline const Metrics& CallMetrics() const
+            {
+                return (_metrics);
+            }
             inline Core::ProxyType<Core::JSON::IElement> Inbound(const uint32_t ID, const Core::JSON::IElement& element)
             {
                 Core::ProxyType<Core::JSON::IElement> result;
@@ -914,6 +1097,35 @@ namespace PluginHost {
 
                 PluginHost::Service::GetMetaData(metaData);
             }
+            // Lazy plugins are activated by the first request that needs them. A job that finds the plugin not
+            // activated yet is parked, and submitted again once the plugin settled, instead of holding a worker
+            // thread. Returns true if the job was parked. The job starts out with requested false, it only starts
+            // one activation and is not parked anymore once that is settled, whatever came of it.
+            bool Wakeup(const Core::ProxyType<Core::IDispatchType<void>>& job, bool& requested);
+            // For callers that can not be parked, it starts the activation if it is needed and returns right away.
+            void Wakeup();
+            inline void RequestWakeup()
+            {
+                _administrator.WorkerPool().Submit(PluginHost::IShell::Job::Create(this, PluginHost::IShell::ACTIVATED, PluginHost::IShell::AUTOMATIC));
+            }
+            // The subsystems that prevent the preconditions from being met, 0 if the plugin can be activated.
+            inline uint32_t PendingConditions()
+            {
+                Lock();
+
+                uint32_t subsystems = _administrator.SubSystemInfo();
+
+                if (State() == PluginHost::IShell::DEACTIVATED) {
+                    // Nothing will be triggered in this state, just bring the condition up to date.
+                    _precondition.Evaluate(subsystems);
+                }
+
+                uint32_t result = (_precondition.IsMet() == true ? 0 : _precondition.Delta(subsystems));
+
+                Unlock();
+
+                return (result);
+            }
             inline void Evaluate()
             {
                 Lock();
@@ -977,6 +1189,10 @@ namespace PluginHost {
             }
 
         private:
+            static inline uint32_t Wait(const uint64_t queued, const uint64_t start)
+            {
+                return (queued == 0 ? static_cast<uint32_t>(~0) : static_cast<uint32_t>(start - queued));
+            }
             inline PluginHost::IPlugin* CheckLibrary(const string& name, const TCHAR* className, const uint32_t version)
             {
                 PluginHost::IPlugin* newIF = nullptr;
@@ -1099,6 +1315,10 @@ namespace PluginHost {
                 Core::ServiceAdministrator::Instance().FlushLibraries();
             }
 
+            void Idle();
+            // The (de)activation is settled, the parked jobs can have another go.
+            void Unpark();
+
         private:
             // The handlers that implement the actual logic behind the service
             IPlugin* _handler;
@@ -1115,6 +1335,11 @@ namespace PluginHost {
             Condition _precondition;
             Condition _termination;
             uint32_t _activity;
+            std::atomic<uint64_t> _lastAccess;
+            std::list<Core::ProxyType<Core::IDispatchType<void>>> _parked;
+            std::list<const PluginHost::Channel*> _channels;
+            Core::ProxyType<Core::IDispatch> _idle;
+            Metrics _metrics;
 
             ServiceMap& _administrator;
             static Core::ProxyType<Web::Response> _unavailableHandler;
@@ -1124,6 +1349,11 @@ namespace PluginHost {
         public:
             typedef Core::IteratorMapType<std::map<const string, Core::ProxyType<Service>>, Core::ProxyType<Service>, const string&> Iterator;
             typedef std::map<const string, IRemoteInstantiation*> RemoteInstantiators;
+            typedef Web::VerifiedTokensType<ISecurity> VerifiedTokens;
+
+            // Tokens verified by the security provider that are remembered, and for how many seconds at most.
+            static constexpr uint16_t TokenCacheEntries = 64;
+            static constexpr uint32_t TokenCacheAge = 300;
 
         private:
             ServiceMap() = delete;
@@ -1641,6 +1871,92 @@ namespace PluginHost {
                     Core::ProxyType<Job> _decoupling;
                 };
 
+                // Requests are routed on this copy of the services, sorted by callsign, so a lookup takes no lock.
+                // It never changes once published, adding or removing a plugin marks it stale, the next lookup
+                // builds a new one.
+                // Compiled whenever the set of services changes. A service is found by its callsign, as in a
+                // JSONRPC designator, or by the path of a request, "<prefix>/<callsign>[/...]" where the prefix
+                // is the one for REST or for JSONRPC. Either way in one pass over the text.
+                class Routes {
+                private:
+                    // The service and if it is addressed by its REST (true) or its JSONRPC (false) path.
+                    typedef std::pair<Core::ProxyType<Service>, bool> Route;
+                    typedef Web::RouterType<Route> Router;
+
+                public:
+                    Routes() = delete;
+                    Routes(const Routes&) = delete;
+                    Routes& operator=(const Routes&) = delete;
+
+                    Routes(const std::map<const string, Core::ProxyType<Service>>& services, const string& webPrefix, const string& JSONRPCPrefix)
+                        : _callsigns(_T("."))
+                        , _locators(_T("./"))
+                    {
+                        for (const std::pair<const string, Core::ProxyType<Service>>& service : services) {
+                            _callsigns.Add(service.first, Route(service.second, false));
+                            _locators.Add(webPrefix + '/' + service.first, Route(service.second, true));
+                            _locators.Add(JSONRPCPrefix + '/' + service.first, Route(service.second, false));
+                        }
+
+                        _callsigns.Compile();
+                        _locators.Compile();
+                    }
+                    ~Routes()
+                    {
+                    }
+
+                public:
+                    // The callsign might be followed by a version, "<callsign>[.<version>]", and a callsign might
+                    // contain dots itself.
+                    uint32_t Find(const Core::TextFragment& identifier, Core::ProxyType<Service>& service) const
+                    {
+                        bool serviceCall;
+
+                        return (Find(_callsigns, identifier, service, serviceCall));
+                    }
+                    uint32_t Locate(const Core::TextFragment& path, Core::ProxyType<Service>& service, bool& serviceCall) const
+                    {
+                        return (Find(_locators, path, service, serviceCall));
+                    }
+
+                private:
+                    static uint32_t Find(const Router& router, const Core::TextFragment& text, Core::ProxyType<Service>& service, bool& serviceCall)
+                    {
+                        uint32_t result = Core::ERROR_UNAVAILABLE;
+                        uint32_t length = 0;
+                        const Route* route = router.Find(text, length);
+
+                        if (route != nullptr) {
+                            result = Core::ERROR_INVALID_SIGNATURE;
+                            serviceCall = route->second;
+
+                            if ((length == text.Length()) || (text[length] == '/') || (route->first->HasVersionSupport(Version(text, length + 1)) == true)) {
+                                service = route->first;
+                                result = Core::ERROR_NONE;
+                            }
+                        }
+
+                        return (result);
+                    }
+                    // The version runs up to the next slash, if any.
+                    static string Version(const Core::TextFragment& text, const uint32_t offset)
+                    {
+                        uint32_t end = offset;
+
+                        while ((end < text.Length()) && (text[end] != '/')) {
+                            end++;
+                        }
+
+                        return (Core::TextFragment(text, offset, end - offset).Text());
+                    }
+
+                private:
+                    Router _callsigns;
+                    Router _locators;
+                };
+
+                typedef Core::SnapshotType<Routes>::Reader Reader;
+
             public:
 #ifdef __WINDOWS__
 #pragma warning(disable : 4355)
@@ -1650,12 +1966,14 @@ namespace PluginHost {
                     , _adminLock()
                     , _notificationLock()
                     , _services()
+                    , _routes(_adminLock, [this]() { return (new Routes(_services, _webbridgeConfig.WebPrefix(), _webbridgeConfig.JSONRPCPrefix())); })
                     , _notifiers()
                     , _engine(Core::ProxyType<RPC::InvokeServer>::Create(&(server._dispatcher)))
                     , _processAdministrator(*this, config.Communicator(), config.PersistentPath(), config.SystemPath(), config.DataPath(), config.VolatilePath(), config.AppPath(), config.ProxyStubPath(), _engine)
                     , _server(server)
                     , _subSystems(this)
                     , _authenticationHandler(nullptr)
+                    , _tokens(TokenCacheEntries, TokenCacheAge)
                 {
                 }
 #ifdef __WINDOWS__
@@ -1682,6 +2000,10 @@ namespace PluginHost {
                         }
                     }
 
+                    // A security provider announces a new key by setting the SECURITY subsystem again, what it
+                    // verified with the old one is not trusted anymore.
+                    _tokens.Clear();
+
                     _adminLock.Unlock();
                 }
                 inline ISecurity* Officer(const string& token)
@@ -1691,7 +2013,15 @@ namespace PluginHost {
                     _adminLock.Lock();
 
                     if (_authenticationHandler != nullptr) {
-                        result = _authenticationHandler->Officer(token);
+                        result = _tokens.Find(token);
+
+                        if (result == nullptr) {
+                            result = _authenticationHandler->Officer(token);
+
+                            if (result != nullptr) {
+                                _tokens.Add(token, result);
+                            }
+                        }
                     } else {
                         result = _webbridgeConfig.Security();
                     }
@@ -1699,6 +2029,16 @@ namespace PluginHost {
                     _adminLock.Unlock();
                     return (result);
                 }
+                inline void TokenStatistics(MetaData::Metrics::Cache& info) const
+                {
+                    uint32_t hits, misses, entries;
+
+                    _tokens.Statistics(hits, misses, entries);
+
+                    info.Hits = hits;
+                    info.Misses = misses;
+                    info.Entries = entries;
+                }
                 inline uint32_t Submit(const uint32_t id, const Core::ProxyType<Core::JSON::IElement>& response)
                 {
                     return (_server.Dispatcher().Submit(id, response));
@@ -1707,6 +2047,10 @@ namespace PluginHost {
                 {
                     return (_subSystems.Value());
                 }
+                inline Core::WorkerPool& WorkerPool()
+                {
+                    return (_server.WorkerPool());
+                }
                 inline ISubSystem* SubSystemsInterface()
                 {
                     return (reinterpret_cast<ISubSystem*>(_subSystems.QueryInterface(ISubSystem::ID)));
@@ -1820,6 +2164,8 @@ namespace PluginHost {
                         // Fire up the interface. Let it handle the messages.
                         _services.insert(std::pair<const string, Core::ProxyType<Service>>(configuration.Callsign.Value(), newService));
 
+                        _routes.Invalidate();
+
                         _adminLock.Unlock();
                     }
 
@@ -1835,6 +2181,8 @@ namespace PluginHost {
                     if (index != _services.end()) {
                         index->second->Destroy();
                         _services.erase(index);
+
+                        _routes.Publish();
                     }
 
                     _adminLock.Unlock();
@@ -1878,32 +2226,43 @@ namespace PluginHost {
                         duplicates.pop_front();
                     }
                 }
-                uint32_t FromIdentifier(const string& callSign, Core::ProxyType<Service>& service)
+                // The call statistics of the given plugin, or of all plugins if no callsign is given.
+                void GetMetrics(const string& callsign, Core::JSON::ArrayType<MetaData::Metrics>& metrics) const
                 {
-                    uint32_t result = Core::ERROR_UNAVAILABLE;
+                    std::list<Core::ProxyType<Service>> duplicates;
 
-                    _adminLock.Lock();
+                    Services(callsign, duplicates);
 
-                    std::map<const string, Core::ProxyType<Service>>::const_iterator index(_services.begin());
+                    while (duplicates.size() > 0) {
+                        MetaData::Metrics newInfo;
+                        duplicates.front()->GetMetrics(newInfo);
+                        metrics.Add(newInfo);
+                        duplicates.pop_front();
+                    }
+                }
+                void Prometheus(string& text) const
+                {
+                    std::list<Core::ProxyType<Service>> duplicates;
+                    std::list<Metrics::Entry> entries;
 
-                    while ((index != _services.end()) && (result == Core::ERROR_UNAVAILABLE)) {
-                        const string& source(index->first);
-                        if (callSign.compare(0, source.length(), source) != 0) {
-                            index++;
-                        } else {
-                            result = Core::ERROR_INVALID_SIGNATURE;
-                            uint32_t length = static_cast<uint32_t>(source.length());
+                    Services(string(), duplicates);
 
-                            if ((callSign.length() == length) || ((callSign[length] == '.') && (index->second->HasVersionSupport(callSign.substr(length + 1))))) {
-                                service = index->second;
-                                result = Core::ERROR_NONE;
-                            }
-                        }
+                    // The services are held by the duplicates, so their metrics stay around till we are done.
+                    for (const Core::ProxyType<Service>& service : duplicates) {
+                        entries.emplace_back(service->Callsign(), &(service->CallMetrics()));
                     }
 
-                    _adminLock.Unlock();
+                    Metrics::Prometheus(entries, text);
+                }
+                uint32_t FromIdentifier(const string& callSign, Core::ProxyType<Service>& service) const
+                {
+                    return (FromIdentifier(Core::TextFragment(callSign), service));
+                }
+                uint32_t FromIdentifier(const Core::TextFragment& callSign, Core::ProxyType<Service>& service) const
+                {
+                    Reader reader(_routes);
 
-                    return (result);
+                    return (reader.Current().Find(callSign, service));
                 }
                 uint32_t FromLocator(const string& identifier, Core::ProxyType<Service>& service, bool& serviceCall);
 
@@ -1919,6 +2278,21 @@ namespace PluginHost {
                 }
 
             private:
+                void Services(const string& callsign, std::list<Core::ProxyType<Service>>& services) const
+                {
+                    _adminLock.Lock();
+
+                    std::map<const string, Core::ProxyType<Service>>::const_iterator index(_services.begin());
+
+                    while (index != _services.end()) {
+                        if ((callsign.empty() == true) || (callsign == index->first)) {
+                            services.push_back(index->second);
+                        }
+                        index++;
+                    }
+
+                    _adminLock.Unlock();
+                }
                 void Remove(const string& connector) const
                 {
                     // This is already locked by the callee, so safe to operate on the map..
@@ -1979,10 +2353,6 @@ namespace PluginHost {
 
                     RecursiveNotification(index);
                 }
-                inline Core::WorkerPool& WorkerPool()
-                {
-                    return (_server.WorkerPool());
-                }
 
             private:
                 PluginHost::Config& _webbridgeConfig;
@@ -1990,6 +2360,7 @@ namespace PluginHost {
                 mutable Core::CriticalSection _adminLock;
                 Core::CriticalSection _notificationLock;
                 std::map<const string, Core::ProxyType<Service>> _services;
+                Core::SnapshotType<Routes> _routes;
                 mutable RemoteInstantiators _instantiators;
                 std::list<IPlugin::INotification*> _notifiers;
                 Core::ProxyType<RPC::InvokeServer> _engine;
@@ -1997,6 +2368,7 @@ namespace PluginHost {
                 Server& _server;
                 Core::Sink<SubSystems> _subSystems;
                 IAuthenticate* _authenticationHandler;
+                VerifiedTokens _tokens;
             };
 
             // Connection handler is the listening socket and keeps track of all open
@@ -2008,6 +2380,42 @@ namespace PluginHost {
                 Channel(const Channel& copy) = delete;
                 Channel& operator=(const Channel&) = delete;
 
+            public:
+                // The response to the HTTP request that took the given slot in the pipeline of the channel.
+                class Reply {
+                public:
+                    Reply() = delete;
+                    Reply& operator=(const Reply&) = delete;
+
+                    Reply(const uint32_t sequence, const Core::ProxyType<Web::Response>& response)
+                        : _sequence(sequence)
+                        , _response(response)
+                    {
+                    }
+                    Reply(const Reply& copy)
+                        : _sequence(copy._sequence)
+                        , _response(copy._response)
+                    {
+                    }
+                    ~Reply()
+                    {
+                    }
+
+                public:
+                    inline uint32_t Sequence() const
+                    {
+                        return (_sequence);
+                    }
+                    inline const Core::ProxyType<Web::Response>& Response() const
+                    {
+                        return (_response);
+                    }
+
+                private:
+                    const uint32_t _sequence;
+                    Core::ProxyType<Web::Response> _response;
+                };
+
             private:
                 class EXTERNAL WebRequestJob : public Core::IDispatchType<void> {
                 private:
@@ -2021,6 +2429,8 @@ namespace PluginHost {
                         , _service()
                         , _request()
                         , _jsonrpc(false)
+                        , _queued(0)
+                        , _wakeup(false)
                     {
                     }
                     virtual ~WebRequestJob()
@@ -2042,7 +2452,26 @@ namespace PluginHost {
                         _missingResponse->ErrorCode = Web::STATUS_INTERNAL_SERVER_ERROR;
                         _missingResponse->Message = _T("There is no response from the requested service.");
                     }
-                    void Set(const uint32_t id, Core::ProxyType<Service>& service, Core::ProxyType<Web::Request>& request, const bool JSONRPC)
+                    static void Answer(Web::Response& response, const Core::ProxyType<Core::JSONRPC::Message>& body)
+                    {
+                        response.Body(body);
+                        if (body->Error.IsSet() == false) {
+                            response.ErrorCode = Web::STATUS_OK;
+                            response.Message = _T("JSONRPC executed succesfully");
+                        } else {
+                            response.ErrorCode = Web::STATUS_ACCEPTED;
+                            response.Message = _T("Failure on JSONRPC: ") + Core::NumberType<uint32_t>(body->Error.Code).Text();
+                        }
+                    }
+                    static void Defaults(Web::Response& response)
+                    {
+                        if (response.AccessControlOrigin.IsSet() == false)
+                            response.AccessControlOrigin = _T("*");
+
+                        if (response.CacheControl.IsSet() == false)
+                            response.CacheControl = _T("no-cache, private, no-store, must-revalidate, max-stale=0, post-check=0, pre-check=0");
+                    }
+                    void Set(const uint32_t id, const uint32_t sequence, Core::ProxyType<Service>& service, Core::ProxyType<Web::Request>& request, const bool JSONRPC)
                     {
                         ASSERT(_request.IsValid() == false);
                         ASSERT(_service.IsValid() == false);
@@ -2050,7 +2479,20 @@ namespace PluginHost {
                         _service = service;
                         _request = request;
                         _ID = id;
+                        _sequence = sequence;
                         _jsonrpc = JSONRPC;
+                        _queued = Core::Time::Now().Ticks();
+                        _wakeup = false;
+                    }
+                    // A job that will not be dispatched anymore goes back to the pool without what it was set with.
+                    void Clear()
+                    {
+                        if (_request.IsValid() == true) {
+                            _request.Release();
+                        }
+                        if (_service.IsValid() == true) {
+                            _service.Release();
+                        }
                     }
                     virtual void Dispatch()
                     {
@@ -2058,49 +2500,56 @@ namespace PluginHost {
 
                         if (_request.IsValid()) {
                             Core::ProxyType<Web::Response> response;
+                            bool pending = false;
 
                             ASSERT(_service.IsValid() == true);
 
+                            // A lazy plugin might still need to be activated, the job is dispatched again once it is.
+                            if ((_service.IsValid() == true) && (_service->Wakeup(Core::ProxyType<Core::IDispatchType<void>>(*this), _wakeup) == true)) {
+                                return;
+                            }
+
                             if (_service.IsValid() == true) {
-                                if ((_jsonrpc == true) && (_request->HasBody() == true)) {
+                                if ((_jsonrpc == true) && (_request->HasBody() == true) && (_service->Dispatcher() != nullptr)) {
                                     response = Factories::Instance().Response();
                                     Core::ProxyType<Core::JSONRPC::Message> message(_request->Body<Core::JSONRPC::Message>());
-                                    Core::ProxyType<Core::JSONRPC::Message> body = _service->Dispatcher()->Invoke(_ID, *message);
-                                    if (body.IsValid() == false) {
-                                        response->ErrorCode = Web::STATUS_BAD_REQUEST;
-                                    } else {
-                                        response->Body(body);
-                                        if (body->Error.IsSet() == false) {
-                                            response->ErrorCode = Web::STATUS_OK;
-                                            response->Message = _T("JSONRPC executed succesfully");
-                                        } else {
-                                            response->ErrorCode = Web::STATUS_ACCEPTED;
-                                            response->Message = _T("Failure on JSONRPC: ") + Core::NumberType<uint32_t>(body->Error.Code).Text();
+                                    const uint32_t id = message->Id.Value();
+
+                                    // The connection of the call carries the sequence, so an asynchronous answer finds
+                                    // its slot in the pipeline, see Channel::Submit.
+                                    if (message->Id.IsSet() == true) {
+                                        message->Id = _sequence;
+                                    }
+
+                                    Core::ProxyType<Core::JSONRPC::Message> body = _service->Invoke(_ID, *message, _queued);
+                                    if (body.IsValid() == true) {
+                                        if (body->Id.IsSet() == true) {
+                                            body->Id = id;
                                         }
+                                        Answer(*response, body);
+                                    } else if (message->Id.IsSet() == true) {
+                                        // Answered asynchronously, the answer is sent as the response, see Channel::Submit.
+                                        pending = true;
+                                    } else {
+                                        response->ErrorCode = Web::STATUS_BAD_REQUEST;
                                     }
                                 } else {
-                                    response = _service->Process(*_request);
+                                    _service->Handover(*_request);
+                                    response = _service->Process(*_request, _queued);
                                 }
                                 _service.Release();
                             }
 
-                            if (response.IsValid() == true) {
+                            if (pending == true) {
+                                // The response waits in the pipeline until the answer is sent.
+                            } else if (response.IsValid() == true) {
                                 // Seems we can handle..
-                                if (response->AccessControlOrigin.IsSet() == false)
-                                    response->AccessControlOrigin = _T("*");
-
-                                if (response->CacheControl.IsSet() == false)
-                                    response->CacheControl = _T("no-cache, private, no-store, must-revalidate, max-stale=0, post-check=0, pre-check=0");
+                                Defaults(*response);
 
-                                _server->Dispatcher().Submit(_ID, response);
+                                _server->Dispatcher().Submit(_ID, Reply(_sequence, response));
                             } else {
                                 // Fire and forget, We are done !!!
-                                _server->Dispatcher().Submit(_ID, _missingResponse);
-                            }
-
-                            if (_request->Connection.Value() == Web::Request::CONNECTION_CLOSE) {
-                                TRACE(Activity, (_T("HTTP Request with direct close on [%d]"), _ID));
-                                _server->Dispatcher().Suspend(_ID);
+                                _server->Dispatcher().Submit(_ID, Reply(_sequence, _missingResponse));
                             }
 
                             // We are done, clear all info
@@ -2110,14 +2559,60 @@ namespace PluginHost {
 
                 private:
                     uint32_t _ID;
+                    uint32_t _sequence;
                     Server* _server;
                     Core::ProxyType<Service> _service;
                     Core::ProxyType<Web::Request> _request;
                     bool _jsonrpc;
+                    uint64_t _queued;
+                    bool _wakeup;
 
                     static Core::ProxyType<Web::Response> _missingResponse;
                 };
 
+                // Requests are answered in the order they came in, whatever order they are handled in. The id of a
+                // JSON-RPC call in a request is kept with its slot, the call is made with the sequence of the slot as
+                // its id, as clients reuse ids, and the answer gets this id back.
+                class Pipeline : public Web::PipelineType<Web::Response, WebRequestJob> {
+                public:
+                    Pipeline() = delete;
+                    Pipeline(const Pipeline&) = delete;
+                    Pipeline& operator=(const Pipeline&) = delete;
+
+                    Pipeline(Channel& parent, const uint16_t depth)
+                        : Web::PipelineType<Web::Response, WebRequestJob>(depth, _overloaded)
+                        , _parent(parent)
+                    {
+                    }
+                    virtual ~Pipeline()
+                    {
+                    }
+
+                private:
+                    // Sending takes the lock of the socket, which is held while a request is received, so the
+                    // pipeline sends without its own lock.
+                    virtual void Send(const Core::ProxyType<Web::Response>& response)
+                    {
+                        _parent.PluginHost::Channel::Submit(response);
+                    }
+                    virtual void Handle(const Core::ProxyType<WebRequestJob>& job)
+                    {
+                        _parent._parent.Submit(Core::proxy_cast<Core::IDispatchType<void>>(job));
+                    }
+                    virtual void Abandon(const Core::ProxyType<WebRequestJob>& job)
+                    {
+                        job->Clear();
+                    }
+                    virtual void Close()
+                    {
+                        TRACE(Activity, (_T("HTTP Request with direct close on [%d]"), _parent.Id()));
+                        _parent.PluginHost::Channel::Close(0);
+                    }
+
+                private:
+                    Channel& _parent;
+                };
+
                 class EXTERNAL JSONElementJob : public Core::IDispatchType<void> {
                 private:
                     JSONElementJob() = delete;
@@ -2130,6 +2625,7 @@ namespace PluginHost {
                         , _service()
                         , _element()
                         , _jsonrpc(false)
+                        , _queued(0)
                     {
                     }
                     virtual ~JSONElementJob()
@@ -2155,6 +2651,7 @@ namespace PluginHost {
                         _element = element;
                         _ID = id;
                         _jsonrpc = JSONRPC;
+                        _queued = Core::Time::Now().Ticks();
                     }
                     virtual void Dispatch()
                     {
@@ -2174,7 +2671,7 @@ namespace PluginHost {
                                     ASSERT(message.IsValid() == true);
 
                                     if ((dispatcher != nullptr) && (message.IsValid() == true)) {
-                                        _element = Core::ProxyType<Core::JSON::IElement>(dispatcher->Invoke(_ID, *message));
+                                        _element = Core::ProxyType<Core::JSON::IElement>(_service->Invoke(_ID, *message, _queued));
                                     }
                                 } else {
                                     _element = _service->Inbound(_ID, *_element);
@@ -2197,6 +2694,159 @@ namespace PluginHost {
                     Core::ProxyType<Service> _service;
                     Core::ProxyType<Core::JSON::IElement> _element;
                     bool _jsonrpc;
+                    uint64_t _queued;
+                };
+
+                // A JSON-RPC batch is split up per callsign. Every callsign gets its own job on the worker
+                // pool, so independent plugins are served in parallel, while the requests for one callsign
+                // are still handled in the order they were sent. The job finishing last sends all responses
+                // back, in request order, as a single frame.
+                class EXTERNAL BatchJob : public Core::IDispatchType<void> {
+                public:
+                    class EXTERNAL Context {
+                    private:
+                        Context() = delete;
+                        Context(const Context&) = delete;
+                        Context& operator=(const Context&) = delete;
+
+                    public:
+                        Context(Server* server, const uint32_t id, Core::ProxyType<Service>& service, Core::ProxyType<Core::JSONRPC::Batch>& batch)
+                            : _ID(id)
+                            , _server(server)
+                            , _service(service)
+                            , _batch(batch)
+                            , _responses(batch->Length())
+                            , _pending(0)
+                            , _queued(Core::Time::Now().Ticks())
+                        {
+                        }
+                        ~Context()
+                        {
+                            _batch.Release();
+                            _service.Release();
+                        }
+
+                    public:
+                        // Answers the request at the given index without handing it to the plugin.
+                        void Reject(const size_t index, const uint32_t code, const string& text)
+                        {
+                            const Core::JSONRPC::Message& request(*(_batch->Elements()[index]));
+                            Core::ProxyType<Core::JSONRPC::Message> response(Core::proxy_cast<Core::JSONRPC::Message>(Factories::Instance().JSONRPC()));
+
+                            // Notifications are never answered, so these responses are dropped when gathering.
+                            if (request.Id.IsSet() == true) {
+                                response->JSONRPC = Core::JSONRPC::Message::DefaultVersion;
+                                response->Id = request.Id.Value();
+                            }
+                            response->Error.SetError(code);
+                            response->Error.Text = text;
+
+                            _responses[index] = response;
+                        }
+                        void Schedule(const Core::ProxyType<Context>& context)
+                        {
+                            typedef std::pair<string, std::vector<uint32_t>> Group;
+
+                            const Core::JSONRPC::Batch::Messages& requests(_batch->Elements());
+                            std::vector<Group> groups;
+
+                            for (size_t index = 0; index < requests.size(); index++) {
+                                if (_responses[index].IsValid() == false) {
+                                    const string callsign(Core::JSONRPC::Message::Callsign(requests[index]->Designator.Value()));
+                                    std::vector<Group>::iterator entry(groups.begin());
+
+                                    while ((entry != groups.end()) && (entry->first != callsign)) {
+                                        entry++;
+                                    }
+                                    if (entry == groups.end()) {
+                                        groups.emplace_back(callsign, std::vector<uint32_t>());
+                                        entry = std::prev(groups.end());
+                                    }
+                                    entry->second.push_back(static_cast<uint32_t>(index));
+                                }
+                            }
+
+                            // One extra count for ourselves, so a batch with nothing left to run still answers.
+                            _pending = static_cast<uint32_t>(groups.size()) + 1;
+
+                            for (Group& group : groups) {
+                                Core::ProxyType<BatchJob> job(Core::ProxyType<BatchJob>::Create(context, group.second));
+
+                                _server->Submit(Core::proxy_cast<Core::IDispatch>(job));
+                            }
+
+                            Completed();
+                        }
+                        void Execute(const std::vector<uint32_t>& entries)
+                        {
+                            PluginHost::IDispatcher* dispatcher = _service->Dispatcher();
+
+                            ASSERT(dispatcher != nullptr);
+
+                            if (dispatcher != nullptr) {
+                                for (const uint32_t index : entries) {
+                                    _responses[index] = _service->Invoke(_ID, *(_batch->Elements()[index]), _queued);
+                                }
+                            }
+                        }
+                        void Completed()
+                        {
+                            if (Core::InterlockedDecrement(_pending) == 0) {
+                                Core::JSONRPC::Batch::Messages& responses(_batch->Elements());
+
+                                // Only requests with an id are answered, the batch now carries the answers.
+                                responses.clear();
+
+                                for (Core::ProxyType<Core::JSONRPC::Message>& response : _responses) {
+                                    if ((response.IsValid() == true) && (response->Id.IsSet() == true)) {
+                                        responses.push_back(response);
+                                    }
+                                    response.Release();
+                                }
+
+                                // If all requests were notifications, there is nothing to send.
+                                if (responses.empty() == false) {
+                                    _server->Dispatcher().Submit(_ID, Core::ProxyType<Core::JSON::IElement>(_batch));
+                                }
+                            }
+                        }
+
+                    private:
+                        uint32_t _ID;
+                        Server* _server;
+                        Core::ProxyType<Service> _service;
+                        Core::ProxyType<Core::JSONRPC::Batch> _batch;
+                        Core::JSONRPC::Batch::Messages _responses;
+                        uint32_t _pending;
+                        uint64_t _queued;
+                    };
+
+                private:
+                    BatchJob() = delete;
+                    BatchJob(const BatchJob&) = delete;
+                    BatchJob& operator=(const BatchJob&) = delete;
+
+                public:
+                    BatchJob(const Core::ProxyType<Context>& context, const std::vector<uint32_t>& entries)
+                        : _context(context)
+                        , _entries(entries)
+                    {
+                    }
+                    virtual ~BatchJob()
+                    {
+                    }
+
+                public:
+                    virtual void Dispatch()
+                    {
+                        _context->Execute(_entries);
+                        _context->Completed();
+                        _context.Release();
+                    }
+
+                private:
+                    Core::ProxyType<Context> _context;
+                    std::vector<uint32_t> _entries;
                 };
 
                 class EXTERNAL TextJob : public Core::IDispatchType<void> {
@@ -2254,6 +2904,51 @@ namespace PluginHost {
                     string _text;
                 };
 
+                // A websocket upgrade for a lazy plugin that is not activated yet. The upgrade is held and the job
+                // parked with the plugin, which gets activated, and the upgrade is answered once that is settled.
+                class EXTERNAL UpgradeJob : public Core::IDispatchType<void> {
+                private:
+                    UpgradeJob() = delete;
+                    UpgradeJob(const UpgradeJob&) = delete;
+                    UpgradeJob& operator=(const UpgradeJob&) = delete;
+
+                public:
+                    UpgradeJob(Channel& channel, const Core::ProxyType<Service>& service)
+                        : _channel(channel)
+                        , _service(service)
+                        , _requested(false)
+                    {
+                    }
+                    virtual ~UpgradeJob()
+                    {
+                    }
+
+                public:
+                    // Returns true if the upgrade waits for the plugin.
+                    bool Park()
+                    {
+                        return (_service->Wakeup(Core::ProxyType<Core::IDispatchType<void>>(*this), _requested));
+                    }
+                    virtual void Dispatch()
+                    {
+                        if (Park() == false) {
+                            if (_service->State() != PluginHost::IShell::ACTIVATED) {
+                                _channel->AbortUpgrade(Web::STATUS_SERVICE_UNAVAILABLE, _T("Service could not be activated."));
+                            }
+
+                            _channel->ResumeUpgrade();
+
+                            _channel.Release();
+                            _service.Release();
+                        }
+                    }
+
+                private:
+                    Core::ProxyType<Channel> _channel;
+                    Core::ProxyType<Service> _service;
+                    bool _requested;
+                };
+
             public:
                 Channel(const SOCKET& connector, const Core::NodeId& remoteId, Core::SocketServerType<Channel>* parent);
                 virtual ~Channel();
@@ -2263,6 +2958,43 @@ namespace PluginHost {
                 {
                     return (PluginHost::Channel::Id());
                 }
+                // The answer to an asynchronous JSON-RPC call is submitted to the channel the call came in on. If
+                // that call was an HTTP request, the answer is the HTTP response to it.
+                using PluginHost::Channel::Submit;
+                void Submit(const Core::ProxyType<Core::JSON::IElement>& element)
+                {
+                    if (IsWebSocket() == true) {
+                        PluginHost::Channel::Submit(element);
+                    } else {
+                        Core::ProxyType<Core::JSONRPC::Message> message(Core::proxy_cast<Core::JSONRPC::Message>(element));
+
+                        if ((message.IsValid() == true) && (message->Id.IsSet() == true)) {
+                            // The call was made with the sequence of its slot as id.
+                            const uint32_t sequence = message->Id.Value();
+                            uint32_t id;
+
+                            // Without a slot, the request is gone together with the pipeline, nobody waits for this.
+                            if (_pipeline.Awaits(sequence, id) == true) {
+                                Core::ProxyType<Web::Response> response(Factories::Instance().Response());
+
+                                message->Id = id;
+
+                                WebRequestJob::Answer(*response, message);
+                                WebRequestJob::Defaults(*response);
+
+                                if (_pipeline.Answer(sequence, response) == true) {
+                                    _pipeline.Release();
+                                }
+                            }
+                        }
+                    }
+                }
+                void Submit(const Reply& reply)
+                {
+                    if (_pipeline.Answer(reply.Sequence(), reply.Response()) == true) {
+                        _pipeline.Release();
+                    }
+                }
                 static void Initialize(const string& serverPrefix)
                 {
                     WebRequestJob::Initialize();
@@ -2275,6 +3007,9 @@ namespace PluginHost {
 
                     _unauthorizedRequest->ErrorCode = Web::STATUS_UNAUTHORIZED;
                     _unauthorizedRequest->Message = _T("Request needs authorization, but it was not authorized");
+
+                    _overloaded->ErrorCode = Web::STATUS_SERVICE_UNAVAILABLE;
+                    _overloaded->Message = _T("Too many pipelined requests, closing the connection.");
                 }
                 void Revoke(PluginHost::ISecurity* baseRights)
                 {
@@ -2319,6 +3054,22 @@ namespace PluginHost {
                     return (_security != nullptr ? _security->Allowed(pathParameter) : false);
                 }
 
+                uint32_t Reserve(Request& request)
+                {
+                    const bool close = ((request.Connection.IsSet() == true) && (request.Connection.Value() == Web::Request::CONNECTION_CLOSE));
+                    Core::OptionalType<uint32_t> id;
+
+                    if ((request.State() == Request::COMPLETE) && (request.ServiceCall() == false) && (request.HasBody() == true)) {
+                        Core::ProxyType<Core::JSONRPC::Message> message(request.Body<Core::JSONRPC::Message>());
+
+                        if ((message.IsValid() == true) && (message->Id.IsSet() == true)) {
+                            id = message->Id.Value();
+                        }
+                    }
+
+                    return (_pipeline.Reserve(close, id));
+                }
+
                 // Handle the HTTP Web requests.
                 // [INBOUND]  Completed received requests are triggering the Received,
                 // [OUTBOUND] Completed send responses are triggering the Send.
@@ -2355,6 +3106,9 @@ namespace PluginHost {
 
                     TRACE(WebFlow, (Core::proxy_cast<Web::Request>(request)));
 
+                    // Requests are answered in the order they came in, whatever order they are handled in.
+                    const uint32_t sequence = Reserve(*request);
+
                     // See if a token has been hooked up to the request, maybe we need a
                     // different security provider.
                     if (request->WebToken.IsSet()) {
@@ -2417,23 +3171,23 @@ namespace PluginHost {
                             result->Message = "Not Found";
                         }
 
-                        Submit(result);
+                        Submit(Reply(sequence, result));
 
                         break;
                     }
                     case Request::MISSING_CALLSIGN: {
                         // Report that we, at least, need a call sign.
-                        Submit(_missingCallsign);
+                        Submit(Reply(sequence, _missingCallsign));
                         break;
                     }
                     case Request::INVALID_VERSION: {
                         // Report that we, at least, need a call sign.
-                        Submit(_incorrectVersion);
+                        Submit(Reply(sequence, _incorrectVersion));
                         break;
                     }
                     case Request::UNAUTHORIZED: {
                         // Report that we, at least, need a call sign.
-                        Submit(_unauthorizedRequest);
+                        Submit(Reply(sequence, _unauthorizedRequest));
                         break;
                     }
                     case Request::COMPLETE: {
@@ -2445,7 +3199,7 @@ namespace PluginHost {
 
                         if (response.IsValid() == true) {
                             // Report that the calls sign could not be found !!
-                            Submit(response);
+                            Submit(Reply(sequence, response));
                         } else {
                             // Send the Request object out to be handled.
                             // By definition, we can issue it on a rental thread..
@@ -2455,8 +3209,8 @@ namespace PluginHost {
 
                             if (job.IsValid() == true) {
                                 Core::ProxyType<Web::Request> baseRequest(Core::proxy_cast<Web::Request>(request));
-                                job->Set(Id(), service, baseRequest, !request->ServiceCall());
-                                _parent.Submit(Core::proxy_cast<Core::IDispatchType<void>>(job));
+                                job->Set(Id(), sequence, service, baseRequest, !request->ServiceCall());
+                                _pipeline.Dispatch(sequence, job);
                             }
                         }
                         break;
@@ -2481,7 +3235,15 @@ namespace PluginHost {
 
                     if (_service.IsValid() == true) {
                         if (State() == JSONRPC) {
-                            result = Core::ProxyType<Core::JSON::IElement>(Factories::Instance().JSONRPC());
+                            if ((identifier == BatchIdentifier) && (_parent.Dispatcher().MaxBatchSize() != 0)) {
+                                Core::ProxyType<Core::JSONRPC::Batch> batch(Factories::Instance().JSONRPCBatch());
+
+                                // Whatever is beyond the maximum is not even read.
+                                batch->Limit(_parent.Dispatcher().MaxBatchSize());
+                                result = Core::ProxyType<Core::JSON::IElement>(batch);
+                            } else {
+                                result = Core::ProxyType<Core::JSON::IElement>(Factories::Instance().JSONRPC());
+                            }
                         } else {
                             result = _service->Inbound(identifier);
                         }
@@ -2502,8 +3264,14 @@ namespace PluginHost {
                     TRACE(SocketFlow, (element));
 
                     if (State() & Channel::JSONRPC) {
+                        Core::ProxyType<Core::JSONRPC::Batch> batch(Core::proxy_cast<Core::JSONRPC::Batch>(element));
                         Core::ProxyType<Core::JSONRPC::Message> message(Core::proxy_cast<Core::JSONRPC::Message>(element));
-                        if (message.IsValid()) {
+
+                        if (batch.IsValid() == true) {
+                            // A batch is cleared and dispatched per request, see Received(batch).
+                            securityClearance = false;
+                            Received(batch);
+                        } else if (message.IsValid()) {
                             PluginHost::Channel::Lock();
                             securityClearance = _security->Allowed(*message);
                             PluginHost::Channel::Unlock();
@@ -2528,6 +3296,38 @@ namespace PluginHost {
                         }
                     }
                 }
+                void Received(Core::ProxyType<Core::JSONRPC::Batch>& batch)
+                {
+                    const uint16_t maxBatchSize = _parent.Dispatcher().MaxBatchSize();
+
+                    if ((batch->Length() == 0) || (batch->Length() > maxBatchSize) || (batch->IsOversized() == true)) {
+                        // Not worth dispatching, a single error answers the batch as a whole.
+                        Core::ProxyType<Core::JSONRPC::Message> response(Core::proxy_cast<Core::JSONRPC::Message>(Factories::Instance().JSONRPC()));
+
+                        response->JSONRPC = Core::JSONRPC::Message::DefaultVersion;
+                        response->Error.SetError(Core::ERROR_INVALID_DESIGNATOR);
+                        if ((batch->Length() == 0) && (batch->IsOversized() == false)) {
+                            response->Error.Text = _T("Empty or invalid batch.");
+                        } else {
+                            response->Error.Text = _T("Batch exceeds the maximum of ") + Core::NumberType<uint16_t>(maxBatchSize).Text() + _T(" requests.");
+                        }
+
+                        Submit(Core::ProxyType<Core::JSON::IElement>(response));
+                    } else {
+                        Core::ProxyType<BatchJob::Context> context(Core::ProxyType<BatchJob::Context>::Create(&_parent, Id(), _service, batch));
+                        const Core::JSONRPC::Batch::Messages& requests(batch->Elements());
+
+                        PluginHost::Channel::Lock();
+                        for (size_t index = 0; index < requests.size(); index++) {
+                            if (_security->Allowed(*(requests[index])) == false) {
+                                context->Reject(index, Core::ERROR_PRIVILIGED_REQUEST, _T("Request needs authorization."));
+                            }
+                        }
+                        PluginHost::Channel::Unlock();
+
+                        context->Schedule(context);
+                    }
+                }
                 virtual void Received(const string& value)
                 {
                     ASSERT(_service.IsValid() == true);
@@ -2580,6 +3380,8 @@ namespace PluginHost {
 
                     // If we are closing (or closed) do the clean up
                     if (IsOpen() == false) {
+                        _pipeline.Clear();
+
                         if (_service.IsValid() == true) {
                             _service->Unsubscribe(*this);
 
@@ -2587,6 +3389,20 @@ namespace PluginHost {
                         }
 
                         State(CLOSED, false);
+                    } else if (IsUpgrading() == true) {
+                        Core::ProxyType<Service> service;
+                        bool serviceCall;
+
+                        _parent.Services().FromLocator(Path(), service, serviceCall);
+
+                        // A lazy plugin is activated before the upgrade is answered, its first messages need it.
+                        if ((service.IsValid() == true) && (service->IsLazy() == true) && (service->State() != PluginHost::IShell::ACTIVATED)) {
+                            Core::ProxyType<UpgradeJob> job(Core::ProxyType<UpgradeJob>::Create(*this, service));
+
+                            if (job->Park() == true) {
+                                HoldUpgrade();
+                            }
+                        }
                     } else if (IsWebSocket() == true) {
                         ASSERT(_service.IsValid() == false);
                         bool serviceCall;
@@ -2609,6 +3425,8 @@ namespace PluginHost {
                                 State(TEXT, false);
                             } else if (Protocol() == _T("jsonrpc")) {
                                 State(JSONRPC, false);
+                            } else if (Protocol() == _T("jsonrpc.msgpack")) {
+                                State(JSONRPC, false, true);
                             } else {
                                 // Channel is a raw communication channel.
                                 // This channel allows for passing binary data back and forth
@@ -2629,7 +3447,8 @@ namespace PluginHost {
                             if (Name().length() > (JSONRPCHeader.length() + 1)) {
                                 Properties(static_cast<uint32_t>(JSONRPCHeader.length()) + 1);
                             }
-                            State(JSONRPC, false);
+                            // Clients can negotiate the binary (MessagePack) wire format for JSONRPC.
+                            State(JSONRPC, false, (Protocol() == _T("jsonrpc.msgpack")));
 
                             // The state needs to be correct before we c
                             if (_service->Subscribe(*this) == false) {
@@ -2651,6 +3470,7 @@ namespace PluginHost {
                 Server& _parent;
                 PluginHost::ISecurity* _security;
                 Core::ProxyType<Service> _service;
+                Pipeline _pipeline;
 
                 // Factories for creating jobs that can be placed on the PluginHost Worker pool.
                 static Core::ProxyPoolType<WebRequestJob> _webJobs;
@@ -2661,6 +3481,9 @@ namespace PluginHost {
                 // we can return a proper answer, without dispatching.
                 static Core::ProxyType<Web::Response> _missingCallsign;
 
+                // The answer to a request that comes in while the pipeline is full.
+                static Core::ProxyType<Web::Response> _overloaded;
+
                 // If there is a call sign but the version request is not avilable,
                 // we can return a proper answer, without dispatching.
                 static Core::ProxyType<Web::Response> _incorrectVersion;
@@ -2708,10 +3531,16 @@ namespace PluginHost {
 #ifdef __WINDOWS__
 #pragma warning(disable : 4355)
 #endif
-                ChannelMap(Server& parent, const Core::NodeId& listeningNode, const uint16_t connectionCheckTimer)
+                ChannelMap(Server& parent, const Core::NodeId& listeningNode, const uint16_t connectionCheckTimer, const uint16_t maxBatchSize, const uint16_t sendQueueLimit, const PluginHost::Channel::queuepolicy sendQueuePolicy, const uint16_t pipelineDepth, const Web::WebSocket::compression compression, const uint32_t maxMessageSize)
                     : Core::SocketServerType<Channel>(listeningNode)
                     , _parent(parent)
                     , _connectionCheckTimer(connectionCheckTimer * 1000)
+                    , _maxBatchSize(maxBatchSize)
+                    , _sendQueueLimit(sendQueueLimit)
+                    , _sendQueuePolicy(sendQueuePolicy)
+                    , _pipelineDepth(pipelineDepth)
+                    , _compression(compression)
+                    , _maxMessageSize(maxMessageSize)
                     , _job(Core::ProxyType<Job>::Create(this))
                 {
                     if (connectionCheckTimer != 0) {
@@ -2767,6 +3596,30 @@ namespace PluginHost {
                 {
                     return (Core::SocketServerType<Channel>::Count());
                 }
+                inline uint16_t MaxBatchSize() const
+                {
+                    return (_maxBatchSize);
+                }
+                inline uint16_t SendQueueLimit() const
+                {
+                    return (_sendQueueLimit);
+                }
+                inline PluginHost::Channel::queuepolicy SendQueuePolicy() const
+                {
+                    return (_sendQueuePolicy);
+                }
+                inline uint16_t PipelineDepth() const
+                {
+                    return (_pipelineDepth);
+                }
+                inline Web::WebSocket::compression Compression() const
+                {
+                    return (_compression);
+                }
+                inline uint32_t MaxMessageSize() const
+                {
+                    return (_maxMessageSize);
+                }
                 void GetMetaData(Core::JSON::ArrayType<MetaData::Channel>& metaData) const;
 
             private:
@@ -2803,9 +3656,111 @@ namespace PluginHost {
             private:
                 Server& _parent;
                 const uint32_t _connectionCheckTimer;
+                const uint16_t _maxBatchSize;
+                const uint16_t _sendQueueLimit;
+                const PluginHost::Channel::queuepolicy _sendQueuePolicy;
+                const uint16_t _pipelineDepth;
+                const Web::WebSocket::compression _compression;
+                const uint32_t _maxMessageSize;
                 Core::ProxyType<Core::IDispatchType<void>> _job;
             };
 
+            // Activates the AutoStart plugins. The preconditions are the edges of the dependency graph: a plugin
+            // is activated once the subsystems it depends on are signalled. Plugins that can be activated, are
+            // activated in parallel on a pool dedicated to the startup. A completed activation might have signalled
+            // subsystems, so whatever is waiting is reconsidered. What is still waiting once nothing is activating
+            // anymore, is left to the precondition handling of the Service.
+            class Startup {
+            private:
+                class Job : public Core::IDispatch {
+                public:
+                    Job() = delete;
+                    Job(const Job&) = delete;
+                    Job& operator=(const Job&) = delete;
+
+                    Job(Startup* parent, const Core::ProxyType<Service>& service)
+                        : _parent(*parent)
+                        , _service(service)
+                        , _queued(0)
+                        , _started(0)
+                        , _finished(0)
+                        , _result(Core::ERROR_UNAVAILABLE)
+                    {
+                        ASSERT(parent != nullptr);
+                    }
+                    ~Job() override
+                    {
+                    }
+
+                public:
+                    inline const Core::ProxyType<Service>& Plugin() const
+                    {
+                        return (_service);
+                    }
+                    inline void Queued(const uint64_t time)
+                    {
+                        _queued = time;
+                    }
+                    inline uint64_t Queued() const
+                    {
+                        return (_queued);
+                    }
+                    inline uint64_t Started() const
+                    {
+                        return (_started);
+                    }
+                    inline uint64_t Finished() const
+                    {
+                        return (_finished);
+                    }
+                    inline uint32_t Result() const
+                    {
+                        return (_result);
+                    }
+                    void Dispatch() override
+                    {
+                        _started = Core::Time::Now().Ticks();
+                        _result = _service->Activate(PluginHost::IShell::STARTUP);
+                        _finished = Core::Time::Now().Ticks();
+
+                        _parent.Completed();
+                    }
+
+                private:
+                    Startup& _parent;
+                    Core::ProxyType<Service> _service;
+                    uint64_t _queued;
+                    uint64_t _started;
+                    uint64_t _finished;
+                    uint32_t _result;
+                };
+
+            public:
+                Startup() = delete;
+                Startup(const Startup&) = delete;
+                Startup& operator=(const Startup&) = delete;
+
+                Startup(const uint8_t threads, const uint32_t stackSize, const std::list<Core::ProxyType<Service>>& services);
+                ~Startup();
+
+            public:
+                void Run();
+
+            private:
+                void Completed()
+                {
+                    Core::InterlockedDecrement(_running);
+                    _signal.SetEvent();
+                }
+                void Timeline(const uint64_t begin, const uint64_t end) const;
+
+            private:
+                Core::ThreadPool _pool;
+                Core::Event _signal;
+                uint32_t _running;
+                std::list<Core::ProxyType<Job>> _jobs;
+            };
+
         public:
             Server(Config& configuration, const bool background);
             virtual ~Server();
@@ -2891,6 +3846,10 @@ namespace PluginHost {
             Core::ProxyType<Service> _controller;
 
             Environment _environment;
+
+            // Startup of the AutoStart plugins.
+            const uint8_t _startupThreads;
+            const uint32_t _stackSize;
         };
     }
 }
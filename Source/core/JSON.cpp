@@ -18,7 +18,10 @@
  */
 
 #include "JSON.h"
+#include <cerrno>
+#include <cmath>
 #include <iomanip>
+#include <limits>
 #include <sstream>
 
 namespace WPEFramework {
@@ -40,6 +43,1145 @@ namespace Core {
 
         /* static */ char IElement::NullTag[] = "null";
 
+        bool Reader::Next()
+        {
+            bool result = false;
+
+            if ((_error == false) && (_depth > 0)) {
+                const uint32_t first = (1 << (_depth - 1));
+                TCHAR current = Peek();
+
+                if (current == '}') {
+                    _position++;
+                    _depth--;
+                } else if (((_scope & first) == 0) && (current != ',')) {
+                    _error = true;
+                } else {
+                    if ((_scope & first) == 0) {
+                        _position++;
+                        current = Peek();
+                    }
+
+                    _scope &= ~first;
+
+                    if (current != '\"') {
+                        _error = true;
+                    } else {
+                        uint32_t hash = 0x811C9DC5;
+
+                        _position++;
+                        _key = &(_text[_position]);
+
+                        while ((_position < _length) && (_text[_position] != '\"') && (_text[_position] != '\\') && (_text[_position] != '\0')) {
+                            hash = (hash ^ static_cast<uint8_t>(_text[_position])) * 0x01000193;
+                            _position++;
+                        }
+
+                        if ((_position < _length) && (_text[_position] == '\"')) {
+                            _keyLength = static_cast<uint32_t>(&(_text[_position]) - _key);
+                            _hash = hash;
+                            _position++;
+                        } else {
+                            // Escaped keys are rare, take the slow road..
+                            _position = static_cast<uint32_t>(_key - _text) - 1;
+
+                            if (Text(_unescapedKey) == true) {
+                                _key = _unescapedKey.c_str();
+                                _keyLength = static_cast<uint32_t>(_unescapedKey.length());
+                                _hash = JSON::Hash(_key);
+                            }
+                        }
+
+                        if (_error == false) {
+                            if (Peek() == ':') {
+                                _position++;
+                                result = true;
+                            } else {
+                                _error = true;
+                            }
+                        }
+                    }
+                }
+            } else {
+                _error = true;
+            }
+
+            return (result);
+        }
+
+        bool Reader::Skip()
+        {
+            TCHAR current = Peek();
+
+            if (current == '\"') {
+                string dummy;
+                Text(dummy);
+            } else if ((current == '{') || (current == '[')) {
+                uint32_t depth = 0;
+                bool quoted = false;
+
+                do {
+                    current = _text[_position++];
+
+                    if (quoted == true) {
+                        if (current == '\\') {
+                            _position++;
+                        } else if (current == '\"') {
+                            quoted = false;
+                        }
+                    } else if (current == '\"') {
+                        quoted = true;
+                    } else if ((current == '{') || (current == '[')) {
+                        depth++;
+                    } else if ((current == '}') || (current == ']')) {
+                        depth--;
+                    }
+                } while ((depth > 0) && (_position < _length) && (current != '\0'));
+
+                _error = (depth != 0);
+            } else {
+                const uint32_t start = _position;
+
+                while ((_position < _length) && (::strchr(",}] \t\r\n", _text[_position]) == nullptr) && (_text[_position] != '\0')) {
+                    _position++;
+                }
+
+                _error = (start == _position);
+            }
+
+            return (_error == false);
+        }
+
+        bool Reader::Value(Boolean& element)
+        {
+            bool result = false;
+            TCHAR current = Peek();
+
+            if (current == 't') {
+                result = Literal(_T("true"));
+                element = true;
+            } else if (current == 'f') {
+                result = Literal(_T("false"));
+                element = false;
+            } else if (current == 'n') {
+                result = Literal(IElement::NullTag);
+                element.Null(true);
+            } else {
+                result = Reflective(element);
+            }
+
+            return (result);
+        }
+
+        bool Reader::Value(String& element)
+        {
+            bool result = false;
+
+            if ((Peek() == '\"') && ((element._scopeCount & String::QuotedSerializeBit) != 0)) {
+                if (Text(element._value) == true) {
+                    element._scopeCount |= (String::QuoteFoundBit | String::SetBit | 1);
+                    result = true;
+                }
+            } else {
+                // Opaque objects, unquoted and null values..
+                result = Reflective(element);
+            }
+
+            return (result);
+        }
+
+        bool Reader::Reflective(IElement& element)
+        {
+            Core::OptionalType<Error> error;
+            uint16_t offset = 0;
+
+            if (Peek() == '\0') {
+                _error = true;
+            } else {
+                const uint32_t remaining = (_length - _position);
+                const uint16_t loaded = element.Deserialize(&(_text[_position]), static_cast<uint16_t>(std::min(remaining, static_cast<uint32_t>(0xFFFF))), offset, error);
+
+                _position += loaded;
+                _error = ((offset != 0) || (error.IsSet() == true));
+            }
+
+            return (_error == false);
+        }
+
+        bool Reader::Separator(const TCHAR closing)
+        {
+            bool result = false;
+            TCHAR current = Peek();
+
+            if (current == ',') {
+                _position++;
+                result = true;
+            } else if (current == closing) {
+                _position++;
+            } else {
+                _error = true;
+            }
+
+            return (result);
+        }
+
+        bool Reader::Literal(const TCHAR literal[])
+        {
+            const uint32_t length = static_cast<uint32_t>(::strlen(literal));
+
+            if (((_position + length) <= _length) && (::strncmp(&(_text[_position]), literal, length) == 0)) {
+                _position += length;
+            } else {
+                _error = true;
+            }
+
+            return (_error == false);
+        }
+
+        bool Reader::Number(uint64_t& value, bool& negative)
+        {
+            // Only the forms the serializers produce are handled here, the rest is left to the
+            // reflective parser.
+            const uint32_t start = _position;
+            const bool quoted = (Peek() == '\"');
+            uint8_t base = 10;
+
+            if (quoted == true) {
+                _position++;
+            }
+            if ((_position < _length) && (_text[_position] == '-')) {
+                negative = true;
+                _position++;
+            }
+            if (quoted == true) {
+                if (((_position + 1) < _length) && (_text[_position] == '0')) {
+                    _position++;
+                    if (::toupper(_text[_position]) == 'X') {
+                        _position++;
+                        base = 16;
+                    } else {
+                        base = 8;
+                    }
+                }
+            }
+
+            const uint32_t digits = _position;
+
+            while (_position < _length) {
+                TCHAR current = _text[_position];
+                uint8_t digit;
+
+                if ((current >= '0') && (current <= '9')) {
+                    digit = (current - '0');
+                } else if ((base == 16) && (::isxdigit(current))) {
+                    digit = (::toupper(current) - 'A') + 10;
+                } else {
+                    break;
+                }
+                if (digit >= base) {
+                    break;
+                }
+
+                value = (value * base) + digit;
+                _position++;
+            }
+
+            bool result = ((_position > digits) && (_position < _length));
+
+            if (result == true) {
+                if (quoted == true) {
+                    result = (_text[_position] == '\"');
+                    _position++;
+                } else {
+                    result = (::strchr(",}] \t\r\n", _text[_position]) != nullptr);
+                }
+            }
+
+            if (result == false) {
+                // Not ours, rewind..
+                _position = start;
+                value = 0;
+                negative = false;
+            }
+
+            return (result);
+        }
+
+        bool Reader::Text(string& value)
+        {
+            ASSERT(_text[_position] == '\"');
+
+            bool completed = false;
+            uint32_t start = ++_position;
+
+            value.clear();
+
+            while ((_position < _length) && (completed == false) && (_error == false)) {
+                TCHAR current = _text[_position];
+
+                if (current == '\"') {
+                    value.append(&(_text[start]), _position - start);
+                    completed = true;
+                } else if (current == '\0') {
+                    _error = true;
+                } else if (current == '\\') {
+                    value.append(&(_text[start]), _position - start);
+
+                    if ((_position + 1) >= _length) {
+                        _error = true;
+                    } else {
+                        switch (_text[++_position]) {
+                        case '\"':
+                            value += '\"';
+                            break;
+                        case '\\':
+                            value += '\\';
+                            break;
+                        case '/':
+                            value += '/';
+                            break;
+                        case 'n':
+                            value += '\n';
+                            break;
+                        case 'r':
+                            value += '\r';
+                            break;
+                        case 't':
+                            value += '\t';
+                            break;
+                        case 'f':
+                            value += '\f';
+                            break;
+                        case 'b':
+                            value += '\b';
+                            break;
+                        case 'u':
+                            // The reflective parser keeps these as is.
+                            value += _T("\\u");
+                            break;
+                        default:
+                            _error = true;
+                            break;
+                        }
+                        start = _position + 1;
+                    }
+                }
+                _position++;
+            }
+
+            if (completed == false) {
+                _error = true;
+            }
+
+            return (_error == false);
+        }
+
+        void Writer::Value(const Boolean& element)
+        {
+            Separator();
+
+            if (element.IsNull() == true) {
+                _text += IElement::NullTag;
+            } else {
+                _text += (element.Value() == true ? _T("true") : _T("false"));
+            }
+        }
+
+        void Writer::Value(const String& element)
+        {
+            Separator();
+
+            if (((element._scopeCount & String::NullBit) == 0) && (element.IsQuoted() == true)) {
+                Text(element._value.c_str(), static_cast<uint32_t>(element._value.length()));
+            } else {
+                Reflective(element);
+            }
+        }
+
+        void Writer::Reflective(const IElement& element)
+        {
+            char buffer[256];
+            uint16_t loaded;
+            uint16_t offset = 0;
+
+            do {
+                loaded = element.Serialize(buffer, sizeof(buffer), offset);
+
+                ASSERT(loaded <= sizeof(buffer));
+
+                _text.append(buffer, loaded);
+
+            } while ((offset != 0) && (loaded == sizeof(buffer)));
+        }
+
+        void Writer::Number(uint64_t value, const uint8_t base)
+        {
+            static constexpr TCHAR digits[] = "0123456789ABCDEF";
+
+            TCHAR buffer[24];
+            uint8_t index = sizeof(buffer);
+
+            if (base == BASE_DECIMAL) {
+                index = static_cast<uint8_t>(Core::FormatDecimal(value, &(buffer[sizeof(buffer)])) - buffer);
+            } else {
+                do {
+                    buffer[--index] = digits[value % base];
+                    value /= base;
+                } while (value != 0);
+            }
+
+            _text.append(&(buffer[index]), sizeof(buffer) - index);
+        }
+
+        void Writer::Text(const TCHAR text[], const uint32_t length)
+        {
+            uint32_t start = 0;
+
+            _text += '\"';
+
+            for (uint32_t index = 0; index < length; index++) {
+                TCHAR replacement = '\0';
+
+                switch (text[index]) {
+                case '\"':
+                    replacement = '\"';
+                    break;
+                case '\\':
+                    // Keep unicode escapes the way the reflective parser stored them.
+                    replacement = (text[index + 1] == 'u' ? '\0' : '\\');
+                    break;
+                case '\n':
+                    replacement = 'n';
+                    break;
+                case '\r':
+                    replacement = 'r';
+                    break;
+                case '\t':
+                    replacement = 't';
+                    break;
+                case '\f':
+                    replacement = 'f';
+                    break;
+                case '\b':
+                    replacement = 'b';
+                    break;
+                default:
+                    break;
+                }
+
+                if (replacement != '\0') {
+                    _text.append(&(text[start]), index - start);
+                    _text += '\\';
+                    _text += replacement;
+                    start = index + 1;
+                }
+            }
+
+            _text.append(&(text[start]), length - start);
+            _text += '\"';
+        }
+
+        static uint64_t BigEndian(const uint8_t stream[], const uint8_t bytes)
+        {
+            uint64_t result = 0;
+
+            for (uint8_t index = 0; index < bytes; index++) {
+                result = (result << 8) | stream[index];
+            }
+
+            return (result);
+        }
+
+        static void Escape(const char text[], const uint32_t length, string& result)
+        {
+            static constexpr TCHAR digits[] = "0123456789ABCDEF";
+
+            result += '\"';
+
+            for (uint32_t index = 0; index < length; index++) {
+                const uint8_t current = static_cast<uint8_t>(text[index]);
+
+                if ((current == '\"') || (current == '\\')) {
+                    result += '\\';
+                    result += static_cast<TCHAR>(current);
+                } else if (current == '\n') {
+                    result += _T("\\n");
+                } else if (current == '\r') {
+                    result += _T("\\r");
+                } else if (current == '\t') {
+                    result += _T("\\t");
+                } else if (current < 0x20) {
+                    result += _T("\\u00");
+                    result += digits[current >> 4];
+                    result += digits[current & 0x0F];
+                } else {
+                    result += static_cast<TCHAR>(current);
+                }
+            }
+
+            result += '\"';
+        }
+
+        // Unescapes the raw content of a JSON string. The output must be able to hold length
+        // characters, unescaping never grows the text. Returns the length of the result.
+        static uint32_t Unescape(const TCHAR text[], const uint32_t length, TCHAR output[])
+        {
+            uint32_t position = 0;
+            uint32_t loaded = 0;
+
+            while (position < length) {
+                if (text[position] != '\\') {
+                    output[loaded++] = text[position++];
+                } else if (++position < length) {
+                    switch (text[position]) {
+                    case 'n': output[loaded++] = '\n'; break;
+                    case 'r': output[loaded++] = '\r'; break;
+                    case 't': output[loaded++] = '\t'; break;
+                    case 'f': output[loaded++] = '\f'; break;
+                    case 'b': output[loaded++] = '\b'; break;
+                    case 'u': {
+                        uint32_t codePoint = 0;
+                        uint8_t digits = 0;
+
+                        while ((digits < 4) && ((position + 1) < length) && (::isxdigit(text[position + 1]) != 0)) {
+                            position++;
+                            codePoint = (codePoint << 4) | (::isdigit(text[position]) != 0 ? (text[position] - '0') : ((::toupper(text[position]) - 'A') + 10));
+                            digits++;
+                        }
+
+                        if ((codePoint >= 0xD800) && (codePoint <= 0xDBFF) && ((position + 6) < length) && (text[position + 1] == '\\') && (text[position + 2] == 'u')) {
+                            // Surrogate pair, combine it with the low part.
+                            uint32_t low = 0;
+                            for (uint8_t index = 0; index < 4; index++) {
+                                const TCHAR current = text[position + 3 + index];
+                                low = (low << 4) | (::isdigit(current) != 0 ? (current - '0') : ((::toupper(current) - 'A') + 10));
+                            }
+                            if ((low >= 0xDC00) && (low <= 0xDFFF)) {
+                                codePoint = 0x10000 + ((codePoint - 0xD800) << 10) + (low - 0xDC00);
+                                position += 6;
+                            }
+                        }
+
+                        if (codePoint < 0x80) {
+                            output[loaded++] = static_cast<char>(codePoint);
+                        } else if (codePoint < 0x800) {
+                            output[loaded++] = static_cast<char>(0xC0 | (codePoint >> 6));
+                            output[loaded++] = static_cast<char>(0x80 | (codePoint & 0x3F));
+                        } else if (codePoint < 0x10000) {
+                            output[loaded++] = static_cast<char>(0xE0 | (codePoint >> 12));
+                            output[loaded++] = static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F));
+                            output[loaded++] = static_cast<char>(0x80 | (codePoint & 0x3F));
+                        } else {
+                            output[loaded++] = static_cast<char>(0xF0 | (codePoint >> 18));
+                            output[loaded++] = static_cast<char>(0x80 | ((codePoint >> 12) & 0x3F));
+                            output[loaded++] = static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F));
+                            output[loaded++] = static_cast<char>(0x80 | (codePoint & 0x3F));
+                        }
+                        break;
+                    }
+                    default:
+                        output[loaded++] = text[position];
+                        break;
+                    }
+                    position++;
+                }
+            }
+
+            return (loaded);
+        }
+
+        /* static */ uint32_t MessagePack::Length(const uint8_t stream[], const uint32_t length)
+        {
+            return (Length(stream, length, 0));
+        }
+
+        /* static */ uint32_t MessagePack::Length(const uint8_t stream[], const uint32_t length, const uint8_t depth)
+        {
+            uint64_t result = 0;
+            uint8_t header = 1;
+            uint32_t elements = 0;
+
+            if (length == 0) {
+                return (0);
+            } else if (depth > MaxDepth) {
+                return (~0);
+            }
+
+            const uint8_t code = stream[0];
+
+            if ((code <= 0x7F) || (code >= 0xE0) || ((code >= 0xC0) && (code <= 0xC3))) {
+                result = 1;
+            } else if (code <= 0x8F) {
+                elements = 2 * (code & 0x0F);
+            } else if (code <= 0x9F) {
+                elements = (code & 0x0F);
+            } else if (code <= 0xBF) {
+                result = 1 + (code & 0x1F);
+            } else {
+                switch (code) {
+                case 0xC4: case 0xD9: header = 2; break;
+                case 0xC5: case 0xDA: case 0xDC: case 0xDE: header = 3; break;
+                case 0xC6: case 0xDB: case 0xDD: case 0xDF: header = 5; break;
+                case 0xC7: header = 3; break;
+                case 0xC8: header = 4; break;
+                case 0xC9: header = 6; break;
+                case 0xCA: case 0xCE: case 0xD2: result = 5; break;
+                case 0xCB: case 0xCF: case 0xD3: result = 9; break;
+                case 0xCC: case 0xD0: result = 2; break;
+                case 0xCD: case 0xD1: result = 3; break;
+                case 0xD4: result = 3; break;
+                case 0xD5: result = 4; break;
+                case 0xD6: result = 6; break;
+                case 0xD7: result = 10; break;
+                case 0xD8: result = 18; break;
+                default: break;
+                }
+
+                if (header > 1) {
+                    if (length < header) {
+                        return (0);
+                    }
+
+                    const uint8_t bytes = (code >= 0xC7) && (code <= 0xC9) ? header - 2 : header - 1;
+                    const uint64_t size = BigEndian(&(stream[1]), bytes);
+
+                    if ((code == 0xDC) || (code == 0xDD)) {
+                        elements = static_cast<uint32_t>(size);
+                    } else if ((code == 0xDE) || (code == 0xDF)) {
+                        elements = static_cast<uint32_t>(2 * size);
+                    } else {
+                        result = header + size;
+                    }
+                }
+            }
+
+            if (result == 0) {
+                // A container, walk its elements..
+                result = header;
+
+                while ((elements != 0) && (result < length)) {
+                    const uint32_t size = Length(&(stream[result]), static_cast<uint32_t>(length - result), depth + 1);
+
+                    if ((size == 0) || (size == static_cast<uint32_t>(~0))) {
+                        return (size);
+                    }
+
+                    result += size;
+                    elements--;
+                }
+
+                if (elements != 0) {
+                    result = length + 1;
+                }
+            }
+
+            return (result > length ? 0 : static_cast<uint32_t>(result));
+        }
+
+        /* static */ uint32_t MessagePack::ToJSON(const uint8_t stream[], const uint32_t length, string& text)
+        {
+            text.clear();
+
+            uint32_t result = ToJSON(stream, length, text, 0);
+
+            if (result == 0) {
+                text.clear();
+            }
+
+            return (result);
+        }
+
+        /* static */ uint32_t MessagePack::ToJSON(const uint8_t stream[], const uint32_t length, string& text, const uint8_t depth)
+        {
+            const uint32_t size = Length(stream, length, depth);
+
+            if ((size == 0) || (size == static_cast<uint32_t>(~0))) {
+                return (0);
+            }
+
+            const uint8_t code = stream[0];
+            uint32_t elements = 0;
+            uint32_t header = 1;
+            bool map = false;
+
+            if (code <= 0x7F) {
+                text += std::to_string(code);
+            } else if (code >= 0xE0) {
+                text += std::to_string(static_cast<int8_t>(code));
+            } else if (code <= 0x8F) {
+                elements = (code & 0x0F);
+                map = true;
+            } else if (code <= 0x9F) {
+                elements = (code & 0x0F);
+            } else if (code <= 0xBF) {
+                Escape(reinterpret_cast<const char*>(&(stream[1])), code & 0x1F, text);
+            } else {
+                switch (code) {
+                case 0xC0:
+                    text += IElement::NullTag;
+                    break;
+                case 0xC2:
+                    text += _T("false");
+                    break;
+                case 0xC3:
+                    text += _T("true");
+                    break;
+                case 0xC4:
+                case 0xC5:
+                case 0xC6: {
+                    const uint8_t bytes = (code == 0xC4 ? 1 : (code == 0xC5 ? 2 : 4));
+                    const uint32_t data = static_cast<uint32_t>(BigEndian(&(stream[1]), bytes));
+                    uint32_t offset = 0;
+                    text += '\"';
+                    // Base64 is taken in runs of 0xFFFF bytes, a multiple of 3, so only the last run is padded.
+                    do {
+                        const uint16_t run = static_cast<uint16_t>(std::min(data - offset, static_cast<uint32_t>(0xFFFF)));
+                        Core::ToString(&(stream[1 + bytes + offset]), run, true, text);
+                        offset += run;
+                    } while (offset < data);
+                    text += '\"';
+                    break;
+                }
+                case 0xCA:
+                case 0xCB: {
+                    double value;
+                    if (code == 0xCA) {
+                        uint32_t raw = static_cast<uint32_t>(BigEndian(&(stream[1]), 4));
+                        float converted;
+                        ::memcpy(&converted, &raw, sizeof(converted));
+                        value = converted;
+                    } else {
+                        uint64_t raw = BigEndian(&(stream[1]), 8);
+                        ::memcpy(&value, &raw, sizeof(value));
+                    }
+                    if (std::isfinite(value) == false) {
+                        text += IElement::NullTag;
+                    } else {
+                        TCHAR buffer[32];
+                        ::snprintf(buffer, sizeof(buffer), (code == 0xCA ? _T("%.9g") : _T("%.17g")), value);
+                        text += buffer;
+                    }
+                    break;
+                }
+                case 0xCC:
+                case 0xCD:
+                case 0xCE:
+                case 0xCF:
+                    text += std::to_string(BigEndian(&(stream[1]), static_cast<uint8_t>(1 << (code - 0xCC))));
+                    break;
+                case 0xD0:
+                case 0xD1:
+                case 0xD2:
+                case 0xD3: {
+                    const uint8_t bytes = static_cast<uint8_t>(1 << (code - 0xD0));
+                    const uint64_t raw = BigEndian(&(stream[1]), bytes);
+                    const uint8_t shift = static_cast<uint8_t>(64 - (8 * bytes));
+                    text += std::to_string(static_cast<int64_t>(raw << shift) >> shift);
+                    break;
+                }
+                case 0xD9:
+                case 0xDA:
+                case 0xDB: {
+                    const uint8_t bytes = (code == 0xD9 ? 1 : (code == 0xDA ? 2 : 4));
+                    Escape(reinterpret_cast<const char*>(&(stream[1 + bytes])), size - 1 - bytes, text);
+                    break;
+                }
+                case 0xDC:
+                case 0xDD:
+                case 0xDE:
+                case 0xDF:
+                    header = ((code == 0xDC) || (code == 0xDE) ? 3 : 5);
+                    elements = static_cast<uint32_t>(BigEndian(&(stream[1]), static_cast<uint8_t>(header - 1)));
+                    map = (code >= 0xDE);
+                    break;
+                case 0xC1:
+                    return (0);
+                default:
+                    // Extension types have no JSON counterpart.
+                    text += IElement::NullTag;
+                    break;
+                }
+            }
+
+            if ((header > 1) || ((code >= 0x80) && (code <= 0x9F))) {
+                uint32_t position = header;
+
+                text += (map == true ? '{' : '[');
+
+                for (uint32_t index = 0; index < elements; index++) {
+                    if (index != 0) {
+                        text += ',';
+                    }
+                    if (map == true) {
+                        string key;
+                        uint32_t loaded = Text(&(stream[position]), size - position, key);
+
+                        if (loaded != 0) {
+                            Escape(key.c_str(), static_cast<uint32_t>(key.length()), text);
+                        } else if ((loaded = ToJSON(&(stream[position]), size - position, key, depth + 1)) != 0) {
+                            Escape(key.c_str(), static_cast<uint32_t>(key.length()), text);
+                        } else {
+                            return (0);
+                        }
+                        position += loaded;
+                        text += ':';
+                    }
+
+                    const uint32_t loaded = ToJSON(&(stream[position]), size - position, text, depth + 1);
+
+                    if (loaded == 0) {
+                        return (0);
+                    }
+                    position += loaded;
+                }
+
+                text += (map == true ? '}' : ']');
+            }
+
+            return (size);
+        }
+
+        /* static */ bool MessagePack::FromJSON(const string& text, std::vector<uint8_t>& stream)
+        {
+            uint32_t position = 0;
+            const uint32_t length = static_cast<uint32_t>(text.length());
+            const size_t start = stream.size();
+
+            bool result = FromJSON(text.c_str(), length, position, stream, 0);
+
+            while ((result == true) && (position < length) && (::isspace(text[position]) != 0)) {
+                position++;
+            }
+
+            if ((result == false) || (position != length)) {
+                stream.resize(start);
+                result = false;
+            }
+
+            return (result);
+        }
+
+        /* static */ bool MessagePack::FromJSON(const TCHAR text[], const uint32_t length, uint32_t& position, std::vector<uint8_t>& stream, const uint8_t depth)
+        {
+            bool result = false;
+
+            while ((position < length) && (::isspace(text[position]) != 0)) {
+                position++;
+            }
+
+            if ((position >= length) || (depth > MaxDepth)) {
+                // Nothing to convert..
+            } else if ((text[position] == '{') || (text[position] == '[')) {
+                const TCHAR closing = (text[position] == '{' ? '}' : ']');
+                const size_t start = stream.size();
+                uint32_t count = 0;
+
+                stream.push_back(0);
+                position++;
+                result = true;
+
+                while ((position < length) && (::isspace(text[position]) != 0)) {
+                    position++;
+                }
+
+                if ((position < length) && (text[position] == closing)) {
+                    position++;
+                } else {
+                    bool completed = false;
+
+                    while ((result == true) && (completed == false)) {
+                        if (closing == '}') {
+                            while ((position < length) && (::isspace(text[position]) != 0)) {
+                                position++;
+                            }
+                            // Keys have to be strings, use the value conversion to do the unescaping.
+                            result = (position < length) && (text[position] == '\"') && (FromJSON(text, length, position, stream, depth + 1) == true);
+
+                            while ((result == true) && (position < length) && (::isspace(text[position]) != 0)) {
+                                position++;
+                            }
+                            result = (result == true) && (position < length) && (text[position++] == ':');
+                        }
+
+                        result = (result == true) && (FromJSON(text, length, position, stream, depth + 1) == true);
+
+                        while ((result == true) && (position < length) && (::isspace(text[position]) != 0)) {
+                            position++;
+                        }
+
+                        if ((result == false) || (position >= length)) {
+                            result = false;
+                        } else if (text[position] == ',') {
+                            position++;
+                        } else if (text[position] == closing) {
+                            position++;
+                            completed = true;
+                        } else {
+                            result = false;
+                        }
+                        count++;
+                    }
+                }
+
+                if (result == true) {
+                    const bool map = (closing == '}');
+
+                    if (count <= 15) {
+                        stream[start] = static_cast<uint8_t>((map == true ? 0x80 : 0x90) | count);
+                    } else {
+                        std::vector<uint8_t> header;
+                        if (count <= 0xFFFF) {
+                            Append(header, (map == true ? 0xDE : 0xDC), count, 2);
+                        } else {
+                            Append(header, (map == true ? 0xDF : 0xDD), count, 4);
+                        }
+                        stream[start] = header[0];
+                        stream.insert(stream.begin() + start + 1, header.begin() + 1, header.end());
+                    }
+                }
+            } else if (text[position] == '\"') {
+                const uint32_t start = ++position;
+
+                while ((position < length) && (text[position] != '\"')) {
+                    position += (((text[position] == '\\') && ((position + 1) < length)) ? 2 : 1);
+                }
+
+                if (position < length) {
+                    string value(position - start, '\0');
+                    value.resize(Unescape(&(text[start]), position - start, &(value[0])));
+                    Text(stream, value);
+                    position++;
+                    result = true;
+                }
+            } else if (::strncmp(&(text[position]), _T("true"), std::min(length - position, 4u)) == 0) {
+                stream.push_back(0xC3);
+                position += 4;
+                result = (position <= length);
+            } else if (::strncmp(&(text[position]), _T("false"), std::min(length - position, 5u)) == 0) {
+                stream.push_back(0xC2);
+                position += 5;
+                result = (position <= length);
+            } else if (::strncmp(&(text[position]), IElement::NullTag, std::min(length - position, 4u)) == 0) {
+                Nil(stream);
+                position += 4;
+                result = (position <= length);
+            } else if ((text[position] == '-') || (::isdigit(text[position]) != 0)) {
+                const uint32_t start = position;
+                bool integer = true;
+
+                while ((position < length) && ((::isdigit(text[position]) != 0) || (text[position] == '-') || (text[position] == '+') || (text[position] == '.') || (text[position] == 'e') || (text[position] == 'E'))) {
+                    integer = integer && (::isdigit(text[position]) != 0 || ((position == start) && (text[position] == '-')));
+                    position++;
+                }
+
+                const string number(&(text[start]), position - start);
+                char* end = nullptr;
+
+                errno = 0;
+
+                if ((integer == true) && (text[start] == '-')) {
+                    const int64_t value = ::strtoll(number.c_str(), &end, 10);
+                    if (errno == 0) {
+                        Number(stream, value);
+                        result = (*end == '\0');
+                    }
+                } else if (integer == true) {
+                    const uint64_t value = ::strtoull(number.c_str(), &end, 10);
+                    if (errno != 0) {
+                        // Out of range, fall through to the double conversion.
+                    } else if (value > static_cast<uint64_t>(std::numeric_limits<int64_t>::max())) {
+                        Append(stream, 0xCF, value, 8);
+                        result = (*end == '\0');
+                    } else {
+                        Number(stream, static_cast<int64_t>(value));
+                        result = (*end == '\0');
+                    }
+                }
+
+                if ((result == false) && (errno != 0 || integer == false)) {
+                    const double value = ::strtod(number.c_str(), &end);
+                    uint64_t raw;
+                    ::memcpy(&raw, &value, sizeof(raw));
+                    Append(stream, 0xCB, raw, 8);
+                    result = (*end == '\0');
+                }
+            }
+
+            return (result);
+        }
+
+        /* static */ void MessagePack::Append(std::vector<uint8_t>& stream, const uint8_t code, const uint64_t value, const uint8_t bytes)
+        {
+            stream.push_back(code);
+
+            for (uint8_t index = bytes; index > 0; index--) {
+                stream.push_back(static_cast<uint8_t>((value >> (8 * (index - 1))) & 0xFF));
+            }
+        }
+
+        /* static */ void MessagePack::Map(std::vector<uint8_t>& stream, const uint32_t count)
+        {
+            if (count <= 15) {
+                stream.push_back(static_cast<uint8_t>(0x80 | count));
+            } else if (count <= 0xFFFF) {
+                Append(stream, 0xDE, count, 2);
+            } else {
+                Append(stream, 0xDF, count, 4);
+            }
+        }
+
+        /* static */ void MessagePack::Array(std::vector<uint8_t>& stream, const uint32_t count)
+        {
+            if (count <= 15) {
+                stream.push_back(static_cast<uint8_t>(0x90 | count));
+            } else if (count <= 0xFFFF) {
+                Append(stream, 0xDC, count, 2);
+            } else {
+                Append(stream, 0xDD, count, 4);
+            }
+        }
+
+        /* static */ void MessagePack::Text(std::vector<uint8_t>& stream, const string& value)
+        {
+            const uint32_t length = static_cast<uint32_t>(value.length());
+
+            if (length <= 31) {
+                stream.push_back(static_cast<uint8_t>(0xA0 | length));
+            } else if (length <= 0xFF) {
+                Append(stream, 0xD9, length, 1);
+            } else if (length <= 0xFFFF) {
+                Append(stream, 0xDA, length, 2);
+            } else {
+                Append(stream, 0xDB, length, 4);
+            }
+
+            stream.insert(stream.end(), value.begin(), value.end());
+        }
+
+        /* static */ void MessagePack::Number(std::vector<uint8_t>& stream, const int64_t value)
+        {
+            if (value >= 0) {
+                if (value <= 0x7F) {
+                    stream.push_back(static_cast<uint8_t>(value));
+                } else if (value <= 0xFF) {
+                    Append(stream, 0xCC, value, 1);
+                } else if (value <= 0xFFFF) {
+                    Append(stream, 0xCD, value, 2);
+                } else if (value <= 0xFFFFFFFF) {
+                    Append(stream, 0xCE, value, 4);
+                } else {
+                    Append(stream, 0xCF, value, 8);
+                }
+            } else if (value >= -32) {
+                stream.push_back(static_cast<uint8_t>(value));
+            } else if (value >= std::numeric_limits<int8_t>::min()) {
+                Append(stream, 0xD0, static_cast<uint64_t>(value), 1);
+            } else if (value >= std::numeric_limits<int16_t>::min()) {
+                Append(stream, 0xD1, static_cast<uint64_t>(value), 2);
+            } else if (value >= std::numeric_limits<int32_t>::min()) {
+                Append(stream, 0xD2, static_cast<uint64_t>(value), 4);
+            } else {
+                Append(stream, 0xD3, static_cast<uint64_t>(value), 8);
+            }
+        }
+
+        /* static */ uint32_t MessagePack::Map(const uint8_t stream[], const uint32_t length, uint32_t& count)
+        {
+            uint32_t result = 0;
+
+            if (length > 0) {
+                if ((stream[0] & 0xF0) == 0x80) {
+                    count = (stream[0] & 0x0F);
+                    result = 1;
+                } else if ((stream[0] == 0xDE) && (length >= 3)) {
+                    count = static_cast<uint32_t>(BigEndian(&(stream[1]), 2));
+                    result = 3;
+                } else if ((stream[0] == 0xDF) && (length >= 5)) {
+                    count = static_cast<uint32_t>(BigEndian(&(stream[1]), 4));
+                    result = 5;
+                }
+            }
+
+            return (result);
+        }
+
+        /* static */ uint32_t MessagePack::Array(const uint8_t stream[], const uint32_t length, uint32_t& count)
+        {
+            uint32_t result = 0;
+
+            if (length > 0) {
+                if ((stream[0] & 0xF0) == 0x90) {
+                    count = (stream[0] & 0x0F);
+                    result = 1;
+                } else if ((stream[0] == 0xDC) && (length >= 3)) {
+                    count = static_cast<uint32_t>(BigEndian(&(stream[1]), 2));
+                    result = 3;
+                } else if ((stream[0] == 0xDD) && (length >= 5)) {
+                    count = static_cast<uint32_t>(BigEndian(&(stream[1]), 4));
+                    result = 5;
+                }
+            }
+
+            return (result);
+        }
+
+        /* static */ uint32_t MessagePack::Text(const uint8_t stream[], const uint32_t length, string& value)
+        {
+            uint32_t result = 0;
+
+            if (length > 0) {
+                uint8_t header = 0;
+                uint32_t size = 0;
+
+                if ((stream[0] & 0xE0) == 0xA0) {
+                    header = 1;
+                    size = (stream[0] & 0x1F);
+                } else if ((stream[0] >= 0xD9) && (stream[0] <= 0xDB)) {
+                    const uint8_t bytes = (stream[0] == 0xD9 ? 1 : (stream[0] == 0xDA ? 2 : 4));
+                    if (length > bytes) {
+                        header = 1 + bytes;
+                        size = static_cast<uint32_t>(BigEndian(&(stream[1]), bytes));
+                    }
+                }
+
+                if ((header != 0) && ((static_cast<uint64_t>(header) + size) <= length)) {
+                    value.assign(reinterpret_cast<const char*>(&(stream[header])), size);
+                    result = header + size;
+                }
+            }
+
+            return (result);
+        }
+
+        /* static */ uint32_t MessagePack::Number(const uint8_t stream[], const uint32_t length, int64_t& value)
+        {
+            uint32_t result = 0;
+
+            if (length > 0) {
+                const uint8_t code = stream[0];
+
+                if ((code <= 0x7F) || (code >= 0xE0)) {
+                    value = static_cast<int8_t>(code);
+                    result = 1;
+                } else if ((code >= 0xCC) && (code <= 0xCF)) {
+                    const uint8_t bytes = static_cast<uint8_t>(1 << (code - 0xCC));
+                    if (length > bytes) {
+                        value = static_cast<int64_t>(BigEndian(&(stream[1]), bytes));
+                        result = 1 + bytes;
+                    }
+                } else if ((code >= 0xD0) && (code <= 0xD3)) {
+                    const uint8_t bytes = static_cast<uint8_t>(1 << (code - 0xD0));
+                    if (length > bytes) {
+                        const uint8_t shift = static_cast<uint8_t>(64 - (8 * bytes));
+                        value = static_cast<int64_t>(BigEndian(&(stream[1]), bytes) << shift) >> shift;
+                        result = 1 + bytes;
+                    }
+                }
+            }
+
+            return (result);
+        }
+
         string Variant::GetDebugString(const TCHAR name[], int indent, int arrayIndex) const
         {
             std::stringstream ss;
@@ -77,6 +1219,378 @@ namespace Core {
                 ss << iterator.Current().GetDebugString(iterator.Label(), indent);
             return ss.str();
         }
+
+        static void SkipWhitespace(const TCHAR text[], const uint32_t length, uint32_t& position)
+        {
+            while ((position < length) && (::isspace(text[position]) != 0)) {
+                position++;
+            }
+        }
+
+        Document::Arena::Arena(const uint32_t blockSize)
+            : _blockSize(blockSize)
+            , _blocks(nullptr)
+            , _position(nullptr)
+            , _end(nullptr)
+        {
+        }
+
+        Document::Arena::~Arena()
+        {
+            while (_blocks != nullptr) {
+                Block* next = _blocks->_next;
+                ::free(_blocks);
+                _blocks = next;
+            }
+        }
+
+        void* Document::Arena::Allocate(const uint32_t size)
+        {
+            // Keep everything 8 byte aligned, nodes hold pointers.
+            const uint32_t aligned = ((size + 7) & ~7u);
+
+            if ((_position == nullptr) || (static_cast<uint32_t>(_end - _position) < aligned)) {
+                Create(std::max(aligned, _blockSize));
+            }
+
+            void* result = _position;
+            _position += aligned;
+
+            return (result);
+        }
+
+        void Document::Arena::Reset()
+        {
+            if ((_blocks != nullptr) && (_blocks->_next != nullptr)) {
+                // The previous document did not fit a single block, replace them all by one block
+                // that is large enough, so the next document of the same size does.
+                uint32_t total = 0;
+
+                while (_blocks != nullptr) {
+                    Block* next = _blocks->_next;
+                    total += _blocks->_size;
+                    ::free(_blocks);
+                    _blocks = next;
+                }
+
+                Create(total);
+            } else if (_blocks != nullptr) {
+                _position = reinterpret_cast<uint8_t*>(&(_blocks[1]));
+            }
+        }
+
+        Document::Arena::Block* Document::Arena::Create(const uint32_t size)
+        {
+            Block* block = static_cast<Block*>(::malloc(sizeof(Block) + size));
+
+            ASSERT(block != nullptr);
+
+            block->_next = _blocks;
+            block->_size = size;
+            _blocks = block;
+            _position = reinterpret_cast<uint8_t*>(&(block[1]));
+            _end = _position + size;
+
+            return (block);
+        }
+
+        int64_t Document::Node::Number() const
+        {
+            int64_t result = 0;
+
+            if (_type == type::NUMBER) {
+                const bool negative = (_text[0] == '-');
+                uint32_t index = (negative == true ? 1 : 0);
+                uint64_t value = 0;
+
+                while ((index < _length) && (::isdigit(_text[index]) != 0)) {
+                    value = (value * 10) + (_text[index++] - '0');
+                }
+
+                if (index < _length) {
+                    // Fraction and/or exponent, truncate like a C++ conversion would.
+                    result = static_cast<int64_t>(Float());
+                } else {
+                    result = static_cast<int64_t>(negative == true ? (0 - value) : value);
+                }
+            }
+
+            return (result);
+        }
+
+        double Document::Node::Float() const
+        {
+            double result = 0.0;
+
+            if (_type == type::NUMBER) {
+                const bool negative = (_text[0] == '-');
+                uint32_t index = (negative == true ? 1 : 0);
+                uint64_t mantissa = 0;
+                int32_t scale = 0;
+                int32_t exponent = 0;
+                uint8_t digits = 0;
+
+                for (; (index < _length) && (::isdigit(_text[index]) != 0); index++) {
+                    if (digits < 19) {
+                        mantissa = (mantissa * 10) + (_text[index] - '0');
+                        digits += (mantissa != 0 ? 1 : 0);
+                    } else {
+                        scale++;
+                    }
+                }
+                if ((index < _length) && (_text[index] == '.')) {
+                    for (index++; (index < _length) && (::isdigit(_text[index]) != 0); index++) {
+                        if (digits < 19) {
+                            mantissa = (mantissa * 10) + (_text[index] - '0');
+                            digits += (mantissa != 0 ? 1 : 0);
+                            scale--;
+                        }
+                    }
+                }
+                if ((index < _length) && ((_text[index] == 'e') || (_text[index] == 'E'))) {
+                    const bool negativeExponent = ((++index < _length) && (_text[index] == '-'));
+
+                    if ((index < _length) && ((_text[index] == '-') || (_text[index] == '+'))) {
+                        index++;
+                    }
+                    for (; (index < _length) && (::isdigit(_text[index]) != 0); index++) {
+                        exponent = std::min((exponent * 10) + (_text[index] - '0'), 99999);
+                    }
+                    exponent = (negativeExponent == true ? -exponent : exponent);
+                }
+
+                result = Core::ComposeFloat(mantissa, exponent + scale, false);
+                result = (negative == true ? -result : result);
+            }
+
+            return (result);
+        }
+
+        const Document::Node& Document::Node::operator[](const TCHAR label[]) const
+        {
+            const Node* index = (_type == type::OBJECT ? _child : nullptr);
+            const uint32_t length = static_cast<uint32_t>(::strlen(label));
+
+            while ((index != nullptr) && ((index->_labelLength != length) || (::memcmp(index->_label, label, length) != 0))) {
+                index = index->_next;
+            }
+
+            return (index != nullptr ? *index : Document::NullNode());
+        }
+
+        const Document::Node& Document::Node::Get(const uint32_t position) const
+        {
+            const Node* index = (((_type == type::ARRAY) || (_type == type::OBJECT)) ? _child : nullptr);
+            uint32_t count = position;
+
+            while ((index != nullptr) && (count-- > 0)) {
+                index = index->_next;
+            }
+
+            return (index != nullptr ? *index : Document::NullNode());
+        }
+
+        void Document::Node::ToString(string& text) const
+        {
+            switch (_type) {
+            case type::OBJECT:
+            case type::ARRAY: {
+                const bool object = (_type == type::OBJECT);
+
+                text += (object == true ? '{' : '[');
+                for (const Node* index = _child; index != nullptr; index = index->_next) {
+                    if (index != _child) {
+                        text += ',';
+                    }
+                    if (object == true) {
+                        Escape(index->_label, index->_labelLength, text);
+                        text += ':';
+                    }
+                    index->ToString(text);
+                }
+                text += (object == true ? '}' : ']');
+                break;
+            }
+            case type::STRING:
+                Escape(_text, _length, text);
+                break;
+            case type::NUMBER:
+            case type::BOOLEAN:
+                text.append(_text, _length);
+                break;
+            default:
+                text += IElement::NullTag;
+                break;
+            }
+        }
+
+        /* static */ const Document::Node& Document::NullNode()
+        {
+            static const Node nullNode;
+
+            return (nullNode);
+        }
+
+        bool Document::FromString(const TCHAR text[], const uint32_t length)
+        {
+            Clear();
+
+            TCHAR* copy = static_cast<TCHAR*>(_arena.Allocate(length * sizeof(TCHAR)));
+            ::memcpy(copy, text, length * sizeof(TCHAR));
+
+            return (Load(copy, length));
+        }
+
+        bool Document::FromBuffer(const TCHAR text[], const uint32_t length)
+        {
+            Clear();
+
+            return (Load(text, length));
+        }
+
+        bool Document::Load(const TCHAR text[], const uint32_t length)
+        {
+            uint32_t position = 0;
+            Node* root = Parse(text, length, position, 0);
+
+            SkipWhitespace(text, length, position);
+
+            if ((root != nullptr) && ((position == length) || (text[position] == '\0'))) {
+                _root = root;
+            } else {
+                TRACE_L1(_T("Parsing failed at position %u"), position);
+                Clear();
+            }
+
+            return (_root != nullptr);
+        }
+
+        Document::Node* Document::Parse(const TCHAR text[], const uint32_t length, uint32_t& position, const uint8_t depth)
+        {
+            Node* result = nullptr;
+
+            SkipWhitespace(text, length, position);
+
+            if ((position < length) && (depth <= MaxDepth)) {
+                Node* node = new (_arena.Allocate(sizeof(Node))) Node();
+                const TCHAR current = text[position];
+
+                if ((current == '{') || (current == '[')) {
+                    const bool object = (current == '{');
+                    const TCHAR closing = (object == true ? '}' : ']');
+                    Node** tail = &(node->_child);
+                    bool valid = true;
+
+                    node->_type = (object == true ? Node::type::OBJECT : Node::type::ARRAY);
+                    position++;
+                    SkipWhitespace(text, length, position);
+
+                    if ((position < length) && (text[position] == closing)) {
+                        position++;
+                    } else {
+                        do {
+                            const TCHAR* label = nullptr;
+                            uint32_t labelLength = 0;
+
+                            if (object == true) {
+                                SkipWhitespace(text, length, position);
+                                valid = ((Parse(text, length, position, label, labelLength) == true));
+
+                                if (valid == true) {
+                                    SkipWhitespace(text, length, position);
+                                    valid = ((position < length) && (text[position++] == ':'));
+                                }
+                            }
+
+                            Node* child = (valid == true ? Parse(text, length, position, depth + 1) : nullptr);
+
+                            if (child == nullptr) {
+                                valid = false;
+                            } else {
+                                child->_label = label;
+                                child->_labelLength = labelLength;
+                                *tail = child;
+                                tail = &(child->_next);
+                                node->_length++;
+
+                                SkipWhitespace(text, length, position);
+                                valid = ((position < length) && ((text[position] == ',') || (text[position] == closing)));
+                            }
+                        } while ((valid == true) && (text[position++] == ','));
+                    }
+
+                    result = (valid == true ? node : nullptr);
+                } else if (current == '\"') {
+                    node->_type = Node::type::STRING;
+                    result = (Parse(text, length, position, node->_text, node->_length) == true ? node : nullptr);
+                } else if ((current == 't') || (current == 'f') || (current == 'n')) {
+                    const TCHAR* literal = (current == 't' ? _T("true") : (current == 'f' ? _T("false") : IElement::NullTag));
+                    const uint32_t size = static_cast<uint32_t>(::strlen(literal));
+
+                    if (((length - position) >= size) && (::strncmp(&(text[position]), literal, size) == 0)) {
+                        node->_type = (current == 'n' ? Node::type::EMPTY : Node::type::BOOLEAN);
+                        node->_text = &(text[position]);
+                        node->_length = size;
+                        position += size;
+                        result = node;
+                    }
+                } else if ((current == '-') || (::isdigit(current) != 0)) {
+                    const uint32_t start = position;
+                    bool digits = false;
+
+                    position += (current == '-' ? 1 : 0);
+
+                    while ((position < length) && ((::isdigit(text[position]) != 0) || (text[position] == '.') || (text[position] == 'e') || (text[position] == 'E') || (((text[position] == '-') || (text[position] == '+')) && ((text[position - 1] == 'e') || (text[position - 1] == 'E'))))) {
+                        digits = digits || (::isdigit(text[position]) != 0);
+                        position++;
+                    }
+
+                    if (digits == true) {
+                        node->_type = Node::type::NUMBER;
+                        node->_text = &(text[start]);
+                        node->_length = position - start;
+                        result = node;
+                    }
+                }
+            }
+
+            return (result);
+        }
+
+        bool Document::Parse(const TCHAR text[], const uint32_t length, uint32_t& position, const TCHAR*& value, uint32_t& size)
+        {
+            bool result = false;
+
+            if ((position < length) && (text[position] == '\"')) {
+                const uint32_t start = ++position;
+                bool escaped = false;
+
+                while ((position < length) && (text[position] != '\"')) {
+                    if ((text[position] == '\\') && ((position + 1) < length)) {
+                        escaped = true;
+                        position += 2;
+                    } else {
+                        position++;
+                    }
+                }
+
+                if (position < length) {
+                    if (escaped == false) {
+                        // Refer to the text, no copy needed.
+                        value = &(text[start]);
+                        size = position - start;
+                    } else {
+                        TCHAR* buffer = static_cast<TCHAR*>(_arena.Allocate((position - start) * sizeof(TCHAR)));
+                        size = Unescape(&(text[start]), position - start, buffer);
+                        value = buffer;
+                    }
+                    position++;
+                    result = true;
+                }
+            }
+
+            return (result);
+        }
     }
 }
 
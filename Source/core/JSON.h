@@ -20,6 +20,7 @@
 #ifndef __JSON_H
 #define __JSON_H
 
+#include <cmath>
 #include <map>
 #include <vector>
 
@@ -83,6 +84,9 @@ namespace Core {
 
         string EXTERNAL ErrorDisplayMessage(const Error& err);
 
+        class Reader;
+        class Writer;
+
         struct EXTERNAL IElement {
 
             static char NullTag[];
@@ -636,7 +640,6 @@ namespace Core {
                             offset = 1;
                         } else {
                             error = Error{ "Unsupported character \"" + std::string(1, stream[loaded]) + "\" in a number" };
-                            ++loaded;
                             _set = ERROR;
                             offset = 4;
                         }
@@ -655,7 +658,6 @@ namespace Core {
                             offset = 2;
                         } else {
                             error = Error{ "Unsupported character \"" + std::string(1, stream[loaded]) + "\" in a number" };
-                            ++loaded;
                             _set = ERROR;
                             offset = 4;
                         }
@@ -673,7 +675,6 @@ namespace Core {
                             offset = 3;
                         } else {
                             error = Error{ "Unsupported character \"" + std::string(1, stream[loaded]) + "\" in a number" };
-                            ++loaded;
                             _set = ERROR;
                             offset = 4;
                         }
@@ -689,7 +690,6 @@ namespace Core {
                             offset = 4;
                         } else {
                             error = Error{ "Unsupported character \"" + std::string(1, stream[loaded]) + "\" in a number" };
-                            ++loaded;
                             _set = ERROR;
                             offset = 4;
                         }
@@ -699,6 +699,15 @@ namespace Core {
 
                 bool completed = ((_set & ERROR) != 0);
 
+                if ((_set & (0x1F | ERROR)) == DECIMAL) {
+                    // Bulk of the numbers, keep the loop tight. Accumulate unsigned, the magnitude of
+                    // the minimum value does not fit the type.
+                    while ((loaded < maxLength) && (static_cast<uint8_t>(stream[loaded] - '0') < 10)) {
+                        _value = static_cast<TYPE>((static_cast<uint64_t>(_value) * 10) + static_cast<uint8_t>(stream[loaded] - '0'));
+                        loaded++;
+                    }
+                }
+
                 while ((loaded < maxLength) && (completed == false)) {
                     if (isdigit(stream[loaded])) {
                         _value *= (_set & 0x1F);
@@ -730,7 +739,7 @@ namespace Core {
                     }
                 } else if (completed == true) {
                     if (_set & NEGATIVE) {
-                        _value *= -1;
+                        _value = static_cast<TYPE>(0 - static_cast<uint64_t>(_value));
                     }
                     _set |= SET;
                     offset = 0;
@@ -787,34 +796,38 @@ namespace Core {
                 return (loaded);
             }
 
-            uint16_t Convert(char stream[], const uint16_t maxLength, uint16_t& offset, const TYPE serialize) const
+            uint16_t Convert(char stream[], const uint16_t maxLength, uint16_t& offset, const uint64_t serialize) const
             {
-                uint8_t parsed = 4;
-                uint16_t loaded = 0;
-                TYPE divider = 1;
-                TYPE value = (serialize / BASETYPE);
+                // Render the digits in one go and continue from where the previous chunk left off.
+                // The digits start at offset 4, the positions before are used by the prefix.
+                char buffer[24];
+                char* const end = &buffer[sizeof(buffer)];
+                const char* start;
 
-                while (divider <= value) {
-                    divider *= BASETYPE;
-                }
+                if (BASETYPE == BASE_DECIMAL) {
+                    start = Core::FormatDecimal(serialize, end);
+                } else {
+                    const uint8_t shift = (BASETYPE == BASE_HEXADECIMAL ? 4 : 3);
+                    const uint8_t mask = static_cast<uint8_t>((1 << shift) - 1);
+                    uint64_t value = serialize;
+                    char* location = end;
 
-                value = serialize;
+                    do {
+                        const uint8_t digit = static_cast<uint8_t>(value & mask);
+                        *(--location) = static_cast<char>(digit < 10 ? ('0' + digit) : ('A' - 10 + digit));
+                        value >>= shift;
+                    } while (value != 0);
 
-                while ((divider > 0) && (loaded < maxLength)) {
-                    if (parsed >= offset) {
-                        uint8_t digit = static_cast<uint8_t>(value / divider);
-                        if ((BASETYPE != BASE_HEXADECIMAL) || (digit < 10)) {
-                            stream[loaded++] = static_cast<char>('0' + digit);
-                        } else {
-                            stream[loaded++] = static_cast<char>('A' - 10 + digit);
-                        }
-                        offset++;
-                    }
-                    parsed++;
-                    value %= divider;
-                    divider /= BASETYPE;
+                    start = location;
                 }
 
+                const uint16_t position = offset - 4;
+                const uint16_t length = static_cast<uint16_t>(end - start);
+                const uint16_t loaded = std::min(static_cast<uint16_t>(length - position), maxLength);
+
+                ::memcpy(stream, &(start[position]), loaded);
+                offset += loaded;
+
                 if ((BASETYPE == BASE_DECIMAL) && (loaded < maxLength)) {
                     offset = 0;
                 }
@@ -824,12 +837,13 @@ namespace Core {
 
             uint16_t Convert(char stream[], const uint16_t maxLength, uint16_t& offset, const TemplateIntToType<false>& /* For compile time diffrentiation */) const
             {
-                return (Convert(stream, maxLength, offset, _value));
+                return (Convert(stream, maxLength, offset, static_cast<uint64_t>(_value)));
             }
 
             uint16_t Convert(char stream[], const uint16_t maxLength, uint16_t& offset, const TemplateIntToType<true>& /* For c ompile time diffrentiation */) const
             {
-                return (Convert(stream, maxLength, offset, ::abs(_value)));
+                // Negate in the unsigned domain, the magnitude of the minimum value does not fit the type.
+                return (Convert(stream, maxLength, offset, (_value < 0 ? (0 - static_cast<uint64_t>(_value)) : static_cast<uint64_t>(_value))));
             }
 
             uint16_t Convert(uint8_t stream[], const uint16_t maxLength, uint16_t& offset, const TemplateIntToType<false>& /* For compile time diffrentiation */) const
@@ -945,6 +959,357 @@ namespace Core {
         typedef NumberType<uint64_t, false, BASE_OCTAL> OctUInt64;
         typedef NumberType<int64_t, true, BASE_OCTAL> OctSInt64;
 
+        template <typename TYPE>
+        class FloatType : public IElement, public IMessagePack {
+        private:
+            static_assert(std::is_floating_point<TYPE>::value == true, "FloatType only supports float and double");
+
+            enum modes {
+                QUOTED = 0x001,
+                NEGATIVE = 0x002,
+                FRACTION = 0x004,
+                EXPONENT = 0x008,
+                EXPONENT_NEGATIVE = 0x010,
+                DIGITS = 0x020,
+                EXPONENT_DIGITS = 0x040,
+                UNDEFINED = 0x080,
+                ERROR = 0x100,
+                SET = 0x200
+            };
+
+            // Longest text: sign, 17 digits, dot, exponent and a terminating zero.
+            static constexpr uint8_t MaxTextLength = 32;
+            static constexpr uint8_t MaxDigits = 19;
+            static constexpr uint32_t MaxExponent = 99999;
+
+        public:
+            FloatType()
+                : _set(0)
+                , _value(0)
+                , _default(0)
+                , _mantissa(0)
+                , _exponent(0)
+                , _scale(0)
+                , _digits(0)
+            {
+            }
+
+            FloatType(const TYPE value, const bool set = false)
+                : _set(set ? SET : 0)
+                , _value(value)
+                , _default(value)
+                , _mantissa(0)
+                , _exponent(0)
+                , _scale(0)
+                , _digits(0)
+            {
+            }
+
+            FloatType(const FloatType<TYPE>& copy)
+                : _set(copy._set)
+                , _value(copy._value)
+                , _default(copy._default)
+                , _mantissa(0)
+                , _exponent(0)
+                , _scale(0)
+                , _digits(0)
+            {
+            }
+
+            ~FloatType() override
+            {
+            }
+
+            FloatType<TYPE>& operator=(const FloatType<TYPE>& RHS)
+            {
+                _value = RHS._value;
+                _set = RHS._set;
+
+                return (*this);
+            }
+
+            FloatType<TYPE>& operator=(const TYPE& RHS)
+            {
+                _value = RHS;
+                _set = SET;
+
+                return (*this);
+            }
+
+            inline TYPE Default() const
+            {
+                return _default;
+            }
+
+            inline TYPE Value() const
+            {
+                return ((_set & SET) != 0 ? _value : _default);
+            }
+
+            inline operator TYPE() const
+            {
+                return Value();
+            }
+
+            void Null(const bool enabled)
+            {
+                if (enabled == true)
+                    _set |= UNDEFINED;
+                else
+                    _set &= ~UNDEFINED;
+            }
+
+            // IElement and IMessagePack iface:
+            bool IsSet() const override
+            {
+                return ((_set & (SET | UNDEFINED)) != 0);
+            }
+
+            bool IsNull() const override
+            {
+                return ((_set & UNDEFINED) != 0);
+            }
+
+            void Clear() override
+            {
+                _set = 0;
+                _value = 0;
+            }
+
+        private:
+            // IElement iface:
+            uint16_t Serialize(char stream[], const uint16_t maxLength, uint16_t& offset) const override
+            {
+                char buffer[MaxTextLength];
+                uint8_t length;
+
+                ASSERT(maxLength > 0);
+
+                // JSON has no notation for infinity and NaN, they go out as null.
+                if (((_set & UNDEFINED) != 0) || (std::isfinite(_value) == false)) {
+                    length = 4;
+                    ::memcpy(buffer, IElement::NullTag, length);
+                } else {
+                    length = Core::FormatFloat(static_cast<double>(_value), (sizeof(TYPE) == sizeof(float)), buffer, sizeof(buffer));
+                }
+
+                ASSERT(length > offset);
+
+                const uint16_t loaded = std::min(static_cast<uint16_t>(length - offset), maxLength);
+
+                ::memcpy(stream, &(buffer[offset]), loaded);
+                offset = ((offset + loaded) < length ? (offset + loaded) : 0);
+
+                return (loaded);
+            }
+
+            uint16_t Deserialize(const char stream[], const uint16_t maxLength, uint16_t& offset, Core::OptionalType<Error>& error) override
+            {
+                uint16_t loaded = 0;
+                bool completed = false;
+
+                if (offset == 0) {
+                    _set = 0;
+                    _mantissa = 0;
+                    _exponent = 0;
+                    _scale = 0;
+                    _digits = 0;
+                    offset = 1;
+
+                    if (maxLength > 0) {
+                        if (stream[0] == '\"') {
+                            _set = QUOTED;
+                            loaded++;
+                        } else if (stream[0] == 'n') {
+                            _set = UNDEFINED;
+                        }
+                    }
+                }
+
+                while ((loaded < maxLength) && (completed == false)) {
+                    const TCHAR current = stream[loaded];
+                    const uint8_t digit = static_cast<uint8_t>(current - '0');
+
+                    if ((_set & UNDEFINED) != 0) {
+                        if (current != IElement::NullTag[offset - 1]) {
+                            _set |= ERROR;
+                        } else {
+                            loaded++;
+                            completed = (++offset == 5);
+                        }
+                    } else if (digit < 10) {
+                        if ((_set & EXPONENT) != 0) {
+                            _exponent = (_exponent < MaxExponent ? ((_exponent * 10) + digit) : _exponent);
+                            _set |= EXPONENT_DIGITS;
+                        } else {
+                            if (_digits < MaxDigits) {
+                                // Leading zeros do not count, the mantissa has room for 19 significant digits.
+                                _mantissa = (_mantissa * 10) + digit;
+                                _digits += (_mantissa != 0 ? 1 : 0);
+                                _scale -= ((_set & FRACTION) != 0 ? 1 : 0);
+                            } else {
+                                // Beyond what a double can tell apart, only the magnitude still matters.
+                                _scale += ((_set & FRACTION) == 0 ? 1 : 0);
+                            }
+                            _set |= DIGITS;
+                        }
+                        loaded++;
+                    } else if ((current == '-') && ((_set & (DIGITS | NEGATIVE | FRACTION | EXPONENT)) == 0)) {
+                        _set |= NEGATIVE;
+                        loaded++;
+                    } else if (((current == '-') || (current == '+')) && ((_set & (EXPONENT | EXPONENT_DIGITS | EXPONENT_NEGATIVE)) == EXPONENT)) {
+                        _set |= (current == '-' ? EXPONENT_NEGATIVE : 0);
+                        loaded++;
+                    } else if ((current == '.') && ((_set & (FRACTION | EXPONENT)) == 0)) {
+                        _set |= FRACTION;
+                        loaded++;
+                    } else if (((current == 'e') || (current == 'E')) && ((_set & (DIGITS | EXPONENT)) == DIGITS)) {
+                        _set |= EXPONENT;
+                        loaded++;
+                    } else if ((_set & QUOTED) != 0) {
+                        if (current == '\"') {
+                            completed = true;
+                            loaded++;
+                        } else {
+                            _set |= ERROR;
+                        }
+                    } else if ((::isspace(current)) || (current == '\0') || (current == ',') || (current == '}') || (current == ']')) {
+                        completed = true;
+                    } else {
+                        _set |= ERROR;
+                    }
+
+                    if ((_set & ERROR) != 0) {
+                        error = Error{ "Unsupported character \"" + std::string(1, current) + "\" in a number" };
+                        loaded++;
+                        completed = true;
+                    }
+                }
+
+                if (completed == true) {
+                    if ((_set & ERROR) != 0) {
+                        // Skip the remainder of a quoted value, to stay in sync with the stream.
+                        while (((_set & QUOTED) != 0) && (loaded < maxLength) && (stream[loaded - 1] != '\"')) {
+                            loaded++;
+                        }
+                        _set = ERROR;
+                    } else if ((_set & UNDEFINED) == 0) {
+                        if (((_set & DIGITS) == 0) || ((_set & (EXPONENT | EXPONENT_DIGITS)) == EXPONENT)) {
+                            error = Error{ "Incomplete number" };
+                            _set = ERROR;
+                        } else {
+                            const int32_t exponent = _scale + ((_set & EXPONENT_NEGATIVE) != 0 ? -static_cast<int32_t>(_exponent) : static_cast<int32_t>(_exponent));
+                            const TYPE value = static_cast<TYPE>(Core::ComposeFloat(_mantissa, exponent, (sizeof(TYPE) == sizeof(float))));
+
+                            _value = ((_set & NEGATIVE) != 0 ? -value : value);
+                            _set = SET;
+                        }
+                    }
+                    offset = 0;
+                }
+
+                return (loaded);
+            }
+
+            // IMessagePack iface:
+            uint16_t Serialize(uint8_t stream[], const uint16_t maxLength, uint16_t& offset) const override
+            {
+                uint8_t buffer[1 + sizeof(TYPE)];
+                uint8_t length = 1;
+
+                if ((_set & UNDEFINED) != 0) {
+                    buffer[0] = IMessagePack::NullValue;
+                } else {
+                    typename std::conditional<sizeof(TYPE) == sizeof(float), uint32_t, uint64_t>::type bits;
+
+                    static_assert(sizeof(bits) == sizeof(TYPE), "Float and double are expected to be IEEE-754");
+
+                    ::memcpy(&bits, &_value, sizeof(bits));
+
+                    buffer[0] = (sizeof(TYPE) == sizeof(float) ? 0xCA : 0xCB);
+                    for (uint8_t index = sizeof(bits); index > 0; index--) {
+                        buffer[length++] = static_cast<uint8_t>(bits >> (8 * (index - 1)));
+                    }
+                }
+
+                const uint16_t loaded = std::min(static_cast<uint16_t>(length - offset), maxLength);
+
+                ::memcpy(stream, &(buffer[offset]), loaded);
+                offset = ((offset + loaded) < length ? (offset + loaded) : 0);
+
+                return (loaded);
+            }
+
+            uint16_t Deserialize(const uint8_t stream[], const uint16_t maxLength, uint16_t& offset) override
+            {
+                uint16_t loaded = 0;
+
+                if ((offset == 0) && (maxLength > 0)) {
+                    // The header is kept in _exponent, the bytes are collected in _mantissa.
+                    const uint8_t header = stream[loaded++];
+
+                    _set = 0;
+                    _mantissa = 0;
+                    _exponent = header;
+
+                    if (header == IMessagePack::NullValue) {
+                        _set = UNDEFINED;
+                    } else if ((header == 0xCA) || (header == 0xCB)) {
+                        offset = (header == 0xCA ? 4 : 8);
+                    } else if ((header >= 0xCC) && (header <= 0xCF)) {
+                        offset = (1 << (header - 0xCC));
+                    } else if ((header >= 0xD0) && (header <= 0xD3)) {
+                        offset = (1 << (header - 0xD0));
+                    } else if (((header & 0x80) == 0) || ((header & 0xE0) == 0xE0)) {
+                        _value = static_cast<TYPE>(static_cast<int8_t>(header));
+                        _set = SET;
+                    } else {
+                        _set = ERROR;
+                    }
+                }
+
+                while ((loaded < maxLength) && (offset != 0)) {
+                    _mantissa = (_mantissa << 8) | stream[loaded++];
+
+                    if (--offset == 0) {
+                        if (_exponent == 0xCA) {
+                            const uint32_t bits = static_cast<uint32_t>(_mantissa);
+                            float value;
+                            ::memcpy(&value, &bits, sizeof(value));
+                            _value = static_cast<TYPE>(value);
+                        } else if (_exponent == 0xCB) {
+                            double value;
+                            ::memcpy(&value, &_mantissa, sizeof(value));
+                            _value = static_cast<TYPE>(value);
+                        } else if (_exponent <= 0xCF) {
+                            _value = static_cast<TYPE>(_mantissa);
+                        } else {
+                            // Sign extend the signed integer of 1, 2, 4 or 8 bytes.
+                            const uint8_t shift = static_cast<uint8_t>(64 - (8 << (_exponent - 0xD0)));
+                            _value = static_cast<TYPE>(static_cast<int64_t>(_mantissa << shift) >> shift);
+                        }
+                        _set = SET;
+                    }
+                }
+
+                return (loaded);
+            }
+
+        private:
+            uint16_t _set;
+            TYPE _value;
+            TYPE _default;
+
+            // Deserialization state, only valid while a value is being read.
+            uint64_t _mantissa;
+            uint32_t _exponent;
+            int32_t _scale;
+            uint8_t _digits;
+        };
+
+        typedef FloatType<float> Float;
+        typedef FloatType<double> Double;
+
         class EXTERNAL Boolean : public IElement, public IMessagePack {
         private:
             static constexpr uint8_t None = 0x00;
@@ -1149,6 +1514,9 @@ namespace Core {
 
         class EXTERNAL String : public IElement, public IMessagePack {
         private:
+            friend class Reader;
+            friend class Writer;
+
             static constexpr uint32_t None = 0x00000000;
             static constexpr uint32_t ScopeMask = 0x007FFFFF;
             static constexpr uint32_t DepthCountMask = 0x0F800000;
@@ -2957,13 +3325,14 @@ namespace Core {
                     case ValueValidity::VALID:
                         loaded++;
                         _fieldName.Clear();
-                        offset = SKIP_BEFORE;
+                        // Right after the opening bracket, the only place where a closing one is fine.
+                        offset = BEGIN_MARKER;
                         break;
                     }
                 }
 
                 while ((offset != 0) && (loaded < maxLength)) {
-                    if ((offset == SKIP_BEFORE) || (offset == SKIP_AFTER) || offset == SKIP_BEFORE_VALUE || offset == SKIP_AFTER_KEY) {
+                    if ((offset == BEGIN_MARKER) || (offset == SKIP_BEFORE) || (offset == SKIP_AFTER) || offset == SKIP_BEFORE_VALUE || offset == SKIP_AFTER_KEY) {
                         // Run till we find a character not a whitespace..
                         while ((loaded < maxLength) && (::isspace(stream[loaded]))) {
                             loaded++;
@@ -2972,7 +3341,7 @@ namespace Core {
                         if (loaded < maxLength) {
                             switch (stream[loaded]) {
                             case '}':
-                                if (offset == SKIP_BEFORE && !_data.empty()) {
+                                if (offset == SKIP_BEFORE) {
                                     _state = ERROR;
                                     error = Error{ "Expected new element, \"}\" found." };
                                 } else if (offset == SKIP_BEFORE_VALUE || offset == SKIP_AFTER_KEY) {
@@ -2983,7 +3352,7 @@ namespace Core {
                                 loaded++;
                                 break;
                             case ',':
-                                if (offset == SKIP_BEFORE) {
+                                if ((offset == SKIP_BEFORE) || (offset == BEGIN_MARKER)) {
                                     _state = ERROR;
                                     error = Error{ "Expected new element \",\" found." };
                                     offset = 0;
@@ -2997,7 +3366,7 @@ namespace Core {
                                 loaded++;
                                 break;
                             case ':':
-                                if (offset == SKIP_BEFORE || offset == SKIP_BEFORE_VALUE) {
+                                if (offset == SKIP_BEFORE || offset == SKIP_BEFORE_VALUE || offset == BEGIN_MARKER) {
                                     _state = ERROR;
                                     error = Error{ "Expected " + std::string{ offset == SKIP_BEFORE_VALUE ? "value" : "new element" } + ", \":\" found." };
                                     offset = 0;
@@ -3060,6 +3429,11 @@ namespace Core {
                             skip = SKIP_AFTER_KEY;
                         } else {
                             loaded += _current.json->Deserialize(&(stream[loaded]), maxLength - loaded, offset, error);
+
+                            // The value of an unknown key lands in the key holder, do not take it for the next key.
+                            if ((offset == 0) && (_current.json == &_fieldName)) {
+                                _fieldName.Clear();
+                            }
                         }
                         offset = (offset == 0 ? skip : offset + PARSE);
                     }
@@ -3855,6 +4229,630 @@ namespace Core {
             return (result);
         }
 
+        // Compile time hash of a JSON label (FNV-1a). Used by the generated, statically dispatched
+        // parsers to switch on the key instead of walking the list of registered labels.
+        constexpr uint32_t Hash(const TCHAR label[], const uint32_t value = 0x811C9DC5)
+        {
+            return (label[0] == '\0' ? value : Hash(&(label[1]), (value ^ static_cast<uint8_t>(label[0])) * 0x01000193));
+        }
+
+        // The Reader is a non-streaming, single pass JSON scanner over a complete document. It is
+        // used by the classes the JsonGenerator emits in "static parser" mode. Whatever it does not
+        // recognize in its fast path is handed over to the reflective (IElement) parser of the
+        // element, so the results are identical to the ones of FromString(). If the document can
+        // not be handled at all, the Reader reports a failure and the caller falls back to the
+        // reflective parser for the complete document.
+        // NOTE: The length passed in should include the terminating character, just like the
+        //       IElement::FromString() does.
+        class EXTERNAL Reader {
+        private:
+            static constexpr uint8_t MaxDepth = 32;
+
+            HAS_MEMBER(FromJSON, hasFromJSON);
+
+        public:
+            Reader() = delete;
+            Reader(const Reader&) = delete;
+            Reader& operator=(const Reader&) = delete;
+
+            Reader(const TCHAR text[], const uint32_t length)
+                : _text(text)
+                , _length(length)
+                , _position(0)
+                , _depth(0)
+                , _scope(0)
+                , _error(false)
+                , _key(nullptr)
+                , _keyLength(0)
+                , _hash(0)
+                , _unescapedKey()
+            {
+            }
+            explicit Reader(const string& text)
+                : Reader(text.c_str(), static_cast<uint32_t>(text.length() + 1))
+            {
+            }
+            ~Reader()
+            {
+            }
+
+        public:
+            template <typename INSTANCEOBJECT>
+            static bool FromString(const string& text, INSTANCEOBJECT& realObject)
+            {
+                bool result = false;
+
+                realObject.Clear();
+
+                if (text.empty() == false) {
+                    Reader reader(text);
+
+                    result = realObject.FromJSON(reader);
+                }
+
+                if (result == false) {
+                    // Let the reflective parser sort it out, it also takes care of the error reporting.
+                    result = IElement::FromString(text, static_cast<IElement&>(realObject));
+                }
+
+                return (result);
+            }
+
+            inline uint32_t Position() const
+            {
+                return (_position);
+            }
+            inline bool IsValid() const
+            {
+                return (_error == false);
+            }
+            inline uint32_t Hash() const
+            {
+                return (_hash);
+            }
+            inline bool Is(const TCHAR label[]) const
+            {
+                return ((::strncmp(label, _key, _keyLength) == 0) && (label[_keyLength] == '\0'));
+            }
+
+            // Object scope handling
+            bool Begin()
+            {
+                if ((Peek() == '{') && (_depth < MaxDepth)) {
+                    _position++;
+                    _scope |= (1 << _depth);
+                    _depth++;
+                } else {
+                    _error = true;
+                }
+                return (_error == false);
+            }
+            bool Next();
+            inline bool End() const
+            {
+                return (_error == false);
+            }
+
+            // Value handling
+            bool Skip();
+
+            template <typename ELEMENT>
+            bool Value(const TCHAR label[], ELEMENT& element)
+            {
+                // Different labels can share a hash, make sure this is the one..
+                return (Is(label) == true ? Value(element) : Skip());
+            }
+
+            template <class TYPE, bool SIGNED, const NumberBase BASETYPE>
+            bool Value(NumberType<TYPE, SIGNED, BASETYPE>& element)
+            {
+                uint64_t value = 0;
+                bool negative = false;
+                bool result = false;
+
+                if (Peek() == 'n') {
+                    result = Literal(IElement::NullTag);
+                    element.Null(true);
+                } else if (Number(value, negative) == true) {
+                    if ((negative == false) || (SIGNED == true)) {
+                        element = static_cast<TYPE>(negative == false ? value : (0 - value));
+                        result = true;
+                    } else {
+                        _error = true;
+                    }
+                } else if (_error == false) {
+                    result = Reflective(element);
+                }
+
+                return (result);
+            }
+
+            bool Value(Boolean& element);
+            bool Value(String& element);
+
+            template <typename ENUMERATE>
+            bool Value(EnumType<ENUMERATE>& element)
+            {
+                bool result = false;
+
+                if (Peek() == '\"') {
+                    string text;
+                    if (Text(text) == true) {
+                        Core::EnumerateType<ENUMERATE> converted(text.c_str(), false);
+
+                        if (converted.IsSet() == true) {
+                            element = converted.Value();
+                        } else {
+                            element.Null(true);
+                        }
+                        result = true;
+                    }
+                } else {
+                    result = Reflective(element);
+                }
+
+                return (result);
+            }
+
+            template <typename ELEMENT>
+            bool Value(ArrayType<ELEMENT>& element)
+            {
+                bool result = false;
+
+                if (Peek() != '[') {
+                    result = Reflective(element);
+                } else {
+                    _position++;
+
+                    if (Peek() == ']') {
+                        _position++;
+                        result = true;
+                    } else {
+                        while ((Value(element.Add()) == true) && (Separator(']') == true)) {
+                            // Next element please..
+                        }
+                        result = (_error == false);
+                    }
+                }
+
+                return (result);
+            }
+
+            template <typename ELEMENT>
+            bool Value(ELEMENT& element)
+            {
+                return (Dispatch(element, ::TemplateIntToType<hasFromJSON<ELEMENT, bool (ELEMENT::*)(Reader&)>::value>()));
+            }
+
+        private:
+            template <typename ELEMENT>
+            bool Dispatch(ELEMENT& element, const ::TemplateIntToType<true>&)
+            {
+                return (Peek() == '{' ? element.FromJSON(*this) : Reflective(element));
+            }
+            template <typename ELEMENT>
+            bool Dispatch(ELEMENT& element, const ::TemplateIntToType<false>&)
+            {
+                return (Reflective(element));
+            }
+
+            inline TCHAR Peek()
+            {
+                while ((_position < _length) && (::isspace(_text[_position]))) {
+                    _position++;
+                }
+                return (_position < _length ? _text[_position] : '\0');
+            }
+
+            bool Reflective(IElement& element);
+            bool Separator(const TCHAR closing);
+            bool Literal(const TCHAR literal[]);
+            bool Number(uint64_t& value, bool& negative);
+            bool Text(string& value);
+
+        private:
+            const TCHAR* _text;
+            const uint32_t _length;
+            uint32_t _position;
+            uint8_t _depth;
+            uint32_t _scope;
+            bool _error;
+            const TCHAR* _key;
+            uint32_t _keyLength;
+            uint32_t _hash;
+            string _unescapedKey;
+        };
+
+        // The Writer is the counterpart of the Reader. It appends a complete JSON document to a
+        // string in one go. Elements without a specialized path are serialized by their reflective
+        // (IElement) implementation, so the output is identical to the one of ToString().
+        class EXTERNAL Writer {
+        private:
+            HAS_MEMBER(ToJSON, hasToJSON);
+
+        public:
+            Writer() = delete;
+            Writer(const Writer&) = delete;
+            Writer& operator=(const Writer&) = delete;
+
+            explicit Writer(string& text)
+                : _text(text)
+            {
+            }
+            ~Writer()
+            {
+            }
+
+        public:
+            template <typename INSTANCEOBJECT>
+            static bool ToString(const INSTANCEOBJECT& realObject, string& text)
+            {
+                Writer writer(text);
+
+                text.clear();
+                realObject.ToJSON(writer);
+
+                return (true);
+            }
+
+            // Object scope handling
+            inline void Begin()
+            {
+                Separator();
+                _text += '{';
+            }
+            inline void End()
+            {
+                _text += '}';
+            }
+
+            // Value handling
+            template <typename ELEMENT>
+            void Value(const TCHAR label[], const ELEMENT& element)
+            {
+                if (element.IsSet() == true) {
+                    Separator();
+                    _text += '\"';
+                    _text += label;
+                    _text += _T("\":");
+                    Value(element);
+                }
+            }
+
+            template <class TYPE, bool SIGNED, const NumberBase BASETYPE>
+            void Value(const NumberType<TYPE, SIGNED, BASETYPE>& element)
+            {
+                Separator();
+
+                if (element.IsNull() == true) {
+                    _text += IElement::NullTag;
+                } else {
+                    const TYPE value = element.Value();
+                    const bool negative = ((SIGNED == true) && (value < 0));
+                    const uint64_t absolute = (negative == true ? (0 - static_cast<uint64_t>(value)) : static_cast<uint64_t>(value));
+
+                    if (BASETYPE == BASE_DECIMAL) {
+                        if (negative == true) {
+                            _text += '-';
+                        }
+                        Number(absolute, BASE_DECIMAL);
+                    } else {
+                        _text += '\"';
+                        if (negative == true) {
+                            _text += '-';
+                        }
+                        _text += (BASETYPE == BASE_HEXADECIMAL ? _T("0x") : _T("0"));
+                        Number(absolute, BASETYPE);
+                        _text += '\"';
+                    }
+                }
+            }
+
+            template <typename TYPE>
+            void Value(const FloatType<TYPE>& element)
+            {
+                const TYPE value = element.Value();
+
+                Separator();
+
+                if ((element.IsNull() == true) || (std::isfinite(value) == false)) {
+                    _text += IElement::NullTag;
+                } else {
+                    TCHAR buffer[32];
+                    _text.append(buffer, Core::FormatFloat(static_cast<double>(value), (sizeof(TYPE) == sizeof(float)), buffer, sizeof(buffer)));
+                }
+            }
+
+            void Value(const Boolean& element);
+            void Value(const String& element);
+
+            template <typename ENUMERATE>
+            void Value(const EnumType<ENUMERATE>& element)
+            {
+                const TCHAR* text = (element.IsNull() == true ? nullptr : element.Data());
+
+                Separator();
+
+                if (text == nullptr) {
+                    _text += IElement::NullTag;
+                } else {
+                    Text(text, static_cast<uint32_t>(::strlen(text)));
+                }
+            }
+
+            template <typename ELEMENT>
+            void Value(const ArrayType<ELEMENT>& element)
+            {
+                typename ArrayType<ELEMENT>::ConstIterator index(element.Elements());
+
+                Separator();
+                _text += '[';
+                while (index.Next() == true) {
+                    Value(index.Current());
+                }
+                _text += ']';
+            }
+
+            template <typename ELEMENT>
+            void Value(const ELEMENT& element)
+            {
+                Dispatch(element, ::TemplateIntToType<hasToJSON<ELEMENT, void (ELEMENT::*)(Writer&) const>::value>());
+            }
+
+        private:
+            template <typename ELEMENT>
+            void Dispatch(const ELEMENT& element, const ::TemplateIntToType<true>&)
+            {
+                element.ToJSON(*this);
+            }
+            template <typename ELEMENT>
+            void Dispatch(const ELEMENT& element, const ::TemplateIntToType<false>&)
+            {
+                Separator();
+                Reflective(element);
+            }
+
+            inline void Separator()
+            {
+                if (_text.empty() == false) {
+                    const TCHAR last = _text[_text.length() - 1];
+                    if ((last != '{') && (last != '[') && (last != ':')) {
+                        _text += ',';
+                    }
+                }
+            }
+
+            void Reflective(const IElement& element);
+            void Number(uint64_t value, const uint8_t base);
+            void Text(const TCHAR text[], const uint32_t length);
+
+        private:
+            string& _text;
+        };
+
+        // Helpers to (de)compose MessagePack encoded values as a whole, used where JSON values
+        // that are kept as opaque text (e.g. JSONRPC parameters) have to travel over a binary
+        // channel. Readers return the number of bytes consumed, 0 if the stream does not hold
+        // (enough of) the requested type.
+        class EXTERNAL MessagePack {
+        public:
+            static constexpr uint8_t MaxDepth = 32;
+
+            MessagePack() = delete;
+            MessagePack(const MessagePack&) = delete;
+            MessagePack& operator=(const MessagePack&) = delete;
+
+        public:
+            // Size of the complete value at the start of the stream, 0 if more data is needed.
+            static uint32_t Length(const uint8_t stream[], const uint32_t length);
+
+            // Transcoding of a complete value from/to its JSON text representation.
+            static uint32_t ToJSON(const uint8_t stream[], const uint32_t length, string& text);
+            static bool FromJSON(const string& text, std::vector<uint8_t>& stream);
+
+            static void Nil(std::vector<uint8_t>& stream)
+            {
+                stream.push_back(static_cast<uint8_t>(IMessagePack::NullValue));
+            }
+            static void Map(std::vector<uint8_t>& stream, const uint32_t count);
+            static void Array(std::vector<uint8_t>& stream, const uint32_t count);
+            static void Text(std::vector<uint8_t>& stream, const string& value);
+            static void Number(std::vector<uint8_t>& stream, const int64_t value);
+
+            static uint32_t Map(const uint8_t stream[], const uint32_t length, uint32_t& count);
+            static uint32_t Array(const uint8_t stream[], const uint32_t length, uint32_t& count);
+            static uint32_t Text(const uint8_t stream[], const uint32_t length, string& value);
+            static uint32_t Number(const uint8_t stream[], const uint32_t length, int64_t& value);
+
+        private:
+            static uint32_t Length(const uint8_t stream[], const uint32_t length, const uint8_t depth);
+            static uint32_t ToJSON(const uint8_t stream[], const uint32_t length, string& text, const uint8_t depth);
+            static bool FromJSON(const TCHAR text[], const uint32_t length, uint32_t& position, std::vector<uint8_t>& stream, const uint8_t depth);
+            static void Append(std::vector<uint8_t>& stream, const uint8_t code, const uint64_t value, const uint8_t bytes);
+        };
+
+        // A read-only DOM for dynamic payloads. The text is parsed once into a tree of nodes that
+        // live in an arena owned by the Document, so there is no allocation per key or value and
+        // everything is released in one go by Clear() or the destructor. Strings without escapes
+        // refer to the text directly, which is why the text must outlive the Document when it is
+        // loaded through FromBuffer(). FromString() keeps a copy of the text in the arena instead.
+        class EXTERNAL Document {
+        private:
+            class EXTERNAL Arena {
+            private:
+                struct Block {
+                    Block* _next;
+                    uint32_t _size;
+                };
+
+            public:
+                Arena() = delete;
+                Arena(const Arena&) = delete;
+                Arena& operator=(const Arena&) = delete;
+
+                explicit Arena(const uint32_t blockSize);
+                ~Arena();
+
+            public:
+                void* Allocate(const uint32_t size);
+                void Reset();
+
+            private:
+                Block* Create(const uint32_t size);
+
+            private:
+                const uint32_t _blockSize;
+                Block* _blocks;
+                uint8_t* _position;
+                uint8_t* _end;
+            };
+
+        public:
+            static constexpr uint8_t MaxDepth = 64;
+            static constexpr uint32_t DefaultBlockSize = 4096;
+
+            class EXTERNAL Node {
+            public:
+                typedef Variant::type type;
+
+            public:
+                Node(const Node&) = delete;
+                Node& operator=(const Node&) = delete;
+
+                Node()
+                    : _type(type::EMPTY)
+                    , _length(0)
+                    , _text(nullptr)
+                    , _label(nullptr)
+                    , _labelLength(0)
+                    , _child(nullptr)
+                    , _next(nullptr)
+                {
+                }
+                ~Node() = default;
+
+            public:
+                inline type Content() const
+                {
+                    return (_type);
+                }
+                inline bool IsNull() const
+                {
+                    return (_type == type::EMPTY);
+                }
+                inline bool Boolean() const
+                {
+                    return ((_type == type::BOOLEAN) && (_text[0] == 't'));
+                }
+                inline TextFragment Label() const
+                {
+                    return (TextFragment(_label, _labelLength));
+                }
+                // The raw text of numbers and booleans, the unescaped text of strings.
+                inline TextFragment Text() const
+                {
+                    return (((_type == type::ARRAY) || (_type == type::OBJECT)) ? TextFragment() : TextFragment(_text, _length));
+                }
+                inline string String() const
+                {
+                    return (_type == type::STRING ? string(_text, _length) : string());
+                }
+                // Number of members of an object, elements of an array.
+                inline uint32_t Elements() const
+                {
+                    return (((_type == type::ARRAY) || (_type == type::OBJECT)) ? _length : 0);
+                }
+                inline const Node* First() const
+                {
+                    return (_child);
+                }
+                inline const Node* Next() const
+                {
+                    return (_next);
+                }
+
+                int64_t Number() const;
+                double Float() const;
+
+                // Lookups return a null node if the member/element does not exist.
+                const Node& operator[](const TCHAR label[]) const;
+                const Node& Get(const uint32_t index) const;
+
+                void ToString(string& text) const;
+
+            private:
+                friend class Document;
+
+                type _type;
+                uint32_t _length;
+                const TCHAR* _text;
+                const TCHAR* _label;
+                uint32_t _labelLength;
+                Node* _child;
+                Node* _next;
+            };
+
+        public:
+            Document(const Document&) = delete;
+            Document& operator=(const Document&) = delete;
+
+            Document()
+                : Document(DefaultBlockSize)
+            {
+            }
+            explicit Document(const uint32_t blockSize)
+                : _arena(blockSize)
+                , _root(nullptr)
+            {
+            }
+            ~Document() = default;
+
+        public:
+            bool FromString(const string& text)
+            {
+                return (FromString(text.c_str(), static_cast<uint32_t>(text.length())));
+            }
+            bool FromString(const TCHAR text[], const uint32_t length);
+            bool FromBuffer(const TCHAR text[], const uint32_t length);
+
+            void ToString(string& text) const
+            {
+                Root().ToString(text);
+            }
+
+            // The root is a null node until a text is parsed successfully.
+            inline const Node& Root() const
+            {
+                return (_root != nullptr ? *_root : NullNode());
+            }
+            inline const Node& operator[](const TCHAR label[]) const
+            {
+                return (Root()[label]);
+            }
+            inline bool IsValid() const
+            {
+                return (_root != nullptr);
+            }
+
+            // Drops all nodes at once, the first block of the arena is kept for reuse.
+            void Clear()
+            {
+                _arena.Reset();
+                _root = nullptr;
+            }
+
+            static const Node& NullNode();
+
+        private:
+            bool Load(const TCHAR text[], const uint32_t length);
+            Node* Parse(const TCHAR text[], const uint32_t length, uint32_t& position, const uint8_t depth);
+            bool Parse(const TCHAR text[], const uint32_t length, uint32_t& position, const TCHAR*& value, uint32_t& size);
+
+        private:
+            Arena _arena;
+            Node* _root;
+        };
+
         template <uint16_t SIZE, typename INSTANCEOBJECT>
         class Tester {
         private:
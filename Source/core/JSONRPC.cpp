@@ -26,6 +26,711 @@ namespace Core {
     namespace JSONRPC {
 
         /* static */ constexpr TCHAR Message::DefaultVersion[];
+        /* static */ Core::ProxyPoolType<Message> Batch::_messageFactory(8);
+
+        static void PackValue(const Core::JSON::String& value, std::vector<uint8_t>& stream)
+        {
+            if ((value.IsNull() == true) || (Core::JSON::MessagePack::FromJSON(value.Value(), stream) == false)) {
+                // Not valid JSON (or nothing at all), pass it on as is.
+                if (value.IsNull() == true) {
+                    Core::JSON::MessagePack::Nil(stream);
+                } else {
+                    Core::JSON::MessagePack::Text(stream, value.Value());
+                }
+            }
+        }
+
+        static uint32_t UnpackValue(const uint8_t stream[], const uint32_t length, Core::JSON::String& value)
+        {
+            uint32_t loaded = 0;
+
+            if ((length > 0) && (stream[0] == Core::JSON::IMessagePack::NullValue)) {
+                value.Null(true);
+                loaded = 1;
+            } else {
+                string text;
+                loaded = Core::JSON::MessagePack::ToJSON(stream, length, text);
+                if (loaded != 0) {
+                    value = text;
+                }
+            }
+
+            return (loaded);
+        }
+
+        static constexpr TCHAR NotificationHead[] = _T("{\"jsonrpc\":\"2.0\",\"method\":\"");
+
+        struct Fragment {
+            const uint8_t* data;
+            uint32_t length;
+        };
+
+        // Copies what fits of the concatenated fragments, continuing where the previous call stopped.
+        static uint16_t Fragments(uint8_t stream[], const uint16_t maxLength, uint32_t& position, uint16_t& offset, const std::initializer_list<Fragment>& fragments)
+        {
+            uint16_t loaded = 0;
+            uint32_t start = 0;
+
+            for (const Fragment& fragment : fragments) {
+                if ((position < (start + fragment.length)) && (loaded < maxLength)) {
+                    const uint32_t skip = position - start;
+                    const uint16_t size = static_cast<uint16_t>(std::min(static_cast<uint32_t>(maxLength - loaded), fragment.length - skip));
+
+                    ::memcpy(&(stream[loaded]), &(fragment.data[skip]), size);
+                    loaded += size;
+                    position += size;
+                }
+                start += fragment.length;
+            }
+
+            // As with the Message, the offset only signals that we are not done yet.
+            offset = (position < start ? 1 : 0);
+
+            return (loaded);
+        }
+
+        static bool NeedsEscaping(const string& text)
+        {
+            bool result = false;
+
+            for (string::const_iterator index = text.cbegin(); (result == false) && (index != text.cend()); index++) {
+                const uint8_t current = static_cast<uint8_t>(*index);
+
+                result = ((current == '\"') || (current == '\\') || (current < 0x20));
+            }
+
+            return (result);
+        }
+
+        static string Escape(const string& text)
+        {
+            static constexpr TCHAR digits[] = "0123456789ABCDEF";
+
+            string result;
+
+            result.reserve(text.length() + 2);
+
+            for (const TCHAR entry : text) {
+                const uint8_t current = static_cast<uint8_t>(entry);
+
+                if ((current == '\"') || (current == '\\')) {
+                    result += '\\';
+                    result += entry;
+                } else if (current == '\n') {
+                    result += _T("\\n");
+                } else if (current == '\r') {
+                    result += _T("\\r");
+                } else if (current == '\t') {
+                    result += _T("\\t");
+                } else if (current < 0x20) {
+                    result += _T("\\u00");
+                    result += digits[current >> 4];
+                    result += digits[current & 0x0F];
+                } else {
+                    result += entry;
+                }
+            }
+
+            return (result);
+        }
+
+        Notification::Frame::Frame(const string& event, const string& parameters)
+            : _event(event)
+            , _parameters(parameters)
+            , _text()
+            , _adminLock()
+            , _packed()
+            , _split(0)
+        {
+            _text.reserve(event.length() + parameters.length() + 14);
+
+            _text = (NeedsEscaping(event) ? Escape(event) : event);
+            _text += '\"';
+
+            if (parameters.empty() == false) {
+                _text += _T(",\"params\":");
+                _text += parameters;
+            }
+
+            _text += '}';
+        }
+
+        const std::vector<uint8_t>& Notification::Frame::Packed(uint32_t& split) const
+        {
+            _adminLock.Lock();
+
+            if (_packed.empty() == true) {
+                Core::JSON::MessagePack::Map(_packed, (_parameters.empty() ? 2 : 3));
+                Core::JSON::MessagePack::Text(_packed, _T("jsonrpc"));
+                Core::JSON::MessagePack::Text(_packed, Message::DefaultVersion);
+                Core::JSON::MessagePack::Text(_packed, _T("method"));
+
+                _split = static_cast<uint32_t>(_packed.size());
+
+                if (_parameters.empty() == false) {
+                    Core::JSON::MessagePack::Text(_packed, _T("params"));
+
+                    if (Core::JSON::MessagePack::FromJSON(_parameters, _packed) == false) {
+                        // Not valid JSON, pass it on as is.
+                        Core::JSON::MessagePack::Text(_packed, _parameters);
+                    }
+                }
+            }
+
+            split = _split;
+
+            _adminLock.Unlock();
+
+            return (_packed);
+        }
+
+        uint16_t Notification::Serialize(char stream[], const uint16_t maxLength, uint16_t& offset) const
+        {
+            ASSERT(_frame.IsValid() == true);
+
+            if (offset == 0) {
+                _position = 0;
+
+                if (NeedsEscaping(_designator) == true) {
+                    _escaped = Escape(_designator);
+                }
+            }
+
+            const string& designator(_escaped.empty() ? _designator : _escaped);
+            const string& text(_frame->Text());
+
+            return (Fragments(reinterpret_cast<uint8_t*>(stream), maxLength, _position, offset,
+                { { reinterpret_cast<const uint8_t*>(NotificationHead), static_cast<uint32_t>(sizeof(NotificationHead) - sizeof(TCHAR)) },
+                    { reinterpret_cast<const uint8_t*>(designator.c_str()), static_cast<uint32_t>(designator.length()) },
+                    { reinterpret_cast<const uint8_t*>("."), (designator.empty() ? 0u : 1u) },
+                    { reinterpret_cast<const uint8_t*>(text.c_str()), static_cast<uint32_t>(text.length()) } }));
+        }
+
+        uint16_t Notification::Deserialize(const char[], const uint16_t, uint16_t& offset, Core::OptionalType<Core::JSON::Error>& error)
+        {
+            error = Core::JSON::Error{ "Notifications can only be sent." };
+            offset = 0;
+
+            return (0);
+        }
+
+        uint16_t Notification::Serialize(uint8_t stream[], const uint16_t maxLength, uint16_t& offset) const
+        {
+            ASSERT(_frame.IsValid() == true);
+
+            uint32_t split;
+            const std::vector<uint8_t>& packed(_frame->Packed(split));
+            const string& event(_frame->Event());
+
+            if (offset == 0) {
+                const uint32_t length = static_cast<uint32_t>(_designator.length() + (_designator.empty() ? 0 : 1) + event.length());
+
+                _position = 0;
+
+                if (length <= 31) {
+                    _header[0] = static_cast<uint8_t>(0xA0 | length);
+                    _headerLength = 1;
+                } else if (length <= 0xFF) {
+                    _header[0] = 0xD9;
+                    _header[1] = static_cast<uint8_t>(length);
+                    _headerLength = 2;
+                } else if (length <= 0xFFFF) {
+                    _header[0] = 0xDA;
+                    _header[1] = static_cast<uint8_t>(length >> 8);
+                    _header[2] = static_cast<uint8_t>(length);
+                    _headerLength = 3;
+                } else {
+                    _header[0] = 0xDB;
+                    _header[1] = static_cast<uint8_t>(length >> 24);
+                    _header[2] = static_cast<uint8_t>(length >> 16);
+                    _header[3] = static_cast<uint8_t>(length >> 8);
+                    _header[4] = static_cast<uint8_t>(length);
+                    _headerLength = 5;
+                }
+            }
+
+            return (Fragments(stream, maxLength, _position, offset,
+                { { packed.data(), split },
+                    { _header, _headerLength },
+                    { reinterpret_cast<const uint8_t*>(_designator.c_str()), static_cast<uint32_t>(_designator.length()) },
+                    { reinterpret_cast<const uint8_t*>("."), (_designator.empty() ? 0u : 1u) },
+                    { reinterpret_cast<const uint8_t*>(event.c_str()), static_cast<uint32_t>(event.length()) },
+                    { &(packed.data()[split]), static_cast<uint32_t>(packed.size() - split) } }));
+        }
+
+        uint16_t Notification::Deserialize(const uint8_t[], const uint16_t, uint16_t& offset)
+        {
+            ASSERT(false);
+
+            offset = 0;
+
+            return (0);
+        }
+
+        uint16_t Batch::Serialize(char stream[], const uint16_t maxLength, uint16_t& offset) const
+        {
+            uint16_t loaded = 0;
+
+            if (offset == 0) {
+                _index = 0;
+                _offset = 0;
+                _state = ELEMENT;
+                stream[loaded++] = '[';
+                offset = 1;
+            }
+
+            while ((offset != 0) && (loaded < maxLength)) {
+                if (_index >= _messages.size()) {
+                    stream[loaded++] = ']';
+                    offset = 0;
+                } else if (_state == SEPARATOR) {
+                    stream[loaded++] = ',';
+                    _state = ELEMENT;
+                } else {
+                    const Core::JSON::IElement& element(*(_messages[_index]));
+
+                    loaded += element.Serialize(&(stream[loaded]), maxLength - loaded, _offset);
+
+                    if (_offset == 0) {
+                        _index++;
+                        _state = SEPARATOR;
+                    }
+                }
+            }
+
+            return (loaded);
+        }
+
+        uint16_t Batch::Deserialize(const char stream[], const uint16_t maxLength, uint16_t& offset, Core::OptionalType<Core::JSON::Error>& error)
+        {
+            uint16_t loaded = 0;
+
+            if (offset == 0) {
+                Clear();
+                _oversized = false;
+
+                while ((loaded < maxLength) && (::isspace(stream[loaded]))) {
+                    loaded++;
+                }
+
+                if (loaded < maxLength) {
+                    if (stream[loaded] != '[') {
+                        error = Core::JSON::Error{ "Invalid batch, \"[\" expected." };
+                    } else {
+                        offset = 1;
+                    }
+                    loaded++;
+                }
+            }
+
+            while ((offset != 0) && (loaded < maxLength) && (error.IsSet() == false)) {
+                if (_state == SKIP) {
+                    // Too many requests, only look for the end of the batch, nothing is kept.
+                    const TCHAR character = stream[loaded++];
+
+                    if (_quoted == true) {
+                        if (_escaped == true) {
+                            _escaped = false;
+                        } else if (character == '\\') {
+                            _escaped = true;
+                        } else if (character == '"') {
+                            _quoted = false;
+                        }
+                    } else if (character == '"') {
+                        _quoted = true;
+                    } else if ((character == '{') || (character == '[')) {
+                        _depth++;
+                    } else if (((character == '}') || (character == ']')) && (--_depth == 0)) {
+                        offset = 0;
+                        _state = OPEN;
+                        _oversized = true;
+                    }
+                } else if (_state == ELEMENT) {
+                    Core::JSON::IElement& element(*(_messages.back()));
+
+                    loaded += element.Deserialize(&(stream[loaded]), maxLength - loaded, _offset, error);
+
+                    if (_offset == 0) {
+                        _state = NEXT;
+                    }
+                } else if (::isspace(stream[loaded])) {
+                    loaded++;
+                } else if ((stream[loaded] == ']') && (_state != SEPARATOR)) {
+                    loaded++;
+                    offset = 0;
+                } else if (_state == NEXT) {
+                    if (stream[loaded] == ',') {
+                        _state = SEPARATOR;
+                    } else {
+                        error = Core::JSON::Error{ "Invalid batch, \",\" or \"]\" expected." };
+                    }
+                    loaded++;
+                } else if ((stream[loaded] == '{') && (_messages.size() >= _limit)) {
+                    _messages.clear();
+                    _depth = 1;
+                    _quoted = false;
+                    _escaped = false;
+                    _state = SKIP;
+                } else if (stream[loaded] == '{') {
+                    _messages.push_back(_messageFactory.Element());
+                    _offset = 0;
+                    _state = ELEMENT;
+                } else {
+                    error = Core::JSON::Error{ "Invalid batch, request object expected." };
+                    loaded++;
+                }
+            }
+
+            if (error.IsSet() == true) {
+                // Never hand out a partially parsed batch.
+                Clear();
+                offset = 0;
+            }
+
+            return (loaded);
+        }
+
+        uint16_t Batch::Serialize(uint8_t stream[], const uint16_t maxLength, uint16_t& offset) const
+        {
+            if (offset == 0) {
+                _packed.clear();
+
+                Core::JSON::MessagePack::Array(_packed, static_cast<uint32_t>(_messages.size()));
+
+                for (const Core::ProxyType<Message>& message : _messages) {
+                    std::vector<uint8_t> packed;
+
+                    Core::JSON::IMessagePack::ToBuffer(packed, static_cast<const Core::JSON::IMessagePack&>(*message));
+                    _packed.insert(_packed.end(), packed.begin(), packed.end());
+                }
+
+                _position = 0;
+            }
+
+            const uint16_t loaded = static_cast<uint16_t>(std::min(static_cast<uint32_t>(maxLength), static_cast<uint32_t>(_packed.size() - _position)));
+
+            ::memcpy(stream, &(_packed[_position]), loaded);
+            _position += loaded;
+
+            offset = (_position < _packed.size() ? 1 : 0);
+
+            return (loaded);
+        }
+
+        uint16_t Batch::Deserialize(const uint8_t stream[], const uint16_t maxLength, uint16_t& offset)
+        {
+            uint16_t loaded = maxLength;
+
+            if (offset == 0) {
+                Clear();
+                _oversized = false;
+
+                const uint32_t size = Core::JSON::MessagePack::Length(stream, maxLength);
+
+                if ((size != 0) && (size != static_cast<uint32_t>(~0))) {
+                    if (Unpack(stream, size) == false) {
+                        Clear();
+                    }
+                    loaded = static_cast<uint16_t>(size);
+                } else if (size == 0) {
+                    _packed.assign(stream, stream + maxLength);
+                    offset = 1;
+                }
+            } else {
+                const uint32_t buffered = static_cast<uint32_t>(_packed.size());
+
+                _packed.insert(_packed.end(), stream, stream + maxLength);
+
+                const uint32_t size = Core::JSON::MessagePack::Length(_packed.data(), static_cast<uint32_t>(_packed.size()));
+
+                if ((size != 0) && (size != static_cast<uint32_t>(~0))) {
+                    if (Unpack(_packed.data(), size) == false) {
+                        Clear();
+                    }
+                    loaded = static_cast<uint16_t>(size - buffered);
+                    offset = 0;
+                    _packed.clear();
+                } else if (size != 0) {
+                    Clear();
+                    offset = 0;
+                }
+            }
+
+            return (loaded);
+        }
+
+        bool Batch::Unpack(const uint8_t stream[], const uint32_t length)
+        {
+            uint32_t count = 0;
+            uint32_t position = Core::JSON::MessagePack::Array(stream, length, count);
+            bool result = (position != 0);
+
+            _messages.clear();
+
+            if ((result == true) && (count > _limit)) {
+                // Not worth unpacking any of it.
+                result = false;
+                _oversized = true;
+            }
+
+            while ((result == true) && (count-- > 0)) {
+                const uint32_t size = Core::JSON::MessagePack::Length(&(stream[position]), length - position);
+
+                if ((size == 0) || (size == static_cast<uint32_t>(~0)) || (size > 0xFFFF)) {
+                    result = false;
+                } else {
+                    Core::ProxyType<Message> message(_messageFactory.Element());
+                    uint16_t offset = 0;
+
+                    static_cast<Core::JSON::IMessagePack&>(*message).Deserialize(&(stream[position]), static_cast<uint16_t>(size), offset);
+
+                    _messages.push_back(message);
+                    position += size;
+                }
+            }
+
+            return (result);
+        }
+
+        uint16_t Message::Serialize(uint8_t stream[], const uint16_t maxLength, uint16_t& offset) const
+        {
+            if (offset == 0) {
+                Pack();
+                _position = 0;
+            }
+
+            const uint16_t loaded = static_cast<uint16_t>(std::min(static_cast<uint32_t>(maxLength), static_cast<uint32_t>(_packed.size() - _position)));
+
+            ::memcpy(stream, &(_packed[_position]), loaded);
+            _position += loaded;
+
+            // The offset only signals that we are not done yet, the real position is kept in _position.
+            offset = (_position < _packed.size() ? 1 : 0);
+
+            return (loaded);
+        }
+
+        uint16_t Message::Deserialize(const uint8_t stream[], const uint16_t maxLength, uint16_t& offset)
+        {
+            uint16_t loaded = maxLength;
+
+            if (offset == 0) {
+                _packed.clear();
+
+                // Most messages arrive in one piece, try to decode them straight from the stream.
+                const uint32_t size = Core::JSON::MessagePack::Length(stream, maxLength);
+
+                if ((size != 0) && (size != static_cast<uint32_t>(~0))) {
+                    if (Unpack(stream, size) == false) {
+                        Clear();
+                    }
+                    loaded = static_cast<uint16_t>(size);
+                } else if (size == 0) {
+                    _packed.assign(stream, stream + maxLength);
+                    offset = 1;
+                } else {
+                    Clear();
+                }
+            } else {
+                const uint32_t buffered = static_cast<uint32_t>(_packed.size());
+
+                _packed.insert(_packed.end(), stream, stream + maxLength);
+
+                const uint32_t size = Core::JSON::MessagePack::Length(_packed.data(), static_cast<uint32_t>(_packed.size()));
+
+                if ((size != 0) && (size != static_cast<uint32_t>(~0))) {
+                    if (Unpack(_packed.data(), size) == false) {
+                        Clear();
+                    }
+                    loaded = static_cast<uint16_t>(size - buffered);
+                    offset = 0;
+                    _packed.clear();
+                } else if (size != 0) {
+                    Clear();
+                    offset = 0;
+                    _packed.clear();
+                }
+            }
+
+            return (loaded);
+        }
+
+        void Message::Pack() const
+        {
+            uint32_t count = (JSONRPC.IsSet() ? 1 : 0) + (Id.IsSet() ? 1 : 0) + (Designator.IsSet() ? 1 : 0) + (Parameters.IsSet() ? 1 : 0) + (Result.IsSet() ? 1 : 0) + (Error.IsSet() ? 1 : 0);
+
+            _packed.clear();
+
+            Core::JSON::MessagePack::Map(_packed, count);
+
+            if (JSONRPC.IsSet() == true) {
+                Core::JSON::MessagePack::Text(_packed, _T("jsonrpc"));
+                Core::JSON::MessagePack::Text(_packed, JSONRPC.Value());
+            }
+            if (Id.IsSet() == true) {
+                Core::JSON::MessagePack::Text(_packed, _T("id"));
+                Core::JSON::MessagePack::Number(_packed, Id.Value());
+            }
+            if (Designator.IsSet() == true) {
+                Core::JSON::MessagePack::Text(_packed, _T("method"));
+                Core::JSON::MessagePack::Text(_packed, Designator.Value());
+            }
+            if (Parameters.IsSet() == true) {
+                Core::JSON::MessagePack::Text(_packed, _T("params"));
+                PackValue(Parameters, _packed);
+            }
+            if (Result.IsSet() == true) {
+                Core::JSON::MessagePack::Text(_packed, _T("result"));
+                PackValue(Result, _packed);
+            }
+            if (Error.IsSet() == true) {
+                Core::JSON::MessagePack::Text(_packed, _T("error"));
+                Core::JSON::MessagePack::Map(_packed, (Error.Code.IsSet() ? 1 : 0) + (Error.Text.IsSet() ? 1 : 0) + (Error.Data.IsSet() ? 1 : 0));
+
+                if (Error.Code.IsSet() == true) {
+                    Core::JSON::MessagePack::Text(_packed, _T("code"));
+                    Core::JSON::MessagePack::Number(_packed, Error.Code.Value());
+                }
+                if (Error.Text.IsSet() == true) {
+                    Core::JSON::MessagePack::Text(_packed, _T("message"));
+                    Core::JSON::MessagePack::Text(_packed, Error.Text.Value());
+                }
+                if (Error.Data.IsSet() == true) {
+                    Core::JSON::MessagePack::Text(_packed, _T("data"));
+                    PackValue(Error.Data, _packed);
+                }
+            }
+        }
+
+        bool Message::Unpack(const uint8_t stream[], const uint32_t length)
+        {
+            uint32_t count = 0;
+            uint32_t position = Core::JSON::MessagePack::Map(stream, length, count);
+            bool result = (position != 0);
+
+            Clear();
+
+            while ((result == true) && (count-- > 0)) {
+                string key;
+                uint32_t loaded = Core::JSON::MessagePack::Text(&(stream[position]), length - position, key);
+
+                if (loaded == 0) {
+                    result = false;
+                } else {
+                    const uint8_t* value = &(stream[position + loaded]);
+                    const uint32_t available = length - position - loaded;
+                    string text;
+                    int64_t number;
+
+                    position += loaded;
+
+                    if (key == _T("jsonrpc")) {
+                        if ((loaded = Core::JSON::MessagePack::Text(value, available, text)) != 0) {
+                            JSONRPC = text;
+                        }
+                    } else if (key == _T("id")) {
+                        if ((loaded = Core::JSON::MessagePack::Number(value, available, number)) != 0) {
+                            Id = static_cast<uint32_t>(number);
+                        }
+                    } else if (key == _T("method")) {
+                        if ((loaded = Core::JSON::MessagePack::Text(value, available, text)) != 0) {
+                            Designator = text;
+                        }
+                    } else if (key == _T("params")) {
+                        loaded = UnpackValue(value, available, Parameters);
+                    } else if (key == _T("result")) {
+                        loaded = UnpackValue(value, available, Result);
+                    } else if (key == _T("error")) {
+                        uint32_t fields = 0;
+                        uint32_t index = Core::JSON::MessagePack::Map(value, available, fields);
+
+                        loaded = index;
+
+                        while ((loaded != 0) && (fields-- > 0)) {
+                            uint32_t size = Core::JSON::MessagePack::Text(&(value[index]), available - index, text);
+
+                            if (size != 0) {
+                                index += size;
+
+                                if (text == _T("code")) {
+                                    if ((size = Core::JSON::MessagePack::Number(&(value[index]), available - index, number)) != 0) {
+                                        Error.Code = static_cast<int32_t>(number);
+                                    }
+                                } else if (text == _T("message")) {
+                                    if ((size = Core::JSON::MessagePack::Text(&(value[index]), available - index, text)) != 0) {
+                                        Error.Text = text;
+                                    }
+                                } else if (text == _T("data")) {
+                                    size = UnpackValue(&(value[index]), available - index, Error.Data);
+                                } else {
+                                    size = Core::JSON::MessagePack::Length(&(value[index]), available - index);
+                                    size = (size == static_cast<uint32_t>(~0) ? 0 : size);
+                                }
+                            }
+
+                            index += size;
+                            loaded = (size != 0 ? index : 0);
+                        }
+                    } else {
+                        // Not ours, skip it..
+                        loaded = Core::JSON::MessagePack::Length(value, available);
+                        loaded = (loaded == static_cast<uint32_t>(~0) ? 0 : loaded);
+                    }
+
+                    position += loaded;
+                    result = (loaded != 0);
+                }
+            }
+
+            return (result);
+        }
+
+        void DesignatorFragments::Parse(const TCHAR text[], const uint32_t length)
+        {
+            uint32_t end = length;
+
+            while ((end > 0) && (text[end - 1] != '@')) {
+                end--;
+            }
+
+            if (end == 0) {
+                end = length;
+            } else {
+                _index = Core::TextFragment(&(text[end]), length - end);
+                end--;
+            }
+
+            uint32_t dot = end;
+
+            while ((dot > 0) && (text[dot - 1] != '.')) {
+                dot--;
+            }
+
+            _method = Core::TextFragment(&(text[dot]), end - dot);
+
+            if (dot > 1) {
+                // Everything in front of the method: "callsign", "version", or "callsign.version".
+                const uint32_t separator = dot - 1;
+                uint32_t start = separator;
+
+                while ((start > 0) && (::isdigit(text[start - 1]))) {
+                    start--;
+                }
+
+                if ((start < separator) && ((start == 0) || (text[start - 1] == '.'))) {
+                    uint32_t version = 0;
+
+                    for (uint32_t index = start; index < separator; index++) {
+                        version = (version * 10) + (text[index] - '0');
+                    }
+
+                    _version = static_cast<uint8_t>(version);
+                    _callsign = Core::TextFragment(text, (start == 0 ? 0 : start - 1));
+                } else {
+                    _callsign = Core::TextFragment(text, separator);
+                }
+            }
+        }
     }
 }
 } // namespace WPEramework::Core::JSONRPC
@@ -21,8 +21,10 @@
 
 #include "JSON.h"
 #include "Module.h"
+#include "Snapshot.h"
 #include "TypeTraits.h"
 
+#include <atomic>
 #include <cctype>
 #include <functional>
 #include <vector>
@@ -119,6 +121,8 @@ namespace Core {
                 , Parameters(false)
                 , Result(false)
                 , Error()
+                , _packed()
+                , _position(0)
             {
                 Add(_T("jsonrpc"), &JSONRPC);
                 Add(_T("id"), &Id);
@@ -246,12 +250,264 @@ namespace Core {
             {
                 return (Index(Designator.Value()));
             }
+
+            // IMessagePack iface:
+            // The MessagePack encoding carries the parameters, result and error data as native
+            // MessagePack values, not as the JSON text they are kept in within this message.
+            uint16_t Serialize(uint8_t stream[], const uint16_t maxLength, uint16_t& offset) const override;
+            uint16_t Deserialize(const uint8_t stream[], const uint16_t maxLength, uint16_t& offset) override;
+
             Core::JSON::String JSONRPC;
             Core::JSON::DecUInt32 Id;
             Core::JSON::String Designator;
             Core::JSON::String Parameters;
             Core::JSON::String Result;
             Info Error;
+
+        private:
+            void Pack() const;
+            bool Unpack(const uint8_t stream[], const uint32_t length);
+
+        private:
+            mutable std::vector<uint8_t> _packed;
+            mutable uint32_t _position;
+        };
+
+        // An outbound notification, as a Message would render it. The bulk of the frame (event and
+        // parameters) is rendered once into a Frame, shared by all subscribers of the event. Per
+        // subscriber only the designator, prefixed to the method, is added when it is sent.
+        class EXTERNAL Notification : public Core::JSON::IElement, public Core::JSON::IMessagePack {
+        public:
+            class EXTERNAL Frame {
+            public:
+                Frame() = delete;
+                Frame(const Frame&) = delete;
+                Frame& operator=(const Frame&) = delete;
+
+                Frame(const string& event, const string& parameters);
+                ~Frame()
+                {
+                }
+
+            public:
+                const string& Event() const
+                {
+                    return (_event);
+                }
+                const string& Parameters() const
+                {
+                    return (_parameters);
+                }
+                // Text rendering, from the (escaped) event name up to the closing bracket.
+                const string& Text() const
+                {
+                    return (_text);
+                }
+                // MessagePack rendering, split at the position where the method value goes.
+                // Only made when the first binary channel asks for it.
+                const std::vector<uint8_t>& Packed(uint32_t& split) const;
+
+            private:
+                const string _event;
+                const string _parameters;
+                string _text;
+                mutable Core::CriticalSection _adminLock;
+                mutable std::vector<uint8_t> _packed;
+                mutable uint32_t _split;
+            };
+
+        public:
+            Notification(const Notification&) = delete;
+            Notification& operator=(const Notification&) = delete;
+
+            Notification()
+                : _frame()
+                , _designator()
+                , _escaped()
+                , _position(0)
+                , _header()
+                , _headerLength(0)
+            {
+            }
+            ~Notification() override
+            {
+            }
+
+        public:
+            void Set(const string& designator, const Core::ProxyType<const Frame>& frame)
+            {
+                _designator = designator;
+                _escaped.clear();
+                _frame = frame;
+            }
+            const string& Designator() const
+            {
+                return (_designator);
+            }
+            const string& Event() const
+            {
+                ASSERT(_frame.IsValid() == true);
+
+                return (_frame->Event());
+            }
+
+            // IElement iface:
+            void Clear() override
+            {
+                if (_frame.IsValid() == true) {
+                    _frame.Release();
+                }
+                _designator.clear();
+                _escaped.clear();
+            }
+            bool IsSet() const override
+            {
+                return (_frame.IsValid());
+            }
+            bool IsNull() const override
+            {
+                return (_frame.IsValid() == false);
+            }
+            uint16_t Serialize(char stream[], const uint16_t maxLength, uint16_t& offset) const override;
+            uint16_t Deserialize(const char stream[], const uint16_t maxLength, uint16_t& offset, Core::OptionalType<Core::JSON::Error>& error) override;
+
+            // IMessagePack iface:
+            uint16_t Serialize(uint8_t stream[], const uint16_t maxLength, uint16_t& offset) const override;
+            uint16_t Deserialize(const uint8_t stream[], const uint16_t maxLength, uint16_t& offset) override;
+
+        private:
+            Core::ProxyType<const Frame> _frame;
+            string _designator;
+            mutable string _escaped;
+            mutable uint32_t _position;
+            mutable uint8_t _header[5];
+            mutable uint8_t _headerLength;
+        };
+
+        // A JSON-RPC 2.0 batch: an array of messages. Inbound it holds the requests, outbound the
+        // responses that go back as one frame.
+        class EXTERNAL Batch : public Core::JSON::IElement, public Core::JSON::IMessagePack {
+        private:
+            enum state : uint8_t {
+                OPEN,
+                ELEMENT,
+                NEXT,
+                SEPARATOR,
+                SKIP
+            };
+
+        public:
+            typedef std::vector<Core::ProxyType<Message>> Messages;
+
+            Batch(const Batch&) = delete;
+            Batch& operator=(const Batch&) = delete;
+
+            Batch()
+                : _messages()
+                , _packed()
+                , _position(0)
+                , _index(0)
+                , _offset(0)
+                , _state(OPEN)
+                , _limit(~0)
+                , _oversized(false)
+                , _depth(0)
+                , _quoted(false)
+                , _escaped(false)
+            {
+            }
+            ~Batch() override
+            {
+            }
+
+        public:
+            uint32_t Length() const
+            {
+                return (static_cast<uint32_t>(_messages.size()));
+            }
+            // A batch holding more requests than this is not read, the rest of it is skipped and the batch is
+            // left empty and oversized.
+            void Limit(const uint32_t limit)
+            {
+                _limit = limit;
+            }
+            bool IsOversized() const
+            {
+                return (_oversized);
+            }
+            Messages& Elements()
+            {
+                return (_messages);
+            }
+            const Messages& Elements() const
+            {
+                return (_messages);
+            }
+            void Add(const Core::ProxyType<Message>& message)
+            {
+                _messages.push_back(message);
+            }
+
+            // Tells, from the first bytes of a frame, if it carries a batch rather than a single message.
+            static bool IsBatch(const uint8_t stream[], const uint16_t length, const bool binary)
+            {
+                bool result = false;
+
+                if (binary == true) {
+                    result = ((length > 0) && (((stream[0] & 0xF0) == 0x90) || (stream[0] == 0xDC) || (stream[0] == 0xDD)));
+                } else {
+                    uint16_t index = 0;
+
+                    while ((index < length) && (::isspace(stream[index]))) {
+                        index++;
+                    }
+
+                    result = ((index < length) && (stream[index] == '['));
+                }
+
+                return (result);
+            }
+
+            // IElement iface:
+            void Clear() override
+            {
+                _messages.clear();
+                _packed.clear();
+                _state = OPEN;
+            }
+            bool IsSet() const override
+            {
+                return (_messages.empty() == false);
+            }
+            bool IsNull() const override
+            {
+                return (false);
+            }
+            uint16_t Serialize(char stream[], const uint16_t maxLength, uint16_t& offset) const override;
+            uint16_t Deserialize(const char stream[], const uint16_t maxLength, uint16_t& offset, Core::OptionalType<Core::JSON::Error>& error) override;
+
+            // IMessagePack iface:
+            uint16_t Serialize(uint8_t stream[], const uint16_t maxLength, uint16_t& offset) const override;
+            uint16_t Deserialize(const uint8_t stream[], const uint16_t maxLength, uint16_t& offset) override;
+
+        private:
+            bool Unpack(const uint8_t stream[], const uint32_t length);
+
+        private:
+            Messages _messages;
+            mutable std::vector<uint8_t> _packed;
+            mutable uint32_t _position;
+            mutable uint32_t _index;
+            mutable uint16_t _offset;
+            mutable state _state;
+            uint32_t _limit;
+            bool _oversized;
+            uint32_t _depth;
+            bool _quoted;
+            bool _escaped;
+
+            // Requests come and go with every batch, recycle them.
+            static Core::ProxyPoolType<Message> _messageFactory;
         };
 
         class EXTERNAL Connection {
@@ -296,6 +552,56 @@ namespace Core {
             uint32_t _sequence;
         };
 
+        // Splits a designator, "[callsign.][version.]method[@index]", into fragments of the given
+        // text, so nothing is copied. The text has to outlive this object.
+        class EXTERNAL DesignatorFragments {
+        public:
+            DesignatorFragments() = delete;
+            DesignatorFragments(const DesignatorFragments&) = delete;
+            DesignatorFragments& operator=(const DesignatorFragments&) = delete;
+            DesignatorFragments(string&&) = delete;
+
+            DesignatorFragments(const string& designator)
+                : _callsign()
+                , _method()
+                , _index()
+                , _version(~0)
+            {
+                Parse(designator.c_str(), static_cast<uint32_t>(designator.length()));
+            }
+            ~DesignatorFragments()
+            {
+            }
+
+        public:
+            const Core::TextFragment& Callsign() const
+            {
+                return (_callsign);
+            }
+            // ~0 if the designator does not carry a version.
+            uint8_t Version() const
+            {
+                return (_version);
+            }
+            const Core::TextFragment& Method() const
+            {
+                return (_method);
+            }
+            const Core::TextFragment& Index() const
+            {
+                return (_index);
+            }
+
+        private:
+            void Parse(const TCHAR text[], const uint32_t length);
+
+        private:
+            Core::TextFragment _callsign;
+            Core::TextFragment _method;
+            Core::TextFragment _index;
+            uint8_t _version;
+        };
+
         typedef std::function<void(const Connection& channel, const string& parameters)> CallbackFunction;
         typedef std::function<uint32_t(const string& method, const string& parameters, string& result)> InvokeFunction;
 
@@ -357,7 +663,11 @@ namespace Core {
                 }
 
             public:
-                uint32_t Invoke(const Connection connection, const string& method, const string& parameters, string& response)
+                bool IsAsynchronous() const
+                {
+                    return (_asynchronous);
+                }
+                uint32_t Invoke(const Connection connection, const string& method, const string& parameters, string& response) const
                 {
                     uint32_t result = ~0;
                     if (_asynchronous == true) {
@@ -415,7 +725,108 @@ namespace Core {
             typedef std::list<Observer> ObserverList;
             typedef std::map<string, ObserverList> ObserverMap;
 
-            typedef std::function<void(const uint32_t id, const string& designator, const string& data)> NotificationFunction;
+            // The methods as they are looked up for every request: an open addressed hash table that
+            // is never changed once published. (Un)registering marks it stale, the next lookup builds a new one.
+            class Table {
+            private:
+                class Slot {
+                public:
+                    Slot() = delete;
+                    Slot& operator=(const Slot&) = delete;
+
+                    Slot(const uint32_t hash, const string& name, const Entry& entry)
+                        : Hash(hash)
+                        , Name(name)
+                        , Method(entry)
+                    {
+                    }
+                    Slot(const Slot& copy) = default;
+                    ~Slot() = default;
+
+                public:
+                    const uint32_t Hash;
+                    const string Name;
+                    const Entry Method;
+                };
+
+            public:
+                Table() = delete;
+                Table(const Table&) = delete;
+                Table& operator=(const Table&) = delete;
+
+                Table(const HandlerMap& handlers)
+                    : _slots()
+                    , _buckets()
+                    , _mask(3)
+                {
+                    while (_mask < (handlers.size() * 2)) {
+                        _mask = (_mask << 1) | 1;
+                    }
+
+                    _buckets.assign(_mask + 1, 0);
+                    _slots.reserve(handlers.size());
+
+                    for (const std::pair<const string, Entry>& handler : handlers) {
+                        const uint32_t hash = Hash(handler.first.c_str(), static_cast<uint32_t>(handler.first.length()));
+                        uint32_t bucket = hash & _mask;
+
+                        while (_buckets[bucket] != 0) {
+                            bucket = (bucket + 1) & _mask;
+                        }
+
+                        _slots.emplace_back(hash, handler.first, handler.second);
+                        _buckets[bucket] = static_cast<uint16_t>(_slots.size());
+                    }
+                }
+                ~Table()
+                {
+                }
+
+            public:
+                const Entry* Find(const Core::TextFragment& name) const
+                {
+                    const Entry* result = nullptr;
+                    const uint32_t hash = Hash(name.Data(), name.Length());
+                    uint32_t bucket = hash & _mask;
+
+                    while ((result == nullptr) && (_buckets[bucket] != 0)) {
+                        const Slot& slot(_slots[_buckets[bucket] - 1]);
+
+                        if ((slot.Hash == hash) && (slot.Name.compare(0, string::npos, name.Data(), name.Length()) == 0)) {
+                            result = &(slot.Method);
+                        } else {
+                            bucket = (bucket + 1) & _mask;
+                        }
+                    }
+
+                    return (result);
+                }
+
+            private:
+                // FNV-1a
+                static uint32_t Hash(const TCHAR name[], const uint32_t length)
+                {
+                    uint32_t result = 2166136261u;
+
+                    for (uint32_t index = 0; index < length; index++) {
+                        result = (result ^ static_cast<uint8_t>(name[index])) * 16777619u;
+                    }
+
+                    return (result);
+                }
+
+            private:
+                std::vector<Slot> _slots;
+                std::vector<uint16_t> _buckets;
+                uint32_t _mask;
+            };
+
+            typedef Core::SnapshotType<Table>::Reader Reader;
+
+            typedef std::function<void(const uint32_t id, const string& designator, const Core::ProxyType<const Notification::Frame>& frame)> NotificationFunction;
+            // As notifications were handed out before the frame was shared: the designator includes the event,
+            // the parameters come as text.
+            typedef std::function<void(const uint32_t id, const string& designator, const string& parameters)> NotificationTextFunction;
 
         public:
             class EventIterator {
@@ -493,6 +904,7 @@ namespace Core {
             Handler(const NotificationFunction& notificationFunction, const std::vector<uint8_t>& versions)
                 : _adminLock()
                 , _handlers()
+                , _table(_adminLock, [this]() { return (new Table(_handlers)); })
                 , _observers()
                 , _notificationFunction(notificationFunction)
                 , _versions(versions)
@@ -501,11 +913,20 @@ namespace Core {
             Handler(const NotificationFunction& notificationFunction, const std::vector<uint8_t>& versions, const Handler& copy)
                 : _adminLock()
                 , _handlers(copy._handlers)
+                , _table(_adminLock, [this]() { return (new Table(_handlers)); })
                 , _observers()
                 , _notificationFunction(notificationFunction)
                 , _versions(versions)
             {
             }
+            Handler(const NotificationTextFunction& notificationFunction, const std::vector<uint8_t>& versions)
+                : Handler(Adapt(notificationFunction), versions)
+            {
+            }
+            Handler(const NotificationTextFunction& notificationFunction, const std::vector<uint8_t>& versions, const Handler& copy)
+                : Handler(Adapt(notificationFunction), versions, copy)
+            {
+            }
             ~Handler()
             {
             }
@@ -525,9 +946,15 @@ namespace Core {
                     copied = true;
                     const Entry& info(index->second);
 
+                    _adminLock.Lock();
+
                     _handlers.emplace(std::piecewise_construct,
                         std::forward_as_tuple(method),
                         std::forward_as_tuple(info));
+
+                    _table.Invalidate();
+
+                    _adminLock.Unlock();
                 }
 
                 return (copied);
@@ -536,7 +963,23 @@ namespace Core {
             // The interface is prepared.
             inline uint32_t Exists(const string& methodName) const
             {
-                return ((_handlers.find(methodName) != _handlers.end()) ? Core::ERROR_NONE : Core::ERROR_UNKNOWN_KEY);
+                return (Exists(Core::TextFragment(methodName.c_str(), static_cast<uint32_t>(methodName.length()))));
+            }
+            inline uint32_t Exists(const Core::TextFragment& methodName) const
+            {
+                Reader reader(_table);
+
+                return ((reader.Current().Find(methodName) != nullptr) ? Core::ERROR_NONE : Core::ERROR_UNKNOWN_KEY);
+            }
+            // Asynchronous methods do not answer when invoked, they are answered later on through their Connection.
+            inline uint32_t Exists(const Core::TextFragment& methodName, bool& asynchronous) const
+            {
+                Reader reader(_table);
+                const Entry* entry = reader.Current().Find(methodName);
+
+                asynchronous = ((entry != nullptr) && (entry->IsAsynchronous() == true));
+
+                return ((entry != nullptr) ? Core::ERROR_NONE : Core::ERROR_UNKNOWN_KEY);
             }
             bool HasVersionSupport(const uint8_t number) const
             {
@@ -616,38 +1059,59 @@ namespace Core {
                 // Due to versioning, we do allow to overwrite methods that have been registered.
                 // These are typically methods that are different from the preferred interface..
 
+                _adminLock.Lock();
+
                 _handlers.emplace(std::piecewise_construct,
                     std::make_tuple(methodName),
                     std::make_tuple(lambda));
+
+                _table.Invalidate();
+
+                _adminLock.Unlock();
             }
             void Register(const string& methodName, const CallbackFunction& lambda)
             {
                 // Due to versioning, we do allow to overwrite methods that have been registsred.
                 // These are typically methods that are different from the preferred interface..
 
+                _adminLock.Lock();
+
                 _handlers.emplace(std::piecewise_construct,
                     std::make_tuple(methodName),
                     std::make_tuple(lambda));
+
+                _table.Invalidate();
+
+                _adminLock.Unlock();
             }
             void Unregister(const string& methodName)
             {
+                _adminLock.Lock();
+
                 HandlerMap::iterator index = _handlers.find(methodName);
 
                 ASSERT((index != _handlers.end()) && _T("Do not unregister methods that are not registered!!!"));
 
                 if (index != _handlers.end()) {
                     _handlers.erase(index);
+
+                    _table.Invalidate();
                 }
+
+                _adminLock.Unlock();
             }
             uint32_t Invoke(const Connection connection, const string& method, const string& parameters, string& response)
             {
                 uint32_t result = Core::ERROR_UNKNOWN_KEY;
+                const DesignatorFragments designator(method);
+                Reader reader(_table);
 
                 response.clear();
 
-                HandlerMap::iterator index = _handlers.find(Message::Method(method));
-                if (index != _handlers.end()) {
-                    result = index->second.Invoke(connection, method, parameters, response);
+                const Entry* entry = reader.Current().Find(designator.Method());
+
+                if (entry != nullptr) {
+                    result = entry->Invoke(connection, method, parameters, response);
                 }
                 return (result);
             }
@@ -1021,37 +1485,55 @@ namespace Core {
             uint32_t InternalNotify(const string& event, const string& parameters, std::function<bool(const string&)>&& sendifmethod = std::function<bool(const string&)>())
             {
                 uint32_t result = Core::ERROR_UNKNOWN_KEY;
+                std::vector<std::pair<uint32_t, string>> subscribers;
 
                 _adminLock.Lock();
 
-                ObserverMap::iterator index = _observers.find(event);
+                ObserverMap::const_iterator index = _observers.find(event);
 
                 if (index != _observers.end()) {
-                    ObserverList& clients = index->second;
-                    ObserverList::iterator loop = clients.begin();
+                    const ObserverList& clients = index->second;
 
                     result = Core::ERROR_NONE;
 
-                    while (loop != clients.end()) {
-                        const string& designator(loop->Designator());
+                    subscribers.reserve(clients.size());
+
+                    for (const Observer& client : clients) {
+                        subscribers.emplace_back(client.Id(), client.Designator());
+                    }
+                }
+
+                _adminLock.Unlock();
+
+                // Dispatch without holding the lock, subscribers may (un)register from within
+                // a send-if method. The frame is rendered once and shared by all of them.
+                Core::ProxyType<const Notification::Frame> frame;
 
-                        if (!sendifmethod || sendifmethod(designator)) {
+                for (const std::pair<uint32_t, string>& subscriber : subscribers) {
+                    if (!sendifmethod || sendifmethod(subscriber.second)) {
 
-                            _notificationFunction(loop->Id(), (designator.empty() == false ? designator + '.' + event : event), parameters);
+                        if (frame.IsValid() == false) {
+                            frame = Core::ProxyType<const Notification::Frame>(Core::ProxyType<Notification::Frame>::Create(event, parameters));
                         }
 
-                        loop++;
+                        _notificationFunction(subscriber.first, subscriber.second, frame);
                     }
                 }
 
-                _adminLock.Unlock();
-
                 return (result);
             }
 
+            static NotificationFunction Adapt(const NotificationTextFunction& notificationFunction)
+            {
+                return ([notificationFunction](const uint32_t id, const string& designator, const Core::ProxyType<const Notification::Frame>& frame) {
+                    notificationFunction(id, (designator.empty() == false ? designator + '.' + frame->Event() : frame->Event()), frame->Parameters());
+                });
+            }
+
         private:
-            Core::CriticalSection _adminLock;
+            mutable Core::CriticalSection _adminLock;
             HandlerMap _handlers;
+            Core::SnapshotType<Table> _table;
             ObserverMap _observers;
             NotificationFunction _notificationFunction;
             const std::vector<uint8_t> _versions;
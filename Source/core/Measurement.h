@@ -24,6 +24,8 @@
 #include "Number.h"
 #include "Portability.h"
 
+#include <atomic>
+
 namespace WPEFramework {
 namespace Core {
     template <typename TYPE>
@@ -111,6 +113,101 @@ namespace Core {
         TYPE _average;
         uint32_t _measurements;
     };
+
+    // Distribution of values (typically durations in microseconds) over power-of-two buckets. Bucket 0
+    // counts the value 0, bucket N the values in [2^(N-1), 2^N), the last bucket everything beyond.
+    // Recording is lock free, so it can be done from any thread. Readers get a consistent value per
+    // counter, not a snapshot of the histogram as a whole.
+    template <const uint8_t BUCKETS>
+    class HistogramType {
+    private:
+        static_assert(BUCKETS >= 2, "A histogram needs at least two buckets");
+        static_assert(BUCKETS <= 33, "A histogram of 32 bit values has at most 33 buckets");
+
+    public:
+        HistogramType(const HistogramType<BUCKETS>&) = delete;
+        HistogramType<BUCKETS>& operator=(const HistogramType<BUCKETS>&) = delete;
+
+        HistogramType()
+            : _count(0)
+            , _total(0)
+            , _max(0)
+        {
+            for (uint8_t index = 0; index < BUCKETS; index++) {
+                _buckets[index] = 0;
+            }
+        }
+        ~HistogramType()
+        {
+        }
+
+    public:
+        static constexpr uint8_t Buckets()
+        {
+            return (BUCKETS);
+        }
+        // Upper bound (exclusive) of the values counted in a bucket, the last one has none.
+        static uint64_t Limit(const uint8_t bucket)
+        {
+            ASSERT(bucket < (BUCKETS - 1));
+
+            return (static_cast<uint64_t>(1) << bucket);
+        }
+        static uint8_t Bucket(uint32_t value)
+        {
+            uint8_t result = 0;
+
+            while ((value != 0) && (result < (BUCKETS - 1))) {
+                value >>= 1;
+                result++;
+            }
+
+            return (result);
+        }
+
+        void Add(const uint32_t value)
+        {
+            _buckets[Bucket(value)].fetch_add(1, std::memory_order_relaxed);
+            _count.fetch_add(1, std::memory_order_relaxed);
+            _total.fetch_add(value, std::memory_order_relaxed);
+
+            uint32_t current = _max.load(std::memory_order_relaxed);
+
+            while ((value > current) && (_max.compare_exchange_weak(current, value, std::memory_order_relaxed) == false)) {
+                // current was reloaded, try again as long as we are the bigger one.
+            }
+        }
+        inline uint32_t Count() const
+        {
+            return (_count.load(std::memory_order_relaxed));
+        }
+        inline uint64_t Total() const
+        {
+            return (_total.load(std::memory_order_relaxed));
+        }
+        inline uint32_t Max() const
+        {
+            return (_max.load(std::memory_order_relaxed));
+        }
+        inline uint32_t Average() const
+        {
+            const uint32_t count = Count();
+
+            return (count == 0 ? 0 : static_cast<uint32_t>(Total() / count));
+        }
+        inline uint32_t operator[](const uint8_t bucket) const
+        {
+            ASSERT(bucket < BUCKETS);
+
+            return (_buckets[bucket].load(std::memory_order_relaxed));
+        }
+
+    private:
+        std::atomic<uint32_t> _buckets[BUCKETS];
+        std::atomic<uint32_t> _count;
+        std::atomic<uint64_t> _total;
+        std::atomic<uint32_t> _max;
+    };
 }
 }
 
@@ -17,6 +17,7 @@
  * limitations under the License.
  */
  
+#include <cmath>
 #include <math.h>
 
 #include "Number.h"
@@ -83,6 +84,113 @@ namespace Core {
     }
     }
 
+    char* FormatDecimal(uint64_t value, char* end)
+    {
+        static const char pairs[] =
+            "0001020304050607080910111213141516171819"
+            "2021222324252627282930313233343536373839"
+            "4041424344454647484950515253545556575859"
+            "6061626364656667686970717273747576777879"
+            "8081828384858687888990919293949596979899";
+
+        // Peel off eight digits at a time, so the bulk of the work is done in 32 bits.
+        while (value >= 100000000) {
+            uint32_t low = static_cast<uint32_t>(value % 100000000);
+            value /= 100000000;
+
+            for (uint8_t index = 0; index < 4; index++) {
+                const uint32_t pair = (low % 100) * 2;
+                low /= 100;
+                *(--end) = pairs[pair + 1];
+                *(--end) = pairs[pair];
+            }
+        }
+
+        uint32_t rest = static_cast<uint32_t>(value);
+
+        while (rest >= 100) {
+            const uint32_t pair = (rest % 100) * 2;
+            rest /= 100;
+            *(--end) = pairs[pair + 1];
+            *(--end) = pairs[pair];
+        }
+
+        if (rest >= 10) {
+            *(--end) = pairs[(rest * 2) + 1];
+            *(--end) = pairs[rest * 2];
+        } else {
+            *(--end) = static_cast<char>('0' + rest);
+        }
+
+        return (end);
+    }
+
+    uint8_t FormatFloat(const double value, const bool single, char buffer[], const uint8_t length)
+    {
+        uint8_t result = 0;
+
+        ASSERT(std::isfinite(value) == true);
+
+        if ((value == ::floor(value)) && (::fabs(value) < 9007199254740992.0 /* 2^53 */)) {
+            // Integral values are exact, no need to look for the shortest digit sequence.
+            char digits[24];
+            char* end = &digits[sizeof(digits)];
+            char* start = FormatDecimal(static_cast<uint64_t>(::fabs(value)), end);
+
+            if (std::signbit(value) == true) {
+                *(--start) = '-';
+            }
+
+            if ((end - start) <= length) {
+                result = static_cast<uint8_t>(end - start);
+                ::memcpy(buffer, start, result);
+            }
+        } else {
+            // No shortest round trip formatter (to_chars, Ryu) available in C++11. The common precision
+            // (15 digits for a double, 6 for a float) nearly always reads back to the same value, if it does
+            // not, the precision that always does (17 or 9) is taken.
+            int written = ::snprintf(buffer, length, "%.*g", (single == true ? 6 : 15), value);
+
+            if ((written > 0) && (written < length) && ((single == true) ? (::strtof(buffer, nullptr) != static_cast<float>(value)) : (::strtod(buffer, nullptr) != value))) {
+                written = ::snprintf(buffer, length, "%.*g", (single == true ? 9 : 17), value);
+            }
+
+            if ((written > 0) && (written < length)) {
+                result = static_cast<uint8_t>(written);
+            }
+        }
+
+        return (result);
+    }
+
+    double ComposeFloat(const uint64_t mantissa, const int32_t exponent, const bool single)
+    {
+        static const double powers[] = {
+            1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+            1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+        };
+
+        double result;
+
+        if (mantissa == 0) {
+            result = 0.0;
+        } else if ((single == false) && (mantissa <= (1ULL << 53)) && (exponent >= -22) && (exponent <= 22)) {
+            // Clinger's fast path: both operands are exact, so only the final operation rounds.
+            const double value = static_cast<double>(mantissa);
+            result = (exponent < 0 ? value / powers[-exponent] : value * powers[exponent]);
+        } else if ((single == true) && (mantissa <= (1ULL << 24)) && (exponent >= -10) && (exponent <= 10)) {
+            const float value = static_cast<float>(mantissa);
+            result = (exponent < 0 ? value / static_cast<float>(powers[-exponent]) : value * static_cast<float>(powers[exponent]));
+        } else {
+            char text[32];
+
+            ::snprintf(text, sizeof(text), "%llue%d", static_cast<unsigned long long>(mantissa), exponent);
+            result = (single == true ? ::strtof(text, nullptr) : ::strtod(text, nullptr));
+        }
+
+        return (result);
+    }
+
     Fractional::Fractional()
         : m_Integer(0)
         , m_Remainder(0)
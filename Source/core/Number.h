@@ -38,6 +38,17 @@ namespace Core {
     EXTERNAL TCHAR ToDirect(const unsigned char element);
     }
 
+    // Writes the decimal digits of value backwards, ending just before end. Returns a pointer to
+    // the first digit. The buffer must hold at least 20 characters.
+    EXTERNAL char* FormatDecimal(uint64_t value, char* end);
+
+    // Writes the shortest text that reads back as exactly the same value (as a float if single is
+    // set) and returns its length, 0 if it did not fit. The value must be finite.
+    EXTERNAL uint8_t FormatFloat(const double value, const bool single, char buffer[], const uint8_t length);
+
+    // Returns mantissa * 10^exponent, correctly rounded to a double (or float if single is set).
+    EXTERNAL double ComposeFloat(const uint64_t mantissa, const int32_t exponent, const bool single);
+
     template <class TYPE, bool SIGNED = (TypeTraits::sign<TYPE>::Signed == 1), const NumberBase BASETYPE = BASE_UNKNOWN>
     class NumberType {
     public:
@@ -376,6 +387,23 @@ namespace Core {
     private:
         uint16_t FillBuffer(char* buffer, const uint16_t maxLength, const NumberBase BaseType) const
         {
+            if ((BaseType == BASE_DECIMAL) || (BaseType == BASE_UNKNOWN)) {
+                // The common case, two digits at a time.
+                const uint64_t magnitude = (Negative() == true ? (0 - static_cast<uint64_t>(m_Value)) : static_cast<uint64_t>(m_Value));
+                char* start = &buffer[maxLength - 1];
+
+                ASSERT(maxLength >= 22);
+
+                *start = '\0';
+                start = FormatDecimal(magnitude, start);
+
+                if (Negative() == true) {
+                    *(--start) = '-';
+                }
+
+                return (static_cast<uint16_t>(start - buffer));
+            }
+
             TCHAR* Location = &buffer[maxLength - 1];
             TYPE Value = NumberType<TYPE, SIGNED>(m_Value).Abs();
             uint16_t Index = maxLength - 1 /* closing character */ - (Negative() ? 1 : 0) - (BaseType == BASE_OCTAL ? 1 : (BaseType == BASE_HEXADECIMAL ? 2 : 0));
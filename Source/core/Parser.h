@@ -58,6 +58,7 @@ namespace Core {
             , _buffer()
             , _parent(parent)
             , _terminator()
+            , _idle(true)
         {
         }
         ~ParserType()
@@ -129,6 +130,8 @@ namespace Core {
                 while (((_state & FLUSH_LINE) != 0) && (current < maxLength)) {
                     int8_t terminated = _terminator.IsTerminated(stream[current]);
 
+                    _idle = ((terminated & 0x40) == 0);
+
                     if ((terminated & 0x80) == 0x80) {
                         _state &= (~FLUSH_LINE);
                         _state |= (SKIP_WHITESPACE);
@@ -147,6 +150,26 @@ namespace Core {
                 }
 
                 while (((_state & SKIP_WHITESPACE) == 0) && (current < maxLength)) {
+                    if (((_state & (ESCAPED | QUOTED)) == 0) && (_idle == true)) {
+                        // Nothing but the terminator, a quote, an escape, a split character or white space
+                        // changes what we do with a character, copy everything in between in one go.
+                        uint16_t end = current;
+
+                        while ((end < maxLength) && (IsPlain(stream[end]) == true)) {
+                            end++;
+                        }
+
+                        if (end != current) {
+                            Append(&stream[current], &stream[end]);
+                            _byteCounter = 0;
+                            current = end;
+
+                            if (current == maxLength) {
+                                break;
+                            }
+                        }
+                    }
+
                     TCHAR character = ((_state & UPPERCASE) != 0 ? toupper(stream[current]) : ((_state & LOWERCASE) != 0 ? tolower(stream[current]) : stream[current]));
 
                     if ((_state & ESCAPED) == ESCAPED) {
@@ -191,6 +214,8 @@ namespace Core {
                     } else {
                         int8_t terminated = _terminator.IsTerminated(character);
 
+                        _idle = ((terminated & 0x40) == 0);
+
                         if ((terminated & 0x80) == 0x80) {
                             if (_byteCounter != 0) {
                                 _buffer.erase(_buffer.end() - _byteCounter);
@@ -221,6 +246,35 @@ namespace Core {
             return (current);
         }
 
+    private:
+        // Control characters (and thus every terminator character) and the space are below or at ' '.
+        inline bool IsPlain(const uint8_t character) const
+        {
+            return ((character > ' ') && (character != '\\') && (character != '\"') && (((_state & SPLITCHAR) == 0) || (character != static_cast<uint8_t>(_splitChar))));
+        }
+        inline void Append(const uint8_t* begin, const uint8_t* end)
+        {
+            const size_t length = _buffer.length();
+
+            _buffer.resize(length + (end - begin));
+
+            TCHAR* destination = &(_buffer[length]);
+
+            if ((_state & UPPERCASE) != 0) {
+                while (begin != end) {
+                    *destination++ = static_cast<TCHAR>(toupper(*begin++));
+                }
+            } else if ((_state & LOWERCASE) != 0) {
+                while (begin != end) {
+                    *destination++ = static_cast<TCHAR>(tolower(*begin++));
+                }
+            } else {
+                while (begin != end) {
+                    *destination++ = static_cast<TCHAR>(*begin++);
+                }
+            }
+        }
+
     private:
         uint16_t _state;
         uint32_t _byteCounter;
@@ -228,6 +282,8 @@ namespace Core {
         HANDLER& _parent;
         TCHAR _splitChar;
         TEXTTERMINATOR _terminator;
+        // The terminator is not in the middle of a sequence, so plain characters can not end a line.
+        bool _idle;
     };
 
     class EXTERNAL TextParser : public TextFragment {
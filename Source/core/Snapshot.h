@@ -0,0 +1,166 @@
+ /*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2020 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef __SNAPSHOT_H
+#define __SNAPSHOT_H
+
+#include "Module.h"
+#include "Sync.h"
+
+#include <atomic>
+#include <functional>
+#include <list>
+
+namespace WPEFramework {
+namespace Core {
+
+    // A read only copy of some administration, looked up without taking a lock. The owner changes its
+    // administration with its lock taken and calls Invalidate(), the copy is built again, with that same
+    // lock taken, by the first reader that comes along. So a burst of changes costs one build.
+    // Readers announce themselves while they use the copy, a replaced copy is only deleted once no
+    // reader is around anymore. Whoever sees that last, the builder or the last reader leaving, deletes it.
+    template <typename SNAPSHOT>
+    class SnapshotType {
+    public:
+        typedef std::function<SNAPSHOT*()> Builder;
+
+        class Reader {
+        public:
+            Reader() = delete;
+            Reader(const Reader&) = delete;
+            Reader& operator=(const Reader&) = delete;
+
+            Reader(const SnapshotType<SNAPSHOT>& parent)
+                : _parent(parent)
+            {
+                if (_parent._stale == true) {
+                    _parent.Refresh();
+                }
+
+                _parent._readers++;
+            }
+            ~Reader()
+            {
+                if ((--_parent._readers == 0) && (_parent._reclaim == true)) {
+                    _parent.Reclaim();
+                }
+            }
+
+        public:
+            const SNAPSHOT& Current() const
+            {
+                return (*(_parent._current.load()));
+            }
+
+        private:
+            const SnapshotType<SNAPSHOT>& _parent;
+        };
+
+    public:
+        SnapshotType() = delete;
+        SnapshotType(const SnapshotType<SNAPSHOT>&) = delete;
+        SnapshotType<SNAPSHOT>& operator=(const SnapshotType<SNAPSHOT>&) = delete;
+
+        // The builder is called with the lock taken, the lock is the one the owner guards its administration with.
+        SnapshotType(Core::CriticalSection& lock, const Builder& builder)
+            : _lock(lock)
+            , _builder(builder)
+            , _current(nullptr)
+            , _readers(0)
+            , _retired()
+            , _reclaim(false)
+            , _stale(true)
+        {
+        }
+        ~SnapshotType()
+        {
+            ASSERT(_readers == 0);
+
+            for (SNAPSHOT* snapshot : _retired) {
+                delete snapshot;
+            }
+
+            delete _current.load();
+        }
+
+    public:
+        // Called with the lock taken.
+        void Invalidate()
+        {
+            _stale = true;
+        }
+        // Called with the lock taken. Builds the copy right away, to let go of what the previous one refers to.
+        void Publish()
+        {
+            _stale = true;
+
+            Refresh();
+        }
+
+    private:
+        void Refresh() const
+        {
+            _lock.Lock();
+
+            if (_stale == true) {
+                _stale = false;
+
+                SNAPSHOT* previous = _current.exchange(_builder());
+
+                if (previous != nullptr) {
+                    _retired.push_back(previous);
+
+                    // Raised before the readers are counted, so a reader leaving meanwhile reclaims it.
+                    _reclaim = true;
+
+                    Reclaim();
+                }
+            }
+
+            _lock.Unlock();
+        }
+        void Reclaim() const
+        {
+            _lock.Lock();
+
+            // A reader that comes in after the exchange, already sees the new copy.
+            if (_readers == 0) {
+                for (SNAPSHOT* snapshot : _retired) {
+                    delete snapshot;
+                }
+                _retired.clear();
+                _reclaim = false;
+            }
+
+            _lock.Unlock();
+        }
+
+    private:
+        Core::CriticalSection& _lock;
+        Builder _builder;
+        mutable std::atomic<SNAPSHOT*> _current;
+        mutable std::atomic<uint32_t> _readers;
+        mutable std::list<SNAPSHOT*> _retired;
+        mutable std::atomic<bool> _reclaim;
+        mutable std::atomic<bool> _stale;
+    };
+}
+} // namespace Core
+
+#endif // __SNAPSHOT_H
@@ -44,6 +44,7 @@
 #include <execinfo.h>
 #include <signal.h>
 #include <sys/ioctl.h>
+#include <sys/sendfile.h>
 #include <sys/signalfd.h>
 #endif
 
@@ -195,6 +196,9 @@ namespace Core {
         , m_ReceivedNode()
         , m_SendBuffer(nullptr)
         , m_ReceiveBuffer(nullptr)
+        , m_TransferFile(INVALID_HANDLE_VALUE)
+        , m_TransferOffset(0)
+        , m_TransferLength(0)
     {
         TRACE_L5("Constructor SocketPort (NodeId&) <%p>", (this));
     }
@@ -216,6 +220,9 @@ namespace Core {
         , m_ReceivedNode()
         , m_SendBuffer(nullptr)
         , m_ReceiveBuffer(nullptr)
+        , m_TransferFile(INVALID_HANDLE_VALUE)
+        , m_TransferOffset(0)
+        , m_TransferLength(0)
     {
         NodeId::SocketInfo localAddress;
         socklen_t localSize = sizeof(localAddress);
@@ -306,6 +313,7 @@ namespace Core {
         m_ReadBytes = 0;
         m_SendBytes = 0;
         m_SendOffset = 0;
+        m_TransferLength = 0;
 
         if ((m_State & (SocketPort::LINK | SocketPort::OPEN | SocketPort::MONITOR)) == (SocketPort::LINK | SocketPort::OPEN)) {
             // Open up an accepted socket, but not yet added to the monitor.
@@ -794,6 +802,34 @@ namespace Core {
         }
     }
 
+    bool SocketPort::Transfer(const File::Handle file, const uint64_t offset, const uint64_t length)
+    {
+        bool result = false;
+
+#ifdef __LINUX__
+        // Only a connected stream, sendfile has no destination address and datagrams would be cut.
+        if ((m_SocketType == SocketPort::STREAM) && ((m_State & SocketPort::LINK) != 0) && (file != INVALID_HANDLE_VALUE)) {
+            m_syncAdmin.Lock();
+
+            ASSERT(m_TransferLength == 0);
+
+            m_TransferFile = file;
+            m_TransferOffset = offset;
+            m_TransferLength = length;
+
+            m_syncAdmin.Unlock();
+
+            result = true;
+        }
+#else
+        DEBUG_VARIABLE(file);
+        DEBUG_VARIABLE(offset);
+        DEBUG_VARIABLE(length);
+#endif
+
+        return (result);
+    }
+
     void SocketPort::Write()
     {
         bool dataLeftToSend = true;
@@ -803,10 +839,10 @@ namespace Core {
         m_State &= (~(SocketPort::WRITE | SocketPort::WRITESLOT));
 
         while (((m_State & (SocketPort::WRITE | SocketPort::SHUTDOWN | SocketPort::OPEN | SocketPort::EXCEPTION)) == SocketPort::OPEN) && (dataLeftToSend == true)) {
-            if (m_SendOffset == m_SendBytes) {
+            if ((m_SendOffset == m_SendBytes) && (m_TransferLength == 0)) {
                 m_SendBytes = SendData(m_SendBuffer, m_SendBufferSize);
                 m_SendOffset = 0;
-                dataLeftToSend = (m_SendOffset != m_SendBytes);
+                dataLeftToSend = ((m_SendOffset != m_SendBytes) || (m_TransferLength != 0));
 
                 ASSERT(m_SendBytes <= m_SendBufferSize);
             }
@@ -814,9 +850,32 @@ namespace Core {
             if (dataLeftToSend == true) {
                 int32_t sendSize;
 
+                if (m_SendOffset == m_SendBytes) {
+#ifdef __LINUX__
+                    // What is in the buffer is out, the kernel takes it from the file straight into the socket.
+                    off_t offset = static_cast<off_t>(m_TransferOffset);
+                    size_t size = static_cast<size_t>(m_TransferLength > 0x7FFFF000 ? 0x7FFFF000 : m_TransferLength);
+
+                    sendSize = static_cast<int32_t>(::sendfile(m_Socket, m_TransferFile, &offset, size));
+
+                    if (sendSize > 0) {
+                        m_TransferOffset += sendSize;
+                        m_TransferLength -= sendSize;
+                    } else if (sendSize == 0) {
+                        // The file is shorter than announced, the other side will never get what it is waiting for.
+                        TRACE_L1("Transfer of file %d ended %d bytes short", m_TransferFile, static_cast<uint32_t>(m_TransferLength));
+                        m_TransferLength = 0;
+                        m_State |= SocketPort::EXCEPTION;
+                        StateChange();
+                    }
+#else
+                    ASSERT(false);
+                    sendSize = 0;
+#endif
+                }
                 // Sockets are non blocking the Send buffer size is equal to the buffer size. We only send
                 // if the buffer free (SEND flag) is active, so the buffer should always fit.
-                if (((m_State & SocketPort::LINK) == 0) && (m_RemoteNode.IsValid() == true)) {
+                else if (((m_State & SocketPort::LINK) == 0) && (m_RemoteNode.IsValid() == true)) {
                     ASSERT(m_RemoteNode.IsValid() == true);
 
                     sendSize = ::sendto(m_Socket,
@@ -825,21 +884,27 @@ namespace Core {
                         static_cast<const NodeId&>(m_RemoteNode),
                         m_RemoteNode.Size());
 
+                    if (sendSize >= 0) {
+                        m_SendOffset = m_SendBytes;
+                    }
                 } else {
                     sendSize = ::send(m_Socket,
                         reinterpret_cast<const char*>(&m_SendBuffer[m_SendOffset]),
                         m_SendBytes - m_SendOffset, 0);
+
+                    if (sendSize >= 0) {
+                        m_SendOffset = ((m_State & SocketPort::LINK) != 0 ? m_SendOffset + sendSize : m_SendBytes);
+                    }
                 }
 
-                if (sendSize >= 0) {
-                    m_SendOffset = ((m_State & SocketPort::LINK) != 0 ? m_SendOffset + sendSize : m_SendBytes);
-                } else {
+                if (sendSize < 0) {
                     uint32_t l_Result = __ERRORRESULT__;
 
                     if ((l_Result == __ERROR_WOULDBLOCK__) || (l_Result == __ERROR_AGAIN__) || (l_Result == __ERROR_INPROGRESS__)) {
                         m_State |= SocketPort::WRITE;
                     } else {
                         printf("Write exception. %d\n", l_Result);
+                        m_TransferLength = 0;
                         m_State |= SocketPort::EXCEPTION;
                         StateChange();
                     }
@@ -24,6 +24,7 @@
 #ifndef __SOCKETPORT_H
 #define __SOCKETPORT_H
 
+#include "FileSystem.h"
 #include "Module.h"
 #include "NodeId.h"
 #include "Portability.h"
@@ -187,6 +188,7 @@ namespace Core {
             m_ReadBytes = 0;
             m_SendBytes = 0;
             m_SendOffset = 0;
+            m_TransferLength = 0;
             m_syncAdmin.Unlock();
         }
 
@@ -207,6 +209,12 @@ namespace Core {
         uint32_t Close(const uint32_t waitTime);
         void Trigger();
 
+        // Have the kernel send <length> bytes of <file>, starting at <offset>, once the data SendData returns
+        // is out. Only to be called from within SendData, the file must stay open till the next SendData call.
+        // Returns false if this socket can not do so (not a connected stream or no sendfile on this platform),
+        // the caller has to copy the data into the send buffer itself then.
+        bool Transfer(const File::Handle file, const uint64_t offset, const uint64_t length);
+
         // Methods to extract and insert data into the socket buffers
         virtual uint16_t SendData(uint8_t* dataFrame, const uint16_t maxSendSize) = 0;
         virtual uint16_t ReceiveData(uint8_t* dataFrame, const uint16_t receivedSize) = 0;
@@ -263,6 +271,9 @@ namespace Core {
         uint16_t m_ReadBytes;
         uint16_t m_SendBytes;
         uint16_t m_SendOffset;
+        File::Handle m_TransferFile;
+        uint64_t m_TransferOffset;
+        uint64_t m_TransferLength;
     };
 
     class EXTERNAL SocketStream : public SocketPort {
@@ -207,7 +207,8 @@ namespace Core {
 
         inline bool operator==(const string& RHS) const
         {
-            return (equal_case_sensitive(TextFragment(RHS)));
+            // Refer to the text, do not copy it, the fragment only lives during the compare.
+            return (equal_case_sensitive(TextFragment(RHS.c_str(), static_cast<uint32_t>(RHS.length()))));
         }
 
         inline bool operator!=(const TextFragment& RHS) const
@@ -78,6 +78,7 @@
 #include "Services.h"
 #include "SharedBuffer.h"
 #include "Singleton.h"
+#include "Snapshot.h"
 #include "SocketPort.h"
 #include "SocketServer.h"
 #include "StateTrigger.h"
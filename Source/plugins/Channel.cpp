@@ -20,8 +20,18 @@
 #include "Channel.h"
 
 namespace WPEFramework {
+
+ENUM_CONVERSION_BEGIN(PluginHost::Channel::queuepolicy)
+
+    { PluginHost::Channel::DROP_OLDEST, _TXT("dropoldest") },
+    { PluginHost::Channel::COALESCE, _TXT("coalesce") },
+    { PluginHost::Channel::DISCONNECT, _TXT("disconnect") },
+
+ENUM_CONVERSION_END(PluginHost::Channel::queuepolicy)
+
 namespace PluginHost {
 
+    /* static */ constexpr TCHAR Channel::BatchIdentifier[];
     /* static */ RequestPool Channel::_requestAllocator(10);
 
 #ifdef __WINDOWS__
@@ -38,6 +48,10 @@ namespace PluginHost {
         , _text()
         , _offset(0)
         , _sendQueue()
+        , _queueLimit(0)
+        , _queuePolicy(DROP_OLDEST)
+        , _dropped(0)
+        , _coalesced(0)
     {
     }
 #ifdef __WINDOWS__
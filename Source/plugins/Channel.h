@@ -57,6 +57,10 @@ namespace PluginHost {
             }
 
         public:
+            bool IsJSON() const
+            {
+                return (_json);
+            }
             const string& Text() const
             {
                 return (_info.text);
@@ -112,7 +116,15 @@ namespace PluginHost {
 				}
 
 				if (_current.IsValid() == true) {
-                    loaded = _current->Serialize(stream, length, _offset);
+                    if (_parent.IsMessagePack() == true) {
+                        const Core::JSON::IMessagePack* package = dynamic_cast<const Core::JSON::IMessagePack*>(_current.operator->());
+
+                        ASSERT(package != nullptr);
+
+                        loaded = (package != nullptr ? package->Serialize(reinterpret_cast<uint8_t*>(stream), length, _offset) : 0);
+                    } else {
+                        loaded = _current->Serialize(stream, length, _offset);
+                    }
                     if ( (_offset == 0) || (loaded != length) ) {
                         _current.Release();
                     }
@@ -153,12 +165,23 @@ namespace PluginHost {
 
                 if (_current.IsValid() == false) {
                     if (_parent.IsOpen() == true) {
-                        _current = _parent.Element(EMPTY_STRING);
+                        // A JSON-RPC batch is recognized by its first character, it needs a different element.
+                        const bool batch = ((_parent.State() == JSONRPC) && (Core::JSONRPC::Batch::IsBatch(reinterpret_cast<const uint8_t*>(stream), length, _parent.IsMessagePack()) == true));
+
+                        _current = _parent.Element(batch == true ? BatchIdentifier : EMPTY_STRING);
                         _offset = 0;
                     }
                 } 
 				if (_current.IsValid() == true) {
-                    loaded = _current->Deserialize(stream, length, _offset);
+                    if (_parent.IsMessagePack() == true) {
+                        Core::JSON::IMessagePack* package = dynamic_cast<Core::JSON::IMessagePack*>(_current.operator->());
+
+                        ASSERT(package != nullptr);
+
+                        loaded = (package != nullptr ? package->Deserialize(reinterpret_cast<const uint8_t*>(stream), length, _offset) : length);
+                    } else {
+                        loaded = _current->Deserialize(stream, length, _offset);
+                    }
                     if ( (_offset == 0) || (loaded != length)) {
                         _parent.Received(_current);
                         _current.Release();
@@ -184,6 +207,18 @@ namespace PluginHost {
             JSONRPC = 0x20
         };
 
+        // What to do with an outbound notification if the send queue is full, i.e. the client does
+        // not keep up. Other outbound messages (responses) are always queued.
+        enum queuepolicy : uint8_t {
+            DROP_OLDEST,
+            COALESCE, // Replace a queued notification of the same event, if any, else drop the oldest.
+            DISCONNECT
+        };
+
+    public:
+        // Identifier passed to Element() when the inbound JSON-RPC frame holds a batch.
+        static constexpr TCHAR BatchIdentifier[] = _T("[");
+
     public:
         Channel() = delete;
         Channel(const Channel& copy) = delete;
@@ -230,6 +265,24 @@ namespace PluginHost {
         {
             return ((_state & 0x8000) != 0);
         }
+        inline bool IsMessagePack() const
+        {
+            return ((_state & 0x2000) != 0);
+        }
+        // A limit of 0 means the send queue is not limited.
+        inline void SendQueue(const uint16_t limit, const queuepolicy policy)
+        {
+            _queueLimit = limit;
+            _queuePolicy = policy;
+        }
+        inline uint32_t Dropped() const
+        {
+            return (_dropped);
+        }
+        inline uint32_t Coalesced() const
+        {
+            return (_coalesced);
+        }
         inline void Submit(const string& text)
         {
             if (IsOpen() == true) {
@@ -250,16 +303,23 @@ namespace PluginHost {
         inline void Submit(const Core::ProxyType<Core::JSON::IElement>& entry)
         {
             if (IsOpen() == true) {
+                bool trigger = false;
+                bool disconnect = false;
 
                 _adminLock.Lock();
 
-                _sendQueue.emplace_back(entry);
+                if ((_queueLimit == 0) || (_sendQueue.size() < _queueLimit) || (Admit(entry, disconnect) == true)) {
+                    _sendQueue.emplace_back(entry);
 
-                bool trigger = (_sendQueue.size() == 1);
+                    trigger = (_sendQueue.size() == 1);
+                }
 
                 _adminLock.Unlock();
 
-                if (trigger == true) {
+                if (disconnect == true) {
+                    TRACE_L1("Send queue of channel %d is full, closing it.", _ID);
+                    BaseClass::Close(0);
+                } else if (trigger == true) {
                     BaseClass::Trigger();
                 }
             }
@@ -290,10 +350,10 @@ namespace PluginHost {
         {
             _nameOffset = offset;
         }
-        inline void State(const ChannelState state, const bool notification)
+        inline void State(const ChannelState state, const bool notification, const bool messagePack = false)
         {
-            Binary(state == RAW);
-            _state = state | (notification ? 0x8000 : 0x0000);
+            Binary((state == RAW) || (messagePack == true));
+            _state = state | (notification ? 0x8000 : 0x0000) | (messagePack ? 0x2000 : 0x0000);
         }
         inline uint16_t Serialize(uint8_t* dataFrame, const uint16_t maxSendSize)
         {
@@ -328,24 +388,29 @@ namespace PluginHost {
                     // Seems we need to send plain strings...
                     _adminLock.Lock();
                     Package& data(_sendQueue.front());
-                    uint16_t neededBytes(static_cast<uint16_t>(data.Text().length() - _offset));
+                    const size_t neededBytes(data.Text().length() - _offset);
+                    bool trigger = false;
 
-                    if (neededBytes <= maxSendSize) {
+                    // A text of any length goes out in frames of the buffer size. A full frame tells there is
+                    // more to come, so a text that fills it exactly is ended by an empty frame next time.
+                    if (neededBytes < maxSendSize) {
                         ::memcpy(dataFrame, &(data.Text().c_str()[_offset]), neededBytes);
-                        size = neededBytes;
+                        size = static_cast<uint16_t>(neededBytes);
                         _offset = 0;
 
                         // See if there is more to do..
                         _sendQueue.pop_front();
+                        trigger = ((size == 0) && (_sendQueue.size() > 0));
                     } else {
-                        uint16_t addedBytes = maxSendSize - size;
-                        ::memcpy(dataFrame, &(data.Text().c_str()[_offset]), addedBytes);
-                        _offset += addedBytes;
-                        size = addedBytes;
+                        ::memcpy(dataFrame, &(data.Text().c_str()[_offset]), maxSendSize);
+                        _offset += maxSendSize;
+                        size = maxSendSize;
                     }
                     _adminLock.Unlock();
 
-                    ASSERT(size != 0);
+                    if (trigger == true) {
+                        BaseClass::Trigger();
+                    }
 
                     break;
                 }
@@ -376,7 +441,9 @@ namespace PluginHost {
                 break;
             }
             case TEXT: {
-                _text += string(reinterpret_cast<const TCHAR*>(dataFrame), receivedSize);
+                // The frames of a message are collected, the buffer keeps its capacity for the next one.
+                // How large it can grow is bounded by the maximum message size of the link.
+                _text.append(reinterpret_cast<const TCHAR*>(dataFrame), receivedSize);
 
                 if (BaseClass::IsCompleted() == true) {
                     Received(_text);
@@ -442,6 +509,59 @@ namespace PluginHost {
 			return (result);
 		}
 
+        // The send queue is full, make room for the entry according to the policy. Returns false if
+        // the entry should not be queued (anymore). Called with the _adminLock taken.
+        bool Admit(const Core::ProxyType<Core::JSON::IElement>& entry, bool& disconnect)
+        {
+            bool admit = true;
+            const Core::ProxyType<const Core::JSONRPC::Notification> notification(Core::proxy_cast<const Core::JSONRPC::Notification>(entry));
+
+            if (notification.IsValid() == true) {
+                if (_queuePolicy == DISCONNECT) {
+                    disconnect = true;
+                    admit = false;
+                    _dropped++;
+                } else {
+                    // The front entry might be on its way out, leave it alone.
+                    std::list<Package>::iterator index(std::next(_sendQueue.begin()));
+                    std::list<Package>::iterator oldest(_sendQueue.end());
+
+                    while (index != _sendQueue.end()) {
+                        const Core::ProxyType<const Core::JSONRPC::Notification> queued(index->IsJSON() == true ? Core::proxy_cast<const Core::JSONRPC::Notification>(index->JSON()) : Core::ProxyType<const Core::JSONRPC::Notification>());
+
+                        if (queued.IsValid() == false) {
+                            index++;
+                        } else if ((_queuePolicy == COALESCE) && (queued->Event() == notification->Event()) && (queued->Designator() == notification->Designator())) {
+                            // Only the latest value matters, it takes the place of the queued one.
+                            index = _sendQueue.erase(index);
+                            _sendQueue.emplace(index, entry);
+                            _coalesced++;
+                            admit = false;
+                            break;
+                        } else {
+                            if (oldest == _sendQueue.end()) {
+                                oldest = index;
+                            }
+                            index++;
+                        }
+                    }
+
+                    if (admit == true) {
+                        _dropped++;
+
+                        if (oldest != _sendQueue.end()) {
+                            _sendQueue.erase(oldest);
+                        } else {
+                            // Nothing queued we may drop, so it is this one.
+                            admit = false;
+                        }
+                    }
+                }
+            }
+
+            return (admit);
+        }
+
     private:
         mutable Core::CriticalSection _adminLock;
         uint32_t _ID;
@@ -452,6 +572,10 @@ namespace PluginHost {
         string _text;
         uint32_t _offset;
         std::list<Package> _sendQueue;
+        uint16_t _queueLimit;
+        queuepolicy _queuePolicy;
+        uint32_t _dropped;
+        uint32_t _coalesced;
 
         // All requests needed by any instance of this webserver are coming from this web server. They are extracted
         // from a pool. If the request is nolonger needed, the request returns to this pool.
@@ -37,6 +37,8 @@ namespace Plugin {
             , ClassName()
             , Versions()
             , AutoStart(true)
+            , Lazy(false)
+            , IdleTimeout(0)
             , Resumed(false)
             , WebUI()
             , Precondition()
@@ -48,6 +50,8 @@ namespace Plugin {
             Add(_T("classname"), &ClassName);
             Add(_T("versions"), &Versions);
             Add(_T("autostart"), &AutoStart);
+            Add(_T("lazy"), &Lazy);
+            Add(_T("idletimeout"), &IdleTimeout);
             Add(_T("resumed"), &Resumed);
             Add(_T("webui"), &WebUI);
             Add(_T("precondition"), &Precondition);
@@ -61,6 +65,8 @@ namespace Plugin {
             , ClassName(copy.ClassName)
             , Versions(copy.Versions)
             , AutoStart(copy.AutoStart)
+            , Lazy(copy.Lazy)
+            , IdleTimeout(copy.IdleTimeout)
             , Resumed(copy.Resumed)
             , WebUI(copy.WebUI)
             , Precondition(copy.Precondition)
@@ -72,6 +78,8 @@ namespace Plugin {
             Add(_T("classname"), &ClassName);
             Add(_T("versions"), &Versions);
             Add(_T("autostart"), &AutoStart);
+            Add(_T("lazy"), &Lazy);
+            Add(_T("idletimeout"), &IdleTimeout);
             Add(_T("resumed"), &Resumed);
             Add(_T("webui"), &WebUI);
             Add(_T("precondition"), &Precondition);
@@ -89,6 +97,8 @@ namespace Plugin {
             ClassName = RHS.ClassName;
             Versions = RHS.Versions;
             AutoStart = RHS.AutoStart;
+            Lazy = RHS.Lazy;
+            IdleTimeout = RHS.IdleTimeout;
             Resumed = RHS.Resumed;
             WebUI = RHS.WebUI;
             Configuration = RHS.Configuration;
@@ -104,6 +114,8 @@ namespace Plugin {
         Core::JSON::String ClassName;
         Core::JSON::String Versions;
         Core::JSON::Boolean AutoStart;
+        Core::JSON::Boolean Lazy;
+        Core::JSON::DecUInt16 IdleTimeout;
         Core::JSON::Boolean Resumed;
         Core::JSON::String WebUI;
         Core::JSON::ArrayType<Core::JSON::EnumType<PluginHost::ISubSystem::subsystem>> Precondition;
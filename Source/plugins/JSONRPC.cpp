@@ -25,5 +25,6 @@ namespace WPEFramework {
 namespace PluginHost {
 
     /* static */ Core::ProxyPoolType<Web::JSONBodyType<Core::JSONRPC::Message>> JSONRPC::_jsonRPCMessageFactory(4);
+    /* static */ Core::ProxyPoolType<Core::JSONRPC::Notification> JSONRPC::_notificationFactory(4);
 }
 } // namespace WPEFramework::PluginHost
@@ -74,30 +74,155 @@ namespace PluginHost {
             STATE_REGISTRATION,
             STATE_UNREGISTRATION,
             STATE_EXISTS,
-            STATE_CUSTOM
+            STATE_CUSTOM,
+            STATE_ASYNCHRONOUS
+        };
+
+        // An asynchronous call that is not answered yet. It is kept by the sequence handed out with its connection,
+        // the id of the call is only what the caller gets back, callers reuse ids.
+        class Pending {
+        public:
+            Pending() = delete;
+            Pending& operator=(const Pending&) = delete;
+
+            Pending(const uint32_t channelId, const uint32_t id, const uint64_t deadline)
+                : ChannelId(channelId)
+                , Id(id)
+                , Deadline(deadline)
+            {
+            }
+            Pending(const Pending& copy) = default;
+            ~Pending() = default;
+
+        public:
+            const uint32_t ChannelId;
+            const uint32_t Id;
+            const uint64_t Deadline;
+        };
+
+        typedef std::map<uint32_t, Pending> PendingMap;
+
+        // How long the answers of a cacheable property are kept, and the events that make them outdated.
+        class CachePolicy {
+        public:
+            CachePolicy() = delete;
+            CachePolicy& operator=(const CachePolicy&) = delete;
+
+            CachePolicy(const uint32_t timeToLive, const std::vector<string>& events)
+                : TimeToLive(timeToLive)
+                , Events(events)
+            {
+            }
+            CachePolicy(const CachePolicy& copy) = default;
+            ~CachePolicy() = default;
+
+        public:
+            const uint32_t TimeToLive;
+            const std::vector<string> Events;
+        };
+
+        class CacheEntry {
+        public:
+            CacheEntry() = delete;
+            CacheEntry& operator=(const CacheEntry&) = delete;
+
+            CacheEntry(const string& property, const string& result, const uint64_t expiry)
+                : Property(property)
+                , Result(result)
+                , Expiry(expiry)
+            {
+            }
+            CacheEntry(const CacheEntry& copy) = default;
+            ~CacheEntry() = default;
+
+        public:
+            const string Property;
+            const string Result;
+            const uint64_t Expiry;
+        };
+
+        typedef std::map<string, CachePolicy> CachePolicies;
+        typedef std::unordered_map<string, CacheEntry> CacheEntries;
+
+        class Expiry : public Core::IDispatch {
+        public:
+            Expiry() = delete;
+            Expiry(const Expiry&) = delete;
+            Expiry& operator=(const Expiry&) = delete;
+
+            Expiry(JSONRPC* parent)
+                : _parent(*parent)
+            {
+            }
+            ~Expiry() override
+            {
+            }
+
+        public:
+            void Dispatch() override
+            {
+                _parent.Expired();
+            }
+
+        private:
+            JSONRPC& _parent;
         };
 
     public:
+        // Time an asynchronous method gets to answer, before the caller is answered with ERROR_TIMEDOUT.
+        static constexpr uint32_t DefaultAsyncTimeout = 30000;
+        // Every index of a property, and every set of parameters it is read with, is cached on its own, so the number of answers kept is limited.
+        static constexpr uint16_t MaxCacheEntries = 256;
+
         JSONRPC(const JSONRPC&) = delete;
         JSONRPC& operator=(const JSONRPC&) = delete;
         JSONRPC()
             : _adminLock()
             , _handlers()
             , _service(nullptr)
+            , _pending()
+            , _sequence(0)
+            , _asyncTimeout(DefaultAsyncTimeout)
+            , _scheduled(0)
+            , _expiry(Core::ProxyType<Expiry>::Create(this))
+            , _cacheLock()
+            , _cachePolicies()
+            , _cacheEntries()
+            , _cacheGeneration(0)
+            , _caching(false)
+            , _cacheHits(0)
+            , _cacheMisses(0)
         {
             std::vector<uint8_t> versions = { 1 };
 
-            _handlers.emplace_back([&](const uint32_t id, const string& designator, const string& data) { Notify(id, designator, data); }, versions);
+            _handlers.emplace_back([&](const uint32_t id, const string& designator, const Core::ProxyType<const Core::JSONRPC::Notification::Frame>& frame) { Notify(id, designator, frame); }, versions);
         }
         JSONRPC(const std::vector<uint8_t> versions)
             : _adminLock()
             , _handlers()
             , _service(nullptr)
-        {
-            _handlers.emplace_back([&](const uint32_t id, const string& designator, const string& data) { Notify(id, designator, data); }, versions);
+            , _pending()
+            , _sequence(0)
+            , _asyncTimeout(DefaultAsyncTimeout)
+            , _scheduled(0)
+            , _expiry(Core::ProxyType<Expiry>::Create(this))
+            , _cacheLock()
+            , _cachePolicies()
+            , _cacheEntries()
+            , _cacheGeneration(0)
+            , _caching(false)
+            , _cacheHits(0)
+            , _cacheMisses(0)
+        {
+            _handlers.emplace_back([&](const uint32_t id, const string& designator, const Core::ProxyType<const Core::JSONRPC::Notification::Frame>& frame) { Notify(id, designator, frame); }, versions);
         }
         virtual ~JSONRPC()
         {
+            ASSERT(_pending.empty() == true);
+
+            if ((_scheduled != 0) && (Core::IWorkerPool::IsAvailable() == true)) {
+                Core::IWorkerPool::Instance().Revoke(Core::proxy_cast<Core::IDispatch>(_expiry));
+            }
         }
 
     public:
@@ -130,12 +255,12 @@ namespace PluginHost {
         }
         Core::JSONRPC::Handler& CreateHandler(const std::vector<uint8_t>& versions)
         {
-            _handlers.emplace_back([&](const uint32_t id, const string& designator, const string& data) { Notify(id, designator, data); }, versions);
+            _handlers.emplace_back([&](const uint32_t id, const string& designator, const Core::ProxyType<const Core::JSONRPC::Notification::Frame>& frame) { Notify(id, designator, frame); }, versions);
             return (_handlers.back());
         }
         Core::JSONRPC::Handler& CreateHandler(const std::vector<uint8_t>& versions, const Core::JSONRPC::Handler& source)
         {
-            _handlers.emplace_back([&](const uint32_t id, const string& designator, const string& data) { Notify(id, designator, data); }, versions, source);
+            _handlers.emplace_back([&](const uint32_t id, const string& designator, const Core::ProxyType<const Core::JSONRPC::Notification::Frame>& frame) { Notify(id, designator, frame); }, versions, source);
             return (_handlers.back());
         }
         Core::JSONRPC::Handler* GetHandler(uint8_t version)
@@ -206,21 +331,80 @@ namespace PluginHost {
         // ------------------------------------------------------------------------------------------------------------------------------
         uint32_t Notify(const string& event)
         {
+            Outdated(event);
             return (_handlers.front().Notify(event, Core::JSON::String()));
         }
         template <typename JSONOBJECT>
         uint32_t Notify(const string& event, const JSONOBJECT& parameters)
         {
+            Outdated(event);
             return (_handlers.front().Notify(event, parameters));
         }
         template <typename JSONOBJECT, typename SENDIFMETHOD>
         uint32_t Notify(const string& event, const JSONOBJECT& parameters, SENDIFMETHOD method)
         {
+            Outdated(event);
             return (_handlers.front().Notify(event, parameters, method));
         }
 
+        //
+        // Properties that are polled a lot, but hardly change, can be answered from a cache instead of calling the getter
+        // every time. An answer is kept for at most timeToLive ms, per index and parameters, and dropped as soon as one of the
+        // given events is notified, the property is set or Invalidate() is called for it.
+        // ------------------------------------------------------------------------------------------------------------------------------
+        void Cacheable(const string& property, const uint32_t timeToLive, const std::vector<string>& events = std::vector<string>())
+        {
+            ASSERT(timeToLive != 0);
+
+            _cacheLock.Lock();
+
+            _cachePolicies.erase(property);
+            _cachePolicies.emplace(std::piecewise_construct,
+                std::forward_as_tuple(property),
+                std::forward_as_tuple(timeToLive, events));
+            _caching = true;
+
+            _cacheLock.Unlock();
+        }
+        void Invalidate(const string& property)
+        {
+            _cacheLock.Lock();
+
+            Evict(property);
+
+            _cacheLock.Unlock();
+        }
+        bool IsCaching() const
+        {
+            return (_caching);
+        }
+        // Tells if a call to this designator would reach a method, the built in ones included.
+        bool Handles(const string& designator)
+        {
+            Core::JSONRPC::Handler* source = nullptr;
+            const state destination = Destination(designator, source);
+
+            return ((destination != STATE_INCORRECT_HANDLER) && (destination != STATE_INCORRECT_VERSION) && (destination != STATE_UNKNOWN_METHOD));
+        }
+        void CacheStatistics(uint32_t& hits, uint32_t& misses, uint32_t& entries) const
+        {
+            _cacheLock.Lock();
+
+            hits = _cacheHits;
+            misses = _cacheMisses;
+            entries = static_cast<uint32_t>(_cacheEntries.size());
+
+            _cacheLock.Unlock();
+        }
+
         //
         // Methods to send responses to inbound invokaction methods (a-synchronous callbacks)
+        // Methods registered with a Core::JSONRPC::Connection as first argument return without answering, the
+        // worker thread is free again. The connection passed to them is the token to complete the call with, from
+        // any thread, exactly once. Its sequence is not the id of the call, it is handed out by this JSONRPC, the
+        // caller gets its own id back. A call that is not completed within the AsyncTimeout() is answered with
+        // ERROR_TIMEDOUT, a call of which the channel closed is dropped. Completing such a call, or a notification
+        // that does not expect an answer, returns ERROR_ALREADY_RELEASED.
         // ------------------------------------------------------------------------------------------------------------------------------
         template <typename JSONOBJECT>
         uint32_t Response(const Core::JSONRPC::Connection& channel, const JSONOBJECT& parameters)
@@ -231,27 +415,54 @@ namespace PluginHost {
         }
         uint32_t Response(const Core::JSONRPC::Connection& channel, const string& result)
         {
-            Core::ProxyType<Web::JSONBodyType<Core::JSONRPC::Message>> message = _jsonRPCMessageFactory.Element();
+            uint32_t status = Core::ERROR_ALREADY_RELEASED;
+            uint32_t id;
 
-            ASSERT(_service != nullptr);
+            if (Complete(channel, id) == true) {
+                Core::ProxyType<Web::JSONBodyType<Core::JSONRPC::Message>> message = _jsonRPCMessageFactory.Element();
 
-            message->Result = result;
-            message->Id = channel.Sequence();
-            message->JSONRPC = Core::JSONRPC::Message::DefaultVersion;
+                message->Result = result;
+
+                status = Send(channel.ChannelId(), id, message);
+            }
 
-            return (_service->Submit(channel.ChannelId(), Core::ProxyType<Core::JSON::IElement>(message)));
+            return (status);
         }
         uint32_t Response(const Core::JSONRPC::Connection& channel, const Core::JSONRPC::Error& result)
         {
-            Core::ProxyType<Web::JSONBodyType<Core::JSONRPC::Message>> message = _jsonRPCMessageFactory.Element();
+            uint32_t status = Core::ERROR_ALREADY_RELEASED;
+            uint32_t id;
 
-            ASSERT(_service != nullptr);
+            if (Complete(channel, id) == true) {
+                Core::ProxyType<Web::JSONBodyType<Core::JSONRPC::Message>> message = _jsonRPCMessageFactory.Element();
 
-            message->Error = result;
-            message->Id = channel.Sequence();
-            message->JSONRPC = Core::JSONRPC::Message::DefaultVersion;
+                message->Error = result;
+
+                status = Send(channel.ChannelId(), id, message);
+            }
+
+            return (status);
+        }
+        // Long running asynchronous work can check if the caller is still waiting for it.
+        bool IsPending(const Core::JSONRPC::Connection& channel) const
+        {
+            _adminLock.Lock();
+
+            PendingMap::const_iterator index(_pending.find(channel.Sequence()));
+            bool result = ((index != _pending.cend()) && (index->second.ChannelId == channel.ChannelId()));
 
-            return (_service->Submit(channel.ChannelId(), Core::ProxyType<Core::JSON::IElement>(message)));
+            _adminLock.Unlock();
+
+            return (result);
+        }
+        uint32_t AsyncTimeout() const
+        {
+            return (_asyncTimeout);
+        }
+        // Applies to the calls made from now on.
+        void AsyncTimeout(const uint32_t waitTime)
+        {
+            _asyncTimeout = waitTime;
         }
 
     protected:
@@ -278,7 +489,9 @@ namespace PluginHost {
                 response->Id = inbound.Id.Value();
             }
 
-            switch (Destination(inbound.Designator.Value(), source)) {
+            const state destination = Destination(inbound.Designator.Value(), source);
+
+            switch (destination) {
             case STATE_INCORRECT_HANDLER:
                 response->Error.SetError(Core::ERROR_INVALID_DESIGNATOR);
                 response->Error.Text = _T("Destined invoke failed.");
@@ -306,9 +519,26 @@ namespace PluginHost {
                     response->Result = Core::NumberType<uint32_t>(Core::ERROR_UNKNOWN_KEY).Text();
                 }
                 break;
+            case STATE_ASYNCHRONOUS:
             case STATE_CUSTOM:
+                const bool tracked = ((destination == STATE_ASYNCHRONOUS) && (inbound.Id.IsSet() == true));
+                // The answer might be given before the call even returns, so it is expected up front.
+                const Core::JSONRPC::Connection connection(channelId, (tracked == true ? Expect(channelId, inbound.Id.Value()) : inbound.Id.Value()));
                 string result;
-                uint32_t code = source->Invoke(Core::JSONRPC::Connection(channelId, inbound.Id.Value()), inbound.FullMethod(), inbound.Parameters.Value(), result);
+                uint32_t code;
+
+                if ((destination == STATE_CUSTOM) && (_caching == true)) {
+                    code = Cached(*source, connection, inbound, result);
+                } else {
+                    code = source->Invoke(connection, inbound.FullMethod(), inbound.Parameters.Value(), result);
+                }
+
+                if ((tracked == true) && (code != static_cast<uint32_t>(~0))) {
+                    uint32_t id;
+
+                    // Unregistered in the meantime, so it was not handled at all.
+                    Complete(connection, id);
+                }
                 if (response.IsValid() == true) {
                     if (code == static_cast<uint32_t>(~0)) {
                         response.Release();
@@ -328,12 +558,13 @@ namespace PluginHost {
         state Destination(const string& designator, Core::JSONRPC::Handler*& source)
         {
             state result = STATE_INCORRECT_HANDLER;
-            string callsign(Core::JSONRPC::Message::Callsign(designator));
+            const Core::JSONRPC::DesignatorFragments fragments(designator);
+            const Core::TextFragment& callsign(fragments.Callsign());
 
-            if (callsign.empty() || (callsign == _callsign)) {
+            if (callsign.IsEmpty() || (callsign == _callsign)) {
                 // Seems we are on the right handler..
                 // now see if someone supports this version
-                uint8_t version = Core::JSONRPC::Message::Version(designator);
+                uint8_t version = fragments.Version();
                 HandlerList::iterator index(_handlers.begin());
 
                 if (version != static_cast<uint8_t>(~0)) {
@@ -345,7 +576,7 @@ namespace PluginHost {
                 if (index == _handlers.end()) {
                     result = STATE_INCORRECT_VERSION;
                 } else {
-                    string method(Core::JSONRPC::Message::Method(designator));
+                    const Core::TextFragment& method(fragments.Method());
 
                     if (method == _T("register")) {
                         result = STATE_REGISTRATION;
@@ -356,29 +587,245 @@ namespace PluginHost {
                     } else if (method == _T("exists")) {
                         result = STATE_EXISTS;
                         source = &(*index);
-                    } else if (index->Exists(method) == Core::ERROR_NONE) {
-                        source = &(*index);
-                        result = STATE_CUSTOM;
                     } else {
-                        result = STATE_UNKNOWN_METHOD;
+                        bool asynchronous = false;
+
+                        if (index->Exists(method, asynchronous) == Core::ERROR_NONE) {
+                            source = &(*index);
+                            result = (asynchronous == true ? STATE_ASYNCHRONOUS : STATE_CUSTOM);
+                        } else {
+                            result = STATE_UNKNOWN_METHOD;
+                        }
                     }
                 }
             }
             return (result);
         }
-        void Notify(const uint32_t id, const string& designator, const string& parameters)
+        // A read of a cacheable property is answered from the cache if possible, per index and per parameters it is
+        // called with. A call that succeeds without a result is a set, only that drops what is cached for the property.
+        uint32_t Cached(Core::JSONRPC::Handler& source, const Core::JSONRPC::Connection& connection, const Core::JSONRPC::Message& inbound, string& result)
         {
-            Core::ProxyType<Core::JSONRPC::Message> message(_jsonRPCMessageFactory.Element());
+            const string method(inbound.FullMethod());
+            const string property(Core::JSONRPC::Message::Method(inbound.Designator.Value()));
+            // A designator never holds a line feed, so this can not be mistaken for another method.
+            const string key(inbound.Parameters.Value().empty() == true ? method : method + '\n' + inbound.Parameters.Value());
+            const uint64_t now = Core::Time::Now().Ticks();
+            uint32_t code = Core::ERROR_UNAVAILABLE;
+            uint32_t timeToLive = 0;
+            uint32_t generation;
 
-            ASSERT(_service != nullptr);
+            _cacheLock.Lock();
+
+            CachePolicies::const_iterator policy(_cachePolicies.find(property));
+
+            if (policy != _cachePolicies.cend()) {
+                CacheEntries::const_iterator entry(_cacheEntries.find(key));
+
+                if ((entry != _cacheEntries.cend()) && (entry->second.Expiry > now)) {
+                    result = entry->second.Result;
+                    code = Core::ERROR_NONE;
+                    _cacheHits++;
+                } else {
+                    timeToLive = policy->second.TimeToLive;
+                    _cacheMisses++;
+                }
+            }
+
+            generation = _cacheGeneration;
+
+            _cacheLock.Unlock();
+
+            if (code != Core::ERROR_NONE) {
+                code = source.Invoke(connection, method, inbound.Parameters.Value(), result);
+
+                if ((code == Core::ERROR_NONE) && (timeToLive != 0)) {
+                    _cacheLock.Lock();
+
+                    if (result.empty() == true) {
+                        // Dropped after the set is done, so a read that ran along with it is not kept either.
+                        Evict(property);
+                    } else if (generation == _cacheGeneration) {
+                        // Whatever was outdated while the getter ran, might be outdated by this answer as well.
+                        if (_cacheEntries.size() >= MaxCacheEntries) {
+                            EvictExpired(now);
+                        }
+                        if (_cacheEntries.size() < MaxCacheEntries) {
+                            _cacheEntries.erase(key);
+                            _cacheEntries.emplace(std::piecewise_construct,
+                                std::forward_as_tuple(key),
+                                std::forward_as_tuple(property, result, now + (static_cast<uint64_t>(timeToLive) * Core::Time::TicksPerMillisecond)));
+                        }
+                    }
+
+                    _cacheLock.Unlock();
+                }
+            }
+
+            return (code);
+        }
+        // Called with the cache lock taken.
+        void Evict(const string& property)
+        {
+            CacheEntries::iterator index(_cacheEntries.begin());
+
+            while (index != _cacheEntries.end()) {
+                if (index->second.Property == property) {
+                    index = _cacheEntries.erase(index);
+                } else {
+                    index++;
+                }
+            }
+
+            _cacheGeneration++;
+        }
+        // Called with the cache lock taken.
+        void EvictExpired(const uint64_t now)
+        {
+            CacheEntries::iterator index(_cacheEntries.begin());
+
+            while (index != _cacheEntries.end()) {
+                if (index->second.Expiry <= now) {
+                    index = _cacheEntries.erase(index);
+                } else {
+                    index++;
+                }
+            }
+        }
+        void Outdated(const string& event)
+        {
+            if (_caching == true) {
+                _cacheLock.Lock();
+
+                for (const std::pair<const string, CachePolicy>& policy : _cachePolicies) {
+                    if (std::find(policy.second.Events.cbegin(), policy.second.Events.cend(), event) != policy.second.Events.cend()) {
+                        Evict(policy.first);
+                    }
+                }
 
-            if (!parameters.empty()) {
-                message->Parameters = parameters;
+                _cacheLock.Unlock();
             }
+        }
+        uint32_t Send(const uint32_t channelId, const uint32_t id, Core::ProxyType<Web::JSONBodyType<Core::JSONRPC::Message>>& message)
+        {
+            ASSERT(_service != nullptr);
 
-            message->Designator = designator;
+            message->Id = id;
             message->JSONRPC = Core::JSONRPC::Message::DefaultVersion;
 
+            return (_service->Submit(channelId, Core::ProxyType<Core::JSON::IElement>(message)));
+        }
+        // Returns the sequence the call is known by from now on.
+        uint32_t Expect(const uint32_t channelId, const uint32_t id)
+        {
+            const uint64_t deadline = Core::Time::Now().Add(_asyncTimeout).Ticks();
+
+            _adminLock.Lock();
+
+            const uint32_t sequence = _sequence++;
+
+            _pending.emplace(std::piecewise_construct,
+                std::forward_as_tuple(sequence),
+                std::forward_as_tuple(channelId, id, deadline));
+
+            // The timeout might have been shortened, so this call might expire before the ones scheduled for.
+            if ((_scheduled == 0) || (deadline < _scheduled)) {
+                Schedule(deadline);
+            }
+
+            _adminLock.Unlock();
+
+            return (sequence);
+        }
+        bool Complete(const Core::JSONRPC::Connection& channel, uint32_t& id)
+        {
+            _adminLock.Lock();
+
+            PendingMap::iterator index(_pending.find(channel.Sequence()));
+            bool result = ((index != _pending.end()) && (index->second.ChannelId == channel.ChannelId()));
+
+            if (result == true) {
+                id = index->second.Id;
+                _pending.erase(index);
+            }
+
+            _adminLock.Unlock();
+
+            return (result);
+        }
+        // Called with the lock taken. A later expiry that was scheduled before, stays scheduled, _scheduled is the
+        // earliest one.
+        void Schedule(const uint64_t deadline)
+        {
+            if (Core::IWorkerPool::IsAvailable() == true) {
+                _scheduled = deadline;
+                Core::IWorkerPool::Instance().Schedule(Core::Time(deadline), Core::proxy_cast<Core::IDispatch>(_expiry));
+            }
+        }
+        void Expired()
+        {
+            std::list<Pending> expired;
+            const uint64_t now = Core::Time::Now().Ticks();
+            uint64_t next = ~0;
+
+            _adminLock.Lock();
+
+            PendingMap::iterator index(_pending.begin());
+
+            while (index != _pending.end()) {
+                if (index->second.Deadline <= now) {
+                    expired.push_back(index->second);
+                    index = _pending.erase(index);
+                } else {
+                    next = std::min(next, index->second.Deadline);
+                    index++;
+                }
+            }
+
+            // Whatever expiry that comes after this one, only schedules again if it has to be earlier.
+            if (_scheduled <= now) {
+                _scheduled = 0;
+            }
+
+            if ((_pending.empty() == false) && ((_scheduled == 0) || (next < _scheduled))) {
+                Schedule(next);
+            }
+
+            _adminLock.Unlock();
+
+            for (const Pending& entry : expired) {
+                Core::ProxyType<Web::JSONBodyType<Core::JSONRPC::Message>> message = _jsonRPCMessageFactory.Element();
+
+                message->Error.SetError(Core::ERROR_TIMEDOUT);
+                message->Error.Text = _T("The asynchronous call was not answered in time.");
+
+                Send(entry.ChannelId, entry.Id, message);
+            }
+        }
+        void DropPending(const std::function<bool(const Pending&)>& predicate)
+        {
+            _adminLock.Lock();
+
+            PendingMap::iterator index(_pending.begin());
+
+            while (index != _pending.end()) {
+                if (predicate(index->second) == true) {
+                    index = _pending.erase(index);
+                } else {
+                    index++;
+                }
+            }
+
+            _adminLock.Unlock();
+        }
+        void Notify(const uint32_t id, const string& designator, const Core::ProxyType<const Core::JSONRPC::Notification::Frame>& frame)
+        {
+            // The frame is shared by all subscribers, the notification only adds the designator.
+            Core::ProxyType<Core::JSONRPC::Notification> message(_notificationFactory.Element());
+
+            ASSERT(_service != nullptr);
+
+            message->Set(designator, frame);
+
             _service->Submit(id, Core::ProxyType<Core::JSON::IElement>(message));
         }
         virtual void Activate(IShell* service) override
@@ -399,6 +846,23 @@ namespace PluginHost {
             }
 
             _handlers.front().Close();
+
+            // Nobody is left to answer the calls still pending.
+            DropPending([](const Pending&) { return (true); });
+
+            _cacheLock.Lock();
+            _cacheEntries.clear();
+            _cacheGeneration++;
+            _cacheLock.Unlock();
+
+            if (Core::IWorkerPool::IsAvailable() == true) {
+                Core::IWorkerPool::Instance().Revoke(Core::proxy_cast<Core::IDispatch>(_expiry));
+            }
+
+            _adminLock.Lock();
+            _scheduled = 0;
+            _adminLock.Unlock();
+
             _service = nullptr;
         }
         virtual void Closed(const uint32_t id) override
@@ -409,6 +873,9 @@ namespace PluginHost {
                 index->Close(id);
                 index++;
             }
+
+            // The caller is gone, a late answer is refused instead of sent.
+            DropPending([id](const Pending& entry) { return (entry.ChannelId == id); });
         }
 
     private:
@@ -416,8 +883,21 @@ namespace PluginHost {
         std::list<Core::JSONRPC::Handler> _handlers;
         IShell* _service;
         string _callsign;
+        PendingMap _pending;
+        uint32_t _sequence;
+        std::atomic<uint32_t> _asyncTimeout;
+        uint64_t _scheduled;
+        Core::ProxyType<Expiry> _expiry;
+        mutable Core::CriticalSection _cacheLock;
+        CachePolicies _cachePolicies;
+        CacheEntries _cacheEntries;
+        uint32_t _cacheGeneration;
+        std::atomic<bool> _caching;
+        uint32_t _cacheHits;
+        uint32_t _cacheMisses;
 
         static Core::ProxyPoolType<Web::JSONBodyType<Core::JSONRPC::Message>> _jsonRPCMessageFactory;
+        static Core::ProxyPoolType<Core::JSONRPC::Notification> _notificationFactory;
     };
 
     class EXTERNAL JSONRPCSupportsEventStatus : public JSONRPC {
@@ -152,6 +152,13 @@ ENUM_CONVERSION_BEGIN(PluginHost::MetaData::Channel::state)
         Core::JSON::Container::Add(_T("activity"), &Activity);
         Core::JSON::Container::Add(_T("id"), &ID);
         Core::JSON::Container::Add(_T("name"), &Name);
+        Core::JSON::Container::Add(_T("dropped"), &Dropped);
+        Core::JSON::Container::Add(_T("coalesced"), &Coalesced);
+        Core::JSON::Container::Add(_T("sent"), &Sent);
+        Core::JSON::Container::Add(_T("sentcompressed"), &SentCompressed);
+        Core::JSON::Container::Add(_T("received"), &Received);
+        Core::JSON::Container::Add(_T("receivedcompressed"), &ReceivedCompressed);
+        Core::JSON::Container::Add(_T("compressiontime"), &CompressionTime);
     }
     MetaData::Channel::Channel(const MetaData::Channel& copy)
         : Core::JSON::Container()
@@ -160,12 +167,26 @@ ENUM_CONVERSION_BEGIN(PluginHost::MetaData::Channel::state)
         , Activity(copy.Activity)
         , ID(copy.ID)
         , Name(copy.Name)
+        , Dropped(copy.Dropped)
+        , Coalesced(copy.Coalesced)
+        , Sent(copy.Sent)
+        , SentCompressed(copy.SentCompressed)
+        , Received(copy.Received)
+        , ReceivedCompressed(copy.ReceivedCompressed)
+        , CompressionTime(copy.CompressionTime)
     {
         Core::JSON::Container::Add(_T("remote"), &Remote);
         Core::JSON::Container::Add(_T("state"), &JSONState);
         Core::JSON::Container::Add(_T("activity"), &Activity);
         Core::JSON::Container::Add(_T("id"), &ID);
         Core::JSON::Container::Add(_T("name"), &Name);
+        Core::JSON::Container::Add(_T("dropped"), &Dropped);
+        Core::JSON::Container::Add(_T("coalesced"), &Coalesced);
+        Core::JSON::Container::Add(_T("sent"), &Sent);
+        Core::JSON::Container::Add(_T("sentcompressed"), &SentCompressed);
+        Core::JSON::Container::Add(_T("received"), &Received);
+        Core::JSON::Container::Add(_T("receivedcompressed"), &ReceivedCompressed);
+        Core::JSON::Container::Add(_T("compressiontime"), &CompressionTime);
     }
     MetaData::Channel::~Channel()
     {
@@ -178,6 +199,13 @@ ENUM_CONVERSION_BEGIN(PluginHost::MetaData::Channel::state)
         Activity = RHS.Activity;
         ID = RHS.ID;
         Name = RHS.Name;
+        Dropped = RHS.Dropped;
+        Coalesced = RHS.Coalesced;
+        Sent = RHS.Sent;
+        SentCompressed = RHS.SentCompressed;
+        Received = RHS.Received;
+        ReceivedCompressed = RHS.ReceivedCompressed;
+        CompressionTime = RHS.CompressionTime;
 
         return (*this);
     }
@@ -226,11 +254,114 @@ ENUM_CONVERSION_BEGIN(PluginHost::MetaData::Channel::state)
         Core::JSON::Container::Add(_T("threads"), &ThreadPoolRuns);
         Core::JSON::Container::Add(_T("pending"), &PendingRequests);
         Core::JSON::Container::Add(_T("occupation"), &PoolOccupation);
+        Core::JSON::Container::Add(_T("tokens"), &Tokens);
     }
     MetaData::Server::~Server()
     {
     }
 
+    MetaData::Metrics::Histogram::Histogram()
+        : Core::JSON::Container()
+    {
+        Add(_T("count"), &Count);
+        Add(_T("total"), &Total);
+        Add(_T("max"), &Max);
+        Add(_T("buckets"), &Buckets);
+    }
+    MetaData::Metrics::Histogram::Histogram(const Histogram& copy)
+        : Core::JSON::Container()
+        , Count(copy.Count)
+        , Total(copy.Total)
+        , Max(copy.Max)
+        , Buckets(copy.Buckets)
+    {
+        Add(_T("count"), &Count);
+        Add(_T("total"), &Total);
+        Add(_T("max"), &Max);
+        Add(_T("buckets"), &Buckets);
+    }
+    MetaData::Metrics::Histogram::~Histogram()
+    {
+    }
+
+    MetaData::Metrics::Method::Method()
+        : Core::JSON::Container()
+    {
+        Add(_T("name"), &Name);
+        Add(_T("calls"), &Calls);
+        Add(_T("errors"), &Errors);
+        Add(_T("lasterror"), &LastError);
+        Add(_T("bytesin"), &BytesIn);
+        Add(_T("bytesout"), &BytesOut);
+        Add(_T("wait"), &Wait);
+        Add(_T("execution"), &Execution);
+    }
+    MetaData::Metrics::Method::Method(const Method& copy)
+        : Core::JSON::Container()
+        , Name(copy.Name)
+        , Calls(copy.Calls)
+        , Errors(copy.Errors)
+        , LastError(copy.LastError)
+        , BytesIn(copy.BytesIn)
+        , BytesOut(copy.BytesOut)
+        , Wait(copy.Wait)
+        , Execution(copy.Execution)
+    {
+        Add(_T("name"), &Name);
+        Add(_T("calls"), &Calls);
+        Add(_T("errors"), &Errors);
+        Add(_T("lasterror"), &LastError);
+        Add(_T("bytesin"), &BytesIn);
+        Add(_T("bytesout"), &BytesOut);
+        Add(_T("wait"), &Wait);
+        Add(_T("execution"), &Execution);
+    }
+    MetaData::Metrics::Method::~Method()
+    {
+    }
+
+    MetaData::Metrics::Cache::Cache()
+        : Core::JSON::Container()
+    {
+        Add(_T("hits"), &Hits);
+        Add(_T("misses"), &Misses);
+        Add(_T("entries"), &Entries);
+    }
+    MetaData::Metrics::Cache::Cache(const Cache& copy)
+        : Core::JSON::Container()
+        , Hits(copy.Hits)
+        , Misses(copy.Misses)
+        , Entries(copy.Entries)
+    {
+        Add(_T("hits"), &Hits);
+        Add(_T("misses"), &Misses);
+        Add(_T("entries"), &Entries);
+    }
+    MetaData::Metrics::Cache::~Cache()
+    {
+    }
+
+    MetaData::Metrics::Metrics()
+        : Core::JSON::Container()
+    {
+        Add(_T("callsign"), &Callsign);
+        Add(_T("methods"), &Methods);
+        Add(_T("cache"), &Cached);
+    }
+    MetaData::Metrics::Metrics(const Metrics& copy)
+        : Core::JSON::Container()
+        , Callsign(copy.Callsign)
+        , Methods(copy.Methods)
+        , Cached(copy.Cached)
+    {
+        Add(_T("callsign"), &Callsign);
+        Add(_T("methods"), &Methods);
+        Add(_T("cache"), &Cached);
+    }
+    MetaData::Metrics::~Metrics()
+    {
+    }
+
     MetaData::MetaData()
     {
         Core::JSON::Container::Add(_T("plugins"), &Plugins);
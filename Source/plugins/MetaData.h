@@ -132,6 +132,13 @@ namespace PluginHost {
             Core::JSON::Boolean Activity;
             Core::JSON::DecUInt32 ID;
             Core::JSON::String Name;
+            Core::JSON::DecUInt32 Dropped;
+            Core::JSON::DecUInt32 Coalesced;
+            Core::JSON::DecUInt64 Sent;
+            Core::JSON::DecUInt64 SentCompressed;
+            Core::JSON::DecUInt64 Received;
+            Core::JSON::DecUInt64 ReceivedCompressed;
+            Core::JSON::DecUInt64 CompressionTime;
         };
 
         class EXTERNAL Bridge : public Core::JSON::Container {
@@ -151,6 +158,74 @@ namespace PluginHost {
             Core::JSON::Boolean Secure;
         };
 
+        class EXTERNAL Metrics : public Core::JSON::Container {
+        private:
+            Metrics& operator=(const Metrics&) = delete;
+
+        public:
+            // Durations are in microseconds, bucket N counts the values below 2^N that did not fit bucket N-1.
+            class EXTERNAL Histogram : public Core::JSON::Container {
+            private:
+                Histogram& operator=(const Histogram&) = delete;
+
+            public:
+                Histogram();
+                Histogram(const Histogram& copy);
+                ~Histogram();
+
+            public:
+                Core::JSON::DecUInt32 Count;
+                Core::JSON::DecUInt64 Total;
+                Core::JSON::DecUInt32 Max;
+                Core::JSON::ArrayType<Core::JSON::DecUInt32> Buckets;
+            };
+
+            class EXTERNAL Method : public Core::JSON::Container {
+            private:
+                Method& operator=(const Method&) = delete;
+
+            public:
+                Method();
+                Method(const Method& copy);
+                ~Method();
+
+            public:
+                Core::JSON::String Name;
+                Core::JSON::DecUInt32 Calls;
+                Core::JSON::DecUInt32 Errors;
+                Core::JSON::DecSInt32 LastError;
+                Core::JSON::DecUInt64 BytesIn;
+                Core::JSON::DecUInt64 BytesOut;
+                Histogram Wait;
+                Histogram Execution;
+            };
+
+            class EXTERNAL Cache : public Core::JSON::Container {
+            private:
+                Cache& operator=(const Cache&) = delete;
+
+            public:
+                Cache();
+                Cache(const Cache& copy);
+                ~Cache();
+
+            public:
+                Core::JSON::DecUInt32 Hits;
+                Core::JSON::DecUInt32 Misses;
+                Core::JSON::DecUInt32 Entries;
+            };
+
+        public:
+            Metrics();
+            Metrics(const Metrics& copy);
+            ~Metrics();
+
+        public:
+            Core::JSON::String Callsign;
+            Core::JSON::ArrayType<Method> Methods;
+            Cache Cached;
+        };
+
         class EXTERNAL Server : public Core::JSON::Container {
         private:
             Server(const Server& copy) = delete;
@@ -169,6 +244,7 @@ namespace PluginHost {
             Core::JSON::ArrayType<Core::JSON::DecUInt32> ThreadPoolRuns;
             Core::JSON::DecUInt32 PendingRequests;
             Core::JSON::DecUInt32 PoolOccupation;
+            Metrics::Cache Tokens;
         };
 
         class EXTERNAL SubSystem : public Core::JSON::Container {
@@ -72,6 +72,7 @@ namespace PluginHost {
         , _responseFactory(5)
         , _fileBodyFactory(5)
         , _jsonRPCFactory(5)
+        , _jsonRPCBatchFactory(1)
     {
     }
 
@@ -103,25 +104,24 @@ namespace PluginHost {
     }
 #endif
 
-    void Service::FileToServe(const string& webServiceRequest, Web::Response& response)
+    void Service::FileToServe(const Web::Request& request, Web::Response& response)
     {
         Web::MIMETypes result;
+        const string& webServiceRequest(request.Path);
         uint16_t offset = static_cast<uint16_t>(_config.WebPrefix().length()) + (_webURLPath.empty() ? 1 : static_cast<uint16_t>(_webURLPath.length()) + 2);
         string fileToService = _webServerFilePath;
+        Core::ProxyType<Web::FileBody> fileBody(Factories::Instance().FileBody());
 
         if ((webServiceRequest.length() <= offset) || (Web::MIMETypeForFile(webServiceRequest.substr(offset, -1), fileToService, result) == false)) {
-            Core::ProxyType<Web::FileBody> fileBody(Factories::Instance().FileBody());
-
             // No filename gives, be default, we go for the index.html page..
             *fileBody = fileToService + _T("index.html");
             response.ContentType = Web::MIME_HTML;
-            response.Body<Web::FileBody>(fileBody);
         } else {
-            Core::ProxyType<Web::FileBody> fileBody(Factories::Instance().FileBody());
             *fileBody = fileToService;
             response.ContentType = result;
-            response.Body<Web::FileBody>(fileBody);
         }
+
+        Web::FileResponse(request, response, fileBody);
     }
 
     bool Service::IsWebServerRequest(const string& segment) const
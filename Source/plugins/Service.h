@@ -59,6 +59,10 @@ namespace PluginHost {
         {
             return (_jsonRPCFactory.Element());
         }
+        inline Core::ProxyType<Core::JSONRPC::Batch> JSONRPCBatch()
+        {
+            return (_jsonRPCBatchFactory.Element());
+        }
 
     private:
         friend class Core::SingletonType<Factories>;
@@ -67,6 +71,7 @@ namespace PluginHost {
         Core::ProxyPoolType<Web::Response> _responseFactory;
         Core::ProxyPoolType<Web::FileBody> _fileBodyFactory;
         Core::ProxyPoolType<Web::JSONBodyType<Core::JSONRPC::Message>> _jsonRPCFactory;
+        Core::ProxyPoolType<Core::JSONRPC::Batch> _jsonRPCBatchFactory;
     };
 
     class EXTERNAL Service : public IShell {
@@ -301,6 +306,16 @@ namespace PluginHost {
         {
             return (_config.Configuration().Resumed.Value());
         }
+        // A lazy plugin is not started at startup, but activated by the first request that needs it.
+        inline bool IsLazy() const
+        {
+            return (_config.Configuration().Lazy.Value());
+        }
+        // Seconds without requests after which a lazy plugin is deactivated again, 0 keeps it active.
+        inline uint16_t IdleTimeout() const
+        {
+            return (_config.Configuration().IdleTimeout.Value());
+        }
         virtual bool IsSupported(const uint8_t number) const
         {
             return (_config.IsSupported(number));
@@ -479,7 +494,7 @@ namespace PluginHost {
             _processedObjects++;
         }
 #endif
-        void FileToServe(const string& webServiceRequest, Web::Response& response);
+        void FileToServe(const Web::Request& request, Web::Response& response);
 
     private:
         mutable Core::CriticalSection _adminLock;
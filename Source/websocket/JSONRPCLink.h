@@ -131,10 +131,23 @@ namespace JSONRPC {
                 typedef Core::StreamJSONType<Web::WebSocketClientType<Core::SocketStream>, FactoryImpl&, INTERFACE> BaseClass;
     
             public:
+                // A MessagePack link negotiates the binary JSONRPC wire format with the other side.
+                static constexpr bool IsMessagePack = std::is_same<INTERFACE, Core::JSON::IMessagePack>::value;
+
                 ChannelImpl(CommunicationChannel* parent, const Core::NodeId& remoteNode, const string& callsign)
-                    : BaseClass(5, FactoryImpl::Instance(), callsign, _T("JSON"), "", "", false, false, false, remoteNode.AnyInterface(), remoteNode, 256, 256)
+                    : BaseClass(5, FactoryImpl::Instance(), callsign, (IsMessagePack ? _T("jsonrpc.msgpack") : _T("JSON")), "", "", IsMessagePack, false, false, remoteNode.AnyInterface(), remoteNode, 256, 256)
                     , _parent(*parent)
                 {
+                    string compression;
+
+                    // permessage-deflate is offered on the upgrade if asked for: none, deflate or deflatenocontext.
+                    if ((Core::SystemInfo::GetEnvironment(_T("THUNDER_COMPRESSION"), compression) == true) && (compression.empty() == false)) {
+                        Core::EnumerateType<Web::WebSocket::compression> mode(compression.c_str(), false);
+
+                        if (mode.IsSet() == true) {
+                            BaseClass::Link().Compression(mode.Value());
+                        }
+                    }
                 }
                 virtual ~ChannelImpl()
                 {
@@ -211,6 +224,8 @@ namespace JSONRPC {
                     Administrator(const Administrator&) = delete;
                     Administrator& operator=(const Administrator&) = delete;
     
+                    // One channel per endpoint and path, every link to the same endpoint that is not directed
+                    // to a callsign multiplexes its calls over the "/jsonrpc/" socket.
                     typedef std::map<const string, CommunicationChannel *> CallsignMap;
     
                     static Administrator& Instance()
@@ -277,7 +292,7 @@ namespace JSONRPC {
     
                             typename CallsignMap::iterator index(_callsignMap.begin());
     
-                            while ((index != _callsignMap.end()) && (&(*object) == index->second)) {
+                            while ((index != _callsignMap.end()) && (&(*object) != index->second)) {
                                 index++;
                             }
     
@@ -435,96 +450,113 @@ namespace JSONRPC {
             mutable std::atomic<uint32_t> _sequence;
             std::list< LinkType<INTERFACE> *> _observers;
         };
+        // A slot of the pending table. It is claimed for the id of a call and reused once that call is
+        // done, so issuing a call does not allocate nor search a tree.
         class Entry {
         private:
             Entry(const Entry&) = delete;
             Entry& operator=(const Entry&) = delete;
-            struct Synchronous {
-                Synchronous()
-                    : _signal(false, true)
-                    , _response()
-                {
-                }
-                Core::Event _signal;
-                Core::ProxyType<Core::JSONRPC::Message> _response;
-            };
-            struct ASynchronous {
-                ASynchronous(const uint32_t waitTime, const CallbackFunction& completed)
-                    : _waitTime(Core::Time::Now().Add(waitTime).Ticks())
-                    , _completed(completed)
-                {
-                }
-                uint64_t _waitTime;
-                CallbackFunction _completed;
+
+            enum state : uint8_t {
+                FREE,
+                SYNCHRONOUS,
+                ASYNCHRONOUS
             };
 
         public:
             Entry()
-                : _synchronous(true)
-                , _info()
-            {
-            }
-            Entry(const uint32_t waitTime, const CallbackFunction& completed)
-                : _synchronous(false)
-                , _info(waitTime, completed)
+                : _state(FREE)
+                , _id(0)
+                , _signal(false, true)
+                , _response()
+                , _waitTime(0)
+                , _completed()
             {
             }
             ~Entry()
             {
-                if (_synchronous == true) {
-                    _info.sync.~Synchronous();
-                } else {
-                    _info.async.~ASynchronous();
-                }
             }
 
         public:
+            bool IsFree() const
+            {
+                return (_state == FREE);
+            }
+            uint32_t Id() const
+            {
+                return (_id);
+            }
+            void Synchronous(const uint32_t id)
+            {
+                ASSERT(_state == FREE);
+
+                _state = SYNCHRONOUS;
+                _id = id;
+                _signal.ResetEvent();
+            }
+            void ASynchronous(const uint32_t id, const uint32_t waitTime, const CallbackFunction& completed)
+            {
+                ASSERT(_state == FREE);
+
+                _state = ASYNCHRONOUS;
+                _id = id;
+                _waitTime = Core::Time::Now().Add(waitTime).Ticks();
+                _completed = completed;
+            }
+            void Clear()
+            {
+                _state = FREE;
+                _response = Core::ProxyType<Core::JSONRPC::Message>();
+                _completed = nullptr;
+            }
             const Core::ProxyType<Core::JSONRPC::Message>& Response() const
             {
-                return (_info.sync._response);
+                return (_response);
             }
             bool Signal(const Core::ProxyType<Core::JSONRPC::Message>& response)
             {
-                if (_synchronous == true) {
-                    _info.sync._response = response;
-                    _info.sync._signal.SetEvent();
+                if (_state == SYNCHRONOUS) {
+                    _response = response;
+                    _signal.SetEvent();
                 } else {
-                    _info.async._completed(*response);
+                    _completed(*response);
                 }
 
-                return (_synchronous == false);
+                return (_state == ASYNCHRONOUS);
             }
             const uint64_t& Expiry() const
             {
-                return (_info.async._waitTime);
+                return (_waitTime);
             }
-            void Abort(const uint32_t id)
+            bool Abort()
             {
-                if (_synchronous == true) {
-                    _info.sync._signal.SetEvent();
+                if (_state == SYNCHRONOUS) {
+                    _signal.SetEvent();
                 } else {
                     Core::JSONRPC::Message message;
-                    message.Id = id;
+                    message.Id = _id;
                     message.Error.Code = Core::ERROR_ASYNC_ABORTED;
                     message.Error.Text = _T("Pending call has been aborted");
-                    _info.async._completed(message);
+                    _completed(message);
                 }
+
+                return (_state == ASYNCHRONOUS);
             }
-            bool Expired(const uint32_t id, const uint64_t& currentTime, uint64_t& nextTime)
+            bool Expired(const uint64_t& currentTime, uint64_t& nextTime)
             {
                 bool expired = false;
 
-                if (_synchronous == false) {
-                    if (_info.async._waitTime > currentTime) {
-                        if (_info.async._waitTime < nextTime) {
-                            nextTime = _info.async._waitTime;
+                if (_state == ASYNCHRONOUS) {
+                    if (_waitTime > currentTime) {
+                        if (_waitTime < nextTime) {
+                            nextTime = _waitTime;
                         }
                     } else {
                         Core::JSONRPC::Message message;
-                        message.Id = id;
+                        message.Id = _id;
                         message.Error.Code = Core::ERROR_TIMEDOUT;
                         message.Error.Text = _T("Pending a-sync call has timed out");
-                        _info.async._completed(message);
+                        _completed(message);
                         expired = true;
                     }
                 }
@@ -532,27 +564,16 @@ namespace JSONRPC {
             }
             bool WaitForResponse(const uint32_t waitTime)
             {
-                return (_info.sync._signal.Lock(waitTime) == Core::ERROR_NONE);
+                return (_signal.Lock(waitTime) == Core::ERROR_NONE);
             }
 
         private:
-            bool _synchronous;
-            union Info {
-            public:
-                Info()
-                    : sync()
-                {
-                }
-                Info(const uint32_t waitTime, const CallbackFunction& completed)
-                    : async(waitTime, completed)
-                {
-                }
-                ~Info()
-                {
-                }
-                Synchronous sync;
-                ASynchronous async;
-            } _info;
+            state _state;
+            uint32_t _id;
+            Core::Event _signal;
+            Core::ProxyType<Core::JSONRPC::Message> _response;
+            uint64_t _waitTime;
+            CallbackFunction _completed;
         };
         static Core::NodeId RemoteNodeId()
         {
@@ -570,7 +591,10 @@ namespace JSONRPC {
         }
 
         static constexpr uint32_t DefaultWaitTime = 10000;
-        typedef std::map<uint32_t, Entry> PendingMap;
+
+        // The number of calls a link can have in flight, synchronous and a-synchronous together. A call
+        // beyond that waits for a slot to come free.
+        static constexpr uint8_t PendingSlots = 64;
         typedef std::function<uint32_t(const string&, const string& parameters, string& result)> InvokeFunction;
 
 	protected:
@@ -578,10 +602,11 @@ namespace JSONRPC {
             : _adminLock()
             , _connectId(RemoteNodeId())
             , _channel(CommunicationChannel::Instance(_connectId, string("/jsonrpc/") + connectingCallsign))
-            , _handler([&](const uint32_t, const string&, const string&) {}, { DetermineVersion(callsign + '.') })
+            , _handler([&](const uint32_t, const string&, const Core::ProxyType<const Core::JSONRPC::Notification::Frame>&) {}, { DetermineVersion(callsign + '.') })
             , _callsign(callsign.empty() ? string() : Core::JSONRPC::Message::Callsign(callsign + '.'))
             , _localSpace()
             , _pendingQueue()
+            , _vacated(false, true)
             , _scheduledTime(0)
         {
             if (localCallsign == nullptr) {
@@ -596,6 +621,102 @@ namespace JSONRPC {
         }
 
     public:
+        // The outcome of a call issued by Request(). The caller is not blocked, any number of calls
+        // can be in flight on a link and each of them completes whenever its response comes in.
+        template <typename RESPONSE>
+        class FutureType {
+        private:
+            friend class LinkType<INTERFACE>;
+
+            class State {
+            public:
+                State(const State&) = delete;
+                State& operator=(const State&) = delete;
+
+                State()
+                    : _signal(false, true)
+                    , _result(Core::ERROR_INPROGRESS)
+                    , _response()
+                {
+                }
+                ~State()
+                {
+                }
+
+            public:
+                Core::Event _signal;
+                uint32_t _result;
+                RESPONSE _response;
+            };
+
+            FutureType(const Core::ProxyType<State>& state)
+                : _state(state)
+            {
+            }
+
+        public:
+            FutureType()
+                : _state()
+            {
+            }
+            FutureType(const FutureType<RESPONSE>& copy)
+                : _state(copy._state)
+            {
+            }
+            ~FutureType()
+            {
+            }
+
+            FutureType<RESPONSE>& operator=(const FutureType<RESPONSE>& rhs)
+            {
+                _state = rhs._state;
+
+                return (*this);
+            }
+
+        public:
+            bool IsValid() const
+            {
+                return (_state.IsValid());
+            }
+            bool IsReady() const
+            {
+                ASSERT(_state.IsValid() == true);
+
+                return (_state->_signal.IsSet());
+            }
+            // Core::ERROR_INPROGRESS if no response came in within the waitTime, otherwise the outcome
+            // of the call: Core::ERROR_NONE, the error code of the JSONRPC error or why it failed.
+            uint32_t Wait(const uint32_t waitTime) const
+            {
+                ASSERT(_state.IsValid() == true);
+
+                return (_state->_signal.Lock(waitTime) == Core::ERROR_NONE ? _state->_result : static_cast<uint32_t>(Core::ERROR_INPROGRESS));
+            }
+            // Only to be looked at once the call completed with Core::ERROR_NONE.
+            const RESPONSE& Response() const
+            {
+                ASSERT(_state.IsValid() == true);
+                ASSERT(IsReady() == true);
+
+                return (_state->_response);
+            }
+
+        private:
+            RESPONSE& Receive()
+            {
+                return (_state->_response);
+            }
+            void Completed(const uint32_t result)
+            {
+                _state->_result = result;
+                _state->_signal.SetEvent();
+            }
+
+        private:
+            Core::ProxyType<State> _state;
+        };
+
         LinkType(const string& callsign, const bool directed = false)
             : LinkType(callsign, (directed ? callsign : string()), nullptr)
         {
@@ -783,6 +904,19 @@ namespace JSONRPC {
                 callback,
                 objectPtr));
         }
+        template <typename PARAMETERS, typename RESPONSE>
+        typename std::enable_if<(std::is_same<PARAMETERS, void>::value && !std::is_same<RESPONSE, void>::value), FutureType<RESPONSE>>::type
+        Request(const uint32_t waitTime, const string& method)
+        {
+            string emptyString(EMPTY_STRING);
+            return (InternalRequest<string, RESPONSE>(waitTime, method, emptyString));
+        }
+        template <typename PARAMETERS, typename RESPONSE>
+        typename std::enable_if<(!std::is_same<PARAMETERS, void>::value && !std::is_same<RESPONSE, void>::value), FutureType<RESPONSE>>::type
+        Request(const uint32_t waitTime, const string& method, const PARAMETERS& parameters)
+        {
+            return (InternalRequest<PARAMETERS, RESPONSE>(waitTime, method, parameters));
+        }
         template <typename PARAMETERS, typename... TYPES>
         uint32_t Set(const uint32_t waitTime, const string& method, const TYPES&&... args)
         {
@@ -861,6 +995,21 @@ namespace JSONRPC {
         {
             return (Get<Core::JSON::VariantContainer>(waitTime, method, object));
         }
+        // The result is parsed once into the document, no per key allocations and no re-parsing
+        // of nested objects and arrays.
+        uint32_t Invoke(const char method[], const string& parameters, Core::JSON::Document& response, const uint32_t waitTime = DefaultWaitTime)
+        {
+            Core::ProxyType<Core::JSONRPC::Message> message;
+            uint32_t result = Send(waitTime, method, parameters, message);
+            if (result == Core::ERROR_NONE) {
+                if (message->Error.IsSet() == true) {
+                    result = message->Error.Code.Value();
+                } else if ((message->Result.IsSet() == true) && (response.FromString(message->Result.Value()) == false)) {
+                    result = Core::ERROR_READ_ERROR;
+                }
+            }
+            return (result);
+        }
         template <typename RESPONSE = Core::JSON::VariantContainer>
         DEPRECATED uint32_t Invoke(const uint32_t waitTime, const string& method, RESPONSE& inbound)
         // Note: use of Invoke without indicating both Parameters and Response type is deprecated -> replace this one by Invoke<void, ResponeType>(..
@@ -887,14 +1036,9 @@ namespace JSONRPC {
             // Lets see if some callback are expire. If so trigger and remove...
             _adminLock.Lock();
 
-            typename PendingMap::iterator index = _pendingQueue.begin();
-
-            while (index != _pendingQueue.end()) {
-
-                if (index->second.Expired(index->first, currentTime, result) == true) {
-                    index = _pendingQueue.erase(index);
-                } else {
-                    index++;
+            for (Entry& slot : _pendingQueue) {
+                if ((slot.IsFree() == false) && (slot.Expired(currentTime, result) == true)) {
+                    Vacate(slot);
                 }
             }
             _scheduledTime = (result != static_cast<uint64_t>(~0) ? result : 0);
@@ -992,6 +1136,30 @@ namespace JSONRPC {
             uint32_t result = Send(waitTime, method, parameters, implementation);
             return (result);
         }
+        template <typename PARAMETERS, typename RESPONSE>
+        FutureType<RESPONSE> InternalRequest(const uint32_t waitTime, const string& method, const PARAMETERS& parameters)
+        {
+            typedef typename FutureType<RESPONSE>::State State;
+
+            FutureType<RESPONSE> future(Core::ProxyType<State>::Create());
+
+            CallbackFunction implementation = [future, this](const Core::JSONRPC::Message& inbound) mutable -> void {
+                if (inbound.Error.IsSet() == true) {
+                    future.Completed(inbound.Error.Code.Value());
+                } else {
+                    FromMessage((INTERFACE*)&(future.Receive()), inbound);
+                    future.Completed(Core::ERROR_NONE);
+                }
+            };
+
+            uint32_t result = Send(waitTime, method, parameters, implementation);
+
+            if (result != Core::ERROR_NONE) {
+                future.Completed(result);
+            }
+
+            return (future);
+        }
         virtual void Opened()
         {
             // Nice to know :-)
@@ -1001,11 +1169,12 @@ namespace JSONRPC {
             // Abort any in progress RPC command:
             _adminLock.Lock();
 
-            // See if we issued anything, if so abort it..
-            while (_pendingQueue.size() != 0) {
-
-                _pendingQueue.begin()->second.Abort(_pendingQueue.begin()->first);
-                _pendingQueue.erase(_pendingQueue.begin());
+            // See if we issued anything, if so abort it. A synchronous slot is left to the caller waiting
+            // on it, that one frees it.
+            for (Entry& slot : _pendingQueue) {
+                if ((slot.IsFree() == false) && (slot.Abort() == true)) {
+                    Vacate(slot);
+                }
             }
 
             _adminLock.Unlock();
@@ -1031,14 +1200,14 @@ namespace JSONRPC {
 
                 _adminLock.Lock();
 
-                typename std::pair< typename PendingMap::iterator, bool> newElement = _pendingQueue.emplace(std::piecewise_construct,
-                    std::forward_as_tuple(id),
-                    std::forward_as_tuple());
-                ASSERT(newElement.second == true);
+                uint32_t remaining = waitTime;
+                Entry* entry = Claim(id, remaining);
 
-                if (newElement.second == true) {
+                if (entry != nullptr) {
 
-                    Entry& slot(newElement.first->second);
+                    Entry& slot(*entry);
+
+                    slot.Synchronous(id);
 
                     _adminLock.Unlock();
 
@@ -1046,7 +1215,7 @@ namespace JSONRPC {
 
                     message.Release();
 
-                    if (slot.WaitForResponse(waitTime) == true) {
+                    if (slot.WaitForResponse(remaining) == true) {
                         response = slot.Response();
 
                         // See if we have a response, maybe it was just the connection
@@ -1058,7 +1227,7 @@ namespace JSONRPC {
 
                     _adminLock.Lock();
 
-                    _pendingQueue.erase(id);
+                    Vacate(slot);
                 }
 
                 _adminLock.Unlock();
@@ -1089,25 +1258,45 @@ namespace JSONRPC {
 
                 _adminLock.Lock();
 
-                typename std::pair<typename PendingMap::iterator, bool> newElement = _pendingQueue.emplace(std::piecewise_construct,
-                    std::forward_as_tuple(id),
-                    std::forward_as_tuple(waitTime, response));
-                ASSERT(newElement.second == true);
+                Entry* slot = Claim(id);
+
+                if (slot != nullptr) {
 
-                if (newElement.second == true) {
+                    slot->ASynchronous(id, waitTime, response);
 
                     _channel->Submit(Core::ProxyType<INTERFACE>(message));
 
                     result = Core::ERROR_NONE;
 
                     message.Release();
-                    if ((_scheduledTime == 0) || (_scheduledTime > newElement.first->second.Expiry())) {
-                        _scheduledTime = newElement.first->second.Expiry();
+                    if ((_scheduledTime == 0) || (_scheduledTime > slot->Expiry())) {
+                        _scheduledTime = slot->Expiry();
                         CommunicationChannel::Trigger(_scheduledTime, this);
                     }
                 }
 
                 _adminLock.Unlock();
+
+                if (slot == nullptr) {
+                    // All slots are in flight, rather than failing the call it is issued synchronously, that
+                    // waits for a slot to come free. The callback is completed before returning.
+                    Core::ProxyType<Core::JSONRPC::Message> answer;
+
+                    result = Send(waitTime, method, parameters, answer);
+
+                    if (result == Core::ERROR_NONE) {
+                        response(*answer);
+                    } else {
+                        // No slot came free or no response came in, in time.
+                        Core::JSONRPC::Message failure;
+                        failure.Id = id;
+                        failure.Error.Code = Core::ERROR_TIMEDOUT;
+                        failure.Error.Text = _T("Pending a-sync call has timed out");
+                        response(failure);
+                    }
+
+                    result = Core::ERROR_NONE;
+                }
             }
 
             return (result);
@@ -1126,13 +1315,13 @@ namespace JSONRPC {
                 _adminLock.Lock();
 
                 // See if we issued this..
-                typename PendingMap::iterator index = _pendingQueue.find(inbound->Id.Value());
+                Entry* slot = Find(inbound->Id.Value());
 
-                if (index != _pendingQueue.end()) {
+                if (slot != nullptr) {
 
-                    if (index->second.Signal(inbound) == true) {
-                        _pendingQueue.erase(index);
-					}
+                    if (slot->Signal(inbound) == true) {
+                        Vacate(*slot);
+                    }
 
                     result = Core::ERROR_NONE;
                 }
@@ -1155,6 +1344,76 @@ namespace JSONRPC {
         }
 
     private:
+        // The id of a call picks its slot, the next free one if that is taken. Ids are handed out in
+        // sequence, so unless many calls are outstanding the first slot looked at is the one.
+        Entry* Claim(const uint32_t id)
+        {
+            Entry* result = nullptr;
+            uint8_t count = 0;
+
+            while ((result == nullptr) && (count < PendingSlots)) {
+                Entry& slot(_pendingQueue[(id + count) % PendingSlots]);
+
+                if (slot.IsFree() == true) {
+                    result = &slot;
+                }
+                count++;
+            }
+
+            return (result);
+        }
+        // Called with the lock taken, the lock is let go of while waiting for a slot to come free. Takes
+        // the time spent waiting off the waitTime.
+        Entry* Claim(const uint32_t id, uint32_t& waitTime)
+        {
+            Entry* result = Claim(id);
+
+            if ((result == nullptr) && (waitTime != 0)) {
+                const uint64_t deadline = (waitTime == Core::infinite ? ~0 : Core::Time::Now().Add(waitTime).Ticks());
+                uint64_t now = Core::Time::Now().Ticks();
+
+                while ((result == nullptr) && (now < deadline)) {
+                    _vacated.ResetEvent();
+
+                    _adminLock.Unlock();
+
+                    _vacated.Lock(waitTime == Core::infinite ? Core::infinite : static_cast<uint32_t>((deadline - now + Core::Time::TicksPerMillisecond - 1) / Core::Time::TicksPerMillisecond));
+
+                    _adminLock.Lock();
+
+                    result = Claim(id);
+                    now = Core::Time::Now().Ticks();
+                }
+
+                if (waitTime != Core::infinite) {
+                    waitTime = (now < deadline ? static_cast<uint32_t>((deadline - now) / Core::Time::TicksPerMillisecond) : 0);
+                }
+            }
+
+            return (result);
+        }
+        // Called with the lock taken.
+        void Vacate(Entry& slot)
+        {
+            slot.Clear();
+            _vacated.SetEvent();
+        }
+        Entry* Find(const uint32_t id)
+        {
+            Entry* result = nullptr;
+            uint8_t count = 0;
+
+            while ((result == nullptr) && (count < PendingSlots)) {
+                Entry& slot(_pendingQueue[(id + count) % PendingSlots]);
+
+                if ((slot.IsFree() == false) && (slot.Id() == id)) {
+                    result = &slot;
+                }
+                count++;
+            }
+
+            return (result);
+        }
         void ToMessage(const string& parameters, Core::ProxyType<Core::JSONRPC::Message>& message) const
         {
            if (parameters.empty() != true) {
@@ -1172,8 +1431,11 @@ namespace JSONRPC {
              std::vector<uint8_t> values;
              parameters->ToBuffer(values);
              if (values.empty() != true) {
-                 string strValues(values.begin(), values.end());
-                 message->Parameters = strValues;
+                 // The message holds JSON text, it is packed again when it goes out.
+                 string strValues;
+                 if (Core::JSON::MessagePack::ToJSON(values.data(), static_cast<uint32_t>(values.size()), strValues) != 0) {
+                     message->Parameters = strValues;
+                 }
              }
              return;
         }
@@ -1192,9 +1454,10 @@ namespace JSONRPC {
         }
         void FromMessage(Core::JSON::IMessagePack* response, const Core::JSONRPC::Message& message)
         {
-            string value = message.Result.Value();
-            std::vector<uint8_t> result(value.begin(), value.end());
-            response->FromBuffer(result);
+            std::vector<uint8_t> result;
+            if (Core::JSON::MessagePack::FromJSON(message.Result.Value(), result) == true) {
+                response->FromBuffer(result);
+            }
         }
 
     private:
@@ -1204,7 +1467,8 @@ namespace JSONRPC {
         Core::JSONRPC::Handler _handler;
         string _callsign;
         string _localSpace;
-        PendingMap _pendingQueue;
+        Entry _pendingQueue[PendingSlots];
+        Core::Event _vacated;
         uint64_t _scheduledTime;
     };
 
@@ -1520,6 +1784,10 @@ namespace JSONRPC {
         {
                 return (_connection.template Get<Core::JSON::VariantContainer>(waitTime, method, object));
         }
+        uint32_t Invoke(const char method[], const string& parameters, Core::JSON::Document& response, const uint32_t waitTime = Client::DefaultWaitTime)
+        {
+                return (_connection.Invoke(method, parameters, response, waitTime));
+        }
         bool IsActivated()
         {
             return (_connection.IsActivated());
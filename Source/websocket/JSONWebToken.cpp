@@ -63,6 +63,29 @@ namespace Web
         Core::JSON::EnumType<JSONWebToken::mode> Algorithm;
     };
 
+    // Only the registered claims that are used here.
+    class EXTERNAL JSONWebClaims : public Core::JSON::Container {
+    private:
+        JSONWebClaims(const JSONWebClaims&) = delete;
+        JSONWebClaims& operator=(const JSONWebClaims&) = delete;
+
+    public:
+        JSONWebClaims(const uint8_t data[], const uint16_t length)
+            : Core::JSON::Container()
+            , Expiry()
+        {
+            Add(_T("exp"), &Expiry);
+
+            FromString(string(reinterpret_cast<const TCHAR*>(data), length / sizeof(TCHAR)));
+        }
+        ~JSONWebClaims()
+        {
+        }
+
+    public:
+        Core::JSON::DecUInt64 Expiry;
+    };
+
     JSONWebToken::JSONWebToken(const mode type, const uint8_t length, const uint8_t key[])
         : _mode(type)
         , _key(string(reinterpret_cast<const char*>(key), length))
@@ -179,6 +202,31 @@ namespace Web
 		return (result);
     }
 
+    /* static */ uint64_t JSONWebToken::Expiry(const string& token)
+    {
+        uint64_t result = 0;
+        size_t first = token.find_first_of('.');
+        size_t last = token.find_last_of('.');
+
+        if ((first != string::npos) && (last > first)) {
+            uint16_t length = static_cast<uint16_t>(last - first - 1);
+            uint8_t* payload = reinterpret_cast<uint8_t*>(ALLOCA(length));
+
+            length = Core::URL::Base64Decode(&(token[first + 1]), length, payload, length, nullptr);
+
+            JSONWebClaims claims(payload, length);
+
+            if (claims.Expiry.IsSet() == true) {
+                // The claim is in seconds since the epoch.
+                static const uint64_t epoch = Core::Time(1970, 1, 1, 0, 0, 0, 0, false).Ticks();
+
+                result = epoch + (claims.Expiry.Value() * 1000 * Core::Time::TicksPerMillisecond);
+            }
+        }
+
+        return (result);
+    }
+
 	uint16_t JSONWebToken::PayloadLength(const string& token) const
     {
         uint16_t result = ~0;
@@ -44,6 +44,9 @@ namespace Web {
         uint16_t Decode(const string& token, const uint16_t maxLength, uint8_t payload[]) const;
         uint16_t PayloadLength(const string& token) const;
 
+        // The "exp" claim of the token in Core::Time ticks, 0 if it has none. The signature is not checked.
+        static uint64_t Expiry(const string& token);
+
 	private:
         bool ValidSignature(const mode type, const string& token) const;
 
@@ -53,4 +56,164 @@ namespace Web {
 		string _key;
     };
 
+    // Tokens that were verified before, with the object they resolved to. Looking a token up again costs a
+    // SHA256 of it, verifying it takes two Base64 decodes, an HMAC and parsing the JSON of the claims.
+    // An entry is kept until the "exp" claim of its token, for maxAge seconds at most, and the least recently
+    // used entry makes place once maxEntries are cached. Whoever verifies the tokens Clear()s the cache when
+    // the key changes. The cache holds a reference to the objects and Find() returns one to the caller.
+    template <typename OBJECT>
+    class VerifiedTokensType {
+    private:
+        class Entry {
+        public:
+            Entry() = delete;
+            Entry(const Entry&) = delete;
+            Entry& operator=(const Entry&) = delete;
+
+            Entry(const string& digest, OBJECT* object, const uint64_t expiry)
+                : Digest(digest)
+                , Object(object)
+                , Expiry(expiry)
+            {
+                Object->AddRef();
+            }
+            ~Entry()
+            {
+                Object->Release();
+            }
+
+        public:
+            const string Digest;
+            OBJECT* const Object;
+            const uint64_t Expiry;
+        };
+
+        // Most recently used first.
+        typedef std::list<Entry> Entries;
+        typedef std::unordered_map<string, typename Entries::iterator> Index;
+
+    public:
+        VerifiedTokensType() = delete;
+        VerifiedTokensType(const VerifiedTokensType<OBJECT>&) = delete;
+        VerifiedTokensType<OBJECT>& operator=(const VerifiedTokensType<OBJECT>&) = delete;
+
+        VerifiedTokensType(const uint16_t maxEntries, const uint32_t maxAge)
+            : _adminLock()
+            , _entries()
+            , _index()
+            , _maxEntries(maxEntries)
+            , _maxAge(maxAge)
+            , _hits(0)
+            , _misses(0)
+        {
+            ASSERT(maxEntries > 0);
+        }
+        ~VerifiedTokensType()
+        {
+            Clear();
+        }
+
+    public:
+        OBJECT* Find(const string& token)
+        {
+            OBJECT* result = nullptr;
+            const string digest(Digest(token));
+            const uint64_t now = Core::Time::Now().Ticks();
+
+            _adminLock.Lock();
+
+            typename Index::iterator index(_index.find(digest));
+
+            if (index != _index.end()) {
+                if (index->second->Expiry > now) {
+                    _entries.splice(_entries.begin(), _entries, index->second);
+                    result = index->second->Object;
+                    result->AddRef();
+                } else {
+                    _entries.erase(index->second);
+                    _index.erase(index);
+                }
+            }
+
+            if (result != nullptr) {
+                _hits++;
+            } else {
+                _misses++;
+            }
+
+            _adminLock.Unlock();
+
+            return (result);
+        }
+        void Add(const string& token, OBJECT* object)
+        {
+            ASSERT(object != nullptr);
+
+            const uint64_t now = Core::Time::Now().Ticks();
+            const uint64_t claimed = JSONWebToken::Expiry(token);
+            uint64_t expiry = now + (static_cast<uint64_t>(_maxAge) * 1000 * Core::Time::TicksPerMillisecond);
+
+            if ((claimed != 0) && (claimed < expiry)) {
+                expiry = claimed;
+            }
+
+            if (expiry > now) {
+                const string digest(Digest(token));
+
+                _adminLock.Lock();
+
+                typename Index::iterator index(_index.find(digest));
+
+                if (index != _index.end()) {
+                    _entries.erase(index->second);
+                    _index.erase(index);
+                } else if (_entries.size() >= _maxEntries) {
+                    _index.erase(_entries.back().Digest);
+                    _entries.pop_back();
+                }
+
+                _entries.emplace_front(digest, object, expiry);
+                _index.emplace(digest, _entries.begin());
+
+                _adminLock.Unlock();
+            }
+        }
+        void Clear()
+        {
+            _adminLock.Lock();
+
+            _index.clear();
+            _entries.clear();
+
+            _adminLock.Unlock();
+        }
+        void Statistics(uint32_t& hits, uint32_t& misses, uint32_t& entries) const
+        {
+            _adminLock.Lock();
+
+            hits = _hits;
+            misses = _misses;
+            entries = static_cast<uint32_t>(_entries.size());
+
+            _adminLock.Unlock();
+        }
+
+    private:
+        static string Digest(const string& token)
+        {
+            Crypto::SHA256 hash(reinterpret_cast<const uint8_t*>(token.c_str()), static_cast<uint16_t>(token.length() * sizeof(TCHAR)));
+
+            return (string(reinterpret_cast<const TCHAR*>(hash.Result()), Crypto::SHA256::Length / sizeof(TCHAR)));
+        }
+
+    private:
+        mutable Core::CriticalSection _adminLock;
+        Entries _entries;
+        Index _index;
+        const uint16_t _maxEntries;
+        const uint32_t _maxAge;
+        uint32_t _hits;
+        uint32_t _misses;
+    };
+
 } } // namespace WPEFramework::Web
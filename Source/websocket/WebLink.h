@@ -72,6 +72,15 @@ namespace Web {
             }
 
         private:
+            virtual void Trigger() override
+            {
+                _parent.Trigger();
+            }
+            virtual bool Transfer(const Core::File::Handle file, const uint64_t offset, const uint32_t length)
+            {
+                // A transform has to see all data, so only a plain link can send a file by itself.
+                return ((std::is_same<TRANSFORM, NoTransform>::value == true) && (_parent._channel.Transfer(file, offset, length) == true));
+            }
             virtual void Serialized(const typename OUTBOUND::BaseElement& element)
             {
                 _lock.Lock();
@@ -332,6 +341,9 @@ namespace Web {
         virtual ~WebLinkType()
         {
             _channel.Close(Core::infinite);
+
+            // The channel goes before the serializer, a streamed body triggering it must be done by now.
+            _serializerImpl.Detach();
         }
 
     public:
@@ -0,0 +1,264 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2020 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "Module.h"
+
+namespace WPEFramework {
+namespace Web {
+
+    // HTTP/1.1 pipelining. Every request takes the next slot in the pipeline when it comes in, and its
+    // response is only sent once all responses before it are sent. Only the requests in the first "depth"
+    // slots are handled, up to "depth" requests behind them wait till the pipeline moves. A request that
+    // comes in when that many already wait, is answered with the rejection and the connection closes after
+    // it. What comes in behind it is not answered anymore. A depth of 0 handles every request right away.
+    // Sending and handling are left to the one owning the pipeline, they are never called with the lock taken,
+    // letting go of a job that is not handled is, so that must not take long.
+    template <typename RESPONSE, typename JOB>
+    class PipelineType {
+    private:
+        class Slot {
+        public:
+            Slot()
+                : Response()
+                , Id()
+                , Close(false)
+            {
+            }
+            ~Slot()
+            {
+            }
+
+        public:
+            Core::ProxyType<RESPONSE> Response;
+            Core::OptionalType<uint32_t> Id;
+            bool Close;
+        };
+
+        typedef std::map<uint32_t, Slot> Slots;
+        typedef std::list<std::pair<uint32_t, Core::ProxyType<JOB>>> Waiting;
+
+    public:
+        PipelineType() = delete;
+        PipelineType(const PipelineType<RESPONSE, JOB>&) = delete;
+        PipelineType<RESPONSE, JOB>& operator=(const PipelineType<RESPONSE, JOB>&) = delete;
+
+        PipelineType(const uint16_t depth, const Core::ProxyType<RESPONSE>& rejection)
+            : _lock()
+            , _slots()
+            , _waiting()
+            , _rejection(rejection)
+            , _sequence(0)
+            , _depth(depth)
+            , _releasing(false)
+            , _rejecting(false)
+        {
+        }
+        virtual ~PipelineType()
+        {
+        }
+
+    public:
+        // The request asks to close the connection after its response, and might carry an id it wants back
+        // with an answer that is given later on, see Awaits().
+        uint32_t Reserve(const bool close, const Core::OptionalType<uint32_t>& id)
+        {
+            _lock.Lock();
+
+            const uint32_t sequence = _sequence++;
+
+            // Behind a rejected request the connection closes, nothing is answered anymore.
+            if (_rejecting == false) {
+                Slot& slot(_slots[sequence]);
+
+                slot.Close = close;
+
+                if (id.IsSet() == true) {
+                    slot.Id = id.Value();
+                }
+            }
+
+            _lock.Unlock();
+
+            return (sequence);
+        }
+        void Dispatch(const uint32_t sequence, const Core::ProxyType<JOB>& job)
+        {
+            bool admitted = false;
+
+            _lock.Lock();
+
+            typename Slots::iterator index(_slots.find(sequence));
+
+            if (index == _slots.end()) {
+                Abandon(job);
+            } else if (Admitted(sequence) == true) {
+                admitted = true;
+            } else if (_waiting.size() < _depth) {
+                _waiting.emplace_back(sequence, job);
+            } else {
+                // Not admitted, so an earlier request is still unanswered, whoever answers it releases this one.
+                index->second.Response = _rejection;
+                index->second.Close = true;
+                _rejecting = true;
+
+                Abandon(job);
+            }
+
+            _lock.Unlock();
+
+            if (admitted == true) {
+                Handle(job);
+            }
+        }
+        // Returns the id a request in a slot that is not answered yet, wants back with its answer.
+        bool Awaits(const uint32_t sequence, uint32_t& id) const
+        {
+            bool result = false;
+
+            _lock.Lock();
+
+            typename Slots::const_iterator index(_slots.find(sequence));
+
+            if ((index != _slots.end()) && (index->second.Response.IsValid() == false) && (index->second.Id.IsSet() == true)) {
+                id = index->second.Id.Value();
+                result = true;
+            }
+
+            _lock.Unlock();
+
+            return (result);
+        }
+        // Returns false if there is no slot to answer, e.g. as the connection is gone. Release() sends it.
+        bool Answer(const uint32_t sequence, const Core::ProxyType<RESPONSE>& response)
+        {
+            bool result = false;
+
+            _lock.Lock();
+
+            typename Slots::iterator index(_slots.find(sequence));
+
+            if ((index != _slots.end()) && (index->second.Response.IsValid() == false)) {
+                index->second.Response = response;
+                result = true;
+            }
+
+            _lock.Unlock();
+
+            return (result);
+        }
+        // Sends what is answered in order, whoever finds no one else releasing, releases for everyone.
+        void Release()
+        {
+            _lock.Lock();
+
+            if (_releasing == false) {
+                bool close = false;
+
+                _releasing = true;
+
+                while ((close == false) && (_slots.empty() == false) && (_slots.begin()->second.Response.IsValid() == true)) {
+                    std::list<Core::ProxyType<RESPONSE>> responses;
+                    std::list<Core::ProxyType<JOB>> jobs;
+
+                    while ((close == false) && (_slots.empty() == false) && (_slots.begin()->second.Response.IsValid() == true)) {
+                        responses.push_back(_slots.begin()->second.Response);
+                        close = _slots.begin()->second.Close;
+                        _slots.erase(_slots.begin());
+                    }
+
+                    if (close == true) {
+                        // Whatever came in after this request, is not answered anymore.
+                        Discard();
+                    }
+
+                    while ((_waiting.empty() == false) && (Admitted(_waiting.front().first) == true)) {
+                        jobs.push_back(_waiting.front().second);
+                        _waiting.pop_front();
+                    }
+
+                    _lock.Unlock();
+
+                    for (const Core::ProxyType<RESPONSE>& response : responses) {
+                        Send(response);
+                    }
+                    for (const Core::ProxyType<JOB>& job : jobs) {
+                        Handle(job);
+                    }
+                    if (close == true) {
+                        Close();
+                    }
+
+                    _lock.Lock();
+                }
+
+                _releasing = false;
+            }
+
+            _lock.Unlock();
+        }
+        // The connection is gone, the requests that are not answered yet are not handled anymore.
+        void Clear()
+        {
+            _lock.Lock();
+
+            Discard();
+
+            _rejecting = false;
+
+            _lock.Unlock();
+        }
+
+    protected:
+        virtual void Send(const Core::ProxyType<RESPONSE>& response) = 0;
+        virtual void Handle(const Core::ProxyType<JOB>& job) = 0;
+        virtual void Abandon(const Core::ProxyType<JOB>& job) = 0;
+        virtual void Close() = 0;
+
+    private:
+        inline bool Admitted(const uint32_t sequence) const
+        {
+            return ((_depth == 0) || (_slots.empty() == true) || ((sequence - _slots.begin()->first) < _depth));
+        }
+        // Called with the lock taken.
+        void Discard()
+        {
+            _slots.clear();
+
+            for (std::pair<uint32_t, Core::ProxyType<JOB>>& entry : _waiting) {
+                Abandon(entry.second);
+            }
+
+            _waiting.clear();
+        }
+
+    private:
+        mutable Core::CriticalSection _lock;
+        Slots _slots;
+        Waiting _waiting;
+        Core::ProxyType<RESPONSE> _rejection;
+        uint32_t _sequence;
+        uint16_t _depth;
+        bool _releasing;
+        bool _rejecting;
+    };
+
+} // namespace Web
+} // namespace WPEFramework
@@ -80,6 +80,17 @@ namespace Web {
     };
 
     struct EXTERNAL IBody {
+        // The link a streamed body is sent over, to be woken once the body has more to send.
+        struct EXTERNAL ILink {
+            virtual ~ILink(){};
+
+            virtual void Trigger() = 0;
+
+            // A body holds the link for as long as it is triggering it, the link is not destructed before that.
+            virtual void AddRef() const = 0;
+            virtual void Release() const = 0;
+        };
+
         virtual ~IBody(){};
 
         // The Serialize/Deserialize methods mark the start of an upcoming serialization/deserialization
@@ -95,6 +106,28 @@ namespace Web {
         // The Serialize and Deserialize methods allow the content to be serialized/deserialized.
         virtual void Serialize(uint8_t[] /* stream*/, const uint16_t /* maxLength */) const = 0;
         virtual void Deserialize(const uint8_t[] /* stream*/, const uint16_t /* maxLength */) = 0;
+
+        // A body kept in a file can be sent by the kernel straight from that file, in stead of being copied
+        // through the Serialize above. Only valid after Serialize(), returns false if there is no such file.
+        virtual bool Descriptor(Core::File::Handle& /* handle */, uint64_t& /* position */) const
+        {
+            return (false);
+        }
+
+        // A body that is produced while it is being sent has no length up front, its Serialize() returns ~0
+        // (as Deserialize() does for a body without a limit) and it is sent chunked. Produce() then hands out
+        // what is available now, 0 if nothing is yet, and flags the end. While the body is sent, Attach() tells
+        // it the link to trigger when more becomes available, nullptr once it is done.
+        virtual uint16_t Produce(uint8_t[] /* stream*/, const uint16_t /* maxLength */, bool& last) const
+        {
+            ASSERT(false);
+
+            last = true;
+            return (0);
+        }
+        virtual void Attach(ILink* /* link */) const
+        {
+        }
     };
 
     class EXTERNAL Signature {
@@ -246,7 +279,10 @@ namespace Web {
             MAN,
             M_X,
             S_T,
-			AUTHORIZATION
+			AUTHORIZATION,
+            IF_MODIFIED_SINCE,
+            IF_NONE_MATCH,
+            RANGE
         };
 
         enum type {
@@ -277,7 +313,7 @@ namespace Web {
             CONNECTION_CLOSE
         };
 
-        class EXTERNAL Serializer {
+        class EXTERNAL Serializer : public IBody::ILink {
         private:
             enum enumState {
                 VERB = 1,
@@ -304,22 +340,64 @@ namespace Web {
                 , _buffer(nullptr)
                 , _lock()
                 , _current()
+                , _holders(0)
             {
             }
             ~Serializer()
             {
+                Detach();
             }
 
         public:
             virtual void Serialized(const Web::Request& element) = 0;
 
+            // A body kept in a file is offered to the link, to be sent from the file by the kernel. Returning
+            // false (the default) has the body copied through Serialize() as usual.
+            virtual bool Transfer(const Core::File::Handle /* file */, const uint64_t /* offset */, const uint32_t /* length */)
+            {
+                return (false);
+            }
+
+            // A streamed body triggers the link through here once it has more to send, see IBody::Produce().
+            // Only a serializer on a link can wait for that.
+            virtual void Trigger() override
+            {
+            }
+            virtual void AddRef() const override
+            {
+                _holders++;
+            }
+            virtual void Release() const override
+            {
+                ASSERT(_holders > 0);
+                _holders--;
+            }
+
+            // Detaches the body being sent and waits till it no longer triggers this link. Not to be called
+            // while the link sends, a trigger under way waits for that.
+            void Detach()
+            {
+                _lock.Lock();
+                if ((_current != nullptr) && (_current->_body.IsValid() == true)) {
+                    _current->_body->Attach(nullptr);
+                }
+                _lock.Unlock();
+
+                while (_holders.load() != 0) {
+                    ::SleepMs(0);
+                }
+            }
+
             void Flush()
             {
                 _lock.Lock();
-                _state = VERSION;
+                _state = VERB;
                 Web::Request* backup = _current;
                 _current = nullptr;
                 if (backup != nullptr) {
+                    if (backup->_body.IsValid() == true) {
+                        backup->_body->Attach(nullptr);
+                    }
                     Serialized(*backup);
                 }
                 _lock.Unlock();
@@ -347,6 +425,7 @@ namespace Web {
             const TCHAR* _buffer;
             Core::CriticalSection _lock;
             Request* _current;
+            mutable std::atomic<uint32_t> _holders;
         };
         class EXTERNAL Deserializer {
         private:
@@ -592,6 +671,9 @@ namespace Web {
             MX.Clear();
             ST.Clear();
             WebToken.Clear();
+            IfModifiedSince.Clear();
+            IfNoneMatch.Clear();
+            Range.Clear();
 
             if (_body.IsValid() == true) {
                 _body.Release();
@@ -629,6 +711,9 @@ namespace Web {
         Core::OptionalType<string> ST;
         Core::OptionalType<uint32_t> MX;
         Core::OptionalType<Authorization> WebToken;
+        Core::OptionalType<Core::Time> IfModifiedSince;
+        Core::OptionalType<string> IfNoneMatch;
+        Core::OptionalType<string> Range;
 
         inline bool HasBody() const
         {
@@ -100,7 +100,9 @@ namespace Web {
             U_S_N,
             S_T,
             CACHE_CONTROL,
-            APPLICATION_URL
+            APPLICATION_URL,
+            WEBSOCKET_EXTENSIONS,
+            CONTENT_RANGE
         };
 
         enum upgrade {
@@ -116,7 +118,7 @@ namespace Web {
             CONNECTION_CLOSE
         };
 
-        class EXTERNAL Serializer {
+        class EXTERNAL Serializer : public IBody::ILink {
         private:
             enum enumState {
                 VERSION = 1,
@@ -142,15 +144,54 @@ namespace Web {
                 , _buffer(nullptr)
                 , _lock()
                 , _current()
+                , _holders(0)
             {
             }
             ~Serializer()
             {
+                Detach();
             }
 
         public:
             virtual void Serialized(const Web::Response& element) = 0;
 
+            // A body kept in a file is offered to the link, to be sent from the file by the kernel. Returning
+            // false (the default) has the body copied through Serialize() as usual.
+            virtual bool Transfer(const Core::File::Handle /* file */, const uint64_t /* offset */, const uint32_t /* length */)
+            {
+                return (false);
+            }
+
+            // A streamed body triggers the link through here once it has more to send, see IBody::Produce().
+            // Only a serializer on a link can wait for that.
+            virtual void Trigger() override
+            {
+            }
+            virtual void AddRef() const override
+            {
+                _holders++;
+            }
+            virtual void Release() const override
+            {
+                ASSERT(_holders > 0);
+                _holders--;
+            }
+
+            // Detaches the body being sent and waits till it no longer triggers this link. Not to be called
+            // while the link sends, a trigger under way waits for that.
+            void Detach()
+            {
+                _lock.Lock();
+                if ((_current != nullptr) && (_current->_body.IsValid() == true)) {
+                    _current->_body->Attach(nullptr);
+                }
+                _lock.Unlock();
+
+                while (_holders.load() != 0) {
+                    ::SleepMs(0);
+                }
+            }
+
             void Flush()
             {
                 _lock.Lock();
@@ -158,6 +199,9 @@ namespace Web {
                 Web::Response* backup = _current;
                 _current = nullptr;
                 if (backup != nullptr) {
+                    if (backup->_body.IsValid() == true) {
+                        backup->_body->Attach(nullptr);
+                    }
                     Serialized(*backup);
                 }
                 _lock.Unlock();
@@ -185,6 +229,7 @@ namespace Web {
             const TCHAR* _buffer;
             Core::CriticalSection _lock;
             Response* _current;
+            mutable std::atomic<uint32_t> _holders;
         };
         class EXTERNAL Deserializer {
         private:
@@ -287,6 +332,8 @@ namespace Web {
             : ErrorCode(Web::STATUS_OK)
             , MajorVersion(Web::MajorVersion)
             , MinorVersion(Web::MinorVersion)
+            , _body()
+            , _marshalMode(MARSHAL_RAW)
         {
         }
         ~Response()
@@ -404,6 +451,7 @@ namespace Web {
             ContentLength.Clear();
             ContentEncoding.Clear();
             WebSocketAccept.Clear();
+            WebSocketExtensions.Clear();
             AccessControlOrigin.Clear();
             AccessControlMethod.Clear();
             AccessControlHeaders.Clear();
@@ -418,6 +466,7 @@ namespace Web {
             WakeUp.Clear();
             CacheControl.Clear();
             ApplicationURL.Clear();
+            ContentRange.Clear();
 
             if (_body.IsValid() == true) {
                 _body.Release();
@@ -452,8 +501,10 @@ namespace Web {
         Core::OptionalType<string> WakeUp;
         Core::OptionalType<string> ETag;
         Core::OptionalType<string> WebSocketProtocol;
+        Core::OptionalType<string> WebSocketExtensions;
         Core::OptionalType<string> CacheControl;
         Core::OptionalType<Core::URL> ApplicationURL;
+        Core::OptionalType<string> ContentRange;
 
         inline bool HasBody() const
         {
@@ -0,0 +1,222 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2020 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "Module.h"
+
+namespace WPEFramework {
+namespace Web {
+
+    // Maps paths to targets. The paths are Add()ed up front and Compile()d into a compressed trie, after which
+    // Find() takes a path through it in a single pass, without allocating anything. A path that was added
+    // only matches as a whole, or when it is followed by one of the separators, "/Service/Foo" matches
+    // "/Service/Foo/Bar" with "/" as a separator but not "/Service/FooBar". Of all paths that match, the
+    // longest one wins.
+    // The framework routes requests to plugins with it, a plugin can use it for the paths beneath its own.
+    template <typename TARGET>
+    class RouterType {
+    private:
+        static constexpr uint32_t NoTarget = ~0;
+
+        typedef std::pair<string, TARGET> Entry;
+
+        // Its children are consecutive nodes, each with a label that starts with a different character.
+        class Node {
+        public:
+            Node()
+                : Offset(0)
+                , Length(0)
+                , FirstChild(0)
+                , Children(0)
+                , Target(NoTarget)
+            {
+            }
+
+        public:
+            uint32_t Offset;
+            uint32_t Length;
+            uint32_t FirstChild;
+            uint32_t Children;
+            uint32_t Target;
+        };
+
+    public:
+        RouterType() = delete;
+        RouterType(const RouterType<TARGET>&) = delete;
+        RouterType<TARGET>& operator=(const RouterType<TARGET>&) = delete;
+
+        RouterType(const TCHAR separators[])
+            : _separators(separators)
+            , _entries()
+            , _labels()
+            , _nodes()
+            , _targets()
+        {
+        }
+        ~RouterType()
+        {
+        }
+
+    public:
+        inline bool IsCompiled() const
+        {
+            return (_entries.empty() == true);
+        }
+        // A path that is added twice is routed to the target it was added with first.
+        void Add(const string& path, const TARGET& target)
+        {
+            ASSERT(_nodes.empty() == true);
+
+            _entries.emplace_back(path, target);
+        }
+        void Compile()
+        {
+            ASSERT(_nodes.empty() == true);
+
+            if (_entries.empty() == false) {
+                std::stable_sort(_entries.begin(), _entries.end(), [](const Entry& lhs, const Entry& rhs) {
+                    return (lhs.first < rhs.first);
+                });
+
+                _nodes.emplace_back();
+
+                Build(0, 0, 0, static_cast<uint32_t>(_entries.size()));
+
+                _entries.clear();
+                _entries.shrink_to_fit();
+            }
+        }
+        const TARGET* Find(const Core::TextFragment& path, uint32_t& matched) const
+        {
+            return (Find(path.Data(), path.Length(), matched));
+        }
+        const TARGET* Find(const TCHAR path[], const uint32_t length, uint32_t& matched) const
+        {
+            ASSERT(IsCompiled() == true);
+
+            const TARGET* result = nullptr;
+            uint32_t offset = 0;
+            uint32_t index = 0;
+
+            while (index < _nodes.size()) {
+                const Node& node(_nodes[index]);
+
+                if (((length - offset) < node.Length) || (::memcmp(&(_labels[node.Offset]), &(path[offset]), node.Length * sizeof(TCHAR)) != 0)) {
+                    break;
+                }
+
+                offset += node.Length;
+
+                if ((node.Target != NoTarget) && ((offset == length) || (IsSeparator(path[offset]) == true))) {
+                    result = &(_targets[node.Target]);
+                    matched = offset;
+                }
+
+                index = (offset < length ? Child(node, path[offset]) : NoTarget);
+            }
+
+            return (result);
+        }
+
+    private:
+        inline bool IsSeparator(const TCHAR character) const
+        {
+            return (_separators.find(character) != string::npos);
+        }
+        uint32_t Child(const Node& node, const TCHAR character) const
+        {
+            uint32_t result = NoTarget;
+            uint32_t index = node.FirstChild;
+            const uint32_t last = node.FirstChild + node.Children;
+
+            // No more children than distinct characters follow a node, mostly only a few.
+            while ((index < last) && (_labels[_nodes[index].Offset] != character)) {
+                index++;
+            }
+
+            if (index < last) {
+                result = index;
+            }
+
+            return (result);
+        }
+        // The entries [begin, end) all start with the first depth characters, they end up in or below the node.
+        void Build(const uint32_t slot, const uint32_t depth, uint32_t begin, const uint32_t end)
+        {
+            const string& first(_entries[begin].first);
+            const string& last(_entries[end - 1].first);
+            uint32_t common = depth;
+
+            // Sorted, so what the first and the last have in common, all of them have.
+            while ((common < first.length()) && (common < last.length()) && (first[common] == last[common])) {
+                common++;
+            }
+
+            _nodes[slot].Offset = static_cast<uint32_t>(_labels.length());
+            _nodes[slot].Length = common - depth;
+            _labels.append(first, depth, common - depth);
+
+            while ((begin < end) && (_entries[begin].first.length() == common)) {
+                if (_nodes[slot].Target == NoTarget) {
+                    _nodes[slot].Target = static_cast<uint32_t>(_targets.size());
+                    _targets.push_back(_entries[begin].second);
+                }
+                begin++;
+            }
+
+            if (begin < end) {
+                uint32_t children = 0;
+
+                for (uint32_t index = begin; index < end; index++) {
+                    if ((index == begin) || (_entries[index].first[common] != _entries[index - 1].first[common])) {
+                        children++;
+                    }
+                }
+
+                const uint32_t firstChild = static_cast<uint32_t>(_nodes.size());
+
+                _nodes[slot].FirstChild = firstChild;
+                _nodes[slot].Children = children;
+                _nodes.resize(_nodes.size() + children);
+
+                for (uint32_t child = 0; child < children; child++) {
+                    uint32_t next = begin + 1;
+
+                    while ((next < end) && (_entries[next].first[common] == _entries[begin].first[common])) {
+                        next++;
+                    }
+
+                    Build(firstChild + child, common, begin, next);
+
+                    begin = next;
+                }
+            }
+        }
+
+    private:
+        const string _separators;
+        std::vector<Entry> _entries;
+        string _labels;
+        std::vector<Node> _nodes;
+        std::vector<TARGET> _targets;
+    };
+
+} // namespace Web
+} // namespace WPEFramework
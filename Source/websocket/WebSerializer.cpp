@@ -63,12 +63,16 @@ static const TCHAR __ST[] = _T("ST:");
 static const TCHAR __MAN[] = _T("MAN:");
 static const TCHAR __MX[] = _T("MX:");
 static const TCHAR __AUTHORIZATION[] = _T("AUTHORIZATION:");
+static const TCHAR __IF_MODIFIED_SINCE[] = _T("IF-MODIFIED-SINCE:");
+static const TCHAR __IF_NONE_MATCH[] = _T("IF-NONE-MATCH:");
+static const TCHAR __RANGE[] = _T("RANGE:");
 
 static const TCHAR __DATE[] = _T("DATE:");
 static const TCHAR __SERVER[] = _T("SERVER:");
 static const TCHAR __MODIFIED[] = _T("LAST-MODIFIED:");
 static const TCHAR __ACCEPT_RANGE[] = _T("ACCEPT-RANGES:");
 static const TCHAR __ETAG[] = _T("ETAG:");
+static const TCHAR __CONTENT_RANGE[] = _T("CONTENT-RANGE:");
 static const TCHAR __ALLOW[] = _T("ALLOW:");
 static const TCHAR __WEBSOCKET_KEY[] = _T("SEC-WEBSOCKET-KEY:");
 static const TCHAR __WEBSOCKET_PROTOCOL[] = _T("SEC-WEBSOCKET-PROTOCOL:");
@@ -227,10 +231,14 @@ ENUM_CONVERSION_BEGIN(Web::Request::keywords)
     { Web::Request::WEBSOCKET_KEY, __TXT(__WEBSOCKET_KEY) },
     { Web::Request::WEBSOCKET_PROTOCOL, __TXT(__WEBSOCKET_PROTOCOL) },
     { Web::Request::WEBSOCKET_VERSION, __TXT(__WEBSOCKET_VERSION) },
+    { Web::Request::WEBSOCKET_EXTENSIONS, __TXT(__WEBSOCKET_EXTENSIONS) },
     { Web::Request::MAN, __TXT(__MAN) },
     { Web::Request::M_X, __TXT(__MX) },
     { Web::Request::S_T, __TXT(__ST) },
     { Web::Request::AUTHORIZATION, __TXT(__AUTHORIZATION) },
+    { Web::Request::IF_MODIFIED_SINCE, __TXT(__IF_MODIFIED_SINCE) },
+    { Web::Request::IF_NONE_MATCH, __TXT(__IF_NONE_MATCH) },
+    { Web::Request::RANGE, __TXT(__RANGE) },
 
 ENUM_CONVERSION_END(Web::Request::keywords)
 
@@ -271,12 +279,14 @@ ENUM_CONVERSION_BEGIN(Web::Response::keywords)
     { Web::Response::ACCESS_CONTROL_MAX_AGE, __TXT(__ACCESS_CONTROL_MAX_AGE) },
     { Web::Response::WEBSOCKET_ACCEPT, __TXT(__WEBSOCKET_ACCEPT) },
     { Web::Response::WEBSOCKET_PROTOCOL, __TXT(__WEBSOCKET_PROTOCOL) },
+    { Web::Response::WEBSOCKET_EXTENSIONS, __TXT(__WEBSOCKET_EXTENSIONS) },
     { Web::Response::LOCATION, __TXT(__LOCATION) },
     { Web::Response::WAKEUP, __TXT(__WAKEUP) },
     { Web::Response::U_S_N, __TXT(__USN) },
     { Web::Response::S_T, __TXT(__ST) },
     { Web::Response::CACHE_CONTROL, __TXT(__CACHE_CONTROL) },
     { Web::Response::APPLICATION_URL, __TXT(__APPLICATION_URL) },
+    { Web::Response::CONTENT_RANGE, __TXT(__CONTENT_RANGE) },
 
 ENUM_CONVERSION_END(Web::Response::keywords)
 
@@ -352,6 +362,98 @@ namespace Web
         { Web::MIME_APPLICATION_RSS_XML, _TXT("rss") }
     };
 
+    // The deserializers look up the verb and every header name they receive. Instead of walking the enum
+    // table, the names are hashed into a table in which each has a slot of its own. The seed that makes the
+    // hash perfect is searched for once, the first time a table is used. Names that occur more than once
+    // keep their first entry, just like a walk of the enum table would.
+    template <typename ENUMERATE>
+    class KeywordTable {
+    private:
+        static constexpr uint16_t Slots = 128;
+        static constexpr uint16_t Seeds = 4096;
+
+    public:
+        KeywordTable(const KeywordTable<ENUMERATE>&) = delete;
+        KeywordTable<ENUMERATE>& operator=(const KeywordTable<ENUMERATE>&) = delete;
+
+        KeywordTable()
+            : _seed(0)
+            , _perfect(false)
+        {
+            while ((_perfect == false) && (_seed < Seeds)) {
+                const Core::EnumerateConversion<ENUMERATE>* entry;
+                uint16_t index = 0;
+
+                ::memset(_slots, 0, sizeof(_slots));
+                _perfect = true;
+
+                while ((_perfect == true) && ((entry = Core::EnumerateType<ENUMERATE>::Entry(index++)) != nullptr)) {
+                    // Not all tables have their lengths right, the names are terminated though.
+                    const uint32_t length = static_cast<uint32_t>(_tcslen(entry->name));
+                    const Core::EnumerateConversion<ENUMERATE>*& slot = _slots[Hash(entry->name, length)];
+
+                    if (slot == nullptr) {
+                        slot = entry;
+                    } else if (Equal(*slot, entry->name, length) == false) {
+                        _perfect = false;
+                        _seed++;
+                    }
+                }
+            }
+
+            ASSERT(_perfect == true);
+        }
+        ~KeywordTable()
+        {
+        }
+
+    public:
+        static Core::OptionalType<ENUMERATE> Find(const string& text)
+        {
+            static const KeywordTable<ENUMERATE> table;
+
+            Core::OptionalType<ENUMERATE> result;
+
+            if (table._perfect == true) {
+                const Core::EnumerateConversion<ENUMERATE>* entry = table._slots[table.Hash(text.c_str(), static_cast<uint32_t>(text.length()))];
+
+                if ((entry != nullptr) && (Equal(*entry, text.c_str(), static_cast<uint32_t>(text.length())) == true)) {
+                    result = entry->value;
+                }
+            } else {
+                Core::EnumerateType<ENUMERATE> value(text.c_str(), true);
+
+                if (value.IsSet() == true) {
+                    result = value.Value();
+                }
+            }
+
+            return (result);
+        }
+
+    private:
+        uint16_t Hash(const TCHAR text[], const uint32_t length) const
+        {
+            // FNV-1a, the seed is mixed in as if it was the first character.
+            uint32_t hash = (2166136261 ^ _seed) * 16777619;
+
+            for (uint32_t index = 0; index < length; index++) {
+                hash = (hash ^ static_cast<uint8_t>(text[index])) * 16777619;
+            }
+
+            return (static_cast<uint16_t>(hash % Slots));
+        }
+        static bool Equal(const Core::EnumerateConversion<ENUMERATE>& entry, const TCHAR text[], const uint32_t length)
+        {
+            return ((_tcsncmp(entry.name, text, length) == 0) && (entry.name[length] == '\0'));
+        }
+
+    private:
+        const Core::EnumerateConversion<ENUMERATE>* _slots[Slots];
+        uint32_t _seed;
+        bool _perfect;
+    };
+
     /* static */ const TCHAR* Request::ToString(const type value)
     {
         return (Core::EnumerateType<type>(value).Data());
@@ -407,6 +509,278 @@ namespace Web
         return (filePresent);
     }
 
+    static bool Number(const Core::TextFragment& text, uint64_t& value)
+    {
+        uint32_t index = 0;
+
+        value = 0;
+
+        // 19 digits always fit in 64 bits.
+        while ((index < text.Length()) && (index < 19) && (isdigit(text[index]) != 0)) {
+            value = (value * 10) + (text[index] - '0');
+            index++;
+        }
+
+        return ((index > 0) && (index == text.Length()));
+    }
+
+    // "bytes=first-last", "bytes=first-" or "bytes=-suffix" (RFC 7233, 2.1). Returns false for anything else,
+    // including a list of ranges, the whole file is served then. A first beyond the file is not satisfiable.
+    static bool ByteRange(const string& text, const uint64_t size, uint64_t& first, uint64_t& last)
+    {
+        static const TCHAR unit[] = _T("bytes=");
+        static const uint32_t unitLength = (sizeof(unit) / sizeof(TCHAR)) - 1;
+
+        bool result = false;
+        Core::TextFragment range(text);
+
+        range.TrimBegin(_T(" \t"));
+        range.TrimEnd(_T(" \t"));
+
+        if ((range.Length() > unitLength) && (Core::TextFragment(range, 0, unitLength).EqualText(unit, 0, unitLength, false) == true) && (range.ForwardFind(',') >= range.Length())) {
+            const Core::TextFragment specifier(range, unitLength, range.Length() - unitLength);
+            const uint32_t dash = specifier.ForwardFind('-');
+
+            if (dash < specifier.Length()) {
+                const Core::TextFragment start(specifier, 0, dash);
+                const Core::TextFragment end(specifier, dash + 1, specifier.Length() - dash - 1);
+                uint64_t from;
+                uint64_t to;
+
+                if (Number(start, from) == true) {
+                    if (end.IsEmpty() == true) {
+                        first = from;
+                        last = size - 1;
+                        result = true;
+                    } else if ((Number(end, to) == true) && (to >= from)) {
+                        first = from;
+                        last = (to < size ? to : size - 1);
+                        result = true;
+                    }
+                } else if ((start.IsEmpty() == true) && (Number(end, to) == true)) {
+                    // The last <to> bytes, none at all can not be satisfied.
+                    first = (to == 0 ? size : (to < size ? size - to : 0));
+                    last = size - 1;
+                    result = true;
+                }
+            }
+        }
+
+        return (result);
+    }
+
+    // Weak comparison (RFC 7232, 2.3.2), a W/ prefix makes no difference for a GET.
+    static bool EntityTagMatch(const string& list, const string& tag)
+    {
+        bool result = false;
+        Core::TextSegmentIterator entries(Core::TextFragment(list), true, ',');
+
+        while ((result == false) && (entries.Next() == true)) {
+            Core::TextFragment entry(entries.Current());
+
+            entry.TrimBegin(_T(" \t"));
+            entry.TrimEnd(_T(" \t"));
+
+            if ((entry.Length() > 2) && (entry[0] == 'W') && (entry[1] == '/')) {
+                entry = Core::TextFragment(entry, 2, entry.Length() - 2);
+            }
+
+            result = ((entry == _T("*")) || (entry == tag));
+        }
+
+        return (result);
+    }
+
+    void FileResponse(const Request& request, Response& response, const Core::ProxyType<FileBody>& body)
+    {
+        ASSERT(body.IsValid() == true);
+
+        if ((body->Exists() == false) || (body->IsDirectory() == true)) {
+            response.ErrorCode = STATUS_NOT_FOUND;
+        } else {
+            const uint64_t size = body->Size();
+            const uint64_t modified = body->ModificationTime().Ticks() / (Core::Time::TicksPerMillisecond * 1000);
+            const string tag(_T("\"") + Core::NumberType<uint64_t>(size).Text() + '-' + Core::NumberType<uint64_t>(modified).Text() + _T("\""));
+            bool unchanged = false;
+            uint64_t first = 0;
+            uint64_t last = 0;
+
+            response.ETag = tag;
+            response.Modified = body->ModificationTime();
+            response.AcceptRange = _T("bytes");
+
+            // If-None-Match wins from If-Modified-Since if both are there (RFC 7232, 3.3).
+            if (request.IfNoneMatch.IsSet() == true) {
+                unchanged = EntityTagMatch(request.IfNoneMatch.Value(), tag);
+            } else if (request.IfModifiedSince.IsSet() == true) {
+                unchanged = (modified <= (request.IfModifiedSince.Value().Ticks() / (Core::Time::TicksPerMillisecond * 1000)));
+            }
+
+            if (unchanged == true) {
+                response.ErrorCode = STATUS_NOT_MODIFIED;
+            } else if ((request.Range.IsSet() == true) && (ByteRange(request.Range.Value(), size, first, last) == true)) {
+                // The body can only start at a position a file can seek to, and its length has to fit 32 bits
+                // (all ones means a length that is not known). A longer range is cut short, the Content-Range
+                // tells the client what it got, so it can ask for the rest.
+                if ((first >= size) || (first > static_cast<uint64_t>(Core::NumberType<int32_t>::Max()))) {
+                    response.ErrorCode = STATUS_REQUEST_RANGE_NOT_SATISFIABLE;
+                    response.ContentRange = _T("bytes */") + Core::NumberType<uint64_t>(size).Text();
+                } else {
+                    last = std::min(last, first + static_cast<uint32_t>(~0) - 2);
+
+                    response.ErrorCode = STATUS_PARTIAL_CONTENT;
+                    response.ContentRange = _T("bytes ") + Core::NumberType<uint64_t>(first).Text() + '-' + Core::NumberType<uint64_t>(last).Text() + '/' + Core::NumberType<uint64_t>(size).Text();
+
+                    body->Range(static_cast<uint32_t>(first), static_cast<uint32_t>(last - first + 1));
+                    response.Body<FileBody>(body);
+                }
+            } else {
+                response.Body<FileBody>(body);
+            }
+        }
+    }
+
+    uint32_t StreamBody::Write(const uint8_t data[], const uint32_t length)
+    {
+        ILink* link = nullptr;
+
+        _adminLock.Lock();
+
+        ASSERT(_closed == false);
+
+        const uint32_t size = static_cast<uint32_t>(_buffer.size());
+        const uint32_t taken = std::min(length, size - _used);
+        const uint32_t tail = (_head + _used) % size;
+        const uint32_t first = std::min(taken, size - tail);
+
+        ::memcpy(&(_buffer[tail]), data, first);
+        ::memcpy(&(_buffer[0]), &(data[first]), taken - first);
+
+        _used += taken;
+        _full = (taken < length);
+
+        if (taken > 0) {
+            link = Triggering();
+        }
+
+        _adminLock.Unlock();
+
+        // Outside the lock, the link sends with its own lock taken and then asks us for more.
+        Trigger(link);
+
+        return (taken);
+    }
+
+    void StreamBody::Close()
+    {
+        ILink* link = nullptr;
+
+        _adminLock.Lock();
+
+        _closed = true;
+
+        link = Triggering();
+
+        _adminLock.Unlock();
+
+        Trigger(link);
+    }
+
+    IBody::ILink* StreamBody::Triggering() const
+    {
+        ILink* link = nullptr;
+
+        if ((_idle == true) && (_link != nullptr)) {
+            _idle = false;
+            link = _link;
+
+            // Taken with the lock, so a detached link is never taken anymore.
+            link->AddRef();
+        }
+
+        return (link);
+    }
+
+    void StreamBody::Trigger(ILink* link) const
+    {
+        if (link != nullptr) {
+            link->Trigger();
+            link->Release();
+        }
+    }
+
+    uint16_t StreamBody::Produce(uint8_t stream[], const uint16_t maxLength, bool& last) const
+    {
+        IProducer* producer = nullptr;
+
+        _adminLock.Lock();
+
+        const uint32_t size = static_cast<uint32_t>(_buffer.size());
+        const uint16_t result = static_cast<uint16_t>(std::min(static_cast<uint32_t>(maxLength), _used));
+        const uint32_t first = std::min(static_cast<uint32_t>(result), size - _head);
+
+        ::memcpy(stream, &(_buffer[_head]), first);
+        ::memcpy(&(stream[first]), &(_buffer[0]), result - first);
+
+        _head = (_head + result) % size;
+        _used -= result;
+
+        last = ((_closed == true) && (_used == 0));
+
+        // Nothing to send, the next Write() or Close() has to wake the link.
+        _idle = ((result == 0) && (last == false));
+
+        if ((result > 0) && (_full == true)) {
+            _full = false;
+            producer = _producer;
+        }
+
+        _adminLock.Unlock();
+
+        if (producer != nullptr) {
+            producer->Writable();
+        }
+
+        return (result);
+    }
+
+    // Chunked transfer coding (RFC 7230, 4.1). The size always has four hex digits, leading zeroes are allowed,
+    // so the data can be produced right behind it. There is room for the closing chunk as well.
+    static constexpr uint16_t ChunkHeader = 6;
+    static constexpr uint16_t ChunkOverhead = ChunkHeader + 2 + 5;
+
+    static uint16_t Chunk(const IBody& body, uint8_t stream[], const uint16_t maxLength, bool& last)
+    {
+        static const TCHAR hex[] = _T("0123456789ABCDEF");
+
+        uint16_t result = 0;
+
+        last = false;
+
+        if (maxLength > ChunkOverhead) {
+            uint16_t size = body.Produce(&(stream[ChunkHeader]), maxLength - ChunkOverhead, last);
+
+            if (size > 0) {
+                stream[0] = hex[(size >> 12) & 0xF];
+                stream[1] = hex[(size >> 8) & 0xF];
+                stream[2] = hex[(size >> 4) & 0xF];
+                stream[3] = hex[size & 0xF];
+                stream[4] = '\r';
+                stream[5] = '\n';
+                stream[ChunkHeader + size] = '\r';
+                stream[ChunkHeader + size + 1] = '\n';
+
+                result = ChunkHeader + size + 2;
+            }
+            if (last == true) {
+                ::memcpy(&(stream[result]), "0\r\n\r\n", 5);
+                result += 5;
+            }
+        }
+
+        return (result);
+    }
+
     static Signature ToSignature(const string& input)
     {
         Core::TextFragment inputLine(input);
@@ -513,6 +887,7 @@ namespace Web
 
         if (_state == REPORT) {
             if (_current->_body.IsValid() == true) {
+                _current->_body->Attach(nullptr);
                 _current->_body->End();
             }
             _buffer = nullptr;
@@ -523,7 +898,10 @@ namespace Web
         }
 
         if (_current != nullptr) {
-            while ((current < maxLength) && (_state != REPORT)) {
+            // Set if a streamed body has nothing to send right now, it triggers the link once it has.
+            bool idle = false;
+
+            while ((current < maxLength) && (_state != REPORT) && (idle == false)) {
                 while ((current < maxLength) && ((_state & EOL_MARKER) == EOL_MARKER)) {
                     if (_offset == 0) {
                         stream[current++] = '\r';
@@ -784,7 +1162,7 @@ namespace Web
                             Core::EnumerateType<TransferTypes> enumValue(_current->TransferEncoding.Value());
 
                             _keyIndex = 18;
-                            _buffer = (_current->Mode() == MARSHAL_UPPERCASE ? __TRANSFER_ENCODING : _T("Transfer-Encoding"));
+                            _buffer = (_current->Mode() == MARSHAL_UPPERCASE ? __TRANSFER_ENCODING : _T("Transfer-Encoding:"));
                             _value = enumValue.Data();
                             _offset = 0;
                         } else if ((_keyIndex <= 18) && (_current->Man.IsSet() == true)) {
@@ -808,15 +1186,39 @@ namespace Web
                             _buffer = (_current->Mode() == MARSHAL_UPPERCASE ? __AUTHORIZATION : _T("Authorization:"));
                             FromAuthorization(_current->WebToken.Value(), _value);
                             _offset = 0;
-                        } else if ((_keyIndex <= 22) && (((_bodyLength = (_current->_body.IsValid() ? _current->_body->Serialize() : 0)) > 0) || (_current->ContentLength.IsSet() == true) || (!_current->Connection.IsSet()) || (_current->Connection.Value() != Request::CONNECTION_CLOSE))) {
-                            _keyIndex = (_bodyLength > 0 ? 23 : 24);
-
-                            Core::NumberType<uint32_t, false, BASE_DECIMAL> number(_bodyLength);
-                            _buffer = (_current->Mode() == MARSHAL_UPPERCASE ? __CONTENT_LENGTH : _T("Content-Length:"));
-                            number.Serialize(_value);
+                        } else if ((_keyIndex <= 22) && (_current->IfModifiedSince.IsSet() == true)) {
+                            _keyIndex = 23;
+                            _buffer = (_current->Mode() == MARSHAL_UPPERCASE ? __IF_MODIFIED_SINCE : _T("If-Modified-Since:"));
+                            _value = _current->IfModifiedSince.Value().ToRFC1123(false);
                             _offset = 0;
-                        } else if ((_keyIndex <= 23) && (_current->ContentSignature.IsSet() == true)) {
+                        } else if ((_keyIndex <= 23) && (_current->IfNoneMatch.IsSet() == true)) {
                             _keyIndex = 24;
+                            _buffer = (_current->Mode() == MARSHAL_UPPERCASE ? __IF_NONE_MATCH : _T("If-None-Match:"));
+                            _value = _current->IfNoneMatch.Value();
+                            _offset = 0;
+                        } else if ((_keyIndex <= 24) && (_current->Range.IsSet() == true)) {
+                            _keyIndex = 25;
+                            _buffer = (_current->Mode() == MARSHAL_UPPERCASE ? __RANGE : _T("Range:"));
+                            _value = _current->Range.Value();
+                            _offset = 0;
+                        } else if ((_keyIndex <= 25) && (((_bodyLength = (_current->_body.IsValid() ? _current->_body->Serialize() : 0)) > 0) || (_current->ContentLength.IsSet() == true) || (!_current->Connection.IsSet()) || (_current->Connection.Value() != Request::CONNECTION_CLOSE))) {
+                            _keyIndex = (_bodyLength > 0 ? 26 : 27);
+
+                            if (_bodyLength == static_cast<uint32_t>(~0)) {
+                                // Produced while it is sent, there is no length to announce.
+                                Core::EnumerateType<TransferTypes> enumValue(TRANSFER_CHUNKED);
+
+                                _buffer = (_current->Mode() == MARSHAL_UPPERCASE ? __TRANSFER_ENCODING : _T("Transfer-Encoding:"));
+                                _value = enumValue.Data();
+                                _current->_body->Attach(this);
+                            } else {
+                                Core::NumberType<uint32_t, false, BASE_DECIMAL> number(_bodyLength);
+                                _buffer = (_current->Mode() == MARSHAL_UPPERCASE ? __CONTENT_LENGTH : _T("Content-Length:"));
+                                number.Serialize(_value);
+                            }
+                            _offset = 0;
+                        } else if ((_keyIndex <= 26) && (_current->ContentSignature.IsSet() == true)) {
+                            _keyIndex = 27;
                             _buffer = (_current->Mode() == MARSHAL_UPPERCASE ? __CONTENT_SIGNATURE : _T("Content-HMAC:"));
                             FromSignature(_current->ContentSignature.Value(), _value);
                             _offset = 0;
@@ -863,16 +1265,35 @@ namespace Web
                     break;
                 }
                 case BODY: {
-                    if (_bodyLength != 0) {
-                        ASSERT(maxLength >= current);
-                        uint32_t size = (static_cast<uint32_t>(maxLength - current) <= _bodyLength ? static_cast<uint32_t>(maxLength - current) : _bodyLength);
+                    if (_bodyLength == static_cast<uint32_t>(~0)) {
+                        bool last;
+                        uint16_t size = Chunk(*(_current->_body), &(stream[current]), maxLength - current, last);
 
-                        if (size > 0) {
-                            ASSERT(_current->_body.IsValid() == true);
+                        current += size;
 
-                            _current->_body->Serialize(&(stream[current]), size);
-                            _bodyLength -= size;
-                            current += size;
+                        if (last == true) {
+                            _bodyLength = 0;
+                        } else if (size == 0) {
+                            idle = true;
+                        }
+                    } else if (_bodyLength != 0) {
+                        Core::File::Handle file;
+                        uint64_t position;
+
+                        ASSERT(_current->_body.IsValid() == true);
+
+                        if ((_current->_body->Descriptor(file, position) == true) && (Transfer(file, position, _bodyLength) == true)) {
+                            // The link sends it straight from the file, after what is in the stream now.
+                            _bodyLength = 0;
+                        } else {
+                            ASSERT(maxLength >= current);
+                            uint32_t size = (static_cast<uint32_t>(maxLength - current) <= _bodyLength ? static_cast<uint32_t>(maxLength - current) : _bodyLength);
+
+                            if (size > 0) {
+                                _current->_body->Serialize(&(stream[current]), size);
+                                _bodyLength -= size;
+                                current += size;
+                            }
                         }
                     }
 
@@ -907,6 +1328,7 @@ namespace Web
 
         if (_state == REPORT) {
             if (_current->_body.IsValid() == true) {
+                _current->_body->Attach(nullptr);
                 _current->_body->End();
             }
             _buffer = nullptr;
@@ -917,7 +1339,10 @@ namespace Web
         }
 
         if (_current != nullptr) {
-            while ((current < maxLength) && (_state != REPORT)) {
+            // Set if a streamed body has nothing to send right now, it triggers the link once it has.
+            bool idle = false;
+
+            while ((current < maxLength) && (_state != REPORT) && (idle == false)) {
                 while ((current < maxLength) && ((_state & EOL_MARKER) == EOL_MARKER)) {
                     if (_offset == 0) {
                         stream[current++] = '\r';
@@ -1038,7 +1463,7 @@ namespace Web
                             _offset = 0;
                         } else if ((_keyIndex <= 2) && (_current->Modified.IsSet() == true)) {
                             _keyIndex = 3;
-                            _buffer = (_current->Mode() == MARSHAL_UPPERCASE ? __MODIFIED : _T("Modified:"));
+                            _buffer = (_current->Mode() == MARSHAL_UPPERCASE ? __MODIFIED : _T("Last-Modified:"));
                             _value = _current->Modified.Value().ToRFC1123(false);
                             _offset = 0;
                         } else if ((_keyIndex <= 3) && (_current->Connection.IsSet() == true)) {
@@ -1060,7 +1485,7 @@ namespace Web
                             _offset = 0;
                         } else if ((_keyIndex <= 6) && (_current->AcceptRange.IsSet() == true)) {
                             _keyIndex = 7;
-                            _buffer = (_current->Mode() == MARSHAL_UPPERCASE ? __ACCEPT_RANGE : _T("Accept-Range:"));
+                            _buffer = (_current->Mode() == MARSHAL_UPPERCASE ? __ACCEPT_RANGE : _T("Accept-Ranges:"));
                             _value = _current->AcceptRange.Value();
                             _offset = 0;
                         } else if ((_keyIndex <= 7) && (_current->ETag.IsSet() == true)) {
@@ -1187,15 +1612,34 @@ namespace Web
                             _buffer = (_current->Mode() == MARSHAL_UPPERCASE ? __APPLICATION_URL : _T("Application-URL:"));
                             _value = _current->ApplicationURL.Value().Text().Text();
                             _offset = 0;
-                        } else if ((_keyIndex <= 23) && (((_bodyLength = (_current->_body.IsValid() ? _current->_body->Serialize() : 0)) > 0) || (_current->ContentLength.IsSet() == true) || (!_current->Connection.IsSet()) || (_current->Connection.Value() != Response::CONNECTION_CLOSE))) {
-                            _keyIndex = (_bodyLength > 0 ? 24 : 25);
-
-                            Core::NumberType<uint32_t, false, BASE_DECIMAL> number(_bodyLength);
-                            _buffer = (_current->Mode() == MARSHAL_UPPERCASE ? __CONTENT_LENGTH : _T("Content-Length:"));
-                            number.Serialize(_value);
+                        } else if ((_keyIndex <= 23) && (_current->WebSocketExtensions.IsSet() == true)) {
+                            _keyIndex = 24;
+                            _buffer = (_current->Mode() == MARSHAL_UPPERCASE ? __WEBSOCKET_EXTENSIONS : _T("Sec-WebSocket-Extensions:"));
+                            _value = _current->WebSocketExtensions.Value();
                             _offset = 0;
-                        } else if ((_keyIndex <= 24) && (_current->ContentSignature.IsSet() == true)) {
+                        } else if ((_keyIndex <= 24) && (_current->ContentRange.IsSet() == true)) {
                             _keyIndex = 25;
+                            _buffer = (_current->Mode() == MARSHAL_UPPERCASE ? __CONTENT_RANGE : _T("Content-Range:"));
+                            _value = _current->ContentRange.Value();
+                            _offset = 0;
+                        } else if ((_keyIndex <= 25) && (((_bodyLength = (_current->_body.IsValid() ? _current->_body->Serialize() : 0)) > 0) || (_current->ContentLength.IsSet() == true) || (!_current->Connection.IsSet()) || (_current->Connection.Value() != Response::CONNECTION_CLOSE))) {
+                            _keyIndex = (_bodyLength > 0 ? 26 : 27);
+
+                            if (_bodyLength == static_cast<uint32_t>(~0)) {
+                                // Produced while it is sent, there is no length to announce.
+                                Core::EnumerateType<TransferTypes> enumValue(TRANSFER_CHUNKED);
+
+                                _buffer = (_current->Mode() == MARSHAL_UPPERCASE ? __TRANSFER_ENCODING : _T("Transfer-Encoding:"));
+                                _value = enumValue.Data();
+                                _current->_body->Attach(this);
+                            } else {
+                                Core::NumberType<uint32_t, false, BASE_DECIMAL> number(_bodyLength);
+                                _buffer = (_current->Mode() == MARSHAL_UPPERCASE ? __CONTENT_LENGTH : _T("Content-Length:"));
+                                number.Serialize(_value);
+                            }
+                            _offset = 0;
+                        } else if ((_keyIndex <= 26) && (_current->ContentSignature.IsSet() == true)) {
+                            _keyIndex = 27;
                             _buffer = (_current->Mode() == MARSHAL_UPPERCASE ? __CONTENT_SIGNATURE : _T("Content-HMAC:"));
                             FromSignature(_current->ContentSignature.Value(), _value);
                             _offset = 0;
@@ -1242,16 +1686,35 @@ namespace Web
                     break;
                 }
                 case BODY: {
-                    if (_bodyLength != 0) {
-                        ASSERT(maxLength >= current);
-                        uint32_t size = (static_cast<uint32_t>(maxLength - current) <= _bodyLength ? static_cast<uint32_t>(maxLength - current) : _bodyLength);
+                    if (_bodyLength == static_cast<uint32_t>(~0)) {
+                        bool last;
+                        uint16_t size = Chunk(*(_current->_body), &(stream[current]), maxLength - current, last);
+
+                        current += size;
+
+                        if (last == true) {
+                            _bodyLength = 0;
+                        } else if (size == 0) {
+                            idle = true;
+                        }
+                    } else if (_bodyLength != 0) {
+                        Core::File::Handle file;
+                        uint64_t position;
+
+                        ASSERT(_current->_body.IsValid() == true);
 
-                        if (size > 0) {
-                            ASSERT(_current->_body.IsValid() == true);
+                        if ((_current->_body->Descriptor(file, position) == true) && (Transfer(file, position, _bodyLength) == true)) {
+                            // The link sends it straight from the file, after what is in the stream now.
+                            _bodyLength = 0;
+                        } else {
+                            ASSERT(maxLength >= current);
+                            uint32_t size = (static_cast<uint32_t>(maxLength - current) <= _bodyLength ? static_cast<uint32_t>(maxLength - current) : _bodyLength);
 
-                            _current->_body->Serialize(&(stream[current]), size);
-                            _bodyLength -= size;
-                            current += size;
+                            if (size > 0) {
+                                _current->_body->Serialize(&(stream[current]), size);
+                                _bodyLength -= size;
+                                current += size;
+                            }
                         }
                     }
 
@@ -1315,13 +1778,12 @@ namespace Web
 
     void Request::Deserializer::Parse(const string& buffer)
     {
-
-        _lock.Lock();
+        // Only called by the parser, from within Deserialize() which holds the lock already.
 
         // Word complete check and set......
         switch (_state) {
         case VERB: {
-            Core::EnumerateType<Request::type> type(buffer.c_str(), true);
+            Core::OptionalType<Request::type> type(KeywordTable<Request::type>::Find(buffer));
             if ((type.IsSet() == false) || ((_current = Element()) == nullptr)) {
                 _parser.FlushLine();
             } else {
@@ -1334,26 +1796,23 @@ namespace Web
             break;
         }
         case URL: {
-            // See if there is a '?' mark in this entry
-            size_t query = buffer.find('?', 0);
-            size_t fragment = buffer.find('#', 0);
+            // See if there is a '?' or a '#' mark in this entry, one scan finds the first of both.
+            size_t marker = buffer.find_first_of(_T("?#"));
 
-            if ((query == string::npos) && (fragment == string::npos)) {
+            if (marker == string::npos) {
                 _current->Path = buffer;
-            } else if (fragment == string::npos) {
-                _current->Path = buffer.substr(0, query);
-                _current->Query = buffer.substr(query + 1, buffer.size() - query);
-            } else if (query == string::npos) {
-                _current->Path = buffer.substr(0, fragment);
-                _current->Fragment = buffer.substr(fragment + 1, buffer.size() - fragment);
-            } else if (query < fragment) {
-                _current->Path = buffer.substr(0, query);
-                _current->Query = buffer.substr(query + 1, buffer.size() - query);
-                _current->Fragment = buffer.substr(fragment + 1, buffer.size() - fragment);
             } else {
-                _current->Path = buffer.substr(0, fragment);
-                _current->Fragment = buffer.substr(fragment + 1, buffer.size() - fragment);
-                _current->Query = buffer.substr(query + 1, buffer.size() - query);
+                size_t query = (buffer[marker] == '?' ? marker : buffer.find('?', marker + 1));
+                size_t fragment = (buffer[marker] == '#' ? marker : buffer.find('#', marker + 1));
+
+                _current->Path.assign(buffer, 0, marker);
+
+                if (query != string::npos) {
+                    _current->Query = buffer.substr(query + 1, buffer.size() - query);
+                }
+                if (fragment != string::npos) {
+                    _current->Fragment = buffer.substr(fragment + 1, buffer.size() - fragment);
+                }
             }
 
             // It should still be in CollectWord mode.. Continue..
@@ -1422,7 +1881,7 @@ namespace Web
                 }
             } else {
                 // See if we recognise this word...
-                Core::EnumerateType<Request::keywords> keyWord(buffer.c_str(), true);
+                Core::OptionalType<Request::keywords> keyWord(KeywordTable<Request::keywords>::Find(buffer));
                 if (keyWord.IsSet() == false) {
                     //TRACE_L1("Could not resolve keyword %s", buffer.c_str());
                     _parser.FlushLine();
@@ -1479,6 +1938,21 @@ namespace Web
             case Request::AUTHORIZATION:
                 _current->WebToken = ToAuthorization(buffer);
                 break;
+            case Request::IF_MODIFIED_SINCE: {
+                Core::Time time;
+
+                if (time.FromString(buffer, true) == true) {
+                    _current->IfModifiedSince = time;
+                }
+
+                break;
+            }
+            case Request::IF_NONE_MATCH:
+                _current->IfNoneMatch = buffer;
+                break;
+            case Request::RANGE:
+                _current->Range = buffer;
+                break;
             case Request::CONTENT_SIGNATURE:
                 _current->ContentSignature = ToSignature(buffer);
                 break;
@@ -1572,7 +2046,7 @@ namespace Web
             break;
         }
         case CHUNK_INIT: {
-            uint32_t chunkedSize = Core::NumberType<uint32_t>(Core::TextFragment(buffer));
+            uint32_t chunkedSize = Core::NumberType<uint32_t>(Core::TextFragment(buffer), NumberBase::BASE_HEXADECIMAL);
             if (chunkedSize == 0) {
                 _state = BODY_END;
                 _parser.FlushLine();
@@ -1585,8 +2059,6 @@ namespace Web
         case BODY_END:
             break;
         }
-
-        _lock.Unlock();
     }
 
     void Request::Deserializer::EndOfPassThrough()
@@ -1656,6 +2128,9 @@ namespace Web
             _state = VERB;
             break;
         }
+        case CHUNK_INIT: {
+            break;
+        }
         default: {
             ASSERT(false);
         }
@@ -1699,7 +2174,7 @@ namespace Web
 
     void Response::Deserializer::Parse(const string& buffer)
     {
-        _lock.Lock();
+        // Only called by the parser, from within Deserialize() which holds the lock already.
 
         // Word complete check and set......
         switch (_state) {
@@ -1781,7 +2256,7 @@ namespace Web
                 break;
             } else {
                 // See if we recognise this word...
-                Core::EnumerateType<Response::keywords> keyWord(buffer.c_str(), true);
+                Core::OptionalType<Response::keywords> keyWord(KeywordTable<Response::keywords>::Find(buffer));
                 if (keyWord.IsSet() == false) {
                     //TRACE_L1("Could not resolve keyword %s", buffer.c_str());
                     _parser.FlushLine();
@@ -1817,6 +2292,12 @@ namespace Web
             case Response::WEBSOCKET_PROTOCOL:
                 _current->WebSocketProtocol = buffer;
                 break;
+            case Response::WEBSOCKET_EXTENSIONS:
+                _current->WebSocketExtensions = buffer;
+                break;
+            case Response::CONTENT_RANGE:
+                _current->ContentRange = buffer;
+                break;
             case Response::CONTENT_SIGNATURE:
                 _current->ContentSignature = ToSignature(buffer);
                 break;
@@ -1924,7 +2405,7 @@ namespace Web
                 Core::Time time;
 
                 if (time.FromString(buffer, true) == true) {
-                    _current->Date = time;
+                    _current->Modified = time;
                 }
 
                 break;
@@ -1962,8 +2443,6 @@ namespace Web
         case BODY_END:
             break;
         }
-
-        _lock.Unlock();
     }
 
     void Response::Deserializer::EndOfPassThrough()
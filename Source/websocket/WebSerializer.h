@@ -149,6 +149,7 @@ namespace Web {
             : Core::File()
             , _opened(false)
             , _startPosition(0)
+            , _length(~0)
         {
         }
 
@@ -156,6 +157,7 @@ namespace Web {
             : Core::File(path, sharable)
             , _opened(false)
             , _startPosition(0)
+            , _length(~0)
         {
         }
 
@@ -168,6 +170,7 @@ namespace Web {
         {
             Core::File::operator=(location);
             _startPosition = 0;
+            _length = ~0;
 
             return (*this);
         }
@@ -175,20 +178,36 @@ namespace Web {
         {
             Core::File::operator=(RHS);
             _startPosition = Core::File::Position();
+            _length = ~0;
 
             return (*this);
         }
+        // Only serialize <length> bytes starting at <offset>, e.g. to answer a range request.
+        inline void Range(const uint32_t offset, const uint32_t length)
+        {
+            _startPosition = offset;
+            _length = length;
+        }
 
     protected:
         virtual uint32_t Serialize() const override
         {
+            uint32_t result = 0;
+
             _opened = (Core::File::IsOpen() == false);
 
             if (_opened == false) {
                 const_cast<FileBody*>(this)->LoadFileInfo();
+            }
+            if ((_opened == false) || (Core::File::Open() == true)) {
+                // Opening does not move to the start position, it has to be set either way.
                 const_cast<FileBody*>(this)->Position(false, _startPosition);
+
+                if (Core::File::Size() > static_cast<uint64_t>(_startPosition)) {
+                    result = static_cast<uint32_t>(std::min(Core::File::Size() - _startPosition, static_cast<uint64_t>(_length)));
+                }
             }
-            return (((_opened == false) || (Core::File::Open() == true)) ? static_cast<uint32_t>(Core::File::Size() - _startPosition) : 0);
+            return (result);
         }
         virtual uint32_t Deserialize() override
         {
@@ -204,6 +223,13 @@ namespace Web {
         {
             Core::File::Write(stream, maxLength);
         }
+        virtual bool Descriptor(Core::File::Handle& handle, uint64_t& position) const override
+        {
+            handle = static_cast<Core::File::Handle>(const_cast<FileBody&>(*this));
+            position = static_cast<uint64_t>(Core::File::Position());
+
+            return (Core::File::IsOpen() == true);
+        }
         virtual void End() const override
         {
             if (Core::File::IsOpen() == true) {
@@ -218,8 +244,13 @@ namespace Web {
     private:
         mutable bool _opened;
         mutable int32_t _startPosition;
+        uint32_t _length;
     };
 
+    // Answers a request for the file of <body>: a 304 if the conditional headers show the client has it
+    // already, a 206 for a single byte range, a 416 for a range beyond the end and otherwise the whole file.
+    void EXTERNAL FileResponse(const Request& request, Response& response, const Core::ProxyType<FileBody>& body);
+
     template <typename HASHALGORITHM>
     class SignedFileBodyType : public FileBody {
     private:
@@ -303,6 +334,137 @@ namespace Web {
         mutable HASHALGORITHM _hash;
     };
 
+    // A body that is never in memory as a whole. Sent, it goes out chunked while it is produced: Write() takes
+    // no more than the buffer has room for and the producer is told when there is room again, so it runs at
+    // the pace the link sends at. Received, every part is handed to the consumer as it comes in, a consumer
+    // that takes its time holds up the link and with it the sender.
+    class EXTERNAL StreamBody : public IBody {
+    public:
+        struct EXTERNAL IProducer {
+            virtual ~IProducer(){};
+
+            // A Write() did not take everything, now there is room again.
+            virtual void Writable() = 0;
+        };
+        struct EXTERNAL IConsumer {
+            virtual ~IConsumer(){};
+
+            virtual void Received(const uint8_t data[], const uint16_t length) = 0;
+            virtual void Completed() = 0;
+        };
+
+    private:
+        StreamBody(const StreamBody&) = delete;
+        StreamBody& operator=(const StreamBody&) = delete;
+
+    public:
+        StreamBody(const uint32_t bufferSize = 0x10000)
+            : _adminLock()
+            , _buffer(bufferSize)
+            , _head(0)
+            , _used(0)
+            , _closed(false)
+            , _full(false)
+            , _idle(false)
+            , _receiving(false)
+            , _link(nullptr)
+            , _producer(nullptr)
+            , _consumer(nullptr)
+        {
+            ASSERT(bufferSize > 0);
+        }
+        virtual ~StreamBody()
+        {
+            ASSERT(_link == nullptr);
+        }
+
+    public:
+        void Producer(IProducer* producer)
+        {
+            _adminLock.Lock();
+            _producer = producer;
+            _adminLock.Unlock();
+        }
+        void Consumer(IConsumer* consumer)
+        {
+            _adminLock.Lock();
+            _consumer = consumer;
+            _adminLock.Unlock();
+        }
+
+        // Returns the number of bytes taken, less than offered if the buffer is full.
+        uint32_t Write(const uint8_t data[], const uint32_t length);
+
+        // Nothing more will be written, the body ends once the buffer is sent.
+        void Close();
+
+    protected:
+        virtual uint32_t Serialize() const override
+        {
+            return (static_cast<uint32_t>(~0));
+        }
+        virtual uint32_t Deserialize() override
+        {
+            _receiving = true;
+            return (static_cast<uint32_t>(~0));
+        }
+        virtual void Serialize(uint8_t[] /* stream */, const uint16_t /* maxLength */) const override
+        {
+            // A stream has no length, it is only sent through Produce().
+            ASSERT(false);
+        }
+        virtual void Deserialize(const uint8_t stream[], const uint16_t maxLength) override
+        {
+            _adminLock.Lock();
+
+            if (_consumer != nullptr) {
+                _consumer->Received(stream, maxLength);
+            }
+
+            _adminLock.Unlock();
+        }
+        virtual void End() const override
+        {
+            _adminLock.Lock();
+
+            if ((_receiving == true) && (_consumer != nullptr)) {
+                _consumer->Completed();
+            }
+            _receiving = false;
+
+            _adminLock.Unlock();
+        }
+        virtual uint16_t Produce(uint8_t stream[], const uint16_t maxLength, bool& last) const override;
+        // Once detached, the link is not triggered anymore. A Trigger() already under way holds the link, it
+        // is the link that waits for it before it goes, see ILink::AddRef(). The link detaches while it sends,
+        // so waiting here would hold up the very Trigger() waited for.
+        virtual void Attach(ILink* link) const override
+        {
+            _adminLock.Lock();
+            _link = link;
+            _idle = false;
+            _adminLock.Unlock();
+        }
+
+    private:
+        // Takes the link to trigger, if there is any and it waits for data, with the lock taken.
+        ILink* Triggering() const;
+        void Trigger(ILink* link) const;
+
+    private:
+        mutable Core::CriticalSection _adminLock;
+        std::vector<uint8_t> _buffer;
+        mutable uint32_t _head;
+        mutable uint32_t _used;
+        bool _closed;
+        mutable bool _full;
+        mutable bool _idle;
+        mutable bool _receiving;
+        mutable ILink* _link;
+        IProducer* _producer;
+        IConsumer* _consumer;
+    };
+
     template <typename JSONOBJECT>
     class JSONBodyType : public JSONOBJECT, public IBody {
     private:
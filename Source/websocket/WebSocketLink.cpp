@@ -19,7 +19,22 @@
 
 #include "WebSocketLink.h"
 
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
 namespace WPEFramework {
+
+ENUM_CONVERSION_BEGIN(Web::WebSocket::compression)
+
+    { Web::WebSocket::NO_COMPRESSION, _TXT("none") },
+    { Web::WebSocket::DEFLATE, _TXT("deflate") },
+    { Web::WebSocket::DEFLATE_NO_CONTEXT, _TXT("deflatenocontext") },
+
+ENUM_CONVERSION_END(Web::WebSocket::compression)
+
 namespace Web {
     namespace WebSocket {
         static RequestAllocator _requestAllocator;
@@ -40,6 +55,7 @@ namespace Web {
         static const uint8_t TYPE_FRAME = 0x0F;
         static const uint8_t MASKING_FRAME = 0x80;
         static const uint8_t CONTROL_FRAME = 0x08;
+        static const uint8_t COMPRESSED_FRAME = 0x40; // RSV1, set on the first frame of a compressed message
         static const uint8_t HandShakeKey[] = "258EAFA5-E914-47DA-95CA-C5AB0DC85B11";
 
         std::string Protocol::RequestKey() const
@@ -77,20 +93,82 @@ namespace Web {
  *  %xA denotes a pong
  *  %xB-F are reserved for further control frames
  */
+        /* static */ void Protocol::Mask(uint8_t data[], const uint32_t length, const uint8_t key[4], const uint8_t offset)
+        {
+            // The key repeats every 4 bytes, so as long as whole blocks are XOR-ed, a block wide key lines up.
+            uint8_t pattern[16];
+            uint32_t index = 0;
+
+            for (uint8_t teller = 0; teller < sizeof(pattern); teller++) {
+                pattern[teller] = key[(offset + teller) & 0x3];
+            }
+
+#if defined(__SSE2__)
+            const __m128i mask = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pattern));
+
+            while ((index + 32) <= length) {
+                __m128i first = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&data[index]));
+                __m128i second = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&data[index + 16]));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(&data[index]), _mm_xor_si128(first, mask));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(&data[index + 16]), _mm_xor_si128(second, mask));
+                index += 32;
+            }
+            if ((index + 16) <= length) {
+                __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&data[index]));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(&data[index]), _mm_xor_si128(block, mask));
+                index += 16;
+            }
+#elif defined(__ARM_NEON)
+            const uint8x16_t mask = vld1q_u8(pattern);
+
+            while ((index + 32) <= length) {
+                vst1q_u8(&data[index], veorq_u8(vld1q_u8(&data[index]), mask));
+                vst1q_u8(&data[index + 16], veorq_u8(vld1q_u8(&data[index + 16]), mask));
+                index += 32;
+            }
+            if ((index + 16) <= length) {
+                vst1q_u8(&data[index], veorq_u8(vld1q_u8(&data[index]), mask));
+                index += 16;
+            }
+#endif
+            // The frame payload has no alignment guarantee, memcpy is how the compiler is told to do an
+            // unaligned 64 bits access.
+            uint64_t word;
+            ::memcpy(&word, pattern, sizeof(word));
+
+            while ((index + sizeof(word)) <= length) {
+                uint64_t value;
+                ::memcpy(&value, &data[index], sizeof(value));
+                value ^= word;
+                ::memcpy(&data[index], &value, sizeof(value));
+                index += sizeof(word);
+            }
+            while (index < length) {
+                data[index] ^= pattern[index & 0x3];
+                index++;
+            }
+        }
+
+        /*  %x0 denotes a continuation frame
+ *  %x1 denotes a text frame
+ *  %x2 denotes a binary frame
+ *  %x3-7 are reserved for further non-control frames
+ *  %x8 denotes a connection close
+ *  %x9 denotes a ping
+ *  %xA denotes a pong
+ *  %xB-F are reserved for further control frames
+ */
+        // The payload is found at dataFrame[HeaderSpace()], the header is written in front of it.
         uint16_t Protocol::Encoder(uint8_t* dataFrame, const uint16_t maxSendSize, const uint16_t usedSize)
         {
             uint32_t result = 0;
 
             if ((usedSize != 0) || (SendInProgress() == true)) {
+                const uint8_t headerSpace = HeaderSpace();
+
                 result = (usedSize <= 125 ? 2 : 4);
 
-                if ((_setFlags & MASKING_FRAME) == 0) {
-                    // Only if this is a smallFrame, we need to "flush" 2 bytes..
-                    if ((result == 2) && (usedSize != 0)) {
-                        // No masking, so just move and insert the header up front..
-                        ::memmove(&dataFrame[2], &(dataFrame[4]), usedSize);
-                    }
-                } else {
+                if ((_setFlags & MASKING_FRAME) != 0) {
                     uint32_t value;
                     // Generate a new mask value
                     uint8_t maskKey[4];
@@ -100,22 +178,18 @@ namespace Web {
                     maskKey[2] = (value >> 16) & 0xFF;
                     maskKey[3] = (value >> 24) & 0xFF;
 
-                    // Mask and insert the bytes on the right spots
-                    uint8_t* source = &dataFrame[usedSize - 1 + 4];
-                    uint8_t* destination = &dataFrame[usedSize - 1 + 4 + result];
-                    uint32_t bytesToMove = usedSize;
+                    Mask(&dataFrame[headerSpace], usedSize, maskKey, 0);
 
-                    while (bytesToMove != 0) {
-                        bytesToMove--;
-                        *destination-- = (*source ^ maskKey[(bytesToMove & 0x3)]);
-                        source--;
-                    }
-
-                    // Now there is space again, write down the encryption key.
+                    // The key goes right after the length, still in front of the payload.
                     ::memcpy(&dataFrame[result], &maskKey, 4);
                     result += 4;
                 }
 
+                // Only a small frame has a header shorter than the space kept for it, close the gap (at most 125 bytes).
+                if ((result < headerSpace) && (usedSize != 0)) {
+                    ::memmove(&dataFrame[result], &(dataFrame[headerSpace]), usedSize);
+                }
+
                 if (usedSize <= 125) {
                     dataFrame[1] = ((_setFlags & MASKING_FRAME) | usedSize);
                 } else {
@@ -127,11 +201,11 @@ namespace Web {
 
                 if (usedSize < maxSendSize) {
                     // Seems like not all available space is used, so I guess we are ready..
-                    dataFrame[0] = FINISHING_FRAME | (SendInProgress() == true ? CONTINUATION_FRAME : TYPE_FRAME & _setFlags);
+                    dataFrame[0] = FINISHING_FRAME | (SendInProgress() == true ? CONTINUATION_FRAME : (TYPE_FRAME | COMPRESSED_FRAME) & _setFlags);
                     _progressInfo &= (~0x40);
                 } else {
                     // There is more to come, this is just part of a bigger picture
-                    dataFrame[0] = (SendInProgress() == true ? CONTINUATION_FRAME : TYPE_FRAME & _setFlags);
+                    dataFrame[0] = (SendInProgress() == true ? CONTINUATION_FRAME : (TYPE_FRAME | COMPRESSED_FRAME) & _setFlags);
                     _progressInfo |= (0x40);
                 }
 
@@ -140,9 +214,40 @@ namespace Web {
 
             if (((_controlStatus & (REQUEST_CLOSE | REQUEST_PING | REQUEST_PONG)) != 0) && ((result + 1) < maxSendSize)) {
                 if ((_controlStatus & REQUEST_CLOSE) != 0) {
-                    dataFrame[result++] = FINISHING_FRAME | Protocol::CLOSE;
-                    _controlStatus &= (~REQUEST_CLOSE);
-                    dataFrame[result++] = 0;
+                    const bool masking = ((_setFlags & MASKING_FRAME) != 0);
+                    const uint8_t length = (_closeStatus != NO_STATUS ? 2 : 0);
+
+                    // The status is the payload, the frame is only sent as a whole.
+                    if ((result + 2 + (masking ? 4 : 0) + length) <= maxSendSize) {
+                        dataFrame[result++] = FINISHING_FRAME | Protocol::CLOSE;
+                        dataFrame[result++] = ((_setFlags & MASKING_FRAME) | length);
+
+                        if (length != 0) {
+                            uint8_t* status = &dataFrame[result + (masking ? 4 : 0)];
+
+                            status[0] = static_cast<uint8_t>(_closeStatus >> 8);
+                            status[1] = static_cast<uint8_t>(_closeStatus & 0xFF);
+
+                            if (masking == true) {
+                                uint32_t value;
+                                uint8_t maskKey[4];
+                                Crypto::Random(value);
+                                maskKey[0] = value & 0xFF;
+                                maskKey[1] = (value >> 8) & 0xFF;
+                                maskKey[2] = (value >> 16) & 0xFF;
+                                maskKey[3] = (value >> 24) & 0xFF;
+
+                                Mask(status, length, maskKey, 0);
+                                ::memcpy(&dataFrame[result], &maskKey, 4);
+                            }
+                        } else if (masking == true) {
+                            // Nothing to mask, any key will do.
+                            ::memset(&dataFrame[result], 0, 4);
+                        }
+
+                        result += (masking ? 4 : 0) + length;
+                        _controlStatus &= (~REQUEST_CLOSE);
+                    }
                 }
                 if (((_controlStatus & REQUEST_PING) != 0) && ((result + 1) < maxSendSize)) {
                     dataFrame[result++] = FINISHING_FRAME | Protocol::PING;
@@ -169,18 +274,15 @@ namespace Web {
                 // Just unscramble, what is left...
                 if ((_progressInfo & 0x20) == 0x20) {
                     // looks like we need to unscramble..
-                    uint8_t* source = dataFrame;
-
+                    // Only what is received now, the rest of the frame follows in the next segment.
                     if (_pendingReceiveBytes < receivedSize) {
                         receivedSize = _pendingReceiveBytes;
                     }
 
-                    while (_pendingReceiveBytes != 0) {
-                        *source = (*source ^ _scrambleKey[(_progressInfo & 0x3)]);
-                        source++;
-                        _progressInfo = ((_progressInfo + 1) & 0x03) | (_progressInfo & 0xFC);
-                        _pendingReceiveBytes--;
-                    }
+                    Mask(dataFrame, receivedSize, _scrambleKey, (_progressInfo & 0x3));
+
+                    _progressInfo = ((_progressInfo + receivedSize) & 0x03) | (_progressInfo & 0xFC);
+                    _pendingReceiveBytes -= receivedSize;
                 } else {
                     if (_pendingReceiveBytes > receivedSize) {
                         _pendingReceiveBytes -= receivedSize;
@@ -197,7 +299,7 @@ namespace Web {
                 uint32_t bytesToMove = (dataFrame[1] & 0x7F);
 
                 // check if the full header is present..
-                actualHeader = 2 + (bytesToMove == 127 ? 4 : (bytesToMove == 126 ? 2 : 0)) + ((dataFrame[1] & MASKING_FRAME) ? 4 : 0);
+                actualHeader = 2 + (bytesToMove == 127 ? 8 : (bytesToMove == 126 ? 2 : 0)) + ((dataFrame[1] & MASKING_FRAME) ? 4 : 0);
 
                 if (actualHeader > receivedSize) {
                     // Frame too small to identify the content yet !!
@@ -231,12 +333,46 @@ namespace Web {
                         _frameType = INCONSISTENT;
                     }
 
-                    // If the frame is not an error, unpack/move what is required..
-                    if ((_frameType & 0xF8) == 0) {
+                    // Only the first frame of a data message may say it is compressed, and only if that was negotiated.
+                    if ((dataFrame[0] & COMPRESSED_FRAME) != 0) {
+                        if (((_setFlags & COMPRESSED_FRAME) == 0) || ((dataFrame[0] & TYPE_FRAME) == CONTINUATION_FRAME) || ((_frameType & CONTROL_FRAME) != 0)) {
+                            _frameType = VIOLATION;
+                        } else {
+                            _progressInfo |= 0x10;
+                        }
+                    } else if (((dataFrame[0] & TYPE_FRAME) != CONTINUATION_FRAME) && ((_frameType & CONTROL_FRAME) == 0)) {
+                        _progressInfo &= (~0x10);
+                    }
+
+                    // A 64 bits length, only the lower 32 bits can be handled.
+                    if ((bytesToMove == 127) && ((dataFrame[2] | dataFrame[3] | dataFrame[4] | dataFrame[5]) != 0)) {
+                        _frameType = TOO_BIG;
+                    }
+
+                    // If the frame is not an error, unpack/move what is required, the payload of a control frame included.
+                    if ((_frameType & 0xF0) == 0) {
                         if (bytesToMove == 126) {
                             bytesToMove = ((dataFrame[2] << 8) + dataFrame[3]);
                         } else if (bytesToMove == 127) {
-                            bytesToMove = ((dataFrame[2] << 24) + (dataFrame[3] << 16) + (dataFrame[4] << 8) + dataFrame[5]);
+                            bytesToMove = ((static_cast<uint32_t>(dataFrame[6]) << 24) + (dataFrame[7] << 16) + (dataFrame[8] << 8) + dataFrame[9]);
+                        }
+
+                        // A message is measured over all its frames, control frames in between do not count.
+                        if ((_frameType & CONTROL_FRAME) == 0) {
+                            if ((dataFrame[0] & TYPE_FRAME) != CONTINUATION_FRAME) {
+                                _messageSize = 0;
+                                _progressInfo &= (~0x08);
+                            }
+
+                            _messageSize += bytesToMove;
+
+                            if ((_maxMessageSize != 0) && (_messageSize > _maxMessageSize)) {
+                                _progressInfo |= 0x08;
+                            }
+                            if ((_progressInfo & 0x08) != 0) {
+                                // Keep track of the frame, so the payload can be skipped.
+                                _frameType = TOO_BIG;
+                            }
                         }
 
                         // We might not have the full body yet...
@@ -255,25 +391,411 @@ namespace Web {
                             _scrambleKey[2] = dataFrame[actualHeader - 2];
                             _scrambleKey[3] = dataFrame[actualHeader - 1];
 
-                            // The last two bits in the progressInfo are used to select the proper scrambling key.
-                            // We need to clear them if we start., the 0x20 indicates scrambling required
-                            _progressInfo |= 0x20;
-                            _progressInfo &= (~0x03);
+                            Mask(&dataFrame[actualHeader], bytesToMove, _scrambleKey, 0);
+
+                            // The last two bits in the progressInfo select the scrambling key byte for the
+                            // remainder of the frame, the 0x20 indicates scrambling required
+                            _progressInfo = (_progressInfo & 0xFC) | 0x20 | (bytesToMove & 0x03);
+                        }
+                    }
+                }
+            }
+
+            return (actualHeader);
+        }
+
+        // A compressed message ends with an empty stored block, it is not sent (RFC 7692, 7.2.1).
+        static const uint8_t DeflateTrailer[] = { 0x00, 0x00, 0xFF, 0xFF };
+        static const TCHAR DeflateExtension[] = _T("permessage-deflate");
+        static constexpr uint8_t MaxWindowBits = 15;
+        // zlib can not deflate with a window of 256 bytes (8 bits), it is only supported for inflating.
+        static constexpr uint8_t MinDeflateWindowBits = 9;
+        static constexpr uint8_t MinInflateWindowBits = 8;
+        static constexpr uint16_t DeflateChunk = 1024;
+
+        // Parameters are "name" or "name=value", where the value might be quoted.
+        static void Parameter(Core::TextFragment parameter, Core::TextFragment& name, Core::TextFragment& value)
+        {
+            parameter.TrimBegin(_T(" \t"));
+            parameter.TrimEnd(_T(" \t"));
+
+            uint32_t index = parameter.ForwardFind('=');
+
+            if (index >= parameter.Length()) {
+                name = parameter;
+                value = Core::TextFragment();
+            } else {
+                name = Core::TextFragment(parameter, 0, index);
+                value = Core::TextFragment(parameter, index + 1, parameter.Length() - index - 1);
+                name.TrimEnd(_T(" \t"));
+                value.TrimBegin(_T(" \t\""));
+                value.TrimEnd(_T(" \t\""));
+            }
+        }
+
+        static bool WindowBits(const Core::TextFragment& value, const uint8_t minimum, uint8_t& bits)
+        {
+            uint32_t result = 0;
+            uint32_t index = 0;
+
+            while ((index < value.Length()) && (index < 3) && (isdigit(value[index]) != 0)) {
+                result = (result * 10) + (value[index] - '0');
+                index++;
+            }
+
+            bits = static_cast<uint8_t>(result);
+
+            return ((index > 0) && (index == value.Length()) && (result >= minimum) && (result <= MaxWindowBits));
+        }
+
+        Deflate::Deflate()
+            : _mode(NO_COMPRESSION)
+            , _active(false)
+            , _localTakeover(true)
+            , _remoteTakeover(true)
+            , _deflate()
+            , _inflate()
+            , _sending(IDLE)
+            , _buffer()
+            , _length(0)
+            , _offset(0)
+            , _trailer(false)
+            , _ending(false)
+            , _drained(true)
+            , _corrupted(false)
+            , _deflated()
+            , _inflated()
+        {
+        }
+
+        Deflate::~Deflate()
+        {
+            Reset();
+        }
+
+        string Deflate::Offer() const
+        {
+            string result(DeflateExtension);
+
+            // We can inflate any window size, so the server may pick the one for our side.
+            result += _T("; client_max_window_bits");
+
+            if (_mode == DEFLATE_NO_CONTEXT) {
+                result += _T("; client_no_context_takeover; server_no_context_takeover");
+            }
+
+            return (result);
+        }
+
+        bool Deflate::Agreed(const string& response)
+        {
+            Core::TextSegmentIterator parameters(Core::TextFragment(response), true, ';');
+            Core::TextFragment name;
+            Core::TextFragment value;
+            bool localTakeover = (_mode != DEFLATE_NO_CONTEXT);
+            bool remoteTakeover = (_mode != DEFLATE_NO_CONTEXT);
+            uint8_t windowBits = MaxWindowBits;
+            bool valid = false;
+
+            Reset();
+
+            if (parameters.Next() == true) {
+                Parameter(parameters.Current(), name, value);
+
+                valid = (name.EqualText(DeflateExtension, 0, 0, false) == true) && (value.IsEmpty() == true);
+            }
+
+            while ((valid == true) && (parameters.Next() == true)) {
+                uint8_t bits;
+
+                Parameter(parameters.Current(), name, value);
 
-                            uint8_t* source = &dataFrame[actualHeader];
+                if (name.EqualText(_T("client_no_context_takeover"), 0, 0, false) == true) {
+                    localTakeover = false;
+                } else if (name.EqualText(_T("server_no_context_takeover"), 0, 0, false) == true) {
+                    remoteTakeover = false;
+                } else if (name.EqualText(_T("client_max_window_bits"), 0, 0, false) == true) {
+                    valid = WindowBits(value, MinDeflateWindowBits, windowBits);
+                } else if (name.EqualText(_T("server_max_window_bits"), 0, 0, false) == true) {
+                    valid = WindowBits(value, MinInflateWindowBits, bits);
+                } else {
+                    valid = false;
+                }
+            }
+
+            if (valid == false) {
+                TRACE_L1("The websocket extension [%s] is not understood, the link is not compressed.", response.c_str());
+            }
+
+            return ((valid == true) && (Start(windowBits, localTakeover, remoteTakeover) == true));
+        }
+
+        bool Deflate::Accept(const string& offers, string& response)
+        {
+            Core::TextSegmentIterator extensions(Core::TextFragment(offers), true, ',');
+            bool accepted = false;
+
+            Reset();
+
+            while ((accepted == false) && (extensions.Next() == true)) {
+                Core::TextSegmentIterator parameters(extensions.Current(), true, ';');
+                Core::TextFragment name;
+                Core::TextFragment value;
+                bool localTakeover = (_mode != DEFLATE_NO_CONTEXT);
+                bool remoteTakeover = (_mode != DEFLATE_NO_CONTEXT);
+                uint8_t windowBits = MaxWindowBits;
+                uint8_t seen = 0;
+                bool valid = false;
+
+                if (parameters.Next() == true) {
+                    Parameter(parameters.Current(), name, value);
+
+                    valid = (name.EqualText(DeflateExtension, 0, 0, false) == true) && (value.IsEmpty() == true);
+                }
+
+                while ((valid == true) && (parameters.Next() == true)) {
+                    uint8_t bits;
+                    uint8_t parameter = 0;
+
+                    Parameter(parameters.Current(), name, value);
+
+                    if (name.EqualText(_T("server_no_context_takeover"), 0, 0, false) == true) {
+                        parameter = 0x01;
+                        localTakeover = false;
+                        valid = value.IsEmpty();
+                    } else if (name.EqualText(_T("client_no_context_takeover"), 0, 0, false) == true) {
+                        parameter = 0x02;
+                        remoteTakeover = false;
+                        valid = value.IsEmpty();
+                    } else if (name.EqualText(_T("server_max_window_bits"), 0, 0, false) == true) {
+                        parameter = 0x04;
+                        valid = WindowBits(value, MinDeflateWindowBits, windowBits);
+                    } else if (name.EqualText(_T("client_max_window_bits"), 0, 0, false) == true) {
+                        // We inflate with the largest window, whatever the client picks is fine.
+                        parameter = 0x08;
+                        valid = ((value.IsEmpty() == true) || (WindowBits(value, MinInflateWindowBits, bits) == true));
+                    } else {
+                        valid = false;
+                    }
+
+                    // A parameter may only be offered once.
+                    valid = valid && ((seen & parameter) == 0);
+                    seen |= parameter;
+                }
+
+                if ((valid == true) && (Start(windowBits, localTakeover, remoteTakeover) == true)) {
+                    accepted = true;
+
+                    response = DeflateExtension;
+
+                    if (localTakeover == false) {
+                        response += _T("; server_no_context_takeover");
+                    }
+                    if (remoteTakeover == false) {
+                        response += _T("; client_no_context_takeover");
+                    }
+                    if (windowBits != MaxWindowBits) {
+                        response += _T("; server_max_window_bits=") + Core::NumberType<uint8_t>(windowBits).Text();
+                    }
+                }
+            }
+
+            return (accepted);
+        }
+
+        bool Deflate::Start(const uint8_t windowBits, const bool localTakeover, const bool remoteTakeover)
+        {
+            ASSERT(_active == false);
+
+            // Negative window bits, raw deflate data without a zlib header or trailer.
+            if (deflateInit2(&_deflate, Z_DEFAULT_COMPRESSION, Z_DEFLATED, -windowBits, 8, Z_DEFAULT_STRATEGY) == Z_OK) {
+                if (inflateInit2(&_inflate, -MaxWindowBits) == Z_OK) {
+                    _active = true;
+                    _localTakeover = localTakeover;
+                    _remoteTakeover = remoteTakeover;
+                } else {
+                    deflateEnd(&_deflate);
+                }
+            }
+
+            return (_active);
+        }
+
+        void Deflate::Reset()
+        {
+            if (_active == true) {
+                deflateEnd(&_deflate);
+                inflateEnd(&_inflate);
+
+                _active = false;
+            }
+
+            _sending = IDLE;
+            _length = 0;
+            _offset = 0;
+            _trailer = false;
+            _ending = false;
+            _drained = true;
+            _corrupted = false;
+        }
+
+        void Deflate::Compress(const uint8_t data[], const uint16_t length, const bool last)
+        {
+            ASSERT(_active == true);
+            ASSERT(_sending != FINISHED);
+
+            const uint64_t start = Core::Time::Now().Ticks();
+            const uint32_t begin = _length;
+
+            _deflate.next_in = const_cast<uint8_t*>(data);
+            _deflate.avail_in = length;
+
+            // As long as the output fills the space given, there might be more.
+            do {
+                if ((_buffer.size() - _length) < DeflateChunk) {
+                    _buffer.resize(_length + DeflateChunk);
+                }
+
+                _deflate.next_out = &(_buffer[_length]);
+                _deflate.avail_out = static_cast<uInt>(_buffer.size() - _length);
+
+                deflate(&_deflate, (last == true ? Z_SYNC_FLUSH : Z_NO_FLUSH));
 
-                            while (bytesToMove != 0) {
-                                *source = (*source ^ _scrambleKey[(_progressInfo & 0x3)]);
-                                source++;
-                                bytesToMove--;
-                                _progressInfo = ((_progressInfo + 1) & 0xF3);
+                _length = static_cast<uint32_t>(_buffer.size() - _deflate.avail_out);
+
+            } while (_deflate.avail_out == 0);
+
+            if (last == false) {
+                _sending = COMPRESSING;
+            } else {
+                if (_length == begin) {
+                    // Nothing new since the previous message was flushed, zlib adds nothing. An empty message
+                    // is an empty stored block without the trailer, the stream is byte aligned after a flush.
+                    ASSERT(_deflate.avail_out > 0);
+
+                    _buffer[_length++] = 0x00;
+                } else {
+                    ASSERT(((_length - begin) >= 4) && (::memcmp(&(_buffer[_length - 4]), DeflateTrailer, sizeof(DeflateTrailer)) == 0));
+
+                    _length -= sizeof(DeflateTrailer);
+                }
+
+                _sending = FINISHED;
+
+                if (_localTakeover == false) {
+                    deflateReset(&_deflate);
+                }
+            }
+
+            _deflated.Original += length;
+            _deflated.Compressed += (_length - begin);
+            _deflated.Duration += (Core::Time::Now().Ticks() - start);
+        }
+
+        uint16_t Deflate::Compressed(uint8_t data[], const uint16_t maxLength)
+        {
+            uint16_t result = static_cast<uint16_t>(std::min(Pending(), static_cast<uint32_t>(maxLength)));
+
+            if (result > 0) {
+                ::memcpy(data, &(_buffer[_offset]), result);
+
+                _offset += result;
+            }
+
+            if (_offset == _length) {
+                _offset = 0;
+                _length = 0;
+
+                // A frame that is not full closes the message, else an empty one has to follow.
+                if ((_sending == FINISHED) && (result < maxLength)) {
+                    _sending = IDLE;
+                }
+            }
+
+            return (result);
+        }
+
+        void Deflate::Decompress(const uint8_t data[], const uint16_t length, const bool last)
+        {
+            ASSERT(_active == true);
+            ASSERT(_inflate.avail_in == 0);
+
+            _inflate.next_in = const_cast<uint8_t*>(data);
+            _inflate.avail_in = length;
+            _trailer = last;
+
+            _inflated.Compressed += length;
+        }
+
+        uint16_t Deflate::Decompressed(uint8_t data[], const uint16_t maxLength)
+        {
+            uint16_t result = 0;
+            bool done = false;
+
+            ASSERT(_active == true);
+
+            const uint64_t start = Core::Time::Now().Ticks();
+
+            while ((result == 0) && (done == false)) {
+                // All given is inflated and nothing is left inside zlib, time for the trailer or we are done.
+                if ((_inflate.avail_in == 0) && (_drained == true)) {
+                    if (_trailer == true) {
+                        _inflate.next_in = const_cast<uint8_t*>(DeflateTrailer);
+                        _inflate.avail_in = sizeof(DeflateTrailer);
+                        _trailer = false;
+                        _ending = true;
+                    } else {
+                        done = true;
+
+                        if (_ending == true) {
+                            _ending = false;
+
+                            if (_remoteTakeover == false) {
+                                inflateReset(&_inflate);
                             }
                         }
                     }
                 }
+
+                if (done == false) {
+                    _inflate.next_out = data;
+                    _inflate.avail_out = maxLength;
+
+                    int status = inflate(&_inflate, Z_SYNC_FLUSH);
+
+                    if ((status == Z_OK) || (status == Z_BUF_ERROR) || (status == Z_STREAM_END)) {
+                        result = static_cast<uint16_t>(maxLength - _inflate.avail_out);
+
+                        // If the output is full, zlib might hold on to more.
+                        _drained = (_inflate.avail_out != 0);
+
+                        if (status == Z_STREAM_END) {
+                            // The other side ended the stream with a final block, the next message starts a new one.
+                            inflateReset(&_inflate);
+                            _inflate.avail_in = 0;
+                            _trailer = false;
+                            _ending = false;
+                            _drained = true;
+                        }
+                    } else {
+                        TRACE_L1("Received compressed websocket data that can not be inflated (%d)", status);
+
+                        // There is no recovery within the message, drop it and restart the stream.
+                        _corrupted = true;
+                        _inflate.avail_in = 0;
+                        _trailer = false;
+                        _ending = false;
+                        _drained = true;
+                        inflateReset(&_inflate);
+                        done = true;
+                    }
+                }
             }
 
-            return (actualHeader);
+            _inflated.Original += result;
+            _inflated.Duration += (Core::Time::Now().Ticks() - start);
+
+            return (result);
         }
     }
 }
@@ -28,6 +28,13 @@
 namespace WPEFramework {
 namespace Web {
     namespace WebSocket {
+        // Compression of the messages on a link, negotiated during the upgrade (RFC 7692, permessage-deflate).
+        enum compression : uint8_t {
+            NO_COMPRESSION,
+            DEFLATE, // The sliding window is kept between messages (context takeover), the best ratio.
+            DEFLATE_NO_CONTEXT // Every message is compressed on its own, less state is kept warm per link.
+        };
+
         class EXTERNAL Protocol {
         public:
             enum frameType {
@@ -40,6 +47,12 @@ namespace Web {
                 TOO_BIG = 0x20, // Protocol max support for 2^16 message per chunk
                 INCONSISTENT = 0x30 // e.g. Protocol defined as Text, but received a binary.
             };
+            // The reason sent along with a close (RFC 6455, 7.4.1).
+            enum closeStatus : uint16_t {
+                NO_STATUS = 0,
+                INVALID_DATA = 1007, // e.g. a compressed message that can not be inflated.
+                MESSAGE_TOO_BIG = 1009
+            };
 
         private:
             enum controlTypes {
@@ -60,6 +73,9 @@ namespace Web {
                 , _pendingReceiveBytes(0)
                 , _frameType(TEXT)
                 , _controlStatus(0)
+                , _closeStatus(NO_STATUS)
+                , _maxMessageSize(0)
+                , _messageSize(0)
             {
             }
             ~Protocol()
@@ -78,9 +94,10 @@ namespace Web {
             {
                 _controlStatus |= REQUEST_PONG;
             }
-            inline void Close()
+            inline void Close(const closeStatus status = NO_STATUS)
             {
                 _controlStatus |= REQUEST_CLOSE;
+                _closeStatus = status;
             }
             inline bool ReceiveInProgress() const
             {
@@ -118,6 +135,48 @@ namespace Web {
             {
                 return ((_setFlags & 0x80) != 0);
             }
+            // Messages sent are flagged as compressed (RSV1) and received ones may be.
+            inline void Compression(const bool enabled)
+            {
+                _setFlags = (enabled ? (_setFlags | 0x40) : (_setFlags & 0xBF));
+            }
+            inline bool Compression() const
+            {
+                return ((_setFlags & 0x40) != 0);
+            }
+            inline bool IsCompressedMessage() const
+            {
+                return ((_progressInfo & 0x10) != 0);
+            }
+            // The largest message accepted, 0 for no limit. The frames of a message that goes beyond it are
+            // reported as TOO_BIG until the message ends, so the rest of it can be skipped.
+            inline void MaxMessageSize(const uint32_t size)
+            {
+                _maxMessageSize = size;
+            }
+            inline uint32_t MaxMessageSize() const
+            {
+                return (_maxMessageSize);
+            }
+            inline bool IsDiscarding() const
+            {
+                return ((_progressInfo & 0x08) != 0);
+            }
+            // Skip the rest of the message being received, e.g. it inflated beyond the maximum size.
+            inline void Discard()
+            {
+                _progressInfo |= 0x08;
+                _frameType = TOO_BIG;
+            }
+            // Space to keep free in front of the payload handed to the Encoder. It fits the largest header this
+            // side sends (16 bits length and a masking key), so a full frame is never moved to insert it.
+            inline uint8_t HeaderSpace() const
+            {
+                return (((_setFlags & 0x80) != 0) ? 8 : 4);
+            }
+
+            // XOR the data with the masking key, starting at byte <offset> of the key.
+            static void Mask(uint8_t data[], const uint32_t length, const uint8_t key[4], const uint8_t offset);
 
             uint16_t Encoder(uint8_t* dataFrame, const uint16_t maxSendSize, const uint16_t usedSize);
             uint16_t Decoder(uint8_t* dataFrame, uint16_t& receivedSize);
@@ -129,6 +188,115 @@ namespace Web {
             frameType _frameType;
             uint8_t _scrambleKey[4];
             uint8_t _controlStatus;
+            closeStatus _closeStatus;
+            uint32_t _maxMessageSize;
+            uint32_t _messageSize;
+        };
+
+        // The permessage-deflate state of a link: the negotiation of the parameters and a zlib stream per
+        // direction. Plain data of a message to send goes in with Compress() and comes out framable with
+        // Compressed(), received payload goes in with Decompress() and comes out with Decompressed().
+        class EXTERNAL Deflate {
+        public:
+            struct Statistics {
+                uint64_t Original; // Bytes of the messages before compression or after decompression.
+                uint64_t Compressed; // Bytes of the messages on the wire.
+                uint64_t Duration; // Time spent in zlib (uS).
+            };
+
+        private:
+            enum state : uint8_t {
+                IDLE,
+                COMPRESSING,
+                FINISHED
+            };
+
+        public:
+            Deflate(const Deflate&) = delete;
+            Deflate& operator=(const Deflate&) = delete;
+
+            Deflate();
+            ~Deflate();
+
+        public:
+            // Takes effect on the next upgrade.
+            inline void Mode(const compression mode)
+            {
+                _mode = mode;
+            }
+            inline compression Mode() const
+            {
+                return (_mode);
+            }
+            inline bool IsActive() const
+            {
+                return (_active);
+            }
+            inline const Statistics& Deflated() const
+            {
+                return (_deflated);
+            }
+            inline const Statistics& Inflated() const
+            {
+                return (_inflated);
+            }
+            // Received data could not be inflated, there is no telling what the rest of the stream means.
+            inline bool IsCorrupted() const
+            {
+                return (_corrupted);
+            }
+
+            // Client side of the negotiation, the offer to send and the answer of the server.
+            string Offer() const;
+            bool Agreed(const string& response);
+
+            // Server side of the negotiation, accepts the first offer of the client it can honour.
+            bool Accept(const string& offers, string& response);
+
+            // Drops the negotiated state, the link is closed.
+            void Reset();
+
+            // Compressed data of the message being sent that is not framed yet.
+            inline uint32_t Pending() const
+            {
+                return (_length - _offset);
+            }
+            inline bool IsCompressing() const
+            {
+                return (_sending != IDLE);
+            }
+            // All data of the message being sent is compressed, it only needs to be framed.
+            inline bool IsFinished() const
+            {
+                return (_sending == FINISHED);
+            }
+            void Compress(const uint8_t data[], const uint16_t length, const bool last);
+            uint16_t Compressed(uint8_t data[], const uint16_t maxLength);
+
+            // The data is not copied, drain it with Decompressed() before it is released.
+            void Decompress(const uint8_t data[], const uint16_t length, const bool last);
+            uint16_t Decompressed(uint8_t data[], const uint16_t maxLength);
+
+        private:
+            bool Start(const uint8_t windowBits, const bool localTakeover, const bool remoteTakeover);
+
+        private:
+            compression _mode;
+            bool _active;
+            bool _localTakeover;
+            bool _remoteTakeover;
+            z_stream _deflate;
+            z_stream _inflate;
+            state _sending;
+            std::vector<uint8_t> _buffer;
+            uint32_t _length;
+            uint32_t _offset;
+            bool _trailer;
+            bool _ending;
+            bool _drained;
+            bool _corrupted;
+            Statistics _deflated;
+            Statistics _inflated;
         };
 
         class EXTERNAL RequestAllocator : public Core::ProxyPoolType<Web::Request> {
@@ -258,6 +426,14 @@ namespace Web {
                 }
 
             private:
+                virtual void Trigger() override
+                {
+                    _parent.Trigger();
+                }
+                virtual bool Transfer(const Core::File::Handle file, const uint64_t offset, const uint32_t length)
+                {
+                    return (_parent.ACTUALLINK::Transfer(file, offset, length));
+                }
                 virtual void Serialized(const typename OUTBOUND::BaseElement& element)
                 {
                     _adminLock.Lock();
@@ -382,6 +558,10 @@ namespace Web {
                 , _origin()
                 , _webSocketMessage(Core::ProxyType<typename OUTBOUND::BaseElement>::Create())
                 , _pingFireTime(0)
+                , _deflate()
+                , _inflated(0)
+                , _upgrade()
+                , _held(false)
             {
             }
             template <typename Arg1, typename Arg2>
@@ -399,6 +579,10 @@ namespace Web {
                 , _origin()
                 , _webSocketMessage(Core::ProxyType<typename OUTBOUND::BaseElement>::Create())
                 , _pingFireTime(0)
+                , _deflate()
+                , _inflated(0)
+                , _upgrade()
+                , _held(false)
             {
             }
             template <typename Arg1, typename Arg2, typename Arg3>
@@ -416,6 +600,10 @@ namespace Web {
                 , _origin()
                 , _webSocketMessage(Core::ProxyType<typename OUTBOUND::BaseElement>::Create())
                 , _pingFireTime(0)
+                , _deflate()
+                , _inflated(0)
+                , _upgrade()
+                , _held(false)
             {
             }
             template <typename Arg1, typename Arg2, typename Arg3, typename Arg4>
@@ -433,6 +621,10 @@ namespace Web {
                 , _origin()
                 , _webSocketMessage(Core::ProxyType<typename OUTBOUND::BaseElement>::Create())
                 , _pingFireTime(0)
+                , _deflate()
+                , _inflated(0)
+                , _upgrade()
+                , _held(false)
             {
             }
             template <typename Arg1, typename Arg2, typename Arg3, typename Arg4, typename Arg5>
@@ -450,6 +642,10 @@ namespace Web {
                 , _origin()
                 , _webSocketMessage(Core::ProxyType<typename OUTBOUND::BaseElement>::Create())
                 , _pingFireTime(0)
+                , _deflate()
+                , _inflated(0)
+                , _upgrade()
+                , _held(false)
             {
             }
             template <typename Arg1, typename Arg2, typename Arg3, typename Arg4, typename Arg5, typename Arg6>
@@ -467,6 +663,10 @@ namespace Web {
                 , _origin()
                 , _webSocketMessage(Core::ProxyType<typename OUTBOUND::BaseElement>::Create())
                 , _pingFireTime(0)
+                , _deflate()
+                , _inflated(0)
+                , _upgrade()
+                , _held(false)
             {
             }
             template <typename Arg1, typename Arg2, typename Arg3, typename Arg4, typename Arg5, typename Arg6, typename Arg7>
@@ -484,6 +684,10 @@ namespace Web {
                 , _origin()
                 , _webSocketMessage(Core::ProxyType<typename OUTBOUND::BaseElement>::Create())
                 , _pingFireTime(0)
+                , _deflate()
+                , _inflated(0)
+                , _upgrade()
+                , _held(false)
             {
             }
             template <typename Arg1>
@@ -501,6 +705,10 @@ namespace Web {
                 , _origin()
                 , _webSocketMessage(Core::ProxyType<typename OUTBOUND::BaseElement>::Create())
                 , _pingFireTime(0)
+                , _deflate()
+                , _inflated(0)
+                , _upgrade()
+                , _held(false)
             {
             }
             template <typename Arg1, typename Arg2>
@@ -518,6 +726,10 @@ namespace Web {
                 , _origin()
                 , _webSocketMessage(Core::ProxyType<typename OUTBOUND::BaseElement>::Create())
                 , _pingFireTime(0)
+                , _deflate()
+                , _inflated(0)
+                , _upgrade()
+                , _held(false)
             {
             }
             template <typename Arg1, typename Arg2, typename Arg3>
@@ -535,6 +747,10 @@ namespace Web {
                 , _origin()
                 , _webSocketMessage(Core::ProxyType<typename OUTBOUND::BaseElement>::Create())
                 , _pingFireTime(0)
+                , _deflate()
+                , _inflated(0)
+                , _upgrade()
+                , _held(false)
             {
             }
             template <typename Arg1, typename Arg2, typename Arg3, typename Arg4>
@@ -552,6 +768,10 @@ namespace Web {
                 , _origin()
                 , _webSocketMessage(Core::ProxyType<typename OUTBOUND::BaseElement>::Create())
                 , _pingFireTime(0)
+                , _deflate()
+                , _inflated(0)
+                , _upgrade()
+                , _held(false)
             {
             }
             template <typename Arg1, typename Arg2, typename Arg3, typename Arg4, typename Arg5>
@@ -569,6 +789,10 @@ namespace Web {
                 , _origin()
                 , _webSocketMessage(Core::ProxyType<typename OUTBOUND::BaseElement>::Create())
                 , _pingFireTime(0)
+                , _deflate()
+                , _inflated(0)
+                , _upgrade()
+                , _held(false)
             {
             }
             template <typename Arg1, typename Arg2, typename Arg3, typename Arg4, typename Arg5, typename Arg6, typename Arg7>
@@ -586,6 +810,10 @@ namespace Web {
                 , _origin()
                 , _webSocketMessage(Core::ProxyType<typename OUTBOUND::BaseElement>::Create())
                 , _pingFireTime(0)
+                , _deflate()
+                , _inflated(0)
+                , _upgrade()
+                , _held(false)
             {
             }
             template <typename Arg1, typename Arg2, typename Arg3, typename Arg4, typename Arg5, typename Arg6, typename Arg7>
@@ -603,6 +831,10 @@ namespace Web {
                 , _origin()
                 , _webSocketMessage(Core::ProxyType<typename OUTBOUND::BaseElement>::Create())
                 , _pingFireTime(0)
+                , _deflate()
+                , _inflated(0)
+                , _upgrade()
+                , _held(false)
             {
             }
 #ifdef __WINDOWS__
@@ -611,6 +843,8 @@ namespace Web {
 
             virtual ~HandlerType()
             {
+                // A streamed body triggering this link must be done before the serializer goes.
+                _serializerImpl.Detach();
             }
 
         public:
@@ -670,6 +904,36 @@ namespace Web {
             {
                 _handler.Masking(masking);
             }
+            // Offered (client) or accepted (server) on the next upgrade.
+            inline void Compression(const WebSocket::compression mode)
+            {
+                _deflate.Mode(mode);
+            }
+            inline WebSocket::compression Compression() const
+            {
+                return (_deflate.Mode());
+            }
+            inline bool IsCompressed() const
+            {
+                return (_handler.Compression());
+            }
+            // The largest message taken in, over all its frames and after inflating, 0 for no limit.
+            inline void MaxMessageSize(const uint32_t size)
+            {
+                _handler.MaxMessageSize(size);
+            }
+            inline uint32_t MaxMessageSize() const
+            {
+                return (_handler.MaxMessageSize());
+            }
+            inline const WebSocket::Deflate::Statistics& Deflated() const
+            {
+                return (_deflate.Deflated());
+            }
+            inline const WebSocket::Deflate::Statistics& Inflated() const
+            {
+                return (_deflate.Inflated());
+            }
             inline void Ping()
             {
                 _pingFireTime = Core::Time::Now().Ticks();
@@ -704,6 +968,34 @@ namespace Web {
                 _webSocketMessage->ErrorCode = status;
                 _webSocketMessage->Message = reason;
             }
+            // From StateChange() while upgrading, the upgrade is not answered till ResumeUpgrade().
+            inline void HoldUpgrade()
+            {
+                _held = true;
+            }
+            // Answers a held upgrade as StateChange() left it, or as an AbortUpgrade() since changed it.
+            inline void ResumeUpgrade()
+            {
+                _adminLock.Lock();
+
+                _held = false;
+
+                if (_upgrade.IsValid() == true) {
+                    Core::ProxyType<INBOUND> element(_upgrade);
+
+                    _upgrade.Release();
+
+                    Answer(*element);
+
+                    _serializerImpl.Submit(_webSocketMessage);
+
+                    _adminLock.Unlock();
+
+                    ACTUALLINK::Trigger();
+                } else {
+                    _adminLock.Unlock();
+                }
+            }
             inline void Submit(const Core::ProxyType<OUTBOUND>& element)
             {
                 _adminLock.Lock();
@@ -750,10 +1042,16 @@ namespace Web {
                 _state = static_cast<EnumlinkState>(_state | ACTIVITY);
 
                 if ((_state & WEBSOCKET) != 0) {
-                    if (maxSendSize > 4) {
-                        result = _parent.SendData(&(dataFrame[4]), (maxSendSize - 4));
+                    const uint8_t headerSpace = _handler.HeaderSpace();
+
+                    if (maxSendSize > headerSpace) {
+                        if (_handler.Compression() == false) {
+                            result = _parent.SendData(&(dataFrame[headerSpace]), (maxSendSize - headerSpace));
+                        } else {
+                            result = SendCompressed(&(dataFrame[headerSpace]), (maxSendSize - headerSpace));
+                        }
 
-                        result = _handler.Encoder(dataFrame, (maxSendSize - 4), result);
+                        result = _handler.Encoder(dataFrame, (maxSendSize - headerSpace), result);
                     }
                 } else {
                     result = _serializerImpl.Serialize(dataFrame, maxSendSize);
@@ -786,7 +1084,12 @@ namespace Web {
                         tooSmall = ((headerSize == 0) && (actualDataSize == 0));
 
                         if (tooSmall == false) {
-                            if ((_handler.FrameType() & 0xF0) != 0) {
+                            if ((_handler.FrameType() == WebSocket::Protocol::TOO_BIG) && (_handler.IsDiscarding() == true)) {
+                                Oversized();
+
+                                // The frame is still followed, only its payload is skipped.
+                                result += (headerSize + actualDataSize);
+                            } else if ((_handler.FrameType() & 0xF0) != 0) {
 
                                 TRACE_L1("Oops we received uncomprehensable data on the web socket 0x%X", _handler.FrameType());
 
@@ -825,7 +1128,12 @@ namespace Web {
                                     _commandData.clear();
                                 }
 
-                                result += headerSize; // actualDataSize
+                                // The payload of a control frame, e.g. the status of a close, is not used.
+                                result += (headerSize + actualDataSize);
+                            } else if (_handler.IsCompressedMessage() == true) {
+                                ReceiveCompressed(&(dataFrame[result + headerSize]), actualDataSize);
+
+                                result += (headerSize + actualDataSize);
                             } else {
                                 _parent.ReceiveData(&(dataFrame[result + headerSize]), actualDataSize);
 
@@ -854,6 +1162,17 @@ namespace Web {
                 // If the connection is closed by peer 'during' socket write, cleanup response message
                 if (IsClosed() == true) {
                     _serializerImpl.Flush();
+
+                    // A next connection negotiates its own compression.
+                    _handler.Compression(false);
+                    _deflate.Reset();
+                    _inflated = 0;
+
+                    // A held upgrade is not answered anymore.
+                    if (_upgrade.IsValid() == true) {
+                        _upgrade.Release();
+                    }
+                    _held = false;
                 }
 
                 _parent.StateChange();
@@ -872,6 +1191,74 @@ namespace Web {
             }
 
         private:
+            // The plain data of the message is loaded in the frame and compressed from there, until there is
+            // enough compressed data to fill the frame or the message is complete.
+            uint16_t SendCompressed(uint8_t* dataFrame, const uint16_t maxSendSize)
+            {
+                bool idle = false;
+
+                while ((idle == false) && (_deflate.IsFinished() == false) && (_deflate.Pending() < maxSendSize)) {
+                    uint16_t loaded = _parent.SendData(dataFrame, maxSendSize);
+
+                    if ((loaded == 0) && (_deflate.IsCompressing() == false)) {
+                        idle = true;
+                    } else {
+                        // Not filling the space given ends the message, see Protocol::Encoder.
+                        _deflate.Compress(dataFrame, loaded, (loaded < maxSendSize));
+                    }
+                }
+
+                return (_deflate.Compressed(dataFrame, maxSendSize));
+            }
+            void ReceiveCompressed(const uint8_t* dataFrame, const uint16_t receivedSize)
+            {
+                uint8_t buffer[1024];
+                uint16_t length;
+                const bool last = ((_handler.IsCompleteMessage() == true) && (_handler.ReceiveInProgress() == false));
+                const uint32_t maxSize = _handler.MaxMessageSize();
+
+                // The trailer is added to the payload of the last frame of the message.
+                _deflate.Decompress(dataFrame, receivedSize, last);
+
+                while ((_handler.IsDiscarding() == false) && ((length = _deflate.Decompressed(buffer, sizeof(buffer))) != 0)) {
+                    _inflated += length;
+
+                    // The limit holds for what the message inflates to as well.
+                    if ((maxSize != 0) && (_inflated > maxSize)) {
+                        _handler.Discard();
+                        Oversized();
+                    } else {
+                        _parent.ReceiveData(buffer, length);
+                    }
+                }
+
+                if ((_deflate.IsCorrupted() == true) && ((_state & SUSPENDED) == 0)) {
+                    TRACE_L1("WebSocket message can not be inflated, closing the link");
+
+                    _handler.Discard();
+                    Refuse(WebSocket::Protocol::INVALID_DATA);
+                }
+
+                if (last == true) {
+                    _inflated = 0;
+                }
+            }
+            // A message beyond the maximum size is not taken in.
+            void Oversized()
+            {
+                if ((_state & SUSPENDED) == 0) {
+                    TRACE_L1("WebSocket message exceeds the maximum of %u bytes, closing the link", _handler.MaxMessageSize());
+
+                    Refuse(WebSocket::Protocol::MESSAGE_TOO_BIG);
+                }
+            }
+            // The other side is asked to close the link, telling why, and no new messages are accepted anymore.
+            void Refuse(const WebSocket::Protocol::closeStatus status)
+            {
+                _state = static_cast<EnumlinkState>(_state | SUSPENDED);
+                _handler.Close(status);
+                ACTUALLINK::Trigger();
+            }
             inline uint32_t CheckForClose(uint32_t waitTime)
             {
                 uint32_t result = 0;
@@ -953,31 +1340,53 @@ namespace Web {
 
                         _parent.StateChange();
 
-                        if (_webSocketMessage->ErrorCode != Web::STATUS_SWITCH_PROTOCOL) {
-                            _state = static_cast<EnumlinkState>((_state & 0xF0) | WEBSERVER);
-                            _path.clear();
-                            _query.clear();
-                            _protocol.clear();
+                        if (_held == true) {
+                            // Answered by ResumeUpgrade().
+                            _upgrade = element;
                         } else {
-                            _webSocketMessage->Connection = Web::Response::CONNECTION_UPGRADE;
-                            _webSocketMessage->Upgrade = Web::Response::UPGRADE_WEBSOCKET;
-                            _webSocketMessage->WebSocketAccept = _handler.ResponseKey(element->WebSocketKey.Value());
-                            if (_protocol.empty() == false) {
-                                _webSocketMessage->WebSocketProtocol = _protocol;
-                            }
+                            Answer(*element);
                         }
                     }
 
-                    // Send out the result of the upgraded message.
-                    _serializerImpl.Submit(_webSocketMessage);
+                    if (_upgrade.IsValid() == true) {
+                        _adminLock.Unlock();
+                    } else {
+                        // Send out the result of the upgraded message.
+                        _serializerImpl.Submit(_webSocketMessage);
 
-                    _adminLock.Unlock();
+                        _adminLock.Unlock();
 
-                    ACTUALLINK::Trigger();
+                        ACTUALLINK::Trigger();
+                    }
                 } else {
                     _parent.Received(element);
                 }
             }
+            inline void Answer(const INBOUND& element)
+            {
+                if (_webSocketMessage->ErrorCode != Web::STATUS_SWITCH_PROTOCOL) {
+                    _state = static_cast<EnumlinkState>((_state & 0xF0) | WEBSERVER);
+                    _path.clear();
+                    _query.clear();
+                    _protocol.clear();
+                } else {
+                    _webSocketMessage->Connection = Web::Response::CONNECTION_UPGRADE;
+                    _webSocketMessage->Upgrade = Web::Response::UPGRADE_WEBSOCKET;
+                    _webSocketMessage->WebSocketAccept = _handler.ResponseKey(element.WebSocketKey.Value());
+                    if (_protocol.empty() == false) {
+                        _webSocketMessage->WebSocketProtocol = _protocol;
+                    }
+
+                    string extension;
+
+                    if ((_deflate.Mode() != WebSocket::NO_COMPRESSION) && (element.WebSocketExtensions.IsSet() == true) && (_deflate.Accept(element.WebSocketExtensions.Value(), extension) == true)) {
+                        _webSocketMessage->WebSocketExtensions = extension;
+                        _handler.Compression(true);
+                    } else {
+                        _webSocketMessage->WebSocketExtensions.Clear();
+                    }
+                }
+            }
             inline void UpgradeCompleted(const TemplateIntToType<1>& /* For compile time diffrentiation */)
             {
                 // We send back the response on what we upgraded, Assuming it was succesfull, we are upgraded.
@@ -1026,6 +1435,9 @@ namespace Web {
                     if (protocol.empty() == false) {
                         _webSocketMessage->WebSocketProtocol = protocol;
                     }
+                    if (_deflate.Mode() != WebSocket::NO_COMPRESSION) {
+                        _webSocketMessage->WebSocketExtensions = _deflate.Offer();
+                    }
 
                     _query = query;
                     _path = path;
@@ -1054,9 +1466,16 @@ namespace Web {
                     // Seems like we succeeded, turn on the link..
                     _state = static_cast<EnumlinkState>((_state & 0xF0) | WEBSOCKET);
 
+                    if ((_deflate.Mode() != WebSocket::NO_COMPRESSION) && (element->WebSocketExtensions.IsSet() == true)) {
+                        _handler.Compression(_deflate.Agreed(element->WebSocketExtensions.Value()));
+                    }
+
                     _parent.StateChange();
 
                     _adminLock.Unlock();
+
+                    // What was submitted while upgrading, could not be sent yet.
+                    ACTUALLINK::Trigger();
                 } else {
                     _parent.Received(element);
                 }
@@ -1076,6 +1495,10 @@ namespace Web {
             string _commandData;
             Core::ProxyType<typename OUTBOUND::BaseElement> _webSocketMessage;
             uint64_t _pingFireTime;
+            WebSocket::Deflate _deflate;
+            uint32_t _inflated;
+            Core::ProxyType<INBOUND> _upgrade;
+            bool _held;
         };
 
     public:
@@ -1222,6 +1645,34 @@ namespace Web {
         {
             return (_channel.Masking());
         }
+        inline void Compression(const WebSocket::compression mode)
+        {
+            _channel.Compression(mode);
+        }
+        inline WebSocket::compression Compression() const
+        {
+            return (_channel.Compression());
+        }
+        inline bool IsCompressed() const
+        {
+            return (_channel.IsCompressed());
+        }
+        inline void MaxMessageSize(const uint32_t size)
+        {
+            _channel.MaxMessageSize(size);
+        }
+        inline uint32_t MaxMessageSize() const
+        {
+            return (_channel.MaxMessageSize());
+        }
+        inline const WebSocket::Deflate::Statistics& Deflated() const
+        {
+            return (_channel.Deflated());
+        }
+        inline const WebSocket::Deflate::Statistics& Inflated() const
+        {
+            return (_channel.Inflated());
+        }
         inline void ResetActivity()
         {
             return (_channel.ResetActivity());
@@ -1250,6 +1701,14 @@ namespace Web {
         {
             return (_channel.AbortUpgrade(status, reason));
         }
+        inline void HoldUpgrade()
+        {
+            return (_channel.HoldUpgrade());
+        }
+        inline void ResumeUpgrade()
+        {
+            return (_channel.ResumeUpgrade());
+        }
         inline uint32_t Open(const uint32_t waitTime)
         {
             return (_channel.Open(waitTime));
@@ -1541,6 +2000,34 @@ namespace Web {
         {
             return (_channel.Masking());
         }
+        inline void Compression(const WebSocket::compression mode)
+        {
+            _channel.Compression(mode);
+        }
+        inline WebSocket::compression Compression() const
+        {
+            return (_channel.Compression());
+        }
+        inline bool IsCompressed() const
+        {
+            return (_channel.IsCompressed());
+        }
+        inline void MaxMessageSize(const uint32_t size)
+        {
+            _channel.MaxMessageSize(size);
+        }
+        inline uint32_t MaxMessageSize() const
+        {
+            return (_channel.MaxMessageSize());
+        }
+        inline const WebSocket::Deflate::Statistics& Deflated() const
+        {
+            return (_channel.Deflated());
+        }
+        inline const WebSocket::Deflate::Statistics& Inflated() const
+        {
+            return (_channel.Inflated());
+        }
         inline uint32_t Open(const uint32_t waitTime)
         {
             return (_channel.Open(waitTime));
@@ -1779,6 +2266,34 @@ namespace Web {
         {
             return (_channel.Masking());
         }
+        inline void Compression(const WebSocket::compression mode)
+        {
+            _channel.Compression(mode);
+        }
+        inline WebSocket::compression Compression() const
+        {
+            return (_channel.Compression());
+        }
+        inline bool IsCompressed() const
+        {
+            return (_channel.IsCompressed());
+        }
+        inline void MaxMessageSize(const uint32_t size)
+        {
+            _channel.MaxMessageSize(size);
+        }
+        inline uint32_t MaxMessageSize() const
+        {
+            return (_channel.MaxMessageSize());
+        }
+        inline const WebSocket::Deflate::Statistics& Deflated() const
+        {
+            return (_channel.Deflated());
+        }
+        inline const WebSocket::Deflate::Statistics& Inflated() const
+        {
+            return (_channel.Inflated());
+        }
         inline uint32_t Open(const uint32_t waitTime)
         {
             return (_channel.Open(waitTime));
@@ -26,8 +26,10 @@
 #include "JSONWebToken.h"
 #include "JSONRPCLink.h"
 #include "WebLink.h"
+#include "WebPipeline.h"
 #include "WebRequest.h"
 #include "WebResponse.h"
+#include "WebRouter.h"
 #include "WebSerializer.h"
 #include "WebSocketLink.h"
 #include "WebTransfer.h"
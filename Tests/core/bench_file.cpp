@@ -0,0 +1,235 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2020 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// Throughput of serving a static file. Not a test, run it by hand and compare the figures before and
+// after a change:
+//
+//     WPEFramework_bench_file [iterations scale]
+//
+// "copy" serializes the response, body included, through a buffer of the size a link has, as a link
+// without Transfer does. "sendfile" only serializes the header and has the kernel send the body from
+// the file, as SocketPort::Transfer does. The other end of a local stream socket drains everything.
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+
+#include <sys/sendfile.h>
+#include <sys/socket.h>
+
+#include <core/core.h>
+#include <websocket/websocket.h>
+
+namespace WPEFramework {
+namespace Benchmark {
+
+    static constexpr uint16_t BufferSize = 16384;
+
+    class Sender : public Web::Response::Serializer {
+    public:
+        Sender(const Sender&) = delete;
+        Sender& operator=(const Sender&) = delete;
+
+        Sender(const int socket, const bool transfer)
+            : Web::Response::Serializer()
+            , _socket(socket)
+            , _transfer(transfer)
+            , _file(-1)
+            , _offset(0)
+            , _length(0)
+        {
+        }
+        ~Sender()
+        {
+        }
+
+    public:
+        void Serialized(const Web::Response&) override
+        {
+        }
+        bool Transfer(const Core::File::Handle file, const uint64_t offset, const uint32_t length) override
+        {
+            _file = file;
+            _offset = offset;
+            _length = length;
+
+            return (_transfer);
+        }
+
+        bool Send(const Web::Response& response)
+        {
+            uint8_t buffer[BufferSize];
+            uint16_t length;
+            bool result = true;
+
+            Submit(response);
+
+            // Like SocketPort::Write, the serializer is only asked for more once the file part went out,
+            // the next call reports the response as sent and closes the file.
+            do {
+                length = Serialize(buffer, sizeof(buffer));
+
+                result = Write(buffer, length);
+
+                while ((result == true) && (_length > 0)) {
+                    off_t offset = static_cast<off_t>(_offset);
+                    ssize_t sent = ::sendfile(_socket, _file, &offset, _length);
+
+                    if (sent <= 0) {
+                        result = false;
+                    } else {
+                        _offset += sent;
+                        _length -= static_cast<uint32_t>(sent);
+                    }
+                }
+            } while ((result == true) && (length != 0));
+
+            return (result);
+        }
+
+    private:
+        bool Write(const uint8_t buffer[], const uint16_t length)
+        {
+            uint16_t offset = 0;
+
+            while (offset < length) {
+                ssize_t sent = ::send(_socket, &(buffer[offset]), length - offset, MSG_NOSIGNAL);
+
+                if (sent <= 0) {
+                    return (false);
+                }
+                offset += static_cast<uint16_t>(sent);
+            }
+
+            return (true);
+        }
+
+    private:
+        int _socket;
+        bool _transfer;
+        Core::File::Handle _file;
+        uint64_t _offset;
+        uint32_t _length;
+    };
+
+    template <typename ACTION>
+    static double Measure(const uint32_t iterations, ACTION&& action)
+    {
+        const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+        for (uint32_t index = 0; index < iterations; index++) {
+            action();
+        }
+
+        const std::chrono::steady_clock::duration duration = std::chrono::steady_clock::now() - start;
+
+        return (std::chrono::duration_cast<std::chrono::duration<double>>(duration).count());
+    }
+
+    static bool Serve(const int socket, const string& fileName, const bool transfer)
+    {
+        Web::Request request;
+        Web::Response response;
+        Core::ProxyType<Web::FileBody> body(Core::ProxyType<Web::FileBody>::Create());
+        Sender sender(socket, transfer);
+
+        *body = fileName;
+
+        Web::FileResponse(request, response, body);
+
+        return (sender.Send(response));
+    }
+
+    static void Report(const TCHAR name[], const uint32_t size, const uint64_t bytes, const uint32_t iterations, const double seconds)
+    {
+        printf("%-10s %10u %12.1f %12.1f\n", name, size, (static_cast<double>(bytes) / (1024.0 * 1024.0)) / seconds, iterations / seconds);
+    }
+
+    static int Run(int argc, char* argv[])
+    {
+        static const uint32_t sizes[] = { 4096, 65536, 1048576, 16777216 };
+
+        const double scale = (argc > 1 ? ::atof(argv[1]) : 1.0);
+        const string fileName(_T("/tmp/wpebenchfile.bin"));
+        int sockets[2];
+        int result = 0;
+
+        if (::socketpair(AF_UNIX, SOCK_STREAM, 0, sockets) != 0) {
+            printf("no socket pair to send over\n");
+            return (1);
+        }
+
+        std::thread reader([&sockets]() {
+            std::vector<uint8_t> buffer(65536);
+
+            while (::recv(sockets[1], buffer.data(), buffer.size(), 0) > 0) {
+            }
+        });
+
+        printf("%-10s %10s %12s %12s\n", "path", "bytes", "MB/s", "responses/s");
+
+        for (const uint32_t size : sizes) {
+            // Roughly the same amount of data for every size.
+            const uint32_t iterations = std::max(static_cast<uint32_t>((1024.0 * 1024.0 * 1024.0 * scale) / size), 1u);
+            const uint64_t bytes = static_cast<uint64_t>(size) * iterations;
+            Core::File file(fileName);
+            std::vector<uint8_t> data(size);
+
+            for (uint32_t index = 0; index < size; index++) {
+                data[index] = static_cast<uint8_t>(index * 7);
+            }
+
+            file.Create();
+            file.Write(data.data(), size);
+            file.Close();
+
+            bool valid = true;
+
+            Report(_T("copy"), size, bytes, iterations, Measure(iterations, [&]() { valid = Serve(sockets[0], fileName, false) && valid; }));
+            Report(_T("sendfile"), size, bytes, iterations, Measure(iterations, [&]() { valid = Serve(sockets[0], fileName, true) && valid; }));
+
+            if (valid == false) {
+                printf("a file of %u bytes could not be sent\n", size);
+                result = 1;
+            }
+
+            file.Destroy();
+        }
+
+        ::shutdown(sockets[0], SHUT_WR);
+        reader.join();
+
+        ::close(sockets[0]);
+        ::close(sockets[1]);
+
+        return (result);
+    }
+} // Benchmark
+} // WPEFramework
+
+int main(int argc, char* argv[])
+{
+    int result = WPEFramework::Benchmark::Run(argc, argv);
+
+    WPEFramework::Core::Singleton::Dispose();
+
+    return (result);
+}
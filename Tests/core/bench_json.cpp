@@ -0,0 +1,730 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2020 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// Throughput and allocation baseline for Core::JSON. Not a test, run it by hand and compare
+// the figures before and after a change:
+//
+//     WPEFramework_bench_json [iterations scale] [--dump <directory>]
+//
+// --dump writes every corpus as .json and .msgpack file, which is a good seed corpus for the
+// fuzz_json harness.
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+
+#include <core/core.h>
+
+static std::atomic<uint64_t> g_allocations(0);
+
+// Kept out of line, once inlined the compiler pairs the malloc() in here with the operator delete of the
+// caller and warns about a mismatch (-Wmismatched-new-delete).
+__attribute__((noinline)) void* operator new(size_t size)
+{
+    g_allocations++;
+    void* result = ::malloc(size == 0 ? 1 : size);
+    if (result == nullptr) {
+        throw std::bad_alloc();
+    }
+    return (result);
+}
+
+__attribute__((noinline)) void operator delete(void* memory) noexcept
+{
+    ::free(memory);
+}
+
+__attribute__((noinline)) void* operator new[](size_t size)
+{
+    return (operator new(size));
+}
+
+__attribute__((noinline)) void operator delete[](void* memory) noexcept
+{
+    ::free(memory);
+}
+
+namespace WPEFramework {
+namespace Benchmark {
+
+    class Service : public Core::JSON::Container {
+    public:
+        Service()
+            : Core::JSON::Container()
+        {
+            Init();
+        }
+        Service(const Service& copy)
+            : Core::JSON::Container()
+            , Callsign(copy.Callsign)
+            , Locator(copy.Locator)
+            , ClassName(copy.ClassName)
+            , AutoStart(copy.AutoStart)
+            , Precondition(copy.Precondition)
+            , State(copy.State)
+            , Observers(copy.Observers)
+            , ProcessedRequests(copy.ProcessedRequests)
+            , ProcessedObjects(copy.ProcessedObjects)
+            , Module(copy.Module)
+            , Hash(copy.Hash)
+        {
+            Init();
+        }
+        Service& operator=(const Service& rhs)
+        {
+            Callsign = rhs.Callsign;
+            Locator = rhs.Locator;
+            ClassName = rhs.ClassName;
+            AutoStart = rhs.AutoStart;
+            Precondition = rhs.Precondition;
+            State = rhs.State;
+            Observers = rhs.Observers;
+            ProcessedRequests = rhs.ProcessedRequests;
+            ProcessedObjects = rhs.ProcessedObjects;
+            Module = rhs.Module;
+            Hash = rhs.Hash;
+            return (*this);
+        }
+
+    private:
+        void Init()
+        {
+            Add(_T("callsign"), &Callsign);
+            Add(_T("locator"), &Locator);
+            Add(_T("classname"), &ClassName);
+            Add(_T("autostart"), &AutoStart);
+            Add(_T("precondition"), &Precondition);
+            Add(_T("state"), &State);
+            Add(_T("observers"), &Observers);
+            Add(_T("processedrequests"), &ProcessedRequests);
+            Add(_T("processedobjects"), &ProcessedObjects);
+            Add(_T("module"), &Module);
+            Add(_T("hash"), &Hash);
+        }
+
+    public:
+        Core::JSON::String Callsign;
+        Core::JSON::String Locator;
+        Core::JSON::String ClassName;
+        Core::JSON::Boolean AutoStart;
+        Core::JSON::ArrayType<Core::JSON::String> Precondition;
+        Core::JSON::String State;
+        Core::JSON::DecUInt32 Observers;
+        Core::JSON::DecUInt32 ProcessedRequests;
+        Core::JSON::DecUInt32 ProcessedObjects;
+        Core::JSON::String Module;
+        Core::JSON::String Hash;
+    };
+
+    // Resembles the Controller metadata.
+    class Metadata : public Core::JSON::Container {
+    public:
+        Metadata(const Metadata&) = delete;
+        Metadata& operator=(const Metadata&) = delete;
+
+        Metadata()
+            : Core::JSON::Container()
+        {
+            Add(_T("plugins"), &Plugins);
+        }
+
+    public:
+        Core::JSON::ArrayType<Service> Plugins;
+    };
+
+    // The same layout, as the JsonGenerator emits it with --static-parser.
+    class StaticService : public Service {
+    public:
+        using Core::JSON::Container::FromString;
+        using Core::JSON::Container::ToString;
+
+        bool FromJSON(Core::JSON::Reader& reader)
+        {
+            bool result = reader.Begin();
+            while ((result == true) && (reader.Next() == true)) {
+                switch (reader.Hash()) {
+                case Core::JSON::Hash(_T("callsign")):
+                    result = reader.Value(_T("callsign"), Callsign);
+                    break;
+                case Core::JSON::Hash(_T("locator")):
+                    result = reader.Value(_T("locator"), Locator);
+                    break;
+                case Core::JSON::Hash(_T("classname")):
+                    result = reader.Value(_T("classname"), ClassName);
+                    break;
+                case Core::JSON::Hash(_T("autostart")):
+                    result = reader.Value(_T("autostart"), AutoStart);
+                    break;
+                case Core::JSON::Hash(_T("precondition")):
+                    result = reader.Value(_T("precondition"), Precondition);
+                    break;
+                case Core::JSON::Hash(_T("state")):
+                    result = reader.Value(_T("state"), State);
+                    break;
+                case Core::JSON::Hash(_T("observers")):
+                    result = reader.Value(_T("observers"), Observers);
+                    break;
+                case Core::JSON::Hash(_T("processedrequests")):
+                    result = reader.Value(_T("processedrequests"), ProcessedRequests);
+                    break;
+                case Core::JSON::Hash(_T("processedobjects")):
+                    result = reader.Value(_T("processedobjects"), ProcessedObjects);
+                    break;
+                case Core::JSON::Hash(_T("module")):
+                    result = reader.Value(_T("module"), Module);
+                    break;
+                case Core::JSON::Hash(_T("hash")):
+                    result = reader.Value(_T("hash"), Hash);
+                    break;
+                default:
+                    result = reader.Skip();
+                    break;
+                }
+            }
+            return ((result == true) && (reader.End() == true));
+        }
+
+        void ToJSON(Core::JSON::Writer& writer) const
+        {
+            writer.Begin();
+            writer.Value(_T("callsign"), Callsign);
+            writer.Value(_T("locator"), Locator);
+            writer.Value(_T("classname"), ClassName);
+            writer.Value(_T("autostart"), AutoStart);
+            writer.Value(_T("precondition"), Precondition);
+            writer.Value(_T("state"), State);
+            writer.Value(_T("observers"), Observers);
+            writer.Value(_T("processedrequests"), ProcessedRequests);
+            writer.Value(_T("processedobjects"), ProcessedObjects);
+            writer.Value(_T("module"), Module);
+            writer.Value(_T("hash"), Hash);
+            writer.End();
+        }
+    };
+
+    class StaticMetadata : public Core::JSON::Container {
+    public:
+        StaticMetadata(const StaticMetadata&) = delete;
+        StaticMetadata& operator=(const StaticMetadata&) = delete;
+
+        StaticMetadata()
+            : Core::JSON::Container()
+        {
+            Add(_T("plugins"), &Plugins);
+        }
+
+        using Core::JSON::Container::FromString;
+        using Core::JSON::Container::ToString;
+
+        bool FromString(const string& text)
+        {
+            return (Core::JSON::Reader::FromString(text, *this));
+        }
+
+        bool ToString(string& text) const
+        {
+            return (Core::JSON::Writer::ToString(*this, text));
+        }
+
+        bool FromJSON(Core::JSON::Reader& reader)
+        {
+            bool result = reader.Begin();
+            while ((result == true) && (reader.Next() == true)) {
+                switch (reader.Hash()) {
+                case Core::JSON::Hash(_T("plugins")):
+                    result = reader.Value(_T("plugins"), Plugins);
+                    break;
+                default:
+                    result = reader.Skip();
+                    break;
+                }
+            }
+            return ((result == true) && (reader.End() == true));
+        }
+
+        void ToJSON(Core::JSON::Writer& writer) const
+        {
+            writer.Begin();
+            writer.Value(_T("plugins"), Plugins);
+            writer.End();
+        }
+
+    public:
+        Core::JSON::ArrayType<StaticService> Plugins;
+    };
+
+    class Numbers : public Core::JSON::Container {
+    public:
+        Numbers(const Numbers&) = delete;
+        Numbers& operator=(const Numbers&) = delete;
+
+        Numbers()
+            : Core::JSON::Container()
+        {
+            Add(_T("values"), &Values);
+        }
+
+    public:
+        Core::JSON::ArrayType<Core::JSON::DecSInt64> Values;
+    };
+
+    class Strings : public Core::JSON::Container {
+    public:
+        Strings(const Strings&) = delete;
+        Strings& operator=(const Strings&) = delete;
+
+        Strings()
+            : Core::JSON::Container()
+        {
+            Add(_T("values"), &Values);
+        }
+
+    public:
+        Core::JSON::ArrayType<Core::JSON::String> Values;
+    };
+
+    struct Corpus {
+        const TCHAR* Name;
+        string Text;
+        Core::JSON::IElement* Typed;
+    };
+
+    struct Measurement {
+        double Seconds;
+        uint64_t Allocations;
+    };
+
+    template <typename ACTION>
+    static Measurement Measure(const uint32_t iterations, ACTION action)
+    {
+        const uint64_t allocations = g_allocations;
+        const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+        for (uint32_t index = 0; index < iterations; index++) {
+            action();
+        }
+
+        const std::chrono::steady_clock::duration duration = std::chrono::steady_clock::now() - start;
+
+        return (Measurement { std::chrono::duration_cast<std::chrono::duration<double>>(duration).count(), g_allocations - allocations });
+    }
+
+    static void Report(const Corpus& corpus, const TCHAR method[], const uint32_t iterations, const size_t size, const Measurement& parse, const Measurement& serialize)
+    {
+        const double megabytes = (static_cast<double>(size) * iterations) / (1024.0 * 1024.0);
+
+        printf("%-12s %-16s %8u", corpus.Name, method, static_cast<uint32_t>(size));
+        if (parse.Seconds > 0) {
+            printf(" %10.1f", megabytes / parse.Seconds);
+        } else {
+            printf(" %10s", "-");
+        }
+        printf(" %10.1f", megabytes / serialize.Seconds);
+        if (parse.Seconds > 0) {
+            printf(" %10.1f", static_cast<double>(parse.Allocations) / iterations);
+        } else {
+            printf(" %10s", "-");
+        }
+        printf(" %10.1f\n", static_cast<double>(serialize.Allocations) / iterations);
+    }
+
+    static string MetadataCorpus(Metadata& metadata)
+    {
+        static const TCHAR* const states[] = { _T("activated"), _T("deactivated"), _T("suspended"), _T("resumed") };
+        string text;
+
+        for (uint32_t index = 0; index < 40; index++) {
+            Service& service(metadata.Plugins.Add());
+            const string callsign(_T("Plugin") + Core::NumberType<uint32_t>(index).Text());
+
+            service.Callsign = callsign;
+            service.Locator = _T("libWPEFramework") + callsign + _T(".so");
+            service.ClassName = callsign;
+            service.AutoStart = ((index % 3) == 0);
+            service.Precondition.Add() = _T("Platform");
+            service.Precondition.Add() = _T("Internet");
+            service.State = states[index % 4];
+            service.Observers = index % 5;
+            service.ProcessedRequests = index * 1021;
+            service.ProcessedObjects = index * 7;
+            service.Module = _T("Plugin_") + callsign;
+            service.Hash = _T("d3c1b2a4f5e6d7c8b9a0");
+        }
+
+        metadata.ToString(text);
+        metadata.Clear();
+
+        return (text);
+    }
+
+    static string NumbersCorpus(Numbers& numbers)
+    {
+        string text;
+        int64_t value = 1;
+
+        for (uint32_t index = 0; index < 4000; index++) {
+            numbers.Values.Add() = ((index & 1) != 0 ? -value : value);
+            value = ((value * 37) + index) % 100000000;
+        }
+
+        numbers.ToString(text);
+        numbers.Clear();
+
+        return (text);
+    }
+
+    static string StringsCorpus(Strings& strings)
+    {
+        string text;
+
+        for (uint32_t index = 0; index < 64; index++) {
+            string value;
+            for (uint32_t part = 0; part < 16; part++) {
+                value += _T("line \"quoted\"\tand/or\n caf\xC3\xA9 ");
+            }
+            strings.Values.Add() = value;
+        }
+
+        strings.ToString(text);
+        strings.Clear();
+
+        return (text);
+    }
+
+    static string NestedCorpus()
+    {
+        static constexpr uint8_t Depth = 24;
+        string text;
+
+        for (uint8_t index = 0; index < 8; index++) {
+            text += (index == 0 ? _T("{") : _T(","));
+            text += _T("\"branch") + Core::NumberType<uint8_t>(index).Text() + _T("\":");
+            for (uint8_t level = 0; level < Depth; level++) {
+                text += ((level & 1) == 0 ? _T("{\"level\":") + Core::NumberType<uint8_t>(level).Text() + _T(",\"next\":") : _T("["));
+            }
+            text += _T("true");
+            for (uint8_t level = Depth; level > 0; level--) {
+                text += (((level - 1) & 1) == 0 ? _T("}") : _T("]"));
+            }
+        }
+        text += _T("}");
+
+        return (text);
+    }
+
+    static string KeysCorpus()
+    {
+        string text(_T("{"));
+
+        for (uint32_t index = 0; index < 1000; index++) {
+            if (index != 0) {
+                text += ',';
+            }
+            text += _T("\"key") + Core::NumberType<uint32_t>(index).Text() + _T("\":") + Core::NumberType<uint32_t>(index * 13).Text();
+        }
+        text += _T("}");
+
+        return (text);
+    }
+
+    // The parser the JsonGenerator emits with --static-parser, on the text of the IElement row of the corpus.
+    static void Static(const Corpus& corpus, const double scale)
+    {
+        const uint32_t iterations = std::max(static_cast<uint32_t>(((4.0 * 1024 * 1024) / corpus.Text.length()) * scale), 1u);
+        StaticMetadata metadata;
+        string text;
+
+        const Measurement parse = Measure(iterations, [&]() { metadata.FromString(corpus.Text); });
+        const Measurement serialize = Measure(iterations, [&]() { text.clear(); metadata.ToString(text); });
+        Report(corpus, _T("Static"), iterations, corpus.Text.length(), parse, serialize);
+    }
+
+    // Arrays of 100000 numbers, past what FromString() takes, so the text is parsed the way a channel feeds it.
+    static void LargeNumbers(const double scale)
+    {
+        static constexpr uint32_t Elements = 100000;
+        static constexpr uint16_t FrameSize = 4096;
+
+        const uint32_t iterations = std::max(static_cast<uint32_t>(20 * scale), 1u);
+        Core::JSON::ArrayType<Core::JSON::DecUInt32> integers;
+        Core::JSON::ArrayType<Core::JSON::Double> doubles;
+        Core::JSON::ArrayType<Core::JSON::Double> parsed;
+        string integerText;
+        string doubleText;
+
+        for (uint32_t index = 0; index < Elements; index++) {
+            integers.Add() = index * 2654435761u;
+            doubles.Add() = (static_cast<double>(index) * 1.0000001) / 7.0;
+        }
+
+        const Measurement integer = Measure(iterations, [&]() { integerText.clear(); integers.ToString(integerText); });
+        const Measurement floating = Measure(iterations, [&]() { doubleText.clear(); doubles.ToString(doubleText); });
+        const Measurement parse = Measure(iterations, [&]() {
+            Core::OptionalType<Core::JSON::Error> error;
+            uint32_t handled = 0;
+            uint16_t offset = 0;
+
+            parsed.Clear();
+
+            do {
+                const uint16_t size = static_cast<uint16_t>(std::min(static_cast<size_t>(FrameSize), doubleText.length() + 1 - handled));
+                handled += static_cast<Core::JSON::IElement&>(parsed).Deserialize(&(doubleText[handled]), size, offset, error);
+            } while ((offset != 0) && (error.IsSet() == false));
+        });
+
+        printf("\n%-12s %8s %10s %10s\n", "x100000", "bytes", "us", "allocs");
+        printf("%-12s %8u %10.1f %10.1f\n", "ser. ints", static_cast<uint32_t>(integerText.length()),
+            (integer.Seconds * 1000000.0) / iterations, static_cast<double>(integer.Allocations) / iterations);
+        printf("%-12s %8u %10.1f %10.1f\n", "ser. doubles", static_cast<uint32_t>(doubleText.length()),
+            (floating.Seconds * 1000000.0) / iterations, static_cast<double>(floating.Allocations) / iterations);
+        printf("%-12s %8u %10.1f %10.1f\n", "parse dbls", static_cast<uint32_t>(doubleText.length()),
+            (parse.Seconds * 1000000.0) / iterations, static_cast<double>(parse.Allocations) / iterations);
+    }
+
+    // Parse a small message and pick one value out of it, as a plugin does with a notification.
+    static void Access(const double scale)
+    {
+        static const string Input = _T("{\"callsign\":\"Monitor\",\"state\":\"activated\",\"observables\":[")
+                                    _T("{\"name\":\"WebKit\",\"restart\":{\"limit\":3,\"window\":60},\"measurements\":{\"resident\":{\"min\":1024,\"max\":2048,\"average\":1536.5}}},")
+                                    _T("{\"name\":\"Net\\tflix\\u00e9\",\"restart\":{\"limit\":-1,\"window\":0},\"active\":true,\"data\":null}],\"count\":2}");
+
+        const uint32_t iterations = std::max(static_cast<uint32_t>(100000 * scale), 1u);
+        Core::JSON::Document document;
+        int64_t sum = 0;
+
+        const Measurement variant = Measure(iterations, [&]() {
+            Core::JSON::VariantContainer container(Input);
+            Core::JSON::VariantContainer first(container[_T("observables")].Array()[0].Object());
+            sum += first[_T("restart")].Object()[_T("limit")].Number();
+        });
+        const Measurement dynamic = Measure(iterations, [&]() {
+            document.FromString(Input);
+            sum -= document[_T("observables")].Get(0)[_T("restart")][_T("limit")].Number();
+        });
+
+        printf("\n%-12s %8s %10s %10s\n", "access", "bytes", "us/access", "allocs");
+        printf("%-12s %8u %10.2f %10.1f\n", "variant", static_cast<uint32_t>(Input.length()),
+            (variant.Seconds * 1000000.0) / iterations, static_cast<double>(variant.Allocations) / iterations);
+        printf("%-12s %8u %10.2f %10.1f\n", "document", static_cast<uint32_t>(Input.length()),
+            (dynamic.Seconds * 1000000.0) / iterations, static_cast<double>(dynamic.Allocations) / iterations);
+
+        // Keeps the work from being optimized away, both should have found the same.
+        if (sum != 0) {
+            printf("Document and VariantContainer disagree!\n");
+        }
+    }
+
+    static void Dump(const string& directory, const Corpus& corpus)
+    {
+        std::vector<uint8_t> packed;
+        const string base(directory + '/' + corpus.Name);
+
+        FILE* file = ::fopen((base + _T(".json")).c_str(), "wb");
+        if (file != nullptr) {
+            ::fwrite(corpus.Text.c_str(), 1, corpus.Text.length(), file);
+            ::fclose(file);
+        }
+        if ((Core::JSON::MessagePack::FromJSON(corpus.Text, packed) == true) && ((file = ::fopen((base + _T(".msgpack")).c_str(), "wb")) != nullptr)) {
+            ::fwrite(packed.data(), 1, packed.size(), file);
+            ::fclose(file);
+        }
+    }
+
+    // A dashboard refresh of 50 property reads, as 50 single JSON-RPC frames or as one batch. Only
+    // the wire side is measured (frames go through a 1K buffer, as on the channel). The per frame
+    // socket wake-up and worker pool job come on top of this for the single requests.
+    static void Refresh(const double scale)
+    {
+        static constexpr uint16_t Calls = 50;
+        static constexpr uint16_t FrameSize = 1024;
+
+        const uint32_t iterations = std::max(static_cast<uint32_t>(2000 * scale), 1u);
+        std::vector<string> requests;
+        std::vector<string> responses;
+        string batchRequest(_T("["));
+        string batchResponse(_T("["));
+        size_t singleSize = 0;
+
+        for (uint16_t index = 0; index < Calls; index++) {
+            const string id(Core::NumberType<uint16_t>(index + 1).Text());
+            const string callsign(_T("Plugin") + Core::NumberType<uint16_t>(index % 8).Text());
+
+            requests.push_back(_T("{\"jsonrpc\":\"2.0\",\"id\":") + id + _T(",\"method\":\"") + callsign + _T(".1.property@") + id + _T("\"}"));
+            responses.push_back(_T("{\"jsonrpc\":\"2.0\",\"id\":") + id + _T(",\"result\":{\"value\":") + id + _T(",\"state\":\"activated\"}}"));
+
+            batchRequest += (index == 0 ? _T("") : _T(",")) + requests.back();
+            batchResponse += (index == 0 ? _T("") : _T(",")) + responses.back();
+            singleSize += requests.back().length() + responses.back().length();
+        }
+        batchRequest += ']';
+        batchResponse += ']';
+
+        auto receive = [](Core::JSON::IElement& element, const string& text) {
+            Core::OptionalType<Core::JSON::Error> error;
+            uint16_t offset = 0;
+            size_t position = 0;
+
+            do {
+                const uint16_t size = static_cast<uint16_t>(std::min(text.length() - position, static_cast<size_t>(FrameSize)));
+                position += element.Deserialize(&(text[position]), size, offset, error);
+            } while ((offset != 0) && (position < text.length()) && (error.IsSet() == false));
+        };
+        auto send = [](const Core::JSON::IElement& element) {
+            char frame[FrameSize];
+            uint16_t offset = 0;
+
+            do {
+                element.Serialize(frame, sizeof(frame), offset);
+            } while (offset != 0);
+        };
+
+        Core::ProxyPoolType<Core::JSONRPC::Message> pool(Calls);
+        Core::JSONRPC::Batch answer;
+        std::vector<Core::ProxyType<Core::JSONRPC::Message>> answers;
+
+        for (const string& text : responses) {
+            answers.push_back(Core::ProxyType<Core::JSONRPC::Message>::Create());
+            answers.back()->FromString(text);
+        }
+        for (const Core::ProxyType<Core::JSONRPC::Message>& entry : answers) {
+            answer.Add(entry);
+        }
+
+        const Measurement single = Measure(iterations, [&]() {
+            for (uint16_t index = 0; index < Calls; index++) {
+                Core::ProxyType<Core::JSONRPC::Message> request(pool.Element());
+                receive(*request, requests[index]);
+                send(*answers[index]);
+            }
+        });
+
+        Core::JSONRPC::Batch batch;
+
+        const Measurement batched = Measure(iterations, [&]() {
+            receive(batch, batchRequest);
+            send(answer);
+        });
+
+        printf("\n%-12s %8s %8s %10s %10s\n", "refresh", "frames", "bytes", "us/refresh", "allocs");
+        printf("%-12s %8u %8u %10.1f %10.1f\n", "single", 2 * Calls, static_cast<uint32_t>(singleSize),
+            (single.Seconds * 1000000.0) / iterations, static_cast<double>(single.Allocations) / iterations);
+        printf("%-12s %8u %8u %10.1f %10.1f\n", "batch", 2, static_cast<uint32_t>(batchRequest.length() + batchResponse.length()),
+            (batched.Seconds * 1000000.0) / iterations, static_cast<double>(batched.Allocations) / iterations);
+    }
+
+    static int Run(int argc, char* argv[])
+    {
+        double scale = 1.0;
+        string dump;
+
+        for (int index = 1; index < argc; index++) {
+            if ((::strcmp(argv[index], "--dump") == 0) && ((index + 1) < argc)) {
+                dump = argv[++index];
+            } else {
+                scale = ::atof(argv[index]);
+            }
+        }
+
+        Metadata metadata;
+        Numbers numbers;
+        Strings strings;
+
+        Corpus corpora[] = {
+            { _T("metadata"), MetadataCorpus(metadata), &metadata },
+            { _T("numbers"), NumbersCorpus(numbers), &numbers },
+            { _T("strings"), StringsCorpus(strings), &strings },
+            { _T("nested"), NestedCorpus(), nullptr },
+            { _T("keys"), KeysCorpus(), nullptr }
+        };
+
+        printf("%-12s %-16s %8s %10s %10s %10s %10s\n", "corpus", "method", "bytes", "parse MB/s", "ser. MB/s", "allocs/in", "allocs/out");
+
+        for (Corpus& corpus : corpora) {
+            // Roughly 4MB of input per measurement.
+            const uint32_t iterations = std::max(static_cast<uint32_t>(((4.0 * 1024 * 1024) / corpus.Text.length()) * scale), 1u);
+            const size_t size = corpus.Text.length();
+            string text;
+
+            if (dump.empty() == false) {
+                Dump(dump, corpus);
+            }
+
+            if (corpus.Typed != nullptr) {
+                Core::JSON::IElement& typed(*corpus.Typed);
+                std::vector<uint8_t> packed;
+
+                Measurement parse = Measure(iterations, [&]() { typed.FromString(corpus.Text); });
+                Measurement serialize = Measure(iterations, [&]() { text.clear(); typed.ToString(text); });
+                Report(corpus, _T("IElement"), iterations, size, parse, serialize);
+
+                // Decoding containers from MessagePack does not round trip yet, so only the encoding
+                // side is measured.
+                const Core::JSON::IMessagePack& binary(*dynamic_cast<const Core::JSON::IMessagePack*>(corpus.Typed));
+                serialize = Measure(iterations, [&]() { Core::JSON::IMessagePack::ToBuffer(packed, binary); });
+                Report(corpus, _T("IMessagePack"), iterations, packed.size(), Measurement { 0, 0 }, serialize);
+            }
+
+            {
+                Core::JSON::VariantContainer container;
+
+                Measurement parse = Measure(iterations, [&]() { container.Clear(); container.FromString(corpus.Text); });
+                Measurement serialize = Measure(iterations, [&]() { text.clear(); container.ToString(text); });
+                Report(corpus, _T("VariantContainer"), iterations, size, parse, serialize);
+            }
+
+            {
+                Core::JSON::Document document;
+
+                Measurement parse = Measure(iterations, [&]() { document.FromString(corpus.Text); });
+                Measurement serialize = Measure(iterations, [&]() { text.clear(); document.ToString(text); });
+                Report(corpus, _T("Document"), iterations, size, parse, serialize);
+            }
+
+            {
+                std::vector<uint8_t> packed;
+
+                Measurement parse = Measure(iterations, [&]() { packed.clear(); Core::JSON::MessagePack::FromJSON(corpus.Text, packed); });
+                Measurement serialize = Measure(iterations, [&]() { text.clear(); Core::JSON::MessagePack::ToJSON(packed.data(), static_cast<uint32_t>(packed.size()), text); });
+                Report(corpus, _T("MessagePack"), iterations, size, parse, serialize);
+            }
+        }
+
+        Static(corpora[0], scale);
+
+        LargeNumbers(scale);
+
+        Access(scale);
+
+        Refresh(scale);
+
+        return (0);
+    }
+} // Benchmark
+} // WPEFramework
+
+int main(int argc, char* argv[])
+{
+    int result = WPEFramework::Benchmark::Run(argc, argv);
+
+    WPEFramework::Core::Singleton::Dispose();
+
+    return (result);
+}
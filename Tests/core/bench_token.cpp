@@ -0,0 +1,168 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2020 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// What the check of the token costs an authenticated request. Not a test, run it by hand and compare the
+// figures before and after a change:
+//
+//     WPEFramework_bench_token [iterations scale]
+//
+// "decode" verifies the token and parses its claims for every request, as a security provider does.
+// "cached" looks it up in the VerifiedTokensType the framework keeps in front of the provider.
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+
+#include <core/core.h>
+#include <websocket/websocket.h>
+
+namespace WPEFramework {
+namespace Benchmark {
+
+    static constexpr uint16_t MaxPayload = 1024;
+
+    class Claims : public Core::JSON::Container {
+    public:
+        Claims(const Claims&) = delete;
+        Claims& operator=(const Claims&) = delete;
+
+        Claims()
+            : Core::JSON::Container()
+        {
+            Add(_T("url"), &Url);
+            Add(_T("user"), &User);
+            Add(_T("exp"), &Expiry);
+        }
+        ~Claims()
+        {
+        }
+
+    public:
+        Core::JSON::String Url;
+        Core::JSON::String User;
+        Core::JSON::DecUInt64 Expiry;
+    };
+
+    // What a cache hit hands out.
+    class Officer {
+    public:
+        Officer(const Officer&) = delete;
+        Officer& operator=(const Officer&) = delete;
+
+        Officer()
+            : _references(1)
+        {
+        }
+        ~Officer()
+        {
+        }
+
+    public:
+        void AddRef() const
+        {
+            _references++;
+        }
+        uint32_t Release() const
+        {
+            _references--;
+            return (Core::ERROR_NONE);
+        }
+
+    private:
+        mutable uint32_t _references;
+    };
+
+    template <typename ACTION>
+    static double Measure(const uint32_t iterations, ACTION&& action)
+    {
+        const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+        for (uint32_t index = 0; index < iterations; index++) {
+            action();
+        }
+
+        const std::chrono::steady_clock::duration duration = std::chrono::steady_clock::now() - start;
+
+        return (std::chrono::duration_cast<std::chrono::duration<double>>(duration).count());
+    }
+
+    static void Report(const TCHAR name[], const uint32_t iterations, const double seconds)
+    {
+        printf("%-10s %12.3f %12.1f\n", name, (seconds * 1000000.0) / iterations, iterations / seconds);
+    }
+
+    static int Run(int argc, char* argv[])
+    {
+        const double scale = (argc > 1 ? ::atof(argv[1]) : 1.0);
+        const uint32_t iterations = std::max(static_cast<uint32_t>(200000 * scale), 1u);
+        const uint8_t key[] = { 'b', 'e', 'n', 'c', 'h', 'm', 'a', 'r', 'k', 'k', 'e', 'y' };
+        const string payload(_T("{\"url\":\"http://localhost:8080/Service/Controller\",\"user\":\"bench\",\"exp\":")
+            + Core::NumberType<uint64_t>(static_cast<uint64_t>(::time(nullptr) + 3600)).Text() + _T("}"));
+
+        Web::JSONWebToken signer(Web::JSONWebToken::SHA256, sizeof(key), key);
+        Web::VerifiedTokensType<Officer> tokens(64, 300);
+        Officer officer;
+        string token;
+        uint32_t valid = 0;
+
+        signer.Encode(token, static_cast<uint16_t>(payload.length()), reinterpret_cast<const uint8_t*>(payload.c_str()));
+        tokens.Add(token, &officer);
+
+        printf("%-10s %12s %12s\n", "path", "us/request", "requests/s");
+
+        Report(_T("decode"), iterations, Measure(iterations, [&]() {
+            uint8_t buffer[MaxPayload];
+            uint16_t length = signer.Decode(token, sizeof(buffer), buffer);
+
+            if (length <= sizeof(buffer)) {
+                Claims claims;
+
+                if ((claims.FromString(string(reinterpret_cast<const TCHAR*>(buffer), length)) == true) && (claims.Expiry.IsSet() == true)) {
+                    valid++;
+                }
+            }
+        }));
+
+        Report(_T("cached"), iterations, Measure(iterations, [&]() {
+            Officer* result = tokens.Find(token);
+
+            if (result != nullptr) {
+                result->Release();
+                valid++;
+            }
+        }));
+
+        if (valid != (2 * iterations)) {
+            printf("the token was not accepted every time\n");
+        }
+
+        return (valid == (2 * iterations) ? 0 : 1);
+    }
+} // Benchmark
+} // WPEFramework
+
+int main(int argc, char* argv[])
+{
+    int result = WPEFramework::Benchmark::Run(argc, argv);
+
+    WPEFramework::Core::Singleton::Dispose();
+
+    return (result);
+}
@@ -0,0 +1,147 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2020 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// Throughput of the websocket masking and framing. Not a test, run it by hand and compare the figures
+// before and after a change:
+//
+//     WPEFramework_bench_websocket [iterations scale]
+//
+// "bytewise" is the one byte at a time XOR the masking used to be, "mask" is Protocol::Mask and
+// "frames" runs a message through a masking Encoder and the Decoder on the other side, in frames
+// of the size a socket buffer typically offers.
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+#include <core/core.h>
+#include <websocket/websocket.h>
+
+namespace WPEFramework {
+namespace Benchmark {
+
+    static constexpr uint16_t FrameSize = 16384;
+
+    static const uint8_t Key[4] = { 0x37, 0xfa, 0x21, 0x3d };
+
+    static void Bytewise(uint8_t data[], const uint32_t length)
+    {
+        for (uint32_t index = 0; index < length; index++) {
+            data[index] ^= Key[index & 0x3];
+        }
+    }
+
+    template <typename ACTION>
+    static double Measure(const uint32_t iterations, ACTION&& action)
+    {
+        const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+        for (uint32_t index = 0; index < iterations; index++) {
+            action();
+        }
+
+        const std::chrono::steady_clock::duration duration = std::chrono::steady_clock::now() - start;
+
+        return (std::chrono::duration_cast<std::chrono::duration<double>>(duration).count());
+    }
+
+    // Sends the message as a masked client would and decodes it as the server does, returns false if
+    // the received payload differs.
+    static bool Frames(Web::WebSocket::Protocol& sender, Web::WebSocket::Protocol& receiver, const std::vector<uint8_t>& message, std::vector<uint8_t>& frame)
+    {
+        const uint8_t headerSpace = sender.HeaderSpace();
+        const uint16_t capacity = static_cast<uint16_t>(frame.size() - headerSpace);
+        bool result = true;
+        size_t offset = 0;
+
+        do {
+            const uint16_t used = static_cast<uint16_t>(std::min(message.size() - offset, static_cast<size_t>(capacity)));
+
+            ::memcpy(&(frame[headerSpace]), &(message[offset]), used);
+
+            uint16_t length = sender.Encoder(frame.data(), capacity, used);
+            uint16_t header = receiver.Decoder(frame.data(), length);
+
+            result = result && (length == used) && (::memcmp(&(frame[header]), &(message[offset]), used) == 0);
+            offset += used;
+
+        } while (sender.SendInProgress() == true);
+
+        return (result);
+    }
+
+    static void Report(const TCHAR name[], const uint32_t size, const uint64_t bytes, const double seconds)
+    {
+        printf("%-10s %8u %12.1f\n", name, size, (static_cast<double>(bytes) / (1024.0 * 1024.0)) / seconds);
+    }
+
+    static int Run(int argc, char* argv[])
+    {
+        static const uint32_t sizes[] = { 1024, 4096, 16384, 65536, 262144, 1048576 };
+
+        const double scale = (argc > 1 ? ::atof(argv[1]) : 1.0);
+        int result = 0;
+
+        printf("%-10s %8s %12s\n", "path", "bytes", "MB/s");
+
+        for (const uint32_t size : sizes) {
+            // Roughly the same amount of data for every size.
+            const uint32_t iterations = std::max(static_cast<uint32_t>((256 * 1024 * 1024 * scale) / size), 1u);
+            const uint64_t bytes = static_cast<uint64_t>(size) * iterations;
+
+            std::vector<uint8_t> data(size);
+
+            for (uint32_t index = 0; index < size; index++) {
+                data[index] = static_cast<uint8_t>(index * 7);
+            }
+
+            // An odd start, a payload behind a 6 or 14 bytes header is not aligned either.
+            std::vector<uint8_t> buffer(size + 1);
+            ::memcpy(&(buffer[1]), data.data(), size);
+
+            Report(_T("bytewise"), size, bytes, Measure(iterations, [&]() { Bytewise(&(buffer[1]), size); }));
+            Report(_T("mask"), size, bytes, Measure(iterations, [&]() { Web::WebSocket::Protocol::Mask(&(buffer[1]), size, Key, 0); }));
+
+            Web::WebSocket::Protocol sender(true, true);
+            Web::WebSocket::Protocol receiver(true, false);
+            std::vector<uint8_t> frame(FrameSize);
+            bool valid = true;
+
+            Report(_T("frames"), size, bytes, Measure(iterations, [&]() { valid = Frames(sender, receiver, data, frame) && valid; }));
+
+            if (valid == false) {
+                printf("frames of %u bytes were not received as sent\n", size);
+                result = 1;
+            }
+        }
+
+        return (result);
+    }
+} // Benchmark
+} // WPEFramework
+
+int main(int argc, char* argv[])
+{
+    int result = WPEFramework::Benchmark::Run(argc, argv);
+
+    WPEFramework::Core::Singleton::Dispose();
+
+    return (result);
+}
@@ -0,0 +1,177 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2020 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// libFuzzer harness for Core::JSON. The input is offered as JSON text to the reflective parser,
+// the VariantContainer and the Document, and as MessagePack to the transcoder and the JSONRPC
+// message. Next to not crashing, whatever is accepted has to survive a round trip.
+//
+//     clang++ -fsanitize=fuzzer,address ... fuzz_json.cpp    (see JSON_FUZZER in CMakeLists.txt)
+//     ./WPEFramework_fuzz_json <corpus directory>            (seed it with bench_json --dump)
+//
+// Without libFuzzer (JSON_FUZZER_STANDALONE), the files on the command line are replayed.
+
+#include <cstdio>
+#include <cstdlib>
+
+#include <core/core.h>
+
+#define FUZZ_CHECK(condition)                                                                  \
+    do {                                                                                       \
+        if (!(condition)) {                                                                    \
+            fprintf(stderr, "%s:%d: check failed: %s\n", __FILE__, __LINE__, #condition);     \
+            ::abort();                                                                         \
+        }                                                                                      \
+    } while (false)
+
+namespace WPEFramework {
+namespace Fuzz {
+
+    class Entry : public Core::JSON::Container {
+    public:
+        Entry(const Entry&) = delete;
+        Entry& operator=(const Entry&) = delete;
+
+        Entry()
+            : Core::JSON::Container()
+        {
+            Add(_T("name"), &Name);
+            Add(_T("id"), &Id);
+            Add(_T("offset"), &Offset);
+            Add(_T("ratio"), &Ratio);
+            Add(_T("active"), &Active);
+            Add(_T("values"), &Values);
+            Add(_T("tags"), &Tags);
+        }
+
+    public:
+        Core::JSON::String Name;
+        Core::JSON::DecUInt32 Id;
+        Core::JSON::DecSInt64 Offset;
+        Core::JSON::Double Ratio;
+        Core::JSON::Boolean Active;
+        Core::JSON::ArrayType<Core::JSON::DecSInt32> Values;
+        Core::JSON::ArrayType<Core::JSON::String> Tags;
+    };
+
+    static void Text(const string& text)
+    {
+        // The reflective parser works on 16 bit lengths.
+        if (text.length() < 0xFF00) {
+            Entry entry;
+            Core::JSON::VariantContainer container;
+            string output;
+
+            if (entry.FromString(text) == true) {
+                entry.ToString(output);
+                Entry check;
+                FUZZ_CHECK(check.FromString(output) == true);
+            }
+
+            container.FromString(text);
+            container.ToString(output);
+        }
+
+        Core::JSON::Document document;
+
+        if (document.FromString(text) == true) {
+            string first;
+            string second;
+
+            document.ToString(first);
+
+            Core::JSON::Document check;
+            FUZZ_CHECK(check.FromString(first) == true);
+            check.ToString(second);
+            FUZZ_CHECK(first == second);
+
+            // Everything the Document accepts (within the depth limit), the transcoder accepts too.
+            std::vector<uint8_t> packed;
+            string back;
+
+            if ((Core::JSON::MessagePack::FromJSON(first, packed) == true)) {
+                FUZZ_CHECK(Core::JSON::MessagePack::Length(packed.data(), static_cast<uint32_t>(packed.size())) == packed.size());
+                FUZZ_CHECK(Core::JSON::MessagePack::ToJSON(packed.data(), static_cast<uint32_t>(packed.size()), back) == packed.size());
+                FUZZ_CHECK((Core::JSON::Document().FromString(back)) == true);
+            }
+        }
+    }
+
+    static void Binary(const uint8_t data[], const size_t size)
+    {
+        const uint32_t length = static_cast<uint32_t>(std::min(size, static_cast<size_t>(0xFFFF)));
+        const uint32_t complete = Core::JSON::MessagePack::Length(data, length);
+        string text;
+
+        if ((complete != 0) && (complete != static_cast<uint32_t>(~0))) {
+            if (Core::JSON::MessagePack::ToJSON(data, length, text) == complete) {
+                std::vector<uint8_t> packed;
+                string again;
+
+                // Transcoding back may pick a different (smaller) encoding, but has to be stable.
+                FUZZ_CHECK(Core::JSON::MessagePack::FromJSON(text, packed) == true);
+                FUZZ_CHECK(Core::JSON::MessagePack::ToJSON(packed.data(), static_cast<uint32_t>(packed.size()), again) == packed.size());
+                FUZZ_CHECK(again == text);
+            }
+        }
+
+        // Offered the way the channel does, must not crash or overrun.
+        Core::JSONRPC::Message message;
+        uint16_t offset = 0;
+        const uint16_t loaded = static_cast<Core::JSON::IMessagePack&>(message).Deserialize(data, static_cast<uint16_t>(length), offset);
+
+        FUZZ_CHECK(loaded <= length);
+    }
+
+} // Fuzz
+} // WPEFramework
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size)
+{
+    WPEFramework::Fuzz::Text(string(reinterpret_cast<const char*>(data), size));
+    WPEFramework::Fuzz::Binary(data, size);
+
+    return (0);
+}
+
+#ifdef JSON_FUZZER_STANDALONE
+int main(int argc, char* argv[])
+{
+    for (int index = 1; index < argc; index++) {
+        FILE* file = ::fopen(argv[index], "rb");
+
+        if (file != nullptr) {
+            std::vector<uint8_t> data;
+            uint8_t buffer[4096];
+            size_t loaded;
+
+            while ((loaded = ::fread(buffer, 1, sizeof(buffer), file)) > 0) {
+                data.insert(data.end(), buffer, buffer + loaded);
+            }
+            ::fclose(file);
+
+            LLVMFuzzerTestOneInput(data.data(), data.size());
+            printf("%s: ok\n", argv[index]);
+        }
+    }
+
+    WPEFramework::Core::Singleton::Dispose();
+
+    return (0);
+}
+#endif
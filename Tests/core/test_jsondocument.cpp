@@ -0,0 +1,129 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2020 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include "JSON.h"
+
+namespace WPEFramework {
+namespace Tests {
+
+    static const string DocumentTestInput = _T("{\"callsign\":\"Monitor\",\"state\":\"activated\",\"observables\":[")
+                                            _T("{\"name\":\"WebKit\",\"restart\":{\"limit\":3,\"window\":60},\"measurements\":{\"resident\":{\"min\":1024,\"max\":2048,\"average\":1536.5}}},")
+                                            _T("{\"name\":\"Net\\tflix\\u00e9\",\"restart\":{\"limit\":-1,\"window\":0},\"active\":true,\"data\":null}],\"count\":2}");
+
+    TEST(JSONDocument, Parse)
+    {
+        Core::JSON::Document document;
+
+        EXPECT_TRUE(document.FromString(DocumentTestInput));
+        EXPECT_TRUE(document.IsValid());
+
+        const Core::JSON::Document::Node& root = document.Root();
+        EXPECT_EQ(root.Content(), Core::JSON::Variant::type::OBJECT);
+        EXPECT_EQ(root.Elements(), 4u);
+        EXPECT_STREQ(root[_T("callsign")].String().c_str(), _T("Monitor"));
+        EXPECT_EQ(root[_T("count")].Number(), 2);
+
+        const Core::JSON::Document::Node& observables = root[_T("observables")];
+        EXPECT_EQ(observables.Content(), Core::JSON::Variant::type::ARRAY);
+        EXPECT_EQ(observables.Elements(), 2u);
+        EXPECT_EQ(observables.Get(0)[_T("restart")][_T("window")].Number(), 60);
+        EXPECT_EQ(observables.Get(0)[_T("measurements")][_T("resident")][_T("average")].Float(), 1536.5);
+        EXPECT_STREQ(observables.Get(1)[_T("name")].String().c_str(), _T("Net\tflix\xC3\xA9"));
+        EXPECT_EQ(observables.Get(1)[_T("restart")][_T("limit")].Number(), -1);
+        EXPECT_TRUE(observables.Get(1)[_T("active")].Boolean());
+        EXPECT_TRUE(observables.Get(1)[_T("data")].IsNull());
+
+        // Missing members and out of range elements are null, also when chained.
+        EXPECT_TRUE(root[_T("unknown")][_T("deeper")].IsNull());
+        EXPECT_TRUE(observables.Get(5).IsNull());
+
+        uint32_t count = 0;
+        for (const Core::JSON::Document::Node* index = root.First(); index != nullptr; index = index->Next()) {
+            count++;
+        }
+        EXPECT_EQ(count, 4u);
+        EXPECT_TRUE(root.First()->Label() == _T("callsign"));
+    }
+
+    TEST(JSONDocument, ZeroCopy)
+    {
+        const string text(_T("{\"plain\":\"text\",\"escaped\":\"a\\tb\"}"));
+        Core::JSON::Document document;
+
+        EXPECT_TRUE(document.FromBuffer(text.c_str(), static_cast<uint32_t>(text.length())));
+
+        // Unescaped strings refer to the source text, escaped ones are unescaped into the arena.
+        const Core::JSON::Document::Node& plain = document[_T("plain")];
+        EXPECT_EQ(&(plain.Text()[0]), &(text[10]));
+        EXPECT_STREQ(document[_T("escaped")].String().c_str(), _T("a\tb"));
+    }
+
+    TEST(JSONDocument, RoundTrip)
+    {
+        Core::JSON::Document document;
+        Core::JSON::VariantContainer reference;
+        string text;
+        string check;
+
+        EXPECT_TRUE(document.FromString(DocumentTestInput));
+        document.ToString(text);
+        EXPECT_STREQ(text.c_str(), _T("{\"callsign\":\"Monitor\",\"state\":\"activated\",\"observables\":[")
+                                   _T("{\"name\":\"WebKit\",\"restart\":{\"limit\":3,\"window\":60},\"measurements\":{\"resident\":{\"min\":1024,\"max\":2048,\"average\":1536.5}}},")
+                                   _T("{\"name\":\"Net\\tflix\xC3\xA9\",\"restart\":{\"limit\":-1,\"window\":0},\"active\":true,\"data\":null}],\"count\":2}"));
+
+        // The output is understood by the reflective parser.
+        EXPECT_TRUE(reference.FromString(text));
+        EXPECT_STREQ(reference[_T("callsign")].String().c_str(), _T("Monitor"));
+
+        // Parsing again reuses the arena.
+        EXPECT_TRUE(document.FromString(_T(" [ 1 , 2.5e1 , \"x\" ] ")));
+        document.ToString(check);
+        EXPECT_STREQ(check.c_str(), _T("[1,2.5e1,\"x\"]"));
+        EXPECT_EQ(document.Root().Get(1).Float(), 25.0);
+    }
+
+    TEST(JSONDocument, Invalid)
+    {
+        Core::JSON::Document document;
+
+        EXPECT_FALSE(document.FromString(_T("{\"a\":1,}")));
+        EXPECT_FALSE(document.IsValid());
+        EXPECT_TRUE(document.Root().IsNull());
+        EXPECT_FALSE(document.FromString(_T("{\"a\" 1}")));
+        EXPECT_FALSE(document.FromString(_T("[1,2")));
+        EXPECT_FALSE(document.FromString(_T("{\"a\":1} x")));
+        EXPECT_FALSE(document.FromString(_T("tru")));
+        EXPECT_FALSE(document.FromString(string(Core::JSON::Document::MaxDepth + 2, '[') + string(Core::JSON::Document::MaxDepth + 2, ']')));
+        EXPECT_TRUE(document.FromString(string(Core::JSON::Document::MaxDepth, '[') + string(Core::JSON::Document::MaxDepth, ']')));
+    }
+
+    TEST(JSONDocument, MatchesVariant)
+    {
+        Core::JSON::Document document;
+        Core::JSON::VariantContainer container(DocumentTestInput);
+        Core::JSON::VariantContainer first(container[_T("observables")].Array()[0].Object());
+
+        EXPECT_TRUE(document.FromString(DocumentTestInput));
+        EXPECT_EQ(document[_T("observables")].Get(0)[_T("restart")][_T("limit")].Number(), first[_T("restart")].Object()[_T("limit")].Number());
+    }
+
+} // Tests
+} // WPEFramework
@@ -0,0 +1,230 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2020 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <limits>
+
+#include <gtest/gtest.h>
+
+#include "JSON.h"
+
+namespace WPEFramework {
+namespace Tests {
+
+    // Serializes in chunks of the given size, to cover resuming in the middle of a number.
+    template <typename ELEMENT>
+    static string Chunked(const ELEMENT& element, const uint16_t chunk)
+    {
+        char buffer[64];
+        uint16_t offset = 0;
+        uint16_t loaded;
+        string result;
+
+        do {
+            loaded = static_cast<const Core::JSON::IElement&>(element).Serialize(buffer, chunk, offset);
+            result.append(buffer, loaded);
+        } while (offset != 0);
+
+        return (result);
+    }
+
+    TEST(JSONNumber, FormatDecimal)
+    {
+        char buffer[24];
+        char* end = &buffer[sizeof(buffer)];
+
+        EXPECT_EQ(string(Core::FormatDecimal(0, end), end), "0");
+        EXPECT_EQ(string(Core::FormatDecimal(7, end), end), "7");
+        EXPECT_EQ(string(Core::FormatDecimal(100000000, end), end), "100000000");
+        EXPECT_EQ(string(Core::FormatDecimal(1000000007, end), end), "1000000007");
+        EXPECT_EQ(string(Core::FormatDecimal(std::numeric_limits<uint64_t>::max(), end), end), "18446744073709551615");
+
+        EXPECT_STREQ(Core::NumberType<int32_t>(-2147483647 - 1).Text().c_str(), _T("-2147483648"));
+        EXPECT_STREQ(Core::NumberType<uint16_t>(65535).Text().c_str(), _T("65535"));
+    }
+
+    TEST(JSONNumber, RejectedCharacter)
+    {
+        static const char* inputs[] = { "x", "\"x", "nx", "nuz", "\"0-" };
+
+        // A number never takes more than it is given, whichever character it stops at.
+        for (const char* input : inputs) {
+            Core::JSON::DecUInt32 number;
+            Core::OptionalType<Core::JSON::Error> error;
+            const uint16_t length = static_cast<uint16_t>(strlen(input));
+            uint16_t offset = 0;
+
+            EXPECT_EQ(static_cast<Core::JSON::IElement&>(number).Deserialize(input, length, offset, error), length);
+            EXPECT_TRUE(error.IsSet());
+        }
+    }
+
+    TEST(JSONNumber, IntegerRoundTrip)
+    {
+        Core::JSON::DecSInt64 minimum(std::numeric_limits<int64_t>::min(), true);
+        Core::JSON::HexSInt32 hex(-255, true);
+        Core::JSON::OctUInt16 octal(8, true);
+        Core::JSON::DecSInt64 parsed;
+        Core::JSON::HexSInt32 parsedHex;
+        string text;
+
+        minimum.ToString(text);
+        EXPECT_STREQ(text.c_str(), _T("-9223372036854775808"));
+        EXPECT_STREQ(Chunked(minimum, 3).c_str(), _T("-9223372036854775808"));
+        EXPECT_TRUE(parsed.FromString(text));
+        EXPECT_EQ(parsed.Value(), std::numeric_limits<int64_t>::min());
+
+        EXPECT_STREQ(Chunked(hex, 2).c_str(), _T("\"-0xFF\""));
+        EXPECT_TRUE(parsedHex.FromString(_T("\"-0xFF\"")));
+        EXPECT_EQ(parsedHex.Value(), -255);
+
+        octal.ToString(text);
+        EXPECT_STREQ(text.c_str(), _T("\"010\""));
+    }
+
+    TEST(JSONNumber, FloatFormatting)
+    {
+        EXPECT_STREQ(Chunked(Core::JSON::Double(0.1, true), 64).c_str(), _T("0.1"));
+        EXPECT_STREQ(Chunked(Core::JSON::Double(-2.5, true), 64).c_str(), _T("-2.5"));
+        EXPECT_STREQ(Chunked(Core::JSON::Double(1e300, true), 64).c_str(), _T("1e+300"));
+        EXPECT_STREQ(Chunked(Core::JSON::Double(123456789.0, true), 64).c_str(), _T("123456789"));
+        EXPECT_STREQ(Chunked(Core::JSON::Double(-0.0, true), 64).c_str(), _T("-0"));
+        EXPECT_STREQ(Chunked(Core::JSON::Float(0.1f, true), 64).c_str(), _T("0.1"));
+        EXPECT_STREQ(Chunked(Core::JSON::Double(std::numeric_limits<double>::quiet_NaN(), true), 64).c_str(), _T("null"));
+        EXPECT_STREQ(Chunked(Core::JSON::Double(0.30000000000000004, true), 3).c_str(), _T("0.30000000000000004"));
+        // What does not read back with 15 digits, is written with 17.
+        EXPECT_STREQ(Chunked(Core::JSON::Double(0.7999999999999999, true), 64).c_str(), _T("0.79999999999999993"));
+        EXPECT_STREQ(Chunked(Core::JSON::Float(5592405.5f, true), 64).c_str(), _T("5592405.5"));
+
+        // Every double must read back exactly.
+        const double samples[] = { 5e-324, 2.2250738585072014e-308, 1.7976931348623157e308, 3.141592653589793, 1.0 / 3.0, 123.456e-7 };
+        for (const double sample : samples) {
+            Core::JSON::Double element(sample, true);
+            Core::JSON::Double parsed;
+            string text;
+
+            element.ToString(text);
+            EXPECT_TRUE(parsed.FromString(text));
+            EXPECT_EQ(parsed.Value(), sample) << text;
+        }
+    }
+
+    TEST(JSONNumber, FloatParsing)
+    {
+        Core::JSON::Double value;
+        Core::JSON::Float single;
+
+        EXPECT_TRUE(value.FromString(_T("1.5e3")));
+        EXPECT_EQ(value.Value(), 1500.0);
+        EXPECT_TRUE(value.FromString(_T("-0.000123")));
+        EXPECT_EQ(value.Value(), -0.000123);
+        EXPECT_TRUE(value.FromString(_T("\"2E-2\"")));
+        EXPECT_EQ(value.Value(), 0.02);
+        EXPECT_TRUE(value.FromString(_T("12345678901234567890123")));
+        EXPECT_EQ(value.Value(), 12345678901234567890123.0);
+        EXPECT_TRUE(value.FromString(_T("null")));
+        EXPECT_TRUE(value.IsNull());
+        EXPECT_TRUE(single.FromString(_T("3.4028235e38")));
+        EXPECT_EQ(single.Value(), std::numeric_limits<float>::max());
+
+        EXPECT_FALSE(value.FromString(_T("1.5e")));
+        EXPECT_FALSE(value.FromString(_T("-")));
+        EXPECT_FALSE(value.FromString(_T("1.2.3")));
+        EXPECT_FALSE(value.FromString(_T("0x10")));
+    }
+
+    TEST(JSONNumber, FloatInContainer)
+    {
+        Core::JSON::ArrayType<Core::JSON::Double> list;
+        string text;
+
+        EXPECT_TRUE(list.FromString(_T("[1,-2.25,3e-5, 4 ,null]")));
+        ASSERT_EQ(list.Length(), 5u);
+        EXPECT_EQ(list[2].Value(), 3e-5);
+        EXPECT_TRUE(list[4].IsNull());
+
+        list.ToString(text);
+        EXPECT_STREQ(text.c_str(), _T("[1,-2.25,3e-05,4,null]"));
+    }
+
+    TEST(JSONNumber, FloatMessagePack)
+    {
+        Core::JSON::Double element(-1.25, true);
+        Core::JSON::Double parsed;
+        Core::JSON::Float single;
+        uint8_t buffer[16];
+        uint16_t offset = 0;
+
+        const uint16_t length = static_cast<const Core::JSON::IMessagePack&>(element).Serialize(buffer, sizeof(buffer), offset);
+        EXPECT_EQ(length, 9u);
+        EXPECT_EQ(buffer[0], 0xCB);
+
+        // Byte by byte.
+        for (uint16_t index = 0; index < length; index++) {
+            static_cast<Core::JSON::IMessagePack&>(parsed).Deserialize(&(buffer[index]), 1, offset);
+        }
+        EXPECT_EQ(offset, 0u);
+        EXPECT_EQ(parsed.Value(), -1.25);
+
+        // Integers are accepted as well.
+        const uint8_t integer[] = { 0xD1, 0xFF, 0x38 };
+        static_cast<Core::JSON::IMessagePack&>(single).Deserialize(integer, sizeof(integer), offset);
+        EXPECT_EQ(single.Value(), -200.0f);
+    }
+
+    TEST(JSONNumber, LargeArray)
+    {
+        static constexpr uint32_t Elements = 100000;
+
+        Core::JSON::ArrayType<Core::JSON::Double> doubles;
+        Core::JSON::ArrayType<Core::JSON::Double> parsed;
+        string doubleText;
+
+        for (uint32_t index = 0; index < Elements; index++) {
+            doubles.Add() = (static_cast<double>(index) * 1.0000001) / 7.0;
+        }
+
+        doubles.ToString(doubleText);
+
+        // FromString is limited to 64KB, feed the text the way a channel would.
+        Core::OptionalType<Core::JSON::Error> error;
+        uint32_t handled = 0;
+        uint16_t offset = 0;
+
+        do {
+            const uint16_t size = static_cast<uint16_t>(std::min(static_cast<size_t>(4096), doubleText.length() + 1 - handled));
+            handled += static_cast<Core::JSON::IElement&>(parsed).Deserialize(&(doubleText[handled]), size, offset, error);
+        } while ((offset != 0) && (error.IsSet() == false));
+
+        EXPECT_FALSE(error.IsSet());
+
+        // Length() is 16 bits, count the elements instead.
+        Core::JSON::ArrayType<Core::JSON::Double>::Iterator index(parsed.Elements());
+        uint32_t count = 0;
+        bool exact = true;
+
+        while (index.Next() == true) {
+            exact = exact && (index.Current().Value() == ((static_cast<double>(count) * 1.0000001) / 7.0));
+            count++;
+        }
+        EXPECT_EQ(count, Elements);
+        EXPECT_TRUE(exact);
+    }
+
+} // Tests
+} // WPEFramework
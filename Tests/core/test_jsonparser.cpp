@@ -768,6 +768,28 @@ namespace Tests {
         ExecutePrimitiveJsonTest<Core::JSON::EnumType<JSONTestEnum>>(data, false, nullptr);
     }
 
+    TEST(JSONParser, EmptyContainer)
+    {
+        // A container with members takes an object without any of them.
+        const std::string key("key");
+        PrimitiveJson<Core::JSON::String> test{};
+        test.Init(key);
+        Execute(test, "{}", true);
+        Execute(test, "{ }", true);
+        Execute(test, "{,}", false);
+        Execute(test, "{:}", false);
+    }
+
+    TEST(JSONParser, UnknownKey)
+    {
+        // The value of a key that is not known, is not taken for the key that follows.
+        const std::string key("key");
+        PrimitiveJson<Core::JSON::String> test{};
+        test.Init(key);
+        Execute(test, "{\"unknown\":\"key\",\"key\":\"value\"}", true);
+        EXPECT_EQ(string{ "value" }, test.Value().Value());
+    }
+
 } // Tests
 
 ENUM_CONVERSION_BEGIN(Tests::JSONTestEnum){ WPEFramework::Tests::JSONTestEnum::ONE, _TXT("one") },
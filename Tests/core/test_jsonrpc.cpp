@@ -0,0 +1,523 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2020 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <thread>
+
+#include <core/core.h>
+
+namespace WPEFramework {
+namespace Tests {
+
+    typedef Core::ProxyType<const Core::JSONRPC::Notification::Frame> NotificationFrame;
+
+    // Packs an element the way the channel does, in chunks of the given size.
+    static void Pack(const Core::JSON::IMessagePack& element, std::vector<uint8_t>& stream, const uint16_t chunk)
+    {
+        uint8_t buffer[256];
+        uint16_t offset = 0;
+        uint16_t loaded;
+
+        stream.clear();
+
+        do {
+            loaded = element.Serialize(buffer, chunk, offset);
+            stream.insert(stream.end(), buffer, buffer + loaded);
+        } while (offset != 0);
+    }
+
+    // Writes an element the way the channel does, in chunks of the given size.
+    static void Write(const Core::JSON::IElement& element, string& text, const uint16_t chunk)
+    {
+        char buffer[256];
+        uint16_t offset = 0;
+        uint16_t loaded;
+
+        text.clear();
+
+        do {
+            loaded = element.Serialize(buffer, chunk, offset);
+            text.append(buffer, loaded);
+        } while (offset != 0);
+    }
+
+    static void Expect(const string& designator, const string& event, const string& parameters)
+    {
+        Core::JSONRPC::Message message;
+        Core::JSONRPC::Notification notification;
+        NotificationFrame frame(Core::ProxyType<Core::JSONRPC::Notification::Frame>::Create(event, parameters));
+        std::vector<uint8_t> expectedPacked;
+        std::vector<uint8_t> packed;
+        string expected;
+        string text;
+
+        message.JSONRPC = Core::JSONRPC::Message::DefaultVersion;
+        message.Designator = (designator.empty() ? event : designator + '.' + event);
+        if (parameters.empty() == false) {
+            message.Parameters = parameters;
+        }
+
+        notification.Set(designator, frame);
+
+        message.ToString(expected);
+        notification.ToString(text);
+        EXPECT_STREQ(text.c_str(), expected.c_str());
+
+        Write(notification, text, 3);
+        EXPECT_STREQ(text.c_str(), expected.c_str());
+
+        Pack(message, expectedPacked, 200);
+        Pack(notification, packed, 200);
+        EXPECT_EQ(packed, expectedPacked);
+
+        Pack(notification, packed, 2);
+        EXPECT_EQ(packed, expectedPacked);
+    }
+
+    TEST(JSONRPCNotification, MatchesMessage)
+    {
+        Expect(_T("client.events"), _T("statechange"), _T("{\"callsign\":\"Monitor\",\"state\":\"activated\"}"));
+        Expect(_T(""), _T("all"), _T("[1,2,{\"a\":null}]"));
+        Expect(_T("client"), _T("ping"), _T(""));
+        Expect(_T("quo\"ted"), _T("event"), _T("\"text\""));
+        Expect(string(40, 'x'), _T("longer"), _T("{\"value\":1.5}"));
+        Expect(string(300, 'y'), _T("longest"), _T("true"));
+    }
+
+    TEST(JSONRPCNotification, ControlCharacters)
+    {
+        NotificationFrame frame(Core::ProxyType<Core::JSONRPC::Notification::Frame>::Create(_T("con\x01trol\t"), _T("1")));
+        Core::JSONRPC::Notification notification;
+        string text;
+
+        notification.Set(_T("line\nfeed"), frame);
+        notification.ToString(text);
+
+        EXPECT_STREQ(text.c_str(), _T("{\"jsonrpc\":\"2.0\",\"method\":\"line\\nfeed.con\\u0001trol\\t\",\"params\":1}"));
+    }
+
+    TEST(JSONRPCNotification, PooledReuse)
+    {
+        Core::ProxyPoolType<Core::JSONRPC::Notification> pool(1);
+        NotificationFrame frame(Core::ProxyType<Core::JSONRPC::Notification::Frame>::Create(_T("event"), _T("{\"x\":1}")));
+        string text;
+
+        {
+            Core::ProxyType<Core::JSONRPC::Notification> first(pool.Element());
+            first->Set(_T("a.b"), frame);
+            first->ToString(text);
+            EXPECT_STREQ(text.c_str(), _T("{\"jsonrpc\":\"2.0\",\"method\":\"a.b.event\",\"params\":{\"x\":1}}"));
+        }
+
+        // Returning to the pool drops the reference on the shared frame.
+        EXPECT_EQ(frame.Release(), static_cast<uint32_t>(Core::ERROR_DESTRUCTION_SUCCEEDED));
+
+        Core::ProxyType<Core::JSONRPC::Notification> second(pool.Element());
+        EXPECT_FALSE(second->IsSet());
+    }
+
+    TEST(JSONRPCNotification, HandlerSharesFrame)
+    {
+        std::vector<std::pair<uint32_t, string>> sent;
+        std::vector<NotificationFrame> frames;
+        Core::JSONRPC::Handler* self = nullptr;
+
+        Core::JSONRPC::Handler handler(
+            [&](const uint32_t id, const string& designator, const NotificationFrame& frame) {
+                sent.emplace_back(id, designator);
+                frames.push_back(frame);
+
+                // Dispatching happens outside the handler lock, so this must not deadlock.
+                if (id == 2) {
+                    Core::JSONRPC::Message response;
+                    self->Unsubscribe(id, _T("tick"), designator, response);
+                    EXPECT_TRUE(response.Result.IsSet());
+                }
+            },
+            { 1 });
+
+        self = &handler;
+
+        Core::JSONRPC::Message response;
+        handler.Subscribe(1, _T("tick"), _T("first"), response);
+        handler.Subscribe(2, _T("tick"), _T("second"), response);
+        handler.Subscribe(3, _T("tick"), _T("third"), response);
+
+        Core::JSON::DecUInt32 value(42);
+
+        EXPECT_EQ(handler.Notify(_T("tick"), value), Core::ERROR_NONE);
+        ASSERT_EQ(sent.size(), 3u);
+        EXPECT_EQ(sent[0].first, 1u);
+        EXPECT_STREQ(sent[2].second.c_str(), _T("third"));
+        EXPECT_EQ(frames[0], frames[1]);
+        EXPECT_EQ(frames[1], frames[2]);
+        EXPECT_STREQ(frames[0]->Parameters().c_str(), _T("42"));
+
+        sent.clear();
+        frames.clear();
+
+        EXPECT_EQ(handler.Notify(_T("tick"), value, [](const string& designator) { return (designator != _T("first")); }), Core::ERROR_NONE);
+        ASSERT_EQ(sent.size(), 1u);
+        EXPECT_EQ(sent[0].first, 3u);
+
+        EXPECT_EQ(handler.Notify(_T("tock"), value), Core::ERROR_UNKNOWN_KEY);
+    }
+
+    TEST(JSONRPCNotification, TextFunction)
+    {
+        std::vector<std::pair<string, string>> sent;
+
+        // The designator includes the event, as before the frame was shared.
+        Core::JSONRPC::Handler handler(
+            [&](const uint32_t, const string& designator, const string& parameters) {
+                sent.emplace_back(designator, parameters);
+            },
+            { 1 });
+
+        Core::JSONRPC::Message response;
+        handler.Subscribe(1, _T("tick"), _T("client.events"), response);
+        handler.Subscribe(2, _T("tick"), _T(""), response);
+
+        Core::JSON::DecUInt32 value(42);
+
+        EXPECT_EQ(handler.Notify(_T("tick"), value), Core::ERROR_NONE);
+        ASSERT_EQ(sent.size(), 2u);
+        EXPECT_STREQ(sent[0].first.c_str(), _T("client.events.tick"));
+        EXPECT_STREQ(sent[0].second.c_str(), _T("42"));
+        EXPECT_STREQ(sent[1].first.c_str(), _T("tick"));
+    }
+
+    // Reads an element the way the channel does, in chunks of the given size.
+    static bool Read(Core::JSON::IElement& element, const string& text, const uint16_t chunk)
+    {
+        Core::OptionalType<Core::JSON::Error> error;
+        uint16_t offset = 0;
+        size_t position = 0;
+
+        do {
+            const uint16_t size = static_cast<uint16_t>(std::min(text.length() - position, static_cast<size_t>(chunk)));
+            position += element.Deserialize(&(text[position]), size, offset, error);
+        } while ((offset != 0) && (position < text.length()) && (error.IsSet() == false));
+
+        return ((offset == 0) && (error.IsSet() == false));
+    }
+
+    static const TCHAR BatchText[] = _T("[{\"jsonrpc\":\"2.0\",\"id\":1,\"method\":\"Controller.1.status@Monitor\"}, ")
+                                     _T("{\"jsonrpc\":\"2.0\",\"method\":\"DeviceInfo.1.ping\",\"params\":[1,\"x\"]},")
+                                     _T("\n {\"jsonrpc\":\"2.0\",\"id\":3,\"method\":\"DeviceInfo.1.systeminfo\",\"params\":{\"a\":[2]}} ]");
+
+    static void ExpectBatch(const Core::JSONRPC::Batch& batch)
+    {
+        ASSERT_EQ(batch.Length(), 3u);
+        EXPECT_EQ(batch.Elements()[0]->Id.Value(), 1u);
+        EXPECT_STREQ(batch.Elements()[0]->Designator.Value().c_str(), _T("Controller.1.status@Monitor"));
+        EXPECT_FALSE(batch.Elements()[1]->Id.IsSet());
+        EXPECT_STREQ(batch.Elements()[1]->Parameters.Value().c_str(), _T("[1,\"x\"]"));
+        EXPECT_EQ(batch.Elements()[2]->Id.Value(), 3u);
+        EXPECT_STREQ(batch.Elements()[2]->Parameters.Value().c_str(), _T("{\"a\":[2]}"));
+    }
+
+    TEST(JSONRPCBatch, Text)
+    {
+        const string input(BatchText);
+        Core::JSONRPC::Batch batch;
+
+        EXPECT_TRUE(Core::JSONRPC::Batch::IsBatch(reinterpret_cast<const uint8_t*>(input.c_str()), static_cast<uint16_t>(input.length()), false));
+        EXPECT_FALSE(Core::JSONRPC::Batch::IsBatch(reinterpret_cast<const uint8_t*>(_T(" {}")), 3, false));
+
+        for (const uint16_t chunk : { 1024, 7, 1 }) {
+            EXPECT_TRUE(Read(batch, input, chunk));
+            ExpectBatch(batch);
+        }
+
+        // What is written, reads back the same, also when written in small pieces.
+        string text;
+        string expected;
+
+        Write(batch, expected, 1024);
+        Write(batch, text, 5);
+        EXPECT_STREQ(text.c_str(), expected.c_str());
+
+        Core::JSONRPC::Batch check;
+        EXPECT_TRUE(Read(check, text, 1024));
+        ExpectBatch(check);
+    }
+
+    TEST(JSONRPCBatch, MessagePack)
+    {
+        const string input(BatchText);
+        Core::JSONRPC::Batch batch;
+        Core::JSONRPC::Batch check;
+        std::vector<uint8_t> packed;
+        std::vector<uint8_t> chunked;
+
+        ASSERT_TRUE(Read(batch, input, 1024));
+
+        Pack(batch, packed, 200);
+        Pack(batch, chunked, 3);
+        EXPECT_EQ(packed, chunked);
+        EXPECT_TRUE(Core::JSONRPC::Batch::IsBatch(packed.data(), static_cast<uint16_t>(packed.size()), true));
+
+        uint16_t offset = 0;
+        uint16_t position = 0;
+
+        while (position < packed.size()) {
+            const uint16_t size = std::min(static_cast<uint16_t>(packed.size() - position), static_cast<uint16_t>(4));
+            position += static_cast<Core::JSON::IMessagePack&>(check).Deserialize(&(packed[position]), size, offset);
+        }
+
+        EXPECT_EQ(offset, 0u);
+        ExpectBatch(check);
+    }
+
+    TEST(JSONRPCBatch, Invalid)
+    {
+        Core::JSONRPC::Batch batch;
+
+        EXPECT_TRUE(Read(batch, _T("[ ]"), 1024));
+        EXPECT_EQ(batch.Length(), 0u);
+
+        EXPECT_FALSE(Read(batch, _T("{\"id\":1}"), 1024));
+        EXPECT_FALSE(Read(batch, _T("[{\"id\":1} {\"id\":2}]"), 1024));
+        EXPECT_FALSE(Read(batch, _T("[{\"id\":1},]"), 1024));
+        EXPECT_FALSE(Read(batch, _T("[1,2]"), 1024));
+
+        // A batch that fails to parse is not handed out half filled.
+        EXPECT_FALSE(batch.FromString(_T("[{\"id\":1},{\"id\"")));
+        EXPECT_EQ(batch.Length(), 0u);
+    }
+
+    TEST(JSONRPCBatch, Oversized)
+    {
+        // More requests than a 16 bit count holds, a batch has to see that it is too long.
+        static constexpr uint32_t Requests = 65600;
+
+        const string request(_T("{\"jsonrpc\":\"2.0\",\"id\":1,\"method\":\"a.b\",\"params\":{\"x\":[1,{\"y\":\"a,b\"}]}}"));
+        string text(_T("["));
+        Core::JSONRPC::Batch batch;
+
+        for (uint32_t index = 0; index < Requests; index++) {
+            text += (index == 0 ? _T("") : _T(",")) + request;
+        }
+        text += _T("]");
+
+        batch.Limit(64);
+
+        // The whole batch is taken, so nothing of it is read as the next message.
+        Core::OptionalType<Core::JSON::Error> error;
+        uint16_t offset = 0;
+        size_t position = 0;
+
+        do {
+            const uint16_t size = static_cast<uint16_t>(std::min(text.length() - position, static_cast<size_t>(1024)));
+            position += batch.Deserialize(&(text[position]), size, offset, error);
+        } while ((offset != 0) && (position < text.length()) && (error.IsSet() == false));
+
+        EXPECT_EQ(offset, 0u);
+        EXPECT_EQ(position, text.length());
+        EXPECT_FALSE(error.IsSet());
+        EXPECT_TRUE(batch.IsOversized());
+        EXPECT_EQ(batch.Length(), 0u);
+
+        // Within the limit, all of them are there.
+        batch.Limit(~0);
+        EXPECT_TRUE(Read(batch, text, 1024));
+        EXPECT_FALSE(batch.IsOversized());
+        EXPECT_EQ(batch.Length(), Requests);
+
+        // Packed, the count is known up front and nothing is unpacked.
+        std::vector<uint8_t> packed;
+        Core::JSONRPC::Batch check;
+        uint16_t packedOffset = 0;
+        size_t packedPosition = 0;
+
+        Core::JSON::IMessagePack::ToBuffer(packed, static_cast<const Core::JSON::IMessagePack&>(batch));
+
+        check.Limit(64);
+
+        do {
+            const uint16_t size = static_cast<uint16_t>(std::min(packed.size() - packedPosition, static_cast<size_t>(0xFFFF)));
+            packedPosition += static_cast<Core::JSON::IMessagePack&>(check).Deserialize(&(packed[packedPosition]), size, packedOffset);
+        } while ((packedOffset != 0) && (packedPosition < packed.size()));
+
+        EXPECT_EQ(packedPosition, packed.size());
+        EXPECT_TRUE(check.IsOversized());
+        EXPECT_EQ(check.Length(), 0u);
+    }
+
+    static void ExpectDesignator(const string& designator, const TCHAR callsign[], const uint8_t version, const TCHAR method[], const TCHAR index[])
+    {
+        const Core::JSONRPC::DesignatorFragments fragments(designator);
+
+        EXPECT_STREQ(fragments.Callsign().Text().c_str(), callsign) << designator;
+        EXPECT_EQ(fragments.Version(), version) << designator;
+        EXPECT_STREQ(fragments.Method().Text().c_str(), method) << designator;
+        EXPECT_STREQ(fragments.Index().Text().c_str(), index) << designator;
+    }
+
+    TEST(JSONRPCHandler, DesignatorFragments)
+    {
+        ExpectDesignator(_T("Controller.1.status@Monitor"), _T("Controller"), 1, _T("status"), _T("Monitor"));
+        ExpectDesignator(_T("Controller.status"), _T("Controller"), static_cast<uint8_t>(~0), _T("status"), _T(""));
+        ExpectDesignator(_T("Some.Plugin.12.method"), _T("Some.Plugin"), 12, _T("method"), _T(""));
+        ExpectDesignator(_T("2.method@a.b"), _T(""), 2, _T("method"), _T("a.b"));
+        ExpectDesignator(_T("method"), _T(""), static_cast<uint8_t>(~0), _T("method"), _T(""));
+        ExpectDesignator(_T(".method"), _T(""), static_cast<uint8_t>(~0), _T("method"), _T(""));
+        ExpectDesignator(_T(""), _T(""), static_cast<uint8_t>(~0), _T(""), _T(""));
+
+        // A callsign ending in digits is not a version.
+        ExpectDesignator(_T("Plugin1.method"), _T("Plugin1"), static_cast<uint8_t>(~0), _T("method"), _T(""));
+
+        // Agrees with the (copying) helpers on Message.
+        for (const TCHAR* text : { _T("Controller.1.status@Monitor"), _T("Some.Plugin.12.method"), _T("2.method@x"), _T("method") }) {
+            const string designator(text);
+            const Core::JSONRPC::DesignatorFragments fragments(designator);
+
+            EXPECT_EQ(fragments.Callsign().Text(), Core::JSONRPC::Message::Callsign(designator));
+            EXPECT_EQ(fragments.Version(), Core::JSONRPC::Message::Version(designator));
+            EXPECT_EQ(fragments.Method().Text(), Core::JSONRPC::Message::Method(designator));
+            EXPECT_EQ(fragments.Index().Text(), Core::JSONRPC::Message::Index(designator));
+        }
+    }
+
+    TEST(JSONRPCHandler, DispatchTable)
+    {
+        Core::JSONRPC::Handler handler([](const uint32_t, const string&, const NotificationFrame&) {}, { 1 });
+        Core::JSONRPC::Connection connection(1, 1);
+        string response;
+
+        // Enough methods to have the table grow a few times.
+        for (uint32_t index = 0; index < 100; index++) {
+            const string name(_T("method") + Core::NumberType<uint32_t>(index).Text());
+
+            handler.Register(name, [index](const string& method, const string& parameters, string& result) -> uint32_t {
+                result = Core::NumberType<uint32_t>(index).Text() + ':' + method + ':' + parameters;
+                return (Core::ERROR_NONE);
+            });
+        }
+
+        EXPECT_EQ(handler.Invoke(connection, _T("Test.1.method42@key"), _T("{}"), response), Core::ERROR_NONE);
+        EXPECT_STREQ(response.c_str(), _T("42:Test.1.method42@key:{}"));
+        EXPECT_EQ(handler.Invoke(connection, _T("method7"), _T(""), response), Core::ERROR_NONE);
+        EXPECT_STREQ(response.c_str(), _T("7:method7:"));
+        EXPECT_EQ(handler.Invoke(connection, _T("method100"), _T(""), response), Core::ERROR_UNKNOWN_KEY);
+        EXPECT_TRUE(response.empty());
+
+        EXPECT_EQ(handler.Exists(_T("method99")), Core::ERROR_NONE);
+        handler.Unregister(_T("method99"));
+        EXPECT_EQ(handler.Exists(_T("method99")), Core::ERROR_UNKNOWN_KEY);
+        EXPECT_EQ(handler.Invoke(connection, _T("method99"), _T(""), response), Core::ERROR_UNKNOWN_KEY);
+
+        // A method may (un)register methods while it is being invoked, it keeps running on the table
+        // it was found in.
+        handler.Register(_T("swap"), [&handler](const string&, const string&, string& result) -> uint32_t {
+            handler.Unregister(_T("swap"));
+            handler.Register(_T("swapped"), [](const string&, const string&, string& result) -> uint32_t {
+                result = _T("done");
+                return (Core::ERROR_NONE);
+            });
+            result = _T("swapping");
+            return (Core::ERROR_NONE);
+        });
+
+        EXPECT_EQ(handler.Invoke(connection, _T("swap"), _T(""), response), Core::ERROR_NONE);
+        EXPECT_STREQ(response.c_str(), _T("swapping"));
+        EXPECT_EQ(handler.Invoke(connection, _T("swap"), _T(""), response), Core::ERROR_UNKNOWN_KEY);
+        EXPECT_EQ(handler.Invoke(connection, _T("swapped"), _T(""), response), Core::ERROR_NONE);
+        EXPECT_STREQ(response.c_str(), _T("done"));
+    }
+
+    TEST(JSONRPCHandler, AsynchronousMethod)
+    {
+        Core::JSONRPC::Handler handler([](const uint32_t, const string&, const NotificationFrame&) {}, { 1 });
+        Core::JSONRPC::Connection token(0, 0);
+        string response;
+        bool asynchronous = true;
+
+        handler.Register(_T("sync"), [](const string&, const string&, string& result) -> uint32_t {
+            result = _T("now");
+            return (Core::ERROR_NONE);
+        });
+        handler.Register(_T("async"), Core::JSONRPC::CallbackFunction([&token](const Core::JSONRPC::Connection& connection, const string&) {
+            token = connection;
+        }));
+
+        EXPECT_EQ(handler.Exists(Core::TextFragment(_T("sync")), asynchronous), Core::ERROR_NONE);
+        EXPECT_FALSE(asynchronous);
+        EXPECT_EQ(handler.Exists(Core::TextFragment(_T("async")), asynchronous), Core::ERROR_NONE);
+        EXPECT_TRUE(asynchronous);
+        EXPECT_EQ(handler.Exists(Core::TextFragment(_T("none")), asynchronous), Core::ERROR_UNKNOWN_KEY);
+        EXPECT_FALSE(asynchronous);
+
+        // Returns without an answer, the connection it got is what it answers with later on.
+        EXPECT_EQ(handler.Invoke(Core::JSONRPC::Connection(7, 42), _T("Test.1.async"), _T("{}"), response), static_cast<uint32_t>(~0));
+        EXPECT_TRUE(response.empty());
+        EXPECT_EQ(token.ChannelId(), 7u);
+        EXPECT_EQ(token.Sequence(), 42u);
+    }
+
+    TEST(JSONRPCHandler, ConcurrentRegistration)
+    {
+        Core::JSONRPC::Handler handler([](const uint32_t, const string&, const NotificationFrame&) {}, { 1 });
+        std::atomic<bool> running(true);
+        std::atomic<uint32_t> failures(0);
+
+        handler.Register(_T("stable"), [](const string&, const string&, string& result) -> uint32_t {
+            result = _T("ok");
+            return (Core::ERROR_NONE);
+        });
+
+        std::vector<std::thread> readers;
+
+        for (uint8_t index = 0; index < 4; index++) {
+            readers.emplace_back([&]() {
+                Core::JSONRPC::Connection connection(1, 1);
+                string response;
+
+                while (running == true) {
+                    if ((handler.Invoke(connection, _T("Test.1.stable"), _T(""), response) != Core::ERROR_NONE) || (response != _T("ok"))) {
+                        failures++;
+                    }
+                }
+            });
+        }
+
+        for (uint32_t index = 0; index < 500; index++) {
+            const string name(_T("volatile") + Core::NumberType<uint32_t>(index % 10).Text());
+
+            if (handler.Exists(name) == Core::ERROR_NONE) {
+                handler.Unregister(name);
+            } else {
+                handler.Register(name, [](const string&, const string&, string&) -> uint32_t { return (Core::ERROR_NONE); });
+            }
+        }
+
+        running = false;
+
+        for (std::thread& reader : readers) {
+            reader.join();
+        }
+
+        EXPECT_EQ(failures, 0u);
+    }
+
+} // Tests
+} // WPEFramework
@@ -0,0 +1,187 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2020 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include <core/core.h>
+#include <websocket/websocket.h>
+
+namespace WPEFramework {
+namespace Tests {
+
+    typedef JSONRPC::LinkType<Core::JSON::IElement> Link;
+    typedef Link::FutureType<Core::JSON::VariantContainer> Future;
+
+    // Points the links created while it exists to the given node, what was set before is put back after.
+    class Access {
+    public:
+        Access() = delete;
+        Access(const Access&) = delete;
+        Access& operator=(const Access&) = delete;
+
+        Access(const TCHAR node[])
+            : _previous()
+            , _set(Core::SystemInfo::GetEnvironment(_T("THUNDER_ACCESS"), _previous))
+        {
+            Core::SystemInfo::SetEnvironment(_T("THUNDER_ACCESS"), node);
+        }
+        ~Access()
+        {
+            Core::SystemInfo::SetEnvironment(_T("THUNDER_ACCESS"), (_set == true ? _previous.c_str() : nullptr));
+        }
+
+    private:
+        string _previous;
+        bool _set;
+    };
+
+    // Answers every call with its own parameters.
+    class EchoServer : public Web::WebSocketLinkType<Core::SocketStream, Web::Request, Web::Response, Web::WebSocket::RequestAllocator&> {
+    private:
+        typedef Web::WebSocketLinkType<Core::SocketStream, Web::Request, Web::Response, Web::WebSocket::RequestAllocator&> BaseClass;
+
+    public:
+        EchoServer(const EchoServer&) = delete;
+        EchoServer& operator=(const EchoServer&) = delete;
+
+        EchoServer(const SOCKET& connector, const Core::NodeId& remoteId, Core::SocketServerType<EchoServer>*)
+            : BaseClass(false, false, 2, Web::WebSocket::RequestAllocator::Instance(), false, connector, remoteId, 1024, 1024)
+            , _lock()
+            , _outbound()
+        {
+        }
+        ~EchoServer() override
+        {
+            Close(Core::infinite);
+        }
+
+    public:
+        void LinkBody(Core::ProxyType<Web::Request>&) override
+        {
+        }
+        void Received(Core::ProxyType<Web::Request>&) override
+        {
+        }
+        void Send(const Core::ProxyType<Web::Response>&) override
+        {
+        }
+        uint16_t SendData(uint8_t* dataFrame, const uint16_t maxSendSize) override
+        {
+            _lock.Lock();
+
+            const uint16_t length = static_cast<uint16_t>(std::min(_outbound.length(), static_cast<size_t>(maxSendSize)));
+
+            ::memcpy(dataFrame, _outbound.c_str(), length);
+            _outbound.erase(0, length);
+
+            _lock.Unlock();
+
+            return (length);
+        }
+        uint16_t ReceiveData(uint8_t* dataFrame, const uint16_t receivedSize) override
+        {
+            Core::JSONRPC::Message request;
+            Core::JSONRPC::Message response;
+            string answer;
+
+            request.FromString(string(reinterpret_cast<const char*>(dataFrame), receivedSize));
+
+            response.Id = request.Id.Value();
+            response.Result = request.Parameters.Value();
+            response.ToString(answer);
+
+            _lock.Lock();
+            _outbound += answer;
+            _lock.Unlock();
+
+            Trigger();
+
+            return (receivedSize);
+        }
+        void StateChange() override
+        {
+        }
+        bool IsIdle() const override
+        {
+            return (true);
+        }
+
+    private:
+        Core::CriticalSection _lock;
+        string _outbound;
+    };
+
+    TEST(JSONRPCLink, Response)
+    {
+        const Core::NodeId node(_T("127.0.0.1"), 31743);
+        Core::SocketServerType<EchoServer> server(node);
+
+        ASSERT_EQ(server.Open(Core::infinite), static_cast<uint32_t>(Core::ERROR_NONE));
+
+        {
+            Access access(_T("127.0.0.1:31743"));
+            Link link(_T("Dummy.1"));
+            Core::JSON::VariantContainer parameters;
+
+            parameters[_T("value")] = Core::JSON::Variant(42);
+
+            Future future(link.Request<Core::JSON::VariantContainer, Core::JSON::VariantContainer>(2000, _T("method"), parameters));
+
+            ASSERT_TRUE(future.IsValid());
+            ASSERT_EQ(future.Wait(3000), static_cast<uint32_t>(Core::ERROR_NONE));
+            EXPECT_TRUE(future.IsReady());
+            EXPECT_EQ(future.Response()[_T("value")].Number(), 42);
+        }
+
+        server.Close(Core::infinite);
+        server.Cleanup();
+    }
+
+    TEST(JSONRPCLink, PendingRequests)
+    {
+        // Nothing listens there, every call that could be issued is in flight until it expires.
+        Access access(_T("127.0.0.1:1"));
+
+        Link link(_T("Dummy.1"));
+        Core::JSON::VariantContainer parameters;
+        std::vector<Future> futures;
+
+        for (uint32_t index = 0; index < 70; index++) {
+            futures.push_back(link.Request<Core::JSON::VariantContainer, Core::JSON::VariantContainer>(100, _T("method"), parameters));
+        }
+
+        // The pending table has 64 slots, the first call beyond that waited for a slot to come free and was
+        // issued synchronously, so it completed before Request() returned. By then the expired calls gave
+        // their slots back to the ones after it.
+        EXPECT_TRUE(futures[64].IsReady());
+
+        for (uint32_t index = 0; index < futures.size(); index++) {
+            ASSERT_TRUE(futures[index].IsValid());
+            EXPECT_EQ(futures[index].Wait(2000), static_cast<uint32_t>(Core::ERROR_TIMEDOUT)) << index;
+            EXPECT_TRUE(futures[index].IsReady());
+        }
+
+        // Expired calls gave their slots back.
+        Future future(link.Request<void, Core::JSON::VariantContainer>(50, _T("method")));
+
+        EXPECT_EQ(future.Wait(2000), static_cast<uint32_t>(Core::ERROR_TIMEDOUT));
+    }
+
+} // Tests
+} // WPEFramework
@@ -0,0 +1,294 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2020 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include "JSON.h"
+
+namespace WPEFramework {
+namespace Tests {
+
+    enum class StaticTestState {
+        IDLE,
+        RUNNING
+    };
+
+    // Reflective layout, as emitted by the JsonGenerator without --static-parser.
+    class ReflectiveEntry : public Core::JSON::Container {
+    public:
+        ReflectiveEntry()
+            : Core::JSON::Container()
+        {
+            Add(_T("name"), &Name);
+            Add(_T("id"), &Id);
+            Add(_T("active"), &Active);
+        }
+        ReflectiveEntry(const ReflectiveEntry& copy)
+            : Core::JSON::Container()
+            , Name(copy.Name)
+            , Id(copy.Id)
+            , Active(copy.Active)
+        {
+            Add(_T("name"), &Name);
+            Add(_T("id"), &Id);
+            Add(_T("active"), &Active);
+        }
+        ReflectiveEntry& operator=(const ReflectiveEntry& rhs)
+        {
+            Name = rhs.Name;
+            Id = rhs.Id;
+            Active = rhs.Active;
+            return (*this);
+        }
+
+    public:
+        Core::JSON::String Name;
+        Core::JSON::DecUInt32 Id;
+        Core::JSON::Boolean Active;
+    };
+
+    class ReflectiveInfo : public Core::JSON::Container {
+    public:
+        ReflectiveInfo(const ReflectiveInfo&) = delete;
+        ReflectiveInfo& operator=(const ReflectiveInfo&) = delete;
+
+        ReflectiveInfo()
+            : Core::JSON::Container()
+        {
+            Add(_T("callsign"), &Callsign);
+            Add(_T("offset"), &Offset);
+            Add(_T("mask"), &Mask);
+            Add(_T("state"), &State);
+            Add(_T("main"), &Main);
+            Add(_T("entries"), &Entries);
+        }
+
+    public:
+        Core::JSON::String Callsign;
+        Core::JSON::DecSInt64 Offset;
+        Core::JSON::HexUInt32 Mask;
+        Core::JSON::EnumType<StaticTestState> State;
+        ReflectiveEntry Main;
+        Core::JSON::ArrayType<ReflectiveEntry> Entries;
+    };
+
+    // Same layout, as emitted by the JsonGenerator with --static-parser.
+    class StaticEntry : public ReflectiveEntry {
+    public:
+        using Core::JSON::Container::FromString;
+        using Core::JSON::Container::ToString;
+
+        bool FromString(const string& text)
+        {
+            return (Core::JSON::Reader::FromString(text, *this));
+        }
+
+        bool ToString(string& text) const
+        {
+            return (Core::JSON::Writer::ToString(*this, text));
+        }
+
+        bool FromJSON(Core::JSON::Reader& reader)
+        {
+            bool result = reader.Begin();
+            while ((result == true) && (reader.Next() == true)) {
+                switch (reader.Hash()) {
+                case Core::JSON::Hash(_T("name")):
+                    result = reader.Value(_T("name"), Name);
+                    break;
+                case Core::JSON::Hash(_T("id")):
+                    result = reader.Value(_T("id"), Id);
+                    break;
+                case Core::JSON::Hash(_T("active")):
+                    result = reader.Value(_T("active"), Active);
+                    break;
+                default:
+                    result = reader.Skip();
+                    break;
+                }
+            }
+            return ((result == true) && (reader.End() == true));
+        }
+
+        void ToJSON(Core::JSON::Writer& writer) const
+        {
+            writer.Begin();
+            writer.Value(_T("name"), Name);
+            writer.Value(_T("id"), Id);
+            writer.Value(_T("active"), Active);
+            writer.End();
+        }
+    };
+
+    class StaticInfo : public Core::JSON::Container {
+    public:
+        StaticInfo(const StaticInfo&) = delete;
+        StaticInfo& operator=(const StaticInfo&) = delete;
+
+        StaticInfo()
+            : Core::JSON::Container()
+        {
+            Add(_T("callsign"), &Callsign);
+            Add(_T("offset"), &Offset);
+            Add(_T("mask"), &Mask);
+            Add(_T("state"), &State);
+            Add(_T("main"), &Main);
+            Add(_T("entries"), &Entries);
+        }
+
+        using Core::JSON::Container::FromString;
+        using Core::JSON::Container::ToString;
+
+        bool FromString(const string& text)
+        {
+            return (Core::JSON::Reader::FromString(text, *this));
+        }
+
+        bool ToString(string& text) const
+        {
+            return (Core::JSON::Writer::ToString(*this, text));
+        }
+
+        bool FromJSON(Core::JSON::Reader& reader)
+        {
+            bool result = reader.Begin();
+            while ((result == true) && (reader.Next() == true)) {
+                switch (reader.Hash()) {
+                case Core::JSON::Hash(_T("callsign")):
+                    result = reader.Value(_T("callsign"), Callsign);
+                    break;
+                case Core::JSON::Hash(_T("offset")):
+                    result = reader.Value(_T("offset"), Offset);
+                    break;
+                case Core::JSON::Hash(_T("mask")):
+                    result = reader.Value(_T("mask"), Mask);
+                    break;
+                case Core::JSON::Hash(_T("state")):
+                    result = reader.Value(_T("state"), State);
+                    break;
+                case Core::JSON::Hash(_T("main")):
+                    result = reader.Value(_T("main"), Main);
+                    break;
+                case Core::JSON::Hash(_T("entries")):
+                    result = reader.Value(_T("entries"), Entries);
+                    break;
+                default:
+                    result = reader.Skip();
+                    break;
+                }
+            }
+            return ((result == true) && (reader.End() == true));
+        }
+
+        void ToJSON(Core::JSON::Writer& writer) const
+        {
+            writer.Begin();
+            writer.Value(_T("callsign"), Callsign);
+            writer.Value(_T("offset"), Offset);
+            writer.Value(_T("mask"), Mask);
+            writer.Value(_T("state"), State);
+            writer.Value(_T("main"), Main);
+            writer.Value(_T("entries"), Entries);
+            writer.End();
+        }
+
+    public:
+        Core::JSON::String Callsign;
+        Core::JSON::DecSInt64 Offset;
+        Core::JSON::HexUInt32 Mask;
+        Core::JSON::EnumType<StaticTestState> State;
+        StaticEntry Main;
+        Core::JSON::ArrayType<StaticEntry> Entries;
+    };
+
+    static const string StaticTestInput = _T("{\"callsign\":\"Some\\\"Plugin\",\"offset\":-1234567,\"mask\":\"0xFF00\",")
+                                          _T("\"state\":\"running\",\"unknown\":{\"a\":[1,2,{\"b\":null}],\"c\":\"d\"},")
+                                          _T("\"main\":{\"name\":\"first\",\"id\":1,\"active\":true},")
+                                          _T("\"entries\":[{\"name\":\"second\",\"id\":2,\"active\":false},{\"name\":\"third\",\"id\":3}]}");
+
+    TEST(JSONStatic, HashIsCompileTime)
+    {
+        static_assert(Core::JSON::Hash(_T("callsign")) != Core::JSON::Hash(_T("offset")), "Distinct labels should hash differently");
+
+        EXPECT_EQ(Core::JSON::Hash(_T("")), 0x811C9DC5u);
+        EXPECT_EQ(Core::JSON::Hash(_T("a")), 0xE40C292Cu);
+    }
+
+    TEST(JSONStatic, ParseMatchesReflective)
+    {
+        ReflectiveInfo reflective;
+        StaticInfo fast;
+
+        EXPECT_TRUE(reflective.FromString(StaticTestInput));
+        EXPECT_TRUE(fast.FromString(StaticTestInput));
+
+        EXPECT_STREQ(fast.Callsign.Value().c_str(), reflective.Callsign.Value().c_str());
+        EXPECT_STREQ(fast.Callsign.Value().c_str(), _T("Some\"Plugin"));
+        EXPECT_EQ(fast.Offset.Value(), -1234567);
+        EXPECT_EQ(fast.Mask.Value(), 0xFF00u);
+        EXPECT_EQ(fast.State.Value(), StaticTestState::RUNNING);
+        EXPECT_STREQ(fast.Main.Name.Value().c_str(), _T("first"));
+        EXPECT_TRUE(fast.Main.Active.Value());
+        ASSERT_EQ(fast.Entries.Length(), reflective.Entries.Length());
+        ASSERT_EQ(fast.Entries.Length(), 2u);
+        EXPECT_EQ(fast.Entries[1].Id.Value(), 3u);
+        EXPECT_FALSE(fast.Entries[1].Active.IsSet());
+    }
+
+    TEST(JSONStatic, SerializeMatchesReflective)
+    {
+        ReflectiveInfo reflective;
+        StaticInfo fast;
+        string reflectiveText;
+        string fastText;
+
+        EXPECT_TRUE(reflective.FromString(StaticTestInput));
+        EXPECT_TRUE(fast.FromString(StaticTestInput));
+
+        reflective.ToString(reflectiveText);
+        fast.ToString(fastText);
+
+        EXPECT_STREQ(fastText.c_str(), reflectiveText.c_str());
+
+        // Whatever one side produces, the other side must accept.
+        ReflectiveInfo check;
+        EXPECT_TRUE(check.FromString(fastText));
+        EXPECT_EQ(check.Offset.Value(), -1234567);
+        EXPECT_STREQ(check.Entries[0].Name.Value().c_str(), _T("second"));
+    }
+
+    TEST(JSONStatic, NonCanonicalInputFallsBack)
+    {
+        StaticInfo fast;
+
+        // Whitespace, unquoted strings and quoted numbers are handled by the reflective parser.
+        EXPECT_TRUE(fast.FromString(_T(" { \"offset\" : \"-12\" ,\n \"mask\":65280, \"main\" : { \"id\" : 7 } } ")));
+        EXPECT_EQ(fast.Offset.Value(), -12);
+        EXPECT_EQ(fast.Mask.Value(), 0xFF00u);
+        EXPECT_EQ(fast.Main.Id.Value(), 7u);
+    }
+
+} // Tests
+
+ENUM_CONVERSION_BEGIN(Tests::StaticTestState)
+    { WPEFramework::Tests::StaticTestState::IDLE, _TXT("idle") },
+    { WPEFramework::Tests::StaticTestState::RUNNING, _TXT("running") },
+    ENUM_CONVERSION_END(Tests::StaticTestState)
+
+} // WPEFramework
@@ -0,0 +1,137 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2020 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include <core/core.h>
+#include <websocket/websocket.h>
+
+namespace WPEFramework {
+namespace Tests {
+
+    // Stands in for the ISecurity the security provider hands out.
+    class Officer {
+    public:
+        Officer(const Officer&) = delete;
+        Officer& operator=(const Officer&) = delete;
+
+        Officer()
+            : _references(1)
+        {
+        }
+        ~Officer()
+        {
+        }
+
+    public:
+        void AddRef() const
+        {
+            _references++;
+        }
+        uint32_t Release() const
+        {
+            _references--;
+            return (Core::ERROR_NONE);
+        }
+        uint32_t References() const
+        {
+            return (_references);
+        }
+
+    private:
+        mutable uint32_t _references;
+    };
+
+    static string Token(const Web::JSONWebToken& signer, const string& user, const int64_t lifetime)
+    {
+        string token;
+        string payload(_T("{\"user\":\"") + user + _T("\""));
+
+        if (lifetime != 0) {
+            payload += _T(",\"exp\":") + Core::NumberType<uint64_t>(static_cast<uint64_t>(::time(nullptr) + lifetime)).Text();
+        }
+        payload += '}';
+
+        signer.Encode(token, static_cast<uint16_t>(payload.length()), reinterpret_cast<const uint8_t*>(payload.c_str()));
+
+        return (token);
+    }
+
+    TEST(JSONWebToken, VerifiedTokens)
+    {
+        const uint8_t key[] = { 's', 'e', 'c', 'r', 'e', 't' };
+        Web::JSONWebToken signer(Web::JSONWebToken::SHA256, sizeof(key), key);
+        Web::VerifiedTokensType<Officer> tokens(2, 300);
+        Officer first, second, third;
+        uint32_t hits, misses, entries;
+
+        const string alice(Token(signer, _T("alice"), 60));
+        const string bob(Token(signer, _T("bob"), 0));
+        const string carol(Token(signer, _T("carol"), 60));
+        const string expired(Token(signer, _T("dave"), -60));
+
+        const uint64_t now = Core::Time::Now().Ticks();
+
+        EXPECT_GT(Web::JSONWebToken::Expiry(alice), now);
+        EXPECT_LE(Web::JSONWebToken::Expiry(alice), now + (61 * 1000 * Core::Time::TicksPerMillisecond));
+        EXPECT_EQ(Web::JSONWebToken::Expiry(bob), 0u);
+        EXPECT_LT(Web::JSONWebToken::Expiry(expired), now);
+
+        EXPECT_EQ(tokens.Find(alice), nullptr);
+
+        tokens.Add(alice, &first);
+        EXPECT_EQ(first.References(), 2u);
+
+        Officer* found = tokens.Find(alice);
+        EXPECT_EQ(found, &first);
+        EXPECT_EQ(first.References(), 3u);
+        found->Release();
+
+        // Only a token that is still valid is remembered.
+        tokens.Add(expired, &second);
+        EXPECT_EQ(second.References(), 1u);
+        EXPECT_EQ(tokens.Find(expired), nullptr);
+
+        // Bob is the least recently used once alice is looked up again, so carol takes his place.
+        tokens.Add(bob, &second);
+        found = tokens.Find(alice);
+        found->Release();
+        tokens.Add(carol, &third);
+
+        EXPECT_EQ(tokens.Find(bob), nullptr);
+        EXPECT_EQ(second.References(), 1u);
+
+        found = tokens.Find(carol);
+        EXPECT_EQ(found, &third);
+        found->Release();
+
+        tokens.Statistics(hits, misses, entries);
+        EXPECT_EQ(hits, 3u);
+        EXPECT_EQ(misses, 3u);
+        EXPECT_EQ(entries, 2u);
+
+        // A new key, nothing verified with the old one is trusted anymore.
+        tokens.Clear();
+        EXPECT_EQ(tokens.Find(alice), nullptr);
+        EXPECT_EQ(first.References(), 1u);
+        EXPECT_EQ(third.References(), 1u);
+    }
+
+} // Tests
+} // WPEFramework
@@ -0,0 +1,90 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2020 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <core/core.h>
+
+namespace WPEFramework {
+namespace Tests {
+
+    TEST(Histogram, Buckets)
+    {
+        typedef Core::HistogramType<8> Histogram;
+
+        EXPECT_EQ(Histogram::Bucket(0), 0);
+        EXPECT_EQ(Histogram::Bucket(1), 1);
+        EXPECT_EQ(Histogram::Bucket(2), 2);
+        EXPECT_EQ(Histogram::Bucket(3), 2);
+        EXPECT_EQ(Histogram::Bucket(4), 3);
+        EXPECT_EQ(Histogram::Bucket(63), 6);
+        EXPECT_EQ(Histogram::Bucket(64), 7);
+        EXPECT_EQ(Histogram::Bucket(~0u), 7);
+
+        EXPECT_EQ(Histogram::Limit(0), 1u);
+        EXPECT_EQ(Histogram::Limit(6), 64u);
+
+        Histogram histogram;
+
+        histogram.Add(0);
+        histogram.Add(3);
+        histogram.Add(3);
+        histogram.Add(1000);
+
+        EXPECT_EQ(histogram.Count(), 4u);
+        EXPECT_EQ(histogram.Total(), 1006u);
+        EXPECT_EQ(histogram.Max(), 1000u);
+        EXPECT_EQ(histogram.Average(), 251u);
+        EXPECT_EQ(histogram[0], 1u);
+        EXPECT_EQ(histogram[2], 2u);
+        EXPECT_EQ(histogram[7], 1u);
+    }
+
+    TEST(Histogram, Concurrent)
+    {
+        Core::HistogramType<16> histogram;
+        std::vector<std::thread> threads;
+
+        for (uint32_t thread = 0; thread < 4; thread++) {
+            threads.emplace_back([&histogram, thread]() {
+                for (uint32_t index = 0; index < 10000; index++) {
+                    histogram.Add((index % 100) + thread);
+                }
+            });
+        }
+        for (std::thread& thread : threads) {
+            thread.join();
+        }
+
+        uint32_t counted = 0;
+        for (uint8_t bucket = 0; bucket < histogram.Buckets(); bucket++) {
+            counted += histogram[bucket];
+        }
+
+        EXPECT_EQ(histogram.Count(), 40000u);
+        EXPECT_EQ(counted, 40000u);
+        EXPECT_EQ(histogram.Max(), 102u);
+        EXPECT_EQ(histogram.Total(), 4u * 495000u + (0u + 1u + 2u + 3u) * 10000u);
+    }
+
+} // Tests
+} // WPEFramework
@@ -0,0 +1,182 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2020 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include <core/core.h>
+
+namespace WPEFramework {
+namespace Tests {
+
+    // Packs a message the way the channel does, in chunks of the given size.
+    static void Pack(const Core::JSONRPC::Message& message, std::vector<uint8_t>& stream, const uint16_t chunk)
+    {
+        uint8_t buffer[1024];
+        uint16_t offset = 0;
+        uint16_t loaded;
+
+        ASSERT(chunk <= sizeof(buffer));
+
+        stream.clear();
+
+        do {
+            loaded = static_cast<const Core::JSON::IMessagePack&>(message).Serialize(buffer, chunk, offset);
+            stream.insert(stream.end(), buffer, buffer + loaded);
+        } while (offset != 0);
+    }
+
+    // Unpacks a message the way the channel does, in chunks of the given size.
+    static uint32_t Unpack(const std::vector<uint8_t>& stream, Core::JSONRPC::Message& message, const uint16_t chunk)
+    {
+        uint32_t handled = 0;
+        uint16_t offset = 0;
+
+        do {
+            const uint16_t size = static_cast<uint16_t>(std::min(static_cast<size_t>(chunk), stream.size() - handled));
+            handled += static_cast<Core::JSON::IMessagePack&>(message).Deserialize(&(stream[handled]), size, offset);
+        } while ((offset != 0) && (handled < stream.size()));
+
+        return (handled);
+    }
+
+    TEST(MessagePack, TranscodeValues)
+    {
+        const string input = _T("{\"a\":1,\"b\":-200,\"c\":[true,false,null],\"d\":\"te\\\"xt\",\"e\":{},\"f\":1.5,\"g\":18446744073709551615}");
+        std::vector<uint8_t> stream;
+        string output;
+
+        EXPECT_TRUE(Core::JSON::MessagePack::FromJSON(input, stream));
+        EXPECT_EQ(Core::JSON::MessagePack::Length(stream.data(), static_cast<uint32_t>(stream.size())), stream.size());
+        EXPECT_EQ(Core::JSON::MessagePack::Length(stream.data(), static_cast<uint32_t>(stream.size() - 1)), 0u);
+        EXPECT_EQ(Core::JSON::MessagePack::ToJSON(stream.data(), static_cast<uint32_t>(stream.size()), output), stream.size());
+        EXPECT_STREQ(output.c_str(), input.c_str());
+
+        stream.clear();
+        EXPECT_TRUE(Core::JSON::MessagePack::FromJSON(_T("\"\\u00e9\\ud83d\\ude00\""), stream));
+        EXPECT_EQ(stream.size(), 7u);
+        EXPECT_EQ(stream[0], 0xA6);
+
+        stream.clear();
+        EXPECT_FALSE(Core::JSON::MessagePack::FromJSON(_T("{\"a\":}"), stream));
+        EXPECT_TRUE(stream.empty());
+    }
+
+    TEST(MessagePack, TranscodeBinary)
+    {
+        const uint8_t small[] = { 0xC4, 0x03, 0x01, 0x02, 0x03 };
+        string output;
+
+        EXPECT_EQ(Core::JSON::MessagePack::ToJSON(small, sizeof(small), output), sizeof(small));
+        EXPECT_STREQ(output.c_str(), _T("\"AQID\""));
+
+        // A bin 32 beyond 0xFFFF bytes is encoded as a whole.
+        const uint32_t length = 70000;
+        std::vector<uint8_t> stream = { 0xC6, 0x00, 0x01, 0x11, 0x70 };
+        string expected(1, '\"');
+
+        for (uint32_t index = 0; index < length; index++) {
+            stream.push_back(static_cast<uint8_t>(index * 7));
+        }
+
+        Core::ToString(&(stream[5]), 0xFFFF, true, expected);
+        Core::ToString(&(stream[5 + 0xFFFF]), static_cast<uint16_t>(length - 0xFFFF), true, expected);
+        expected += '\"';
+
+        EXPECT_EQ(Core::JSON::MessagePack::ToJSON(stream.data(), static_cast<uint32_t>(stream.size()), output), stream.size());
+        EXPECT_EQ(output.length(), 2 + (4 * ((length + 2) / 3)));
+        EXPECT_EQ(output, expected);
+    }
+
+    TEST(MessagePack, JSONRPCRequestInterop)
+    {
+        const string text = _T("{\"jsonrpc\":\"2.0\",\"id\":42,\"method\":\"Controller.1.activate\",\"params\":{\"callsign\":\"Monitor\",\"retries\":[1,2,300]}}");
+
+        Core::JSONRPC::Message original;
+        Core::JSONRPC::Message received;
+        std::vector<uint8_t> stream;
+        string result;
+
+        EXPECT_TRUE(original.FromString(text));
+
+        // Small chunks force the partial (re)assembly paths.
+        Pack(original, stream, 7);
+        EXPECT_EQ(Unpack(stream, received, 5), stream.size());
+
+        EXPECT_EQ(received.Id.Value(), 42u);
+        EXPECT_STREQ(received.Designator.Value().c_str(), _T("Controller.1.activate"));
+        EXPECT_STREQ(received.Parameters.Value().c_str(), original.Parameters.Value().c_str());
+
+        received.ToString(result);
+        EXPECT_STREQ(result.c_str(), text.c_str());
+
+        // The encoding is smaller than the text.
+        EXPECT_LT(stream.size(), text.length());
+    }
+
+    TEST(MessagePack, JSONRPCNativeParameters)
+    {
+        // Hand packed by a client: {"jsonrpc":"2.0","id":1,"method":"a.b","params":{"x":-1}}
+        const uint8_t request[] = { 0x84,
+            0xA7, 'j', 's', 'o', 'n', 'r', 'p', 'c', 0xA3, '2', '.', '0',
+            0xA2, 'i', 'd', 0x01,
+            0xA6, 'm', 'e', 't', 'h', 'o', 'd', 0xA3, 'a', '.', 'b',
+            0xA6, 'p', 'a', 'r', 'a', 'm', 's', 0x81, 0xA1, 'x', 0xFF };
+
+        const std::vector<uint8_t> stream(request, request + sizeof(request));
+        Core::JSONRPC::Message message;
+
+        EXPECT_EQ(Unpack(stream, message, sizeof(request)), sizeof(request));
+        EXPECT_EQ(message.Id.Value(), 1u);
+        EXPECT_STREQ(message.Parameters.Value().c_str(), _T("{\"x\":-1}"));
+    }
+
+    TEST(MessagePack, JSONRPCResponseInterop)
+    {
+        Core::JSONRPC::Message response;
+        Core::JSONRPC::Message received;
+        std::vector<uint8_t> stream;
+
+        response.JSONRPC = Core::JSONRPC::Message::DefaultVersion;
+        response.Id = 7;
+        response.Error.SetError(Core::ERROR_UNKNOWN_KEY);
+        response.Error.Text = _T("Unknown method.");
+
+        Pack(response, stream, sizeof(uint8_t) * 64);
+
+        // Two messages in one frame should be split correctly.
+        std::vector<uint8_t> twice(stream);
+        twice.insert(twice.end(), stream.begin(), stream.end());
+
+        EXPECT_EQ(Unpack(twice, received, static_cast<uint16_t>(twice.size())), stream.size());
+        EXPECT_EQ(received.Id.Value(), 7u);
+        EXPECT_EQ(received.Error.Code.Value(), -32601);
+        EXPECT_STREQ(received.Error.Text.Value().c_str(), _T("Unknown method."));
+        EXPECT_FALSE(received.Result.IsSet());
+
+        received.Clear();
+        response.Error.Clear();
+        response.Result = _T("[\"a\",{\"b\":null}]");
+        Pack(response, stream, 3);
+        EXPECT_EQ(Unpack(stream, received, 2), stream.size());
+        EXPECT_STREQ(received.Result.Value().c_str(), _T("[\"a\",{\"b\":null}]"));
+        EXPECT_FALSE(received.Error.IsSet());
+    }
+
+} // Tests
+} // WPEFramework
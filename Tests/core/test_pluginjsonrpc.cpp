@@ -0,0 +1,422 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2020 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include <core/core.h>
+#include <plugins/plugins.h>
+
+namespace WPEFramework {
+namespace Tests {
+
+    // Collects what a plugin sends, all else it is not asked for.
+    class Shell : public PluginHost::IShell {
+    public:
+        Shell(const Shell&) = delete;
+        Shell& operator=(const Shell&) = delete;
+
+        Shell()
+            : _lock()
+            , _sent(false, true)
+            , _replies()
+        {
+        }
+        ~Shell() override
+        {
+        }
+
+    public:
+        BEGIN_INTERFACE_MAP(Shell)
+        INTERFACE_ENTRY(PluginHost::IShell)
+        END_INTERFACE_MAP
+
+        // Waits for the next reply and hands out the channel, id and error code of it.
+        bool Reply(uint32_t& channelId, uint32_t& id, uint32_t& code, const uint32_t waitTime = 2000)
+        {
+            bool result = false;
+
+            _lock.Lock();
+
+            if (_replies.empty() == true) {
+                _sent.ResetEvent();
+                _lock.Unlock();
+                _sent.Lock(waitTime);
+                _lock.Lock();
+            }
+
+            if (_replies.empty() == false) {
+                Core::ProxyType<Core::JSONRPC::Message> message(Core::proxy_cast<Core::JSONRPC::Message>(_replies.front().second));
+
+                channelId = _replies.front().first;
+                id = message->Id.Value();
+                code = (message->Error.IsSet() == true ? message->Error.Code.Value() : Core::ERROR_NONE);
+                _replies.pop_front();
+                result = true;
+            }
+
+            _lock.Unlock();
+
+            return (result);
+        }
+
+        uint32_t Submit(const uint32_t id, const Core::ProxyType<Core::JSON::IElement>& response) override
+        {
+            _lock.Lock();
+            _replies.emplace_back(id, response);
+            _sent.SetEvent();
+            _lock.Unlock();
+
+            return (Core::ERROR_NONE);
+        }
+        string Callsign() const override
+        {
+            return (_T("Test"));
+        }
+
+        void EnableWebServer(const string&, const string&) override {}
+        void DisableWebServer() override {}
+        string Version() const override { return (string()); }
+        string Model() const override { return (string()); }
+        bool Background() const override { return (false); }
+        string Accessor() const override { return (string()); }
+        string WebPrefix() const override { return (string()); }
+        string Locator() const override { return (string()); }
+        string ClassName() const override { return (string()); }
+        string Versions() const override { return (string()); }
+        string PersistentPath() const override { return (string()); }
+        string VolatilePath() const override { return (string()); }
+        string DataPath() const override { return (string()); }
+        string ProxyStubPath() const override { return (string()); }
+        string ConfigSubstitution(const string& input) const override { return (input); }
+        bool AutoStart() const override { return (false); }
+        bool Resumed() const override { return (false); }
+        string HashKey() const override { return (string()); }
+        string ConfigLine() const override { return (string()); }
+        bool IsSupported(const uint8_t) const override { return (true); }
+        PluginHost::ISubSystem* SubSystems() override { return (nullptr); }
+        void Notify(const string&) override {}
+        void Register(PluginHost::IPlugin::INotification*) override {}
+        void Unregister(PluginHost::IPlugin::INotification*) override {}
+        state State() const override { return (ACTIVATED); }
+        void* QueryInterfaceByCallsign(const uint32_t, const string&) override { return (nullptr); }
+        uint32_t Activate(const reason) override { return (Core::ERROR_NONE); }
+        uint32_t Deactivate(const reason) override { return (Core::ERROR_NONE); }
+        reason Reason() const override { return (REQUESTED); }
+        ICOMLink* COMLink() override { return (nullptr); }
+
+    private:
+        Core::CriticalSection _lock;
+        Core::Event _sent;
+        std::list<std::pair<uint32_t, Core::ProxyType<Core::JSON::IElement>>> _replies;
+    };
+
+    class Dispatcher : public PluginHost::JSONRPC {
+    public:
+        Dispatcher(const Dispatcher&) = delete;
+        Dispatcher& operator=(const Dispatcher&) = delete;
+
+        Dispatcher()
+            : PluginHost::JSONRPC()
+            , Calls()
+            , Values()
+            , Reads(0)
+        {
+            Register(_T("async"), Core::JSONRPC::CallbackFunction([this](const Core::JSONRPC::Connection& connection, const string&) {
+                Calls.push_back(connection);
+            }));
+            Property<Core::JSON::DecUInt32>(_T("value"), &Dispatcher::Get, &Dispatcher::Set, this);
+            Register<Core::JSON::DecUInt32, Core::JSON::DecUInt32>(_T("double"), &Dispatcher::Double, this);
+        }
+        ~Dispatcher() override
+        {
+            Unregister(_T("double"));
+            Unregister(_T("value"));
+            Unregister(_T("async"));
+        }
+
+    public:
+        BEGIN_INTERFACE_MAP(Dispatcher)
+        INTERFACE_ENTRY(PluginHost::IDispatcher)
+        END_INTERFACE_MAP
+
+        // Returns if the call was answered right away.
+        bool Call(const uint32_t channelId, const uint32_t id, const string& method)
+        {
+            Core::JSONRPC::Message message;
+
+            message.Id = id;
+            message.Designator = _T("Test.1.") + method;
+
+            return (Invoke(channelId, message).IsValid());
+        }
+        string Result(const string& method, const string& parameters = string())
+        {
+            Core::JSONRPC::Message message;
+
+            message.Id = 1;
+            message.Designator = _T("Test.1.") + method;
+            if (parameters.empty() == false) {
+                message.Parameters = parameters;
+            }
+
+            Core::ProxyType<Core::JSONRPC::Message> response(Invoke(1, message));
+
+            return (response.IsValid() == true ? response->Result.Value() : string());
+        }
+
+    private:
+        uint32_t Get(const string& index, Core::JSON::DecUInt32& value) const
+        {
+            std::map<string, uint32_t>::const_iterator entry(Values.find(index));
+
+            value = (entry != Values.cend() ? entry->second : 0);
+            Reads++;
+
+            return (Core::ERROR_NONE);
+        }
+        uint32_t Set(const string& index, const Core::JSON::DecUInt32& value)
+        {
+            Values[index] = value.Value();
+
+            return (Core::ERROR_NONE);
+        }
+        uint32_t Double(const Core::JSON::DecUInt32& inbound, Core::JSON::DecUInt32& outbound)
+        {
+            outbound = inbound.Value() * 2;
+            Reads++;
+
+            return (Core::ERROR_NONE);
+        }
+
+    public:
+        std::vector<Core::JSONRPC::Connection> Calls;
+        std::map<string, uint32_t> Values;
+        mutable uint32_t Reads;
+    };
+
+    TEST(PluginJSONRPC, CompleteOnce)
+    {
+        Core::Sink<Shell> shell;
+        Core::Sink<Dispatcher> dispatcher;
+        PluginHost::IDispatcher& framework(dispatcher);
+        uint32_t channelId, id, code;
+
+        framework.Activate(&shell);
+
+        // The same id, from the same channel, is two calls.
+        EXPECT_FALSE(dispatcher.Call(1, 7, _T("async")));
+        EXPECT_FALSE(dispatcher.Call(1, 7, _T("async")));
+        ASSERT_EQ(dispatcher.Calls.size(), 2u);
+        EXPECT_TRUE(dispatcher.IsPending(dispatcher.Calls[0]));
+        EXPECT_TRUE(dispatcher.IsPending(dispatcher.Calls[1]));
+
+        EXPECT_EQ(dispatcher.Response(dispatcher.Calls[1], string(_T("1"))), Core::ERROR_NONE);
+        EXPECT_EQ(dispatcher.Response(dispatcher.Calls[1], string(_T("2"))), Core::ERROR_ALREADY_RELEASED);
+        EXPECT_TRUE(dispatcher.IsPending(dispatcher.Calls[0]));
+
+        ASSERT_TRUE(shell.Reply(channelId, id, code));
+        EXPECT_EQ(channelId, 1u);
+        EXPECT_EQ(id, 7u);
+        EXPECT_EQ(code, Core::ERROR_NONE);
+
+        EXPECT_EQ(dispatcher.Response(dispatcher.Calls[0], Core::JSONRPC::Error()), Core::ERROR_NONE);
+        ASSERT_TRUE(shell.Reply(channelId, id, code, 0));
+        EXPECT_EQ(id, 7u);
+        EXPECT_FALSE(shell.Reply(channelId, id, code, 0));
+
+        framework.Deactivate();
+    }
+
+    TEST(PluginJSONRPC, Timeout)
+    {
+        Core::WorkerPool pool(2, 0, 16);
+        Core::Sink<Shell> shell;
+        Core::Sink<Dispatcher> dispatcher;
+        PluginHost::IDispatcher& framework(dispatcher);
+        uint32_t channelId, id, code;
+
+        Core::IWorkerPool::Assign(&pool);
+
+        framework.Activate(&shell);
+
+        dispatcher.AsyncTimeout(60000);
+        EXPECT_FALSE(dispatcher.Call(1, 1, _T("async")));
+
+        // A shorter timeout expires before the one that was scheduled already.
+        dispatcher.AsyncTimeout(100);
+        EXPECT_FALSE(dispatcher.Call(2, 2, _T("async")));
+
+        ASSERT_TRUE(shell.Reply(channelId, id, code));
+        EXPECT_EQ(channelId, 2u);
+        EXPECT_EQ(id, 2u);
+        EXPECT_EQ(code, static_cast<uint32_t>(Core::ERROR_TIMEDOUT));
+
+        ASSERT_EQ(dispatcher.Calls.size(), 2u);
+        EXPECT_EQ(dispatcher.Response(dispatcher.Calls[1], string(_T("late"))), Core::ERROR_ALREADY_RELEASED);
+        EXPECT_TRUE(dispatcher.IsPending(dispatcher.Calls[0]));
+
+        framework.Deactivate();
+
+        Core::IWorkerPool::Assign(nullptr);
+    }
+
+    TEST(PluginJSONRPC, ChannelClosed)
+    {
+        Core::Sink<Shell> shell;
+        Core::Sink<Dispatcher> dispatcher;
+        PluginHost::IDispatcher& framework(dispatcher);
+        uint32_t channelId, id, code;
+
+        framework.Activate(&shell);
+
+        EXPECT_FALSE(dispatcher.Call(3, 1, _T("async")));
+        EXPECT_FALSE(dispatcher.Call(4, 1, _T("async")));
+        ASSERT_EQ(dispatcher.Calls.size(), 2u);
+
+        framework.Closed(3);
+
+        EXPECT_FALSE(dispatcher.IsPending(dispatcher.Calls[0]));
+        EXPECT_TRUE(dispatcher.IsPending(dispatcher.Calls[1]));
+        EXPECT_EQ(dispatcher.Response(dispatcher.Calls[0], string(_T("1"))), Core::ERROR_ALREADY_RELEASED);
+        EXPECT_FALSE(shell.Reply(channelId, id, code, 0));
+
+        EXPECT_EQ(dispatcher.Response(dispatcher.Calls[1], string(_T("1"))), Core::ERROR_NONE);
+        ASSERT_TRUE(shell.Reply(channelId, id, code, 0));
+        EXPECT_EQ(channelId, 4u);
+
+        framework.Deactivate();
+    }
+
+    TEST(PluginJSONRPC, CacheHit)
+    {
+        Core::Sink<Shell> shell;
+        Core::Sink<Dispatcher> dispatcher;
+        PluginHost::IDispatcher& framework(dispatcher);
+        uint32_t hits, misses, entries;
+
+        framework.Activate(&shell);
+
+        dispatcher.Cacheable(_T("value"), 60000);
+        dispatcher.Cacheable(_T("double"), 60000);
+
+        EXPECT_EQ(dispatcher.Result(_T("value@a")), _T("0"));
+        EXPECT_EQ(dispatcher.Result(_T("value@a")), _T("0"));
+        EXPECT_EQ(dispatcher.Reads, 1u);
+
+        // Every index is kept on its own.
+        EXPECT_EQ(dispatcher.Result(_T("value@b")), _T("0"));
+        EXPECT_EQ(dispatcher.Reads, 2u);
+
+        // A read with parameters is kept per parameters, and does not drop what is kept for other ones.
+        EXPECT_EQ(dispatcher.Result(_T("double"), _T("3")), _T("6"));
+        EXPECT_EQ(dispatcher.Result(_T("double"), _T("4")), _T("8"));
+        EXPECT_EQ(dispatcher.Result(_T("double"), _T("3")), _T("6"));
+        EXPECT_EQ(dispatcher.Reads, 4u);
+
+        // A set drops what is kept for every index of the property.
+        EXPECT_EQ(dispatcher.Result(_T("value@a"), _T("5")), _T(""));
+        EXPECT_EQ(dispatcher.Result(_T("value@a")), _T("5"));
+        EXPECT_EQ(dispatcher.Result(_T("value@b")), _T("0"));
+        EXPECT_EQ(dispatcher.Reads, 6u);
+
+        dispatcher.CacheStatistics(hits, misses, entries);
+        EXPECT_EQ(hits, 2u);
+        EXPECT_EQ(misses, 7u);
+        EXPECT_EQ(entries, 4u);
+
+        framework.Deactivate();
+    }
+
+    TEST(PluginJSONRPC, CacheExpiry)
+    {
+        Core::Sink<Shell> shell;
+        Core::Sink<Dispatcher> dispatcher;
+        PluginHost::IDispatcher& framework(dispatcher);
+
+        framework.Activate(&shell);
+
+        dispatcher.Cacheable(_T("value"), 50);
+
+        dispatcher.Result(_T("value@a"));
+        dispatcher.Result(_T("value@a"));
+        EXPECT_EQ(dispatcher.Reads, 1u);
+
+        SleepMs(100);
+
+        dispatcher.Result(_T("value@a"));
+        EXPECT_EQ(dispatcher.Reads, 2u);
+
+        framework.Deactivate();
+    }
+
+    TEST(PluginJSONRPC, CacheEvent)
+    {
+        Core::Sink<Shell> shell;
+        Core::Sink<Dispatcher> dispatcher;
+        PluginHost::IDispatcher& framework(dispatcher);
+
+        framework.Activate(&shell);
+
+        dispatcher.Cacheable(_T("value"), 60000, { _T("valuechanged") });
+
+        dispatcher.Result(_T("value@a"));
+        dispatcher.Notify(_T("otherchanged"));
+        dispatcher.Result(_T("value@a"));
+        EXPECT_EQ(dispatcher.Reads, 1u);
+
+        dispatcher.Notify(_T("valuechanged"));
+        dispatcher.Result(_T("value@a"));
+        EXPECT_EQ(dispatcher.Reads, 2u);
+
+        dispatcher.Invalidate(_T("value"));
+        dispatcher.Result(_T("value@a"));
+        EXPECT_EQ(dispatcher.Reads, 3u);
+
+        framework.Deactivate();
+    }
+
+    TEST(PluginJSONRPC, CacheLimit)
+    {
+        Core::Sink<Shell> shell;
+        Core::Sink<Dispatcher> dispatcher;
+        PluginHost::IDispatcher& framework(dispatcher);
+        const uint32_t limit = PluginHost::JSONRPC::MaxCacheEntries;
+        uint32_t hits, misses, entries;
+
+        framework.Activate(&shell);
+
+        dispatcher.Cacheable(_T("value"), 60000);
+
+        for (uint32_t index = 0; index < (limit + 4); index++) {
+            dispatcher.Result(_T("value@") + Core::NumberType<uint32_t>(index).Text());
+        }
+
+        dispatcher.CacheStatistics(hits, misses, entries);
+        EXPECT_EQ(entries, limit);
+
+        // What did not fit is read every time, what did is still kept.
+        dispatcher.Result(_T("value@") + Core::NumberType<uint32_t>(limit).Text());
+        dispatcher.Result(_T("value@0"));
+        EXPECT_EQ(dispatcher.Reads, limit + 5);
+
+        framework.Deactivate();
+    }
+
+} // Tests
+} // WPEFramework
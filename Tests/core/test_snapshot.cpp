@@ -0,0 +1,120 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2020 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include <core/core.h>
+
+namespace WPEFramework {
+namespace Tests {
+
+    class Counted {
+    public:
+        Counted() = delete;
+        Counted(const Counted&) = delete;
+        Counted& operator=(const Counted&) = delete;
+
+        Counted(const uint32_t value, uint32_t& alive)
+            : Value(value)
+            , _alive(alive)
+        {
+            _alive++;
+        }
+        ~Counted()
+        {
+            _alive--;
+        }
+
+    public:
+        const uint32_t Value;
+
+    private:
+        uint32_t& _alive;
+    };
+
+    TEST(Snapshot, BuildsOncePerBurst)
+    {
+        Core::CriticalSection lock;
+        uint32_t value = 0;
+        uint32_t builds = 0;
+        uint32_t alive = 0;
+
+        {
+            Core::SnapshotType<Counted> snapshot(lock, [&]() {
+                builds++;
+                return (new Counted(value, alive));
+            });
+
+            EXPECT_EQ(builds, 0u);
+
+            // Many changes, one build, by the first lookup after them.
+            for (uint32_t index = 0; index < 100; index++) {
+                lock.Lock();
+                value = index;
+                snapshot.Invalidate();
+                lock.Unlock();
+            }
+
+            {
+                Core::SnapshotType<Counted>::Reader reader(snapshot);
+                EXPECT_EQ(reader.Current().Value, 99u);
+            }
+            {
+                Core::SnapshotType<Counted>::Reader reader(snapshot);
+                EXPECT_EQ(reader.Current().Value, 99u);
+            }
+
+            EXPECT_EQ(builds, 1u);
+            EXPECT_EQ(alive, 1u);
+        }
+
+        EXPECT_EQ(alive, 0u);
+    }
+
+    TEST(Snapshot, ReaderKeepsReplacedCopy)
+    {
+        Core::CriticalSection lock;
+        uint32_t value = 1;
+        uint32_t alive = 0;
+
+        Core::SnapshotType<Counted> snapshot(lock, [&]() { return (new Counted(value, alive)); });
+
+        {
+            Core::SnapshotType<Counted>::Reader reader(snapshot);
+            const Counted& current(reader.Current());
+
+            lock.Lock();
+            value = 2;
+            snapshot.Publish();
+            lock.Unlock();
+
+            // Replaced, but still in use.
+            EXPECT_EQ(alive, 2u);
+            EXPECT_EQ(current.Value, 1u);
+        }
+
+        // The last reader leaving, deleted it.
+        EXPECT_EQ(alive, 1u);
+
+        Core::SnapshotType<Counted>::Reader reader(snapshot);
+        EXPECT_EQ(reader.Current().Value, 2u);
+    }
+
+} // Tests
+} // WPEFramework
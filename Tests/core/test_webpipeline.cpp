@@ -0,0 +1,180 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2020 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include <core/core.h>
+#include <websocket/websocket.h>
+
+namespace WPEFramework {
+namespace Tests {
+
+    class Token {
+    public:
+        Token() = delete;
+        Token(const Token&) = delete;
+        Token& operator=(const Token&) = delete;
+
+        Token(const uint32_t value)
+            : Value(value)
+        {
+        }
+        ~Token()
+        {
+        }
+
+    public:
+        const uint32_t Value;
+    };
+
+    // Records what the pipeline asks for, as the channel would do it.
+    class Pipeline : public Web::PipelineType<Token, Token> {
+    public:
+        Pipeline() = delete;
+        Pipeline(const Pipeline&) = delete;
+        Pipeline& operator=(const Pipeline&) = delete;
+
+        Pipeline(const uint16_t depth)
+            : Web::PipelineType<Token, Token>(depth, Core::ProxyType<Token>::Create(~0))
+            , Sent()
+            , Handled()
+            , Abandoned()
+            , Closed(0)
+        {
+        }
+        ~Pipeline() override
+        {
+            Clear();
+        }
+
+    public:
+        // A request with its job, the job carries the sequence of the request.
+        uint32_t Request()
+        {
+            const uint32_t sequence = Reserve(false, Core::OptionalType<uint32_t>());
+
+            Dispatch(sequence, Core::ProxyType<Token>::Create(sequence));
+
+            return (sequence);
+        }
+        void Respond(const uint32_t sequence)
+        {
+            EXPECT_TRUE(Answer(sequence, Core::ProxyType<Token>::Create(sequence)));
+
+            Release();
+        }
+
+    private:
+        void Send(const Core::ProxyType<Token>& response) override
+        {
+            Sent.push_back(response->Value);
+        }
+        void Handle(const Core::ProxyType<Token>& job) override
+        {
+            Handled.push_back(job->Value);
+        }
+        void Abandon(const Core::ProxyType<Token>& job) override
+        {
+            Abandoned.push_back(job->Value);
+        }
+        void Close() override
+        {
+            Closed++;
+        }
+
+    public:
+        std::vector<uint32_t> Sent;
+        std::vector<uint32_t> Handled;
+        std::vector<uint32_t> Abandoned;
+        uint32_t Closed;
+    };
+
+    TEST(WebPipeline, InOrder)
+    {
+        Pipeline pipeline(2);
+
+        for (uint32_t index = 0; index < 4; index++) {
+            EXPECT_EQ(pipeline.Request(), index);
+        }
+
+        // The first two are handled, the others wait till the pipeline moves.
+        EXPECT_EQ(pipeline.Handled, std::vector<uint32_t>({ 0, 1 }));
+
+        // Answered out of order, sent in order.
+        pipeline.Respond(1);
+        EXPECT_TRUE(pipeline.Sent.empty());
+
+        pipeline.Respond(0);
+        EXPECT_EQ(pipeline.Sent, std::vector<uint32_t>({ 0, 1 }));
+        EXPECT_EQ(pipeline.Handled, std::vector<uint32_t>({ 0, 1, 2, 3 }));
+
+        pipeline.Respond(3);
+        pipeline.Respond(2);
+        EXPECT_EQ(pipeline.Sent, std::vector<uint32_t>({ 0, 1, 2, 3 }));
+
+        EXPECT_TRUE(pipeline.Abandoned.empty());
+        EXPECT_EQ(pipeline.Closed, 0u);
+    }
+
+    TEST(WebPipeline, DepthLimit)
+    {
+        Pipeline pipeline(1);
+
+        EXPECT_EQ(pipeline.Request(), 0u);
+        EXPECT_EQ(pipeline.Request(), 1u);
+
+        // One is handled, one waits, the next one is rejected and what follows it is dropped.
+        EXPECT_EQ(pipeline.Request(), 2u);
+        EXPECT_EQ(pipeline.Request(), 3u);
+
+        EXPECT_EQ(pipeline.Handled, std::vector<uint32_t>({ 0 }));
+        EXPECT_EQ(pipeline.Abandoned, std::vector<uint32_t>({ 2, 3 }));
+        EXPECT_FALSE(pipeline.Answer(3, Core::ProxyType<Token>::Create(3)));
+
+        pipeline.Respond(0);
+        EXPECT_EQ(pipeline.Sent, std::vector<uint32_t>({ 0 }));
+        EXPECT_EQ(pipeline.Handled, std::vector<uint32_t>({ 0, 1 }));
+        EXPECT_EQ(pipeline.Closed, 0u);
+
+        // The rejection follows the last answer, then the connection closes.
+        pipeline.Respond(1);
+        EXPECT_EQ(pipeline.Sent, std::vector<uint32_t>({ 0, 1, static_cast<uint32_t>(~0) }));
+        EXPECT_EQ(pipeline.Closed, 1u);
+    }
+
+    TEST(WebPipeline, Unlimited)
+    {
+        Pipeline pipeline(0);
+
+        for (uint32_t index = 0; index < 100; index++) {
+            pipeline.Request();
+        }
+
+        EXPECT_EQ(pipeline.Handled.size(), 100u);
+        EXPECT_TRUE(pipeline.Abandoned.empty());
+
+        // Whatever is not answered when the connection is gone, is not sent anymore.
+        pipeline.Respond(1);
+        pipeline.Clear();
+        EXPECT_FALSE(pipeline.Answer(0, Core::ProxyType<Token>::Create(0)));
+        EXPECT_TRUE(pipeline.Sent.empty());
+    }
+
+} // Tests
+} // WPEFramework
@@ -0,0 +1,88 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2020 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include <core/core.h>
+#include <websocket/websocket.h>
+
+namespace WPEFramework {
+namespace Tests {
+
+    TEST(WebRouter, LongestMatch)
+    {
+        Web::RouterType<uint32_t> router(_T("./"));
+        uint32_t matched = 0;
+
+        router.Add(_T("/Service/Controller"), 1);
+        router.Add(_T("/Service/Foo"), 2);
+        router.Add(_T("/Service/Foo.Bar"), 3);
+        router.Add(_T("/Service/FooBar"), 4);
+        router.Add(_T("/jsonrpc/Foo"), 5);
+        router.Add(_T("/Service/Foo"), 6);
+        EXPECT_FALSE(router.IsCompiled());
+
+        router.Compile();
+        ASSERT_TRUE(router.IsCompiled());
+
+        const uint32_t* target = router.Find(Core::TextFragment(_T("/Service/Foo")), matched);
+        ASSERT_NE(target, nullptr);
+        EXPECT_EQ(*target, 2u);
+        EXPECT_EQ(matched, 12u);
+
+        // Whatever follows a separator is left to the target, a path that was added twice keeps its first target.
+        target = router.Find(Core::TextFragment(_T("/Service/Foo/Sub/Path")), matched);
+        ASSERT_NE(target, nullptr);
+        EXPECT_EQ(*target, 2u);
+        EXPECT_EQ(matched, 12u);
+
+        // The longest path that is followed by a separator.
+        target = router.Find(Core::TextFragment(_T("/Service/Foo.Bar.2/Sub")), matched);
+        ASSERT_NE(target, nullptr);
+        EXPECT_EQ(*target, 3u);
+        EXPECT_EQ(matched, 16u);
+
+        target = router.Find(Core::TextFragment(_T("/Service/Foo.Baz")), matched);
+        ASSERT_NE(target, nullptr);
+        EXPECT_EQ(*target, 2u);
+        EXPECT_EQ(matched, 12u);
+
+        target = router.Find(Core::TextFragment(_T("/Service/FooBar")), matched);
+        ASSERT_NE(target, nullptr);
+        EXPECT_EQ(*target, 4u);
+
+        target = router.Find(Core::TextFragment(_T("/jsonrpc/Foo")), matched);
+        ASSERT_NE(target, nullptr);
+        EXPECT_EQ(*target, 5u);
+
+        // Only as a whole or up to a separator.
+        EXPECT_EQ(router.Find(Core::TextFragment(_T("/Service/FooBa")), matched), nullptr);
+        EXPECT_EQ(router.Find(Core::TextFragment(_T("/Service/FooBarBaz")), matched), nullptr);
+        EXPECT_EQ(router.Find(Core::TextFragment(_T("/Service/Fo")), matched), nullptr);
+        EXPECT_EQ(router.Find(Core::TextFragment(_T("/Service")), matched), nullptr);
+        EXPECT_EQ(router.Find(Core::TextFragment(_T("/jsonrpc/Controller")), matched), nullptr);
+        EXPECT_EQ(router.Find(Core::TextFragment(_T("")), matched), nullptr);
+
+        Web::RouterType<uint32_t> empty(_T("/"));
+        empty.Compile();
+        EXPECT_EQ(empty.Find(Core::TextFragment(_T("/Service/Foo")), matched), nullptr);
+    }
+
+} // Tests
+} // WPEFramework
@@ -0,0 +1,656 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2020 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include <core/core.h>
+#include <websocket/websocket.h>
+
+namespace WPEFramework {
+namespace Tests {
+
+    class RequestReceiver : public Web::Request::Deserializer {
+    public:
+        RequestReceiver(const RequestReceiver&) = delete;
+        RequestReceiver& operator=(const RequestReceiver&) = delete;
+
+        RequestReceiver()
+            : Web::Request::Deserializer()
+            , Received()
+            , Body(Core::ProxyType<Web::TextBody>::Create())
+            , Count(0)
+        {
+        }
+        ~RequestReceiver()
+        {
+        }
+
+    public:
+        void Deserialized(Web::Request&) override
+        {
+            Count++;
+        }
+        Web::Request* Element() override
+        {
+            return (&Received);
+        }
+        bool LinkBody(Web::Request& request) override
+        {
+            request.Body(Body);
+            return (true);
+        }
+
+        Web::Request Received;
+        Core::ProxyType<Web::TextBody> Body;
+        uint32_t Count;
+    };
+
+    static const TCHAR Request[] = _T("POST /Service/Controller/Plugins?detail=true HTTP/1.1\r\n")
+                                   _T("host: 127.0.0.1:80\r\n")
+                                   _T("User-Agent: \"quoted agent\"\r\n")
+                                   _T("X-Unknown-Header: ignored\r\n")
+                                   _T("Connection: Upgrade\r\n")
+                                   _T("UPGRADE: websocket\r\n")
+                                   _T("Sec-WebSocket-Key: dGhlIHNhbXBsZSBub25jZQ==\r\n")
+                                   _T("Content-Type: application/json\r\n")
+                                   _T("Content-Length: 13\r\n")
+                                   _T("\r\n")
+                                   _T("{\"value\":123}");
+
+    static void Check(const RequestReceiver& receiver)
+    {
+        const Web::Request& request(receiver.Received);
+
+        EXPECT_EQ(receiver.Count, 1u);
+        EXPECT_EQ(request.Verb, Web::Request::HTTP_POST);
+        EXPECT_EQ(request.Path, _T("/Service/Controller/Plugins"));
+        ASSERT_TRUE(request.Query.IsSet());
+        EXPECT_EQ(request.Query.Value(), _T("detail=true"));
+        EXPECT_FALSE(request.Fragment.IsSet());
+        EXPECT_EQ(request.MajorVersion, 1);
+        EXPECT_EQ(request.MinorVersion, 1);
+        EXPECT_EQ(request.Host.Value(), _T("127.0.0.1:80"));
+        EXPECT_EQ(request.UserAgent.Value(), _T("quoted agent"));
+        EXPECT_EQ(request.Connection.Value(), Web::Request::CONNECTION_UPGRADE);
+        EXPECT_EQ(request.Upgrade.Value(), Web::Request::UPGRADE_WEBSOCKET);
+        EXPECT_EQ(request.WebSocketKey.Value(), _T("dGhlIHNhbXBsZSBub25jZQ=="));
+        EXPECT_EQ(request.ContentType.Value(), Web::MIME_JSON);
+        EXPECT_EQ(request.ContentLength.Value(), 13u);
+        EXPECT_EQ(static_cast<const string&>(*receiver.Body), _T("{\"value\":123}"));
+    }
+
+    TEST(WebSerializer, Request)
+    {
+        RequestReceiver receiver;
+        const uint16_t length = static_cast<uint16_t>((sizeof(Request) / sizeof(TCHAR)) - 1);
+
+        EXPECT_EQ(receiver.Deserialize(reinterpret_cast<const uint8_t*>(Request), length), length);
+
+        Check(receiver);
+    }
+
+    TEST(WebSerializer, RequestInSegments)
+    {
+        const uint16_t length = static_cast<uint16_t>((sizeof(Request) / sizeof(TCHAR)) - 1);
+
+        // Every split point, a token or a line terminator split over two segments should not matter.
+        for (uint16_t split = 1; split < length; split++) {
+            RequestReceiver receiver;
+            const uint8_t* stream = reinterpret_cast<const uint8_t*>(Request);
+
+            EXPECT_EQ(receiver.Deserialize(stream, split), split);
+            EXPECT_EQ(receiver.Deserialize(&stream[split], length - split), length - split);
+
+            Check(receiver);
+        }
+    }
+
+    TEST(WebSerializer, Verbs)
+    {
+        static const TCHAR* const verbs[] = { _T("GET"), _T("HEAD"), _T("PUT"), _T("DELETE"), _T("OPTIONS"), _T("M-SEARCH"), _T("NOTIFY") };
+        static const Web::Request::type types[] = { Web::Request::HTTP_GET, Web::Request::HTTP_HEAD, Web::Request::HTTP_PUT, Web::Request::HTTP_DELETE, Web::Request::HTTP_OPTIONS, Web::Request::HTTP_MSEARCH, Web::Request::HTTP_NOTIFY };
+
+        for (uint8_t index = 0; index < (sizeof(verbs) / sizeof(verbs[0])); index++) {
+            RequestReceiver receiver;
+            const string text(string(verbs[index]) + _T(" / HTTP/1.1\r\n\r\n"));
+
+            receiver.Deserialize(reinterpret_cast<const uint8_t*>(text.c_str()), static_cast<uint16_t>(text.length()));
+
+            EXPECT_EQ(receiver.Count, 1u);
+            EXPECT_EQ(receiver.Received.Verb, types[index]);
+        }
+
+        RequestReceiver receiver;
+        const string text(_T("FETCH / HTTP/1.1\r\n\r\n"));
+
+        receiver.Deserialize(reinterpret_cast<const uint8_t*>(text.c_str()), static_cast<uint16_t>(text.length()));
+
+        EXPECT_EQ(receiver.Count, 0u);
+    }
+
+    TEST(WebSerializer, ConditionalHeaders)
+    {
+        RequestReceiver receiver;
+        const string text(_T("GET /index.html HTTP/1.1\r\n")
+                          _T("If-Modified-Since: Sun, 06 Nov 1994 08:49:37 GMT\r\n")
+                          _T("If-None-Match: W/\"1-2\", \"3-4\"\r\n")
+                          _T("Range: bytes=10-\r\n")
+                          _T("\r\n"));
+
+        receiver.Deserialize(reinterpret_cast<const uint8_t*>(text.c_str()), static_cast<uint16_t>(text.length()));
+
+        ASSERT_EQ(receiver.Count, 1u);
+        ASSERT_TRUE(receiver.Received.IfModifiedSince.IsSet());
+        EXPECT_EQ(receiver.Received.IfModifiedSince.Value().ToRFC1123(false), _T("Sun, 06 Nov 1994 08:49:37 GMT"));
+        EXPECT_EQ(receiver.Received.IfNoneMatch.Value(), _T("W/\"1-2\", \"3-4\""));
+        EXPECT_EQ(receiver.Received.Range.Value(), _T("bytes=10-"));
+    }
+
+    // Collects the header of a response and either the body bytes or, if the link can, the part of the
+    // file the kernel would have sent.
+    class ResponseSender : public Web::Response::Serializer {
+    public:
+        ResponseSender(const ResponseSender&) = delete;
+        ResponseSender& operator=(const ResponseSender&) = delete;
+
+        ResponseSender(const bool transfer)
+            : Web::Response::Serializer()
+            , Text()
+            , Offset(0)
+            , Length(0)
+            , Transferred(false)
+            , Triggers(0)
+            , Done(false)
+            , _transfer(transfer)
+        {
+        }
+        ~ResponseSender()
+        {
+        }
+
+    public:
+        void Serialized(const Web::Response&) override
+        {
+            Done = true;
+        }
+        void Trigger() override
+        {
+            Triggers++;
+        }
+        bool Transfer(const Core::File::Handle, const uint64_t offset, const uint32_t length) override
+        {
+            Offset = offset;
+            Length = length;
+            Transferred = _transfer;
+
+            return (_transfer);
+        }
+
+        void Send(const Web::Response& response)
+        {
+            uint8_t buffer[64];
+            uint16_t length;
+
+            Submit(response);
+
+            while ((length = Serialize(buffer, sizeof(buffer))) != 0) {
+                Text.append(reinterpret_cast<const char*>(buffer), length);
+            }
+        }
+        // What a link does once it is triggered.
+        string Resume()
+        {
+            const size_t start = Text.length();
+            uint8_t buffer[64];
+            uint16_t length;
+
+            while ((length = Serialize(buffer, sizeof(buffer))) != 0) {
+                Text.append(reinterpret_cast<const char*>(buffer), length);
+            }
+
+            return (Text.substr(start));
+        }
+
+        string Text;
+        uint64_t Offset;
+        uint32_t Length;
+        bool Transferred;
+        uint32_t Triggers;
+        bool Done;
+
+    private:
+        bool _transfer;
+    };
+
+    class WebFileResponse : public ::testing::Test {
+    protected:
+        WebFileResponse()
+            : _file(string(_T("/tmp/wpefileresponse.txt")))
+        {
+        }
+
+        void SetUp() override
+        {
+            ASSERT_TRUE(_file.Create());
+
+            for (uint8_t index = 0; index < 100; index++) {
+                uint8_t value = '0' + (index % 10);
+                _file.Write(&value, 1);
+            }
+
+            _file.Close();
+            _file.LoadFileInfo();
+        }
+        void TearDown() override
+        {
+            _file.Destroy();
+        }
+
+        string Tag() const
+        {
+            return (_T("\"100-") + Core::NumberType<uint64_t>(_file.ModificationTime().Ticks() / 1000000).Text() + _T("\""));
+        }
+
+        uint16_t Answer(Web::Request& request, Web::Response& response)
+        {
+            Core::ProxyType<Web::FileBody> body(Core::ProxyType<Web::FileBody>::Create());
+
+            *body = _file.Name();
+
+            Web::FileResponse(request, response, body);
+
+            return (response.ErrorCode);
+        }
+
+        Core::File _file;
+    };
+
+    TEST_F(WebFileResponse, Whole)
+    {
+        Web::Request request;
+        Web::Response response;
+
+        EXPECT_EQ(Answer(request, response), Web::STATUS_OK);
+        EXPECT_EQ(response.ETag.Value(), Tag());
+        EXPECT_EQ(response.AcceptRange.Value(), _T("bytes"));
+        EXPECT_FALSE(response.ContentRange.IsSet());
+
+        ResponseSender sender(false);
+        sender.Send(response);
+
+        EXPECT_NE(sender.Text.find(_T("Content-Length: 100\r\n")), string::npos);
+        EXPECT_EQ(sender.Text.substr(sender.Text.length() - 12), _T("890123456789"));
+    }
+
+    TEST_F(WebFileResponse, Range)
+    {
+        static const TCHAR* const ranges[] = { _T("bytes=10-19"), _T("bytes=90-"), _T("bytes=-5"), _T("bytes=95-200") };
+        static const TCHAR* const contentRanges[] = { _T("bytes 10-19/100"), _T("bytes 90-99/100"), _T("bytes 95-99/100"), _T("bytes 95-99/100") };
+        static const TCHAR* const bodies[] = { _T("0123456789"), _T("0123456789"), _T("56789"), _T("56789") };
+
+        for (uint8_t index = 0; index < (sizeof(ranges) / sizeof(ranges[0])); index++) {
+            Web::Request request;
+            Web::Response response;
+
+            request.Range = ranges[index];
+
+            EXPECT_EQ(Answer(request, response), Web::STATUS_PARTIAL_CONTENT);
+            EXPECT_EQ(response.ContentRange.Value(), contentRanges[index]);
+
+            ResponseSender sender(false);
+            sender.Send(response);
+
+            const string body(bodies[index]);
+
+            EXPECT_NE(sender.Text.find(_T("Content-Length: ") + Core::NumberType<uint32_t>(static_cast<uint32_t>(body.length())).Text() + _T("\r\n")), string::npos);
+            EXPECT_EQ(sender.Text.substr(sender.Text.length() - body.length()), body);
+        }
+
+        // Sent by the kernel, only the header goes through the serializer.
+        Web::Request request;
+        Web::Response response;
+        ResponseSender sender(true);
+
+        request.Range = _T("bytes=10-19");
+        Answer(request, response);
+        sender.Send(response);
+
+        EXPECT_TRUE(sender.Transferred);
+        EXPECT_EQ(sender.Offset, 10u);
+        EXPECT_EQ(sender.Length, 10u);
+        EXPECT_EQ(sender.Text.substr(sender.Text.length() - 4), _T("\r\n\r\n"));
+    }
+
+    TEST_F(WebFileResponse, Unsatisfiable)
+    {
+        Web::Request request;
+        Web::Response response;
+
+        request.Range = _T("bytes=100-");
+
+        EXPECT_EQ(Answer(request, response), Web::STATUS_REQUEST_RANGE_NOT_SATISFIABLE);
+        EXPECT_EQ(response.ContentRange.Value(), _T("bytes */100"));
+        EXPECT_FALSE(response.HasBody());
+
+        // Multiple ranges or other units are not supported, the whole file is sent.
+        for (const TCHAR* range : { _T("bytes=0-1,5-6"), _T("items=0-1"), _T("bytes=5-2"), _T("bytes=a-") }) {
+            Web::Response other;
+
+            request.Range = range;
+
+            EXPECT_EQ(Answer(request, other), Web::STATUS_OK);
+            EXPECT_FALSE(other.ContentRange.IsSet());
+        }
+    }
+
+    TEST_F(WebFileResponse, Large)
+    {
+        // A sparse file, past what a body can be positioned at or serialize in one go.
+        ASSERT_TRUE(_file.Open(false));
+        ASSERT_TRUE(_file.SetSize(0x180000000ULL));
+        _file.Close();
+
+        Web::Request request;
+        Web::Response response;
+
+        request.Range = _T("bytes=16-");
+
+        EXPECT_EQ(Answer(request, response), Web::STATUS_PARTIAL_CONTENT);
+        EXPECT_EQ(response.ContentRange.Value(), _T("bytes 16-4294967309/6442450944"));
+
+        Web::Response beyond;
+
+        request.Range = _T("bytes=4294967296-");
+
+        EXPECT_EQ(Answer(request, beyond), Web::STATUS_REQUEST_RANGE_NOT_SATISFIABLE);
+        EXPECT_EQ(beyond.ContentRange.Value(), _T("bytes */6442450944"));
+        EXPECT_FALSE(beyond.HasBody());
+    }
+
+    TEST_F(WebFileResponse, NotModified)
+    {
+        Web::Request request;
+        Web::Response response;
+
+        request.IfNoneMatch = _T("\"1-2\", W/") + Tag();
+
+        EXPECT_EQ(Answer(request, response), Web::STATUS_NOT_MODIFIED);
+        EXPECT_FALSE(response.HasBody());
+
+        // If-None-Match has precedence, even if the time says it is not modified.
+        Web::Response changed;
+
+        request.IfNoneMatch = _T("\"1-2\"");
+        request.IfModifiedSince = Core::Time::Now();
+
+        EXPECT_EQ(Answer(request, changed), Web::STATUS_OK);
+
+        Web::Response unchanged;
+
+        request.IfNoneMatch.Clear();
+
+        EXPECT_EQ(Answer(request, unchanged), Web::STATUS_NOT_MODIFIED);
+
+        Web::Response modified;
+
+        request.IfModifiedSince = Core::Time(_file.ModificationTime().Ticks() - (2 * 1000000));
+
+        EXPECT_EQ(Answer(request, modified), Web::STATUS_OK);
+    }
+
+    TEST(WebSerializer, FileNotFound)
+    {
+        Web::Request request;
+        Web::Response response;
+        Core::ProxyType<Web::FileBody> body(Core::ProxyType<Web::FileBody>::Create());
+
+        *body = _T("/this/file/does/not/exist.html");
+
+        Web::FileResponse(request, response, body);
+
+        EXPECT_EQ(response.ErrorCode, Web::STATUS_NOT_FOUND);
+        EXPECT_FALSE(response.HasBody());
+    }
+
+    class ResponseReceiver : public Web::Response::Deserializer {
+    public:
+        ResponseReceiver(const ResponseReceiver&) = delete;
+        ResponseReceiver& operator=(const ResponseReceiver&) = delete;
+
+        ResponseReceiver()
+            : Web::Response::Deserializer()
+            , Received()
+            , Body(Core::ProxyType<Web::TextBody>::Create())
+            , Count(0)
+        {
+        }
+        ~ResponseReceiver()
+        {
+        }
+
+    public:
+        void Deserialized(Web::Response&) override
+        {
+            Count++;
+        }
+        Web::Response* Element() override
+        {
+            return (&Received);
+        }
+        bool LinkBody(Web::Response& response) override
+        {
+            response.Body(Body);
+            return (true);
+        }
+
+        Web::Response Received;
+        Core::ProxyType<Web::TextBody> Body;
+        uint32_t Count;
+    };
+
+    class Producer : public Web::StreamBody::IProducer, public Web::StreamBody::IConsumer {
+    public:
+        Producer(const Producer&) = delete;
+        Producer& operator=(const Producer&) = delete;
+
+        Producer()
+            : Writables(0)
+            , Data()
+            , Done(false)
+        {
+        }
+        ~Producer()
+        {
+        }
+
+    public:
+        void Writable() override
+        {
+            Writables++;
+        }
+        void Received(const uint8_t data[], const uint16_t length) override
+        {
+            Data.append(reinterpret_cast<const char*>(data), length);
+        }
+        void Completed() override
+        {
+            Done = true;
+        }
+
+        uint32_t Writables;
+        string Data;
+        bool Done;
+    };
+
+    static uint32_t Write(Web::StreamBody& body, const string& text)
+    {
+        return (body.Write(reinterpret_cast<const uint8_t*>(text.c_str()), static_cast<uint32_t>(text.length())));
+    }
+
+    TEST(WebSerializer, StreamedResponse)
+    {
+        Core::ProxyType<Web::StreamBody> body(Core::ProxyType<Web::StreamBody>::Create());
+        Web::Response response;
+        ResponseSender sender(false);
+
+        response.Body<Web::StreamBody>(body);
+
+        Write(*body, _T("Hello"));
+        sender.Send(response);
+
+        EXPECT_NE(sender.Text.find(_T("Transfer-Encoding: chunked\r\n")), string::npos);
+        EXPECT_EQ(sender.Text.find(_T("Content-Length:")), string::npos);
+
+        // Nothing more yet, the link waits to be triggered.
+        EXPECT_FALSE(sender.Done);
+        EXPECT_EQ(sender.Triggers, 0u);
+
+        Write(*body, _T(", "));
+        Write(*body, _T("world"));
+
+        EXPECT_EQ(sender.Triggers, 1u);
+        EXPECT_EQ(sender.Resume(), _T("0007\r\n, world\r\n"));
+
+        body->Close();
+
+        EXPECT_EQ(sender.Triggers, 2u);
+        EXPECT_EQ(sender.Resume(), _T("0\r\n\r\n"));
+        EXPECT_TRUE(sender.Done);
+
+        // It is read back as sent.
+        ResponseReceiver receiver;
+
+        receiver.Deserialize(reinterpret_cast<const uint8_t*>(sender.Text.c_str()), static_cast<uint16_t>(sender.Text.length()));
+
+        EXPECT_EQ(receiver.Count, 1u);
+        EXPECT_EQ(static_cast<const string&>(*receiver.Body), _T("Hello, world"));
+    }
+
+    TEST(WebSerializer, StreamFlowControl)
+    {
+        Core::ProxyType<Web::StreamBody> body(Core::ProxyType<Web::StreamBody>::Create(8));
+        Web::Response response;
+        ResponseSender sender(false);
+        Producer producer;
+        string sent;
+
+        body->Producer(&producer);
+        response.Body<Web::StreamBody>(body);
+
+        EXPECT_EQ(Write(*body, _T("0123456789")), 8u);
+        EXPECT_EQ(Write(*body, _T("89")), 0u);
+
+        sender.Send(response);
+
+        // Taking out what was buffered makes room.
+        EXPECT_EQ(producer.Writables, 1u);
+        EXPECT_EQ(Write(*body, _T("89ABCDEFGHIJ")), 8u);
+        EXPECT_EQ(sender.Triggers, 1u);
+
+        sender.Resume();
+        EXPECT_EQ(producer.Writables, 2u);
+
+        EXPECT_EQ(Write(*body, _T("GHIJ")), 4u);
+        body->Close();
+        sender.Resume();
+
+        EXPECT_TRUE(sender.Done);
+
+        ResponseReceiver receiver;
+
+        receiver.Deserialize(reinterpret_cast<const uint8_t*>(sender.Text.c_str()), static_cast<uint16_t>(sender.Text.length()));
+
+        EXPECT_EQ(static_cast<const string&>(*receiver.Body), _T("0123456789ABCDEFGHIJ"));
+    }
+
+    TEST(WebSerializer, StreamDetachedWhileTriggered)
+    {
+        // A link that sends as soon as it is triggered, so the body ends and detaches within its Trigger().
+        class Sender : public ResponseSender {
+        public:
+            Sender()
+                : ResponseSender(false)
+            {
+            }
+
+            void Trigger() override
+            {
+                ResponseSender::Trigger();
+                Resume();
+            }
+        };
+
+        Core::ProxyType<Web::StreamBody> body(Core::ProxyType<Web::StreamBody>::Create());
+        Web::Response response;
+        Sender sender;
+
+        response.Body<Web::StreamBody>(body);
+        sender.Send(response);
+
+        Write(*body, _T("Hello"));
+        EXPECT_EQ(sender.Triggers, 1u);
+
+        body->Close();
+
+        EXPECT_EQ(sender.Triggers, 2u);
+        EXPECT_TRUE(sender.Done);
+
+        // Detached, the body does not trigger the link anymore.
+        body->Close();
+        EXPECT_EQ(sender.Triggers, 2u);
+    }
+
+    TEST(WebSerializer, StreamedRequest)
+    {
+        // The chunk sizes are hexadecimal.
+        const string text(_T("POST /upload HTTP/1.1\r\n")
+                          _T("Transfer-Encoding: chunked\r\n")
+                          _T("\r\n")
+                          _T("1A\r\nabcdefghijklmnopqrstuvwxyz\r\n")
+                          _T("3\r\n123\r\n")
+                          _T("0\r\n\r\n"));
+
+        class Receiver : public RequestReceiver {
+        public:
+            bool LinkBody(Web::Request& request) override
+            {
+                request.Body(Stream);
+                return (true);
+            }
+
+            Core::ProxyType<Web::StreamBody> Stream = Core::ProxyType<Web::StreamBody>::Create();
+        } receiver;
+        Producer consumer;
+
+        receiver.Stream->Consumer(&consumer);
+
+        // In small segments, nothing is kept in the body itself.
+        for (size_t offset = 0; offset < text.length(); offset += 7) {
+            const uint16_t length = static_cast<uint16_t>(std::min(text.length() - offset, static_cast<size_t>(7)));
+
+            receiver.Deserialize(reinterpret_cast<const uint8_t*>(&(text.c_str()[offset])), length);
+        }
+
+        EXPECT_EQ(receiver.Count, 1u);
+        EXPECT_EQ(consumer.Data, _T("abcdefghijklmnopqrstuvwxyz123"));
+        EXPECT_TRUE(consumer.Done);
+    }
+
+} // Tests
+} // WPEFramework
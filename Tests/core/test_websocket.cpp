@@ -0,0 +1,562 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2020 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include <core/core.h>
+#include <websocket/websocket.h>
+
+namespace WPEFramework {
+namespace Tests {
+
+    // Sends one message the way the link does: plain data is handed out in chunks of the frame size and
+    // the compressed data is taken out per frame.
+    static std::vector<string> Send(Web::WebSocket::Deflate& deflate, const string& message, const uint16_t frameSize)
+    {
+        std::vector<string> frames;
+        std::vector<uint8_t> frame(frameSize);
+        size_t offset = 0;
+
+        do {
+            while ((deflate.IsFinished() == false) && (deflate.Pending() < frameSize)) {
+                uint16_t loaded = static_cast<uint16_t>(std::min(message.length() - offset, static_cast<size_t>(frameSize)));
+
+                ::memcpy(frame.data(), &(message.c_str()[offset]), loaded);
+                offset += loaded;
+
+                deflate.Compress(frame.data(), loaded, (loaded < frameSize));
+            }
+
+            uint16_t length = deflate.Compressed(frame.data(), frameSize);
+
+            frames.push_back(string(reinterpret_cast<const char*>(frame.data()), length));
+
+        } while (deflate.IsCompressing() == true);
+
+        return (frames);
+    }
+
+    static string Receive(Web::WebSocket::Deflate& inflate, const std::vector<string>& frames)
+    {
+        string message;
+        uint8_t buffer[64];
+
+        for (uint32_t index = 0; index < frames.size(); index++) {
+            uint16_t length;
+
+            inflate.Decompress(reinterpret_cast<const uint8_t*>(frames[index].c_str()), static_cast<uint16_t>(frames[index].length()), (index == (frames.size() - 1)));
+
+            while ((length = inflate.Decompressed(buffer, sizeof(buffer))) != 0) {
+                message.append(reinterpret_cast<const char*>(buffer), length);
+            }
+        }
+
+        return (message);
+    }
+
+    static string Message(const uint32_t size)
+    {
+        string result;
+
+        while (result.length() < size) {
+            result += _T("{\"jsonrpc\":\"2.0\",\"method\":\"client.events.1.statechange\",\"params\":{\"callsign\":\"WebKitBrowser\",\"state\":\"activated\"}}");
+        }
+        result.resize(size);
+
+        return (result);
+    }
+
+    TEST(WebSocket, DeflateNegotiation)
+    {
+        Web::WebSocket::Deflate client;
+        Web::WebSocket::Deflate server;
+        string response;
+
+        client.Mode(Web::WebSocket::DEFLATE);
+        server.Mode(Web::WebSocket::DEFLATE_NO_CONTEXT);
+
+        // What a browser offers.
+        EXPECT_TRUE(server.Accept(_T("permessage-deflate; client_max_window_bits"), response));
+        EXPECT_EQ(response, _T("permessage-deflate; server_no_context_takeover; client_no_context_takeover"));
+        EXPECT_TRUE(server.IsActive());
+
+        EXPECT_TRUE(client.Agreed(response));
+        EXPECT_TRUE(client.IsActive());
+
+        // The first offer that can be honoured wins.
+        server.Mode(Web::WebSocket::DEFLATE);
+        EXPECT_TRUE(server.Accept(_T("permessage-deflate; server_max_window_bits=8, permessage-deflate; server_max_window_bits=\"10\", permessage-deflate"), response));
+        EXPECT_EQ(response, _T("permessage-deflate; server_max_window_bits=10"));
+
+        EXPECT_FALSE(server.Accept(_T("x-webkit-deflate-frame"), response));
+        EXPECT_FALSE(server.Accept(_T("permessage-deflate; server_no_context_takeover; server_no_context_takeover"), response));
+        EXPECT_FALSE(server.IsActive());
+
+        EXPECT_EQ(client.Offer(), _T("permessage-deflate; client_max_window_bits"));
+        EXPECT_FALSE(client.Agreed(_T("permessage-deflate; unknown_parameter")));
+        EXPECT_FALSE(client.IsActive());
+    }
+
+    TEST(WebSocket, DeflateMessage)
+    {
+        // RFC 7692, 7.2.3.1: "Hello" compressed in a single frame.
+        static const uint8_t hello[] = { 0xf2, 0x48, 0xcd, 0xc9, 0xc9, 0x07, 0x00 };
+
+        Web::WebSocket::Deflate deflate;
+        string response;
+
+        deflate.Mode(Web::WebSocket::DEFLATE_NO_CONTEXT);
+        ASSERT_TRUE(deflate.Accept(_T("permessage-deflate"), response));
+
+        std::vector<string> frames(Send(deflate, _T("Hello"), 128));
+
+        ASSERT_EQ(frames.size(), 1u);
+        EXPECT_EQ(frames[0], string(reinterpret_cast<const char*>(hello), sizeof(hello)));
+
+        EXPECT_EQ(Receive(deflate, frames), _T("Hello"));
+
+        EXPECT_EQ(deflate.Deflated().Original, 5u);
+        EXPECT_EQ(deflate.Deflated().Compressed, sizeof(hello));
+        EXPECT_EQ(deflate.Inflated().Original, 5u);
+        EXPECT_EQ(deflate.Inflated().Compressed, sizeof(hello));
+    }
+
+    TEST(WebSocket, DeflateStream)
+    {
+        static const Web::WebSocket::compression modes[] = { Web::WebSocket::DEFLATE, Web::WebSocket::DEFLATE_NO_CONTEXT };
+        static const uint32_t sizes[] = { 0, 1, 100, 256, 4000, 70000 };
+
+        for (const Web::WebSocket::compression mode : modes) {
+            Web::WebSocket::Deflate client;
+            Web::WebSocket::Deflate server;
+            string response;
+
+            client.Mode(mode);
+            server.Mode(mode);
+
+            ASSERT_TRUE(server.Accept(client.Offer(), response));
+            ASSERT_TRUE(client.Agreed(response));
+
+            // Messages are compressed one after the other on the same stream, in frames of different sizes.
+            for (const uint32_t size : sizes) {
+                for (const uint16_t frameSize : { 16, 256, 1024 }) {
+                    const string message(Message(size));
+                    std::vector<string> frames(Send(client, message, frameSize));
+
+                    for (const string& frame : frames) {
+                        EXPECT_LE(frame.length(), frameSize);
+                    }
+
+                    EXPECT_EQ(Receive(server, frames), message);
+                }
+            }
+
+            EXPECT_LT(client.Deflated().Compressed, client.Deflated().Original);
+            EXPECT_EQ(server.Inflated().Original, client.Deflated().Original);
+            EXPECT_EQ(server.Inflated().Compressed, client.Deflated().Compressed);
+        }
+    }
+
+    TEST(WebSocket, DeflateCorrupted)
+    {
+        // A block of the reserved type, there is no making sense of what follows.
+        static const uint8_t garbage[] = { 0xff, 0xff, 0xff, 0xff };
+
+        Web::WebSocket::Deflate deflate;
+        uint8_t buffer[64];
+        string response;
+
+        ASSERT_TRUE(deflate.Accept(_T("permessage-deflate"), response));
+        EXPECT_FALSE(deflate.IsCorrupted());
+
+        deflate.Decompress(garbage, sizeof(garbage), true);
+
+        EXPECT_EQ(deflate.Decompressed(buffer, sizeof(buffer)), 0);
+        EXPECT_TRUE(deflate.IsCorrupted());
+
+        deflate.Reset();
+        EXPECT_FALSE(deflate.IsCorrupted());
+    }
+
+    TEST(WebSocket, CompressedFrame)
+    {
+        Web::WebSocket::Protocol sender(false, false);
+        Web::WebSocket::Protocol receiver(false, false);
+        uint8_t frame[32];
+
+        sender.Compression(true);
+        receiver.Compression(true);
+
+        ::memcpy(&frame[4], "abc", 3);
+
+        uint16_t length = sender.Encoder(frame, sizeof(frame) - 4, 3);
+
+        ASSERT_EQ(length, 5);
+        EXPECT_EQ(frame[0], 0xC1); // FIN, RSV1 and a text frame.
+
+        uint16_t payload = length;
+        uint16_t header = receiver.Decoder(frame, payload);
+
+        EXPECT_EQ(header, 2);
+        EXPECT_EQ(payload, 3);
+        EXPECT_EQ(receiver.FrameType(), Web::WebSocket::Protocol::TEXT);
+        EXPECT_TRUE(receiver.IsCompressedMessage());
+
+        // RSV1 on a link that did not negotiate compression is a protocol violation.
+        Web::WebSocket::Protocol plain(false, false);
+
+        payload = length;
+        plain.Decoder(frame, payload);
+
+        EXPECT_EQ(plain.FrameType(), Web::WebSocket::Protocol::VIOLATION);
+    }
+
+    TEST(WebSocket, CloseStatus)
+    {
+        Web::WebSocket::Protocol server(false, false);
+        Web::WebSocket::Protocol client(false, true);
+        Web::WebSocket::Protocol receiver(false, false);
+        uint8_t frame[32];
+
+        server.Close(Web::WebSocket::Protocol::INVALID_DATA);
+
+        ASSERT_EQ(server.Encoder(frame, sizeof(frame), 0), 4);
+        EXPECT_EQ(frame[0], 0x88);
+        EXPECT_EQ(frame[1], 0x02);
+        EXPECT_EQ(frame[2], 0x03);
+        EXPECT_EQ(frame[3], 0xEF);
+
+        // Only sent as a whole.
+        client.Close(Web::WebSocket::Protocol::MESSAGE_TOO_BIG);
+
+        EXPECT_EQ(client.Encoder(frame, 7, 0), 0);
+
+        uint16_t length = client.Encoder(frame, sizeof(frame), 0);
+        uint16_t header = receiver.Decoder(frame, length);
+
+        ASSERT_EQ(header, 6);
+        ASSERT_EQ(length, 2);
+        EXPECT_EQ(receiver.FrameType(), Web::WebSocket::Protocol::CLOSE);
+        EXPECT_EQ((frame[header] << 8) | frame[header + 1], 1009);
+    }
+
+    TEST(WebSocket, Mask)
+    {
+        static const uint8_t key[4] = { 0x12, 0x34, 0x56, 0x78 };
+        uint8_t data[100];
+        uint8_t expected[100];
+
+        // Every length, start alignment and key offset, so each of the block sizes and the tail are hit.
+        for (uint8_t offset = 0; offset < 4; offset++) {
+            for (uint8_t start = 0; start < 8; start++) {
+                for (uint32_t length = 0; length <= (sizeof(data) - start); length++) {
+                    for (uint32_t index = 0; index < sizeof(data); index++) {
+                        data[index] = static_cast<uint8_t>(index * 13);
+                        expected[index] = data[index];
+                    }
+                    for (uint32_t index = 0; index < length; index++) {
+                        expected[start + index] ^= key[(offset + index) & 0x3];
+                    }
+
+                    Web::WebSocket::Protocol::Mask(&data[start], length, key, offset);
+
+                    ASSERT_EQ(::memcmp(data, expected, sizeof(data)), 0) << "length " << length << " start " << static_cast<uint32_t>(start) << " offset " << static_cast<uint32_t>(offset);
+                }
+            }
+        }
+    }
+
+    TEST(WebSocket, MaskedFrame)
+    {
+        for (const uint16_t size : { 1, 5, 125, 126, 1000 }) {
+            Web::WebSocket::Protocol sender(false, true);
+            Web::WebSocket::Protocol receiver(false, false);
+            std::vector<uint8_t> frame(size + 16);
+            const string message(Message(size));
+
+            ASSERT_EQ(sender.HeaderSpace(), 8);
+
+            ::memcpy(&frame[sender.HeaderSpace()], message.c_str(), size);
+
+            uint16_t length = sender.Encoder(frame.data(), size + 1, size);
+
+            ASSERT_EQ(length, size + (size <= 125 ? 6 : 8));
+            EXPECT_EQ(frame[0], 0x81);
+            EXPECT_EQ(frame[1] & 0x80, 0x80);
+
+            // The payload arrives in two segments, the masking key has to continue where the first one stopped.
+            const uint16_t split = (length / 2) + 7;
+            uint16_t received = std::min(split, length);
+            uint16_t header = receiver.Decoder(frame.data(), received);
+            string payload(reinterpret_cast<const char*>(&frame[header]), received);
+
+            if (received + header < length) {
+                EXPECT_FALSE(receiver.IsCompleteMessage());
+
+                received = length - split;
+                EXPECT_EQ(receiver.Decoder(&frame[split], received), 0);
+                payload.append(reinterpret_cast<const char*>(&frame[split]), received);
+            }
+
+            EXPECT_TRUE(receiver.IsCompleteMessage());
+            EXPECT_EQ(receiver.FrameType(), Web::WebSocket::Protocol::TEXT);
+            EXPECT_EQ(payload, message);
+        }
+    }
+
+    TEST(WebSocket, LargeFrameHeader)
+    {
+        // A 64 bits length of 70000, only the first part of the payload has arrived.
+        uint8_t frame[32] = { 0x82, 127, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x11, 0x70 };
+        Web::WebSocket::Protocol receiver(true, false);
+        uint16_t received = sizeof(frame);
+
+        EXPECT_EQ(receiver.Decoder(frame, received), 10);
+        EXPECT_EQ(received, sizeof(frame) - 10);
+        EXPECT_EQ(receiver.FrameType(), Web::WebSocket::Protocol::BINARY);
+        EXPECT_FALSE(receiver.IsCompleteMessage());
+
+        // Beyond 32 bits is not supported.
+        Web::WebSocket::Protocol other(true, false);
+
+        frame[5] = 0x01;
+        received = sizeof(frame);
+        other.Decoder(frame, received);
+
+        EXPECT_EQ(other.FrameType(), Web::WebSocket::Protocol::TOO_BIG);
+    }
+
+    // Sends the message in frames with room for frameSize bytes, all frames are decoded in one go. Returns
+    // the payload of the frames that were accepted, the frame types are reported.
+    static string Fragments(Web::WebSocket::Protocol& sender, Web::WebSocket::Protocol& receiver, const string& message, const uint16_t frameSize, std::vector<Web::WebSocket::Protocol::frameType>& types)
+    {
+        std::vector<uint8_t> frame(frameSize + sender.HeaderSpace());
+        string payload;
+        size_t offset = 0;
+
+        do {
+            const uint16_t used = static_cast<uint16_t>(std::min(message.length() - offset, static_cast<size_t>(frameSize)));
+
+            ::memcpy(&frame[sender.HeaderSpace()], &(message.c_str()[offset]), used);
+            offset += used;
+
+            uint16_t length = sender.Encoder(frame.data(), frameSize, used);
+            uint16_t header = receiver.Decoder(frame.data(), length);
+
+            types.push_back(receiver.FrameType());
+
+            if ((receiver.FrameType() & 0xF0) == 0) {
+                payload.append(reinterpret_cast<const char*>(&frame[header]), length);
+            }
+
+        } while (sender.SendInProgress() == true);
+
+        return (payload);
+    }
+
+    TEST(WebSocket, FragmentedMessage)
+    {
+        Web::WebSocket::Protocol sender(false, true);
+        Web::WebSocket::Protocol receiver(false, false);
+        std::vector<Web::WebSocket::Protocol::frameType> types;
+
+        // A message of exactly three frames is ended by an empty one.
+        const string message(Message(48));
+
+        EXPECT_EQ(Fragments(sender, receiver, message, 16, types), message);
+        ASSERT_EQ(types.size(), 4u);
+        EXPECT_TRUE(receiver.IsCompleteMessage());
+        EXPECT_FALSE(receiver.ReceiveInProgress());
+
+        for (const Web::WebSocket::Protocol::frameType type : types) {
+            EXPECT_EQ(type, Web::WebSocket::Protocol::TEXT);
+        }
+    }
+
+    TEST(WebSocket, MaxMessageSize)
+    {
+        Web::WebSocket::Protocol sender(false, true);
+        Web::WebSocket::Protocol receiver(false, false);
+        std::vector<Web::WebSocket::Protocol::frameType> types;
+
+        receiver.MaxMessageSize(100);
+
+        // Up to the limit, over any number of frames.
+        EXPECT_EQ(Fragments(sender, receiver, Message(100), 16, types), Message(100));
+        EXPECT_FALSE(receiver.IsDiscarding());
+
+        // The frames from the one that crosses the limit on are to be skipped, up to the end of the message.
+        types.clear();
+        EXPECT_EQ(Fragments(sender, receiver, Message(150), 16, types), Message(96));
+        ASSERT_EQ(types.size(), 10u);
+        EXPECT_EQ(types[5], Web::WebSocket::Protocol::TEXT);
+        EXPECT_EQ(types[6], Web::WebSocket::Protocol::TOO_BIG);
+        EXPECT_EQ(types[9], Web::WebSocket::Protocol::TOO_BIG);
+        EXPECT_TRUE(receiver.IsDiscarding());
+        EXPECT_FALSE(receiver.ReceiveInProgress());
+
+        // The next message starts over.
+        types.clear();
+        EXPECT_EQ(Fragments(sender, receiver, Message(20), 64, types), Message(20));
+        EXPECT_FALSE(receiver.IsDiscarding());
+    }
+
+    // The server end of a link whose upgrade is held till ResumeUpgrade(), as for a plugin that is still to be
+    // activated. Whatever comes in once it is upgraded is kept.
+    class HeldServer : public Web::WebSocketLinkType<Core::SocketStream, Web::Request, Web::Response, Web::WebSocket::RequestAllocator&> {
+    private:
+        typedef Web::WebSocketLinkType<Core::SocketStream, Web::Request, Web::Response, Web::WebSocket::RequestAllocator&> BaseClass;
+
+    public:
+        HeldServer(const HeldServer&) = delete;
+        HeldServer& operator=(const HeldServer&) = delete;
+
+        HeldServer(const SOCKET& connector, const Core::NodeId& remoteId, Core::SocketServerType<HeldServer>*)
+            : BaseClass(false, false, 2, Web::WebSocket::RequestAllocator::Instance(), false, connector, remoteId, 1024, 1024)
+        {
+        }
+        ~HeldServer() override
+        {
+            Close(Core::infinite);
+        }
+
+    public:
+        static HeldServer* Held;
+        static Core::Event Holding;
+        static Core::Event Receiving;
+        static string Data;
+
+        void LinkBody(Core::ProxyType<Web::Request>&) override
+        {
+        }
+        void Received(Core::ProxyType<Web::Request>&) override
+        {
+        }
+        void Send(const Core::ProxyType<Web::Response>&) override
+        {
+        }
+        uint16_t SendData(uint8_t*, const uint16_t) override
+        {
+            return (0);
+        }
+        uint16_t ReceiveData(uint8_t* dataFrame, const uint16_t receivedSize) override
+        {
+            Data.append(reinterpret_cast<const char*>(dataFrame), receivedSize);
+            Receiving.SetEvent();
+
+            return (receivedSize);
+        }
+        void StateChange() override
+        {
+            if (IsUpgrading() == true) {
+                HoldUpgrade();
+                Held = this;
+                Holding.SetEvent();
+            }
+        }
+        bool IsIdle() const override
+        {
+            return (true);
+        }
+    };
+
+    /* static */ HeldServer* HeldServer::Held = nullptr;
+    /* static */ Core::Event HeldServer::Holding(false, true);
+    /* static */ Core::Event HeldServer::Receiving(false, true);
+    /* static */ string HeldServer::Data;
+
+    class HeldClient : public Web::WebSocketClientType<Core::SocketStream> {
+    public:
+        HeldClient(const HeldClient&) = delete;
+        HeldClient& operator=(const HeldClient&) = delete;
+
+        HeldClient(const Core::NodeId& remoteNode)
+            : Web::WebSocketClientType<Core::SocketStream>(_T("/jsonrpc/Dummy"), _T("jsonrpc"), _T(""), _T(""), false, true, false, remoteNode.AnyInterface(), remoteNode, 1024, 1024)
+            , Text()
+        {
+        }
+        ~HeldClient() override
+        {
+            Close(Core::infinite);
+        }
+
+    public:
+        uint16_t SendData(uint8_t* dataFrame, const uint16_t maxSendSize) override
+        {
+            const uint16_t length = static_cast<uint16_t>(std::min(Text.length(), static_cast<size_t>(maxSendSize)));
+
+            ::memcpy(dataFrame, Text.c_str(), length);
+            Text.erase(0, length);
+
+            return (length);
+        }
+        uint16_t ReceiveData(uint8_t*, const uint16_t receivedSize) override
+        {
+            return (receivedSize);
+        }
+        void StateChange() override
+        {
+        }
+        bool IsIdle() const override
+        {
+            return (Text.empty());
+        }
+
+        string Text;
+    };
+
+    TEST(WebSocket, HeldUpgrade)
+    {
+        const Core::NodeId node(_T("127.0.0.1"), 31742);
+        const string call(_T("{\"jsonrpc\":\"2.0\",\"id\":1,\"method\":\"Dummy.1.method\"}"));
+        Core::SocketServerType<HeldServer> server(node);
+
+        ASSERT_EQ(server.Open(Core::infinite), static_cast<uint32_t>(Core::ERROR_NONE));
+
+        {
+            HeldClient client(node);
+
+            EXPECT_EQ(client.Open(1000), static_cast<uint32_t>(Core::ERROR_NONE));
+            ASSERT_EQ(HeldServer::Holding.Lock(2000), static_cast<uint32_t>(Core::ERROR_NONE));
+
+            // Not answered while held.
+            SleepMs(100);
+            EXPECT_FALSE(client.IsWebSocket());
+
+            HeldServer::Held->ResumeUpgrade();
+
+            for (uint32_t waited = 0; (client.IsWebSocket() == false) && (waited < 2000); waited += 10) {
+                SleepMs(10);
+            }
+            ASSERT_TRUE(client.IsWebSocket());
+
+            // The first message after the upgrade is taken in.
+            client.Text = call;
+            client.Trigger();
+
+            ASSERT_EQ(HeldServer::Receiving.Lock(2000), static_cast<uint32_t>(Core::ERROR_NONE));
+            EXPECT_EQ(HeldServer::Data, call);
+        }
+
+        server.Close(Core::infinite);
+        server.Cleanup();
+    }
+
+} // Tests
+} // WPEFramework
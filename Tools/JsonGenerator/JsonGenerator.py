@@ -79,6 +79,7 @@ DEFAULT_INT_SIZE = 32
 CPP_IF_PATH = "interfaces" + os.sep
 IF_PATH = CPP_IF_PATH + "json"
 DUMP_JSON = False
+STATIC_PARSER = False
 
 GLOBAL_DEFINITIONS = "global.json"
 FRAMEWORK_NAMESPACE = "WPEFramework"
@@ -229,20 +230,28 @@ class JsonNumber(JsonType):
         JsonType.__init__(self, name, parent, schema)
         self.size = DEFAULT_INT_SIZE
         self.signed = False
+        self.float = False
         # NOTE: Take a hint on the size and signedness of the number/integer
         if "size" in schema:
             self.size = schema["size"]
         if "signed" in schema:
             self.signed = schema["signed"]
+        # NOTE: "number" is used for integers all over, floating point is opt-in
+        if "float" in schema:
+            self.float = schema["float"]
 
     # def CppDefValue(self):
     #    return "0"
 
     def CppClass(self):
+        if self.float:
+            return TypePrefix("Float" if self.size == 32 else "Double")
         return TypePrefix("Dec%sInt%i" %
                           ("S" if self.signed else "U", self.size))
 
     def CppStdClass(self):
+        if self.float:
+            return "float" if self.size == 32 else "double"
         return "%sint%i_t" % ("" if self.signed else "u", self.size)
 
 
@@ -827,6 +836,8 @@ def LoadInterface(file):
                 properties = {"type": jsonType}
                 if size:
                     properties["size"] = size
+                if jsonType == "number":
+                    properties["float"] = True
                 if signed:
                     properties["signed"] = signed
                 if var.brief:
@@ -1822,6 +1833,73 @@ def EmitObjects(root, emit, emitCommon=False):
                 emit.Line("Add(_T(\"%s\"), &%s);" %
                           (prop.JsonName(), prop.CppName()))
 
+        def CanEmitStaticParser(jsonObj):
+            # Must match Core::JSON::Hash()
+            def Hash(label):
+                value = 0x811C9DC5
+                for c in label.encode("utf-8"):
+                    value = ((value ^ c) * 0x01000193) & 0xFFFFFFFF
+                return value
+
+            hashes = [Hash(prop.JsonName()) for prop in jsonObj.Properties()]
+            if len(set(hashes)) != len(hashes):
+                trace.Warn("Labels of class '%s' share a hash, not emitting a static parser for it" % jsonObj.CppClass())
+                return False
+            return True
+
+        def EmitStaticParser(jsonObj):
+            emit.Line("using %s;" % TypePrefix("Container::FromString"))
+            emit.Line("using %s;" % TypePrefix("Container::ToString"))
+            emit.Line()
+            emit.Line("bool FromString(const string& text)")
+            emit.Line("{")
+            emit.Indent()
+            emit.Line("return (%s(text, *this));" % TypePrefix("Reader::FromString"))
+            emit.Unindent()
+            emit.Line("}")
+            emit.Line()
+            emit.Line("bool ToString(string& text) const")
+            emit.Line("{")
+            emit.Indent()
+            emit.Line("return (%s(*this, text));" % TypePrefix("Writer::ToString"))
+            emit.Unindent()
+            emit.Line("}")
+            emit.Line()
+            emit.Line("bool FromJSON(%s& reader)" % TypePrefix("Reader"))
+            emit.Line("{")
+            emit.Indent()
+            emit.Line("bool result = reader.Begin();")
+            emit.Line("while ((result == true) && (reader.Next() == true)) {")
+            emit.Indent()
+            emit.Line("switch (reader.Hash()) {")
+            for prop in jsonObj.Properties():
+                emit.Line("case %s(_T(\"%s\")):" % (TypePrefix("Hash"), prop.JsonName()))
+                emit.Indent()
+                emit.Line("result = reader.Value(_T(\"%s\"), %s);" % (prop.JsonName(), prop.CppName()))
+                emit.Line("break;")
+                emit.Unindent()
+            emit.Line("default:")
+            emit.Indent()
+            emit.Line("result = reader.Skip();")
+            emit.Line("break;")
+            emit.Unindent()
+            emit.Line("}")
+            emit.Unindent()
+            emit.Line("}")
+            emit.Line("return ((result == true) && (reader.End() == true));")
+            emit.Unindent()
+            emit.Line("}")
+            emit.Line()
+            emit.Line("void ToJSON(%s& writer) const" % TypePrefix("Writer"))
+            emit.Line("{")
+            emit.Indent()
+            emit.Line("writer.Begin();")
+            for prop in jsonObj.Properties():
+                emit.Line("writer.Value(_T(\"%s\"), %s);" % (prop.JsonName(), prop.CppName()))
+            emit.Line("writer.End();")
+            emit.Unindent()
+            emit.Line("}")
+
         def EmitCtor(jsonObj, noInitCode=False, copyCtor=False):
             if copyCtor:
                 emit.Line("%s(const %s& other)" %
@@ -1891,6 +1969,12 @@ def EmitObjects(root, emit, emitCommon=False):
                 emit.Line("return (*this);")
                 emit.Unindent()
                 emit.Line("}")
+            if STATIC_PARSER and CanEmitStaticParser(jsonObj):
+                if jsonObj.NeedsCopyCtor():
+                    emit.Line()
+                EmitStaticParser(jsonObj)
+                if not jsonObj.NeedsCopyCtor():
+                    emit.Line()
             if jsonObj.NeedsCopyCtor():
                 emit.Unindent()
                 emit.Line()
@@ -2811,6 +2895,14 @@ if __name__ == "__main__":
                            default=DEFAULT_INT_SIZE,
                            help="default integer size in bits (default: %i)" %
                            DEFAULT_INT_SIZE)
+    argparser.add_argument(
+        "--static-parser",
+        dest="static_parser",
+        action="store_true",
+        default=False,
+        help=
+        "also emit statically dispatched FromJSON()/ToJSON() methods for each class (default: reflective parsing only)"
+    )
     argparser.add_argument(
         "--no-warnings",
         dest="no_warnings",
@@ -2826,6 +2918,7 @@ if __name__ == "__main__":
     DEFAULT_EMPTY_STRING = args.def_string
     DEFAULT_INT_SIZE = args.def_int_size
     DUMP_JSON = args.dump_json
+    STATIC_PARSER = args.static_parser
     if args.if_path and args.if_path != ".":
         IF_PATH = args.if_path
     IF_PATH = posixpath.normpath(IF_PATH) + os.sep